@@ -38,12 +38,11 @@ static int get_kf_id(struct ngl_node * const *animkf, int nb_animkf, int start,
     return ret;
 }
 
-int ngli_animation_evaluate(struct animation *s, void *dst, double t)
+int ngli_animation_locate(struct animation *s, double t, double *tnorm,
+                          const struct animkeyframe_priv **kf)
 {
     struct ngl_node * const *animkf = s->kfs;
     const int nb_animkf = s->nb_kfs;
-    if (!nb_animkf)
-        return 0;
     int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
     if (kf_id < 0)
         kf_id = get_kf_id(animkf, nb_animkf, 0, t);
@@ -53,19 +52,49 @@ int ngli_animation_evaluate(struct animation *s, void *dst, double t)
         const double t0 = kf0->time;
         const double t1 = kf1->time;
 
-        double tnorm = (t - t0) / (t1 - t0);
-        if (kf1->scale_boundaries)
-            tnorm = (kf1->offsets[1] - kf1->offsets[0]) * tnorm + kf1->offsets[0];
-        double ratio = kf1->function(tnorm, kf1->nb_args, kf1->args);
+        double tn = (t - t0) / (t1 - t0);
         if (kf1->scale_boundaries)
-            ratio = (ratio - kf1->boundaries[0]) / (kf1->boundaries[1] - kf1->boundaries[0]);
+            tn = (kf1->offsets[1] - kf1->offsets[0]) * tn + kf1->offsets[0];
 
         s->current_kf = kf_id;
-        s->mix_func(s->user_arg, dst, kf0, kf1, ratio);
+        *tnorm = tn;
+        return kf_id;
+    }
+
+    const struct animkeyframe_priv *kf0 = animkf[            0]->priv_data;
+    const struct animkeyframe_priv *kfn = animkf[nb_animkf - 1]->priv_data;
+    *kf = t < kf0->time ? kf0 : kfn;
+    return -1;
+}
+
+double ngli_animation_ease(const struct animkeyframe_priv *kf1, double tnorm)
+{
+    if (kf1->lut.samples)
+        return ngli_easing_lut_evaluate(&kf1->lut, tnorm);
+    return kf1->function(tnorm, kf1->nb_args, kf1->args);
+}
+
+double ngli_animation_scale_ratio(const struct animkeyframe_priv *kf1, double ratio)
+{
+    if (kf1->scale_boundaries)
+        ratio = (ratio - kf1->boundaries[0]) / (kf1->boundaries[1] - kf1->boundaries[0]);
+    return ratio;
+}
+
+int ngli_animation_evaluate(struct animation *s, void *dst, double t)
+{
+    if (!s->nb_kfs)
+        return 0;
+
+    double tnorm;
+    const struct animkeyframe_priv *kf;
+    const int kf_id = ngli_animation_locate(s, t, &tnorm, &kf);
+    if (kf_id >= 0) {
+        const struct animkeyframe_priv *kf0 = s->kfs[kf_id    ]->priv_data;
+        const struct animkeyframe_priv *kf1 = s->kfs[kf_id + 1]->priv_data;
+        const double ratio = ngli_animation_ease(kf1, tnorm);
+        s->mix_func(s->user_arg, dst, kf0, kf1, ngli_animation_scale_ratio(kf1, ratio));
     } else {
-        const struct animkeyframe_priv *kf0 = animkf[            0]->priv_data;
-        const struct animkeyframe_priv *kfn = animkf[nb_animkf - 1]->priv_data;
-        const struct animkeyframe_priv *kf  = t < kf0->time ? kf0 : kfn;
         s->cpy_func(s->user_arg, dst, kf);
     }
     return 0;
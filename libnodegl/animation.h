@@ -50,4 +50,19 @@ int ngli_animation_init(struct animation *s, void *user_arg,
 
 int ngli_animation_evaluate(struct animation *s, void *dst, double t);
 
+/*
+ * Locate t within the key frames. If t is within a segment, the index of its
+ * first key frame is returned and tnorm is set to the normalized time to pass
+ * to the easing of the second key frame. Otherwise, -1 is returned and kf is
+ * set to the key frame holding the value to use as is.
+ */
+int ngli_animation_locate(struct animation *s, double t, double *tnorm,
+                          const struct animkeyframe_priv **kf);
+
+/* Evaluate the easing of kf1, through its look-up table if any */
+double ngli_animation_ease(const struct animkeyframe_priv *kf1, double tnorm);
+
+/* Rescale the output of the easing of kf1 if it is truncated */
+double ngli_animation_scale_ratio(const struct animkeyframe_priv *kf1, double ratio);
+
 #endif
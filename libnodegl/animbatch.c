@@ -0,0 +1,215 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "animbatch.h"
+#include "math_utils.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+struct animbatch_segment {
+    struct ngl_node *node;
+    const struct animkeyframe_priv *kf0;
+    const struct animkeyframe_priv *kf1;
+    double tnorm;
+    int bucket;
+};
+
+/*
+ * Easings with arguments or a look-up table can not share a pass since every
+ * key frame has its own arguments and table, so they are evaluated
+ * individually.
+ */
+#define BUCKET_CUSTOM EASING_NB
+#define NB_BUCKETS    (EASING_NB + 1)
+
+void ngli_animbatch_init(struct animbatch *s)
+{
+    ngli_darray_init(&s->nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->segments, sizeof(struct animbatch_segment), 0);
+    ngli_darray_init(&s->order, sizeof(int), 0);
+    ngli_darray_init(&s->tnorms, sizeof(double), 0);
+    ngli_darray_init(&s->ratios, sizeof(double), 0);
+}
+
+int ngli_animbatch_add(struct animbatch *s, struct ngl_node *node)
+{
+    struct variable_priv *priv = node->priv_data;
+    if (!ngli_darray_push(&s->nodes, &node))
+        return NGL_ERROR_MEMORY;
+    priv->batch_index = ngli_darray_count(&s->nodes) - 1;
+    return 0;
+}
+
+void ngli_animbatch_remove(struct animbatch *s, struct ngl_node *node)
+{
+    struct variable_priv *priv = node->priv_data;
+    if (priv->batch_index < 0)
+        return;
+
+    /* Move the last node in place of the removed one */
+    struct ngl_node **nodes = ngli_darray_data(&s->nodes);
+    struct ngl_node *last = *(struct ngl_node **)ngli_darray_pop(&s->nodes);
+    if (last != node) {
+        struct variable_priv *last_priv = last->priv_data;
+        nodes[priv->batch_index] = last;
+        last_priv->batch_index = priv->batch_index;
+    }
+    priv->batch_index = -1;
+}
+
+static void mix_values(struct ngl_node *node,
+                       const struct animkeyframe_priv *kf0,
+                       const struct animkeyframe_priv *kf1,
+                       double ratio)
+{
+    struct variable_priv *s = node->priv_data;
+    if (node->class->id == NGL_NODE_ANIMATEDFLOAT) {
+        s->scalar = NGLI_MIX(kf0->scalar, kf1->scalar, ratio);
+        return;
+    }
+    const int nb_comp = s->data_size / sizeof(*s->vector);
+    for (int i = 0; i < nb_comp; i++)
+        s->vector[i] = NGLI_MIX(kf0->value[i], kf1->value[i], ratio);
+}
+
+static void flag_updated(struct ngl_node *node, double t)
+{
+    node->last_update_time = t;
+    node->draw_count = 0;
+    node->ctx->nb_updated_nodes++;
+}
+
+int ngli_animbatch_update(struct animbatch *s, double t)
+{
+    struct ngl_node **nodes = ngli_darray_data(&s->nodes);
+    const int nb_nodes = ngli_darray_count(&s->nodes);
+    if (!nb_nodes)
+        return 0;
+
+    /*
+     * Locate every active animation on its timeline. This happens after the
+     * release/prefetch pass, so the active nodes are all ready.
+     */
+    int offsets[NB_BUCKETS + 1] = {0};
+    s->segments.count = 0;
+    for (int i = 0; i < nb_nodes; i++) {
+        struct ngl_node *node = nodes[i];
+        if (!node->is_active || node->last_update_time == t)
+            continue;
+
+        struct variable_priv *priv = node->priv_data;
+        struct animation *anim = &priv->anim;
+        if (!anim->nb_kfs)
+            continue;
+
+        double tnorm;
+        const struct animkeyframe_priv *kf;
+        const int kf_id = ngli_animation_locate(anim, t, &tnorm, &kf);
+        if (kf_id < 0) {
+            anim->cpy_func(anim->user_arg, priv->data, kf);
+            flag_updated(node, t);
+            continue;
+        }
+
+        const struct animkeyframe_priv *kf1 = anim->kfs[kf_id + 1]->priv_data;
+        const struct animbatch_segment segment = {
+            .node   = node,
+            .kf0    = anim->kfs[kf_id]->priv_data,
+            .kf1    = kf1,
+            .tnorm  = tnorm,
+            .bucket = kf1->nb_args || kf1->lut.samples ? BUCKET_CUSTOM : kf1->easing,
+        };
+        if (!ngli_darray_push(&s->segments, &segment))
+            return NGL_ERROR_MEMORY;
+        offsets[segment.bucket + 1]++;
+    }
+
+    const struct animbatch_segment *segments = ngli_darray_data(&s->segments);
+    const int nb_segments = ngli_darray_count(&s->segments);
+    if (!nb_segments)
+        return 0;
+
+    /* Sort the easing inputs by easing (counting sort) */
+    for (int i = 0; i < NB_BUCKETS; i++)
+        offsets[i + 1] += offsets[i];
+
+    s->order.count = s->tnorms.count = s->ratios.count = 0;
+    for (int i = 0; i < nb_segments; i++) {
+        if (!ngli_darray_push(&s->order, NULL) ||
+            !ngli_darray_push(&s->tnorms, NULL) ||
+            !ngli_darray_push(&s->ratios, NULL))
+            return NGL_ERROR_MEMORY;
+    }
+
+    int *order = ngli_darray_data(&s->order);
+    double *tnorms = ngli_darray_data(&s->tnorms);
+    double *ratios = ngli_darray_data(&s->ratios);
+
+    int positions[NB_BUCKETS];
+    memcpy(positions, offsets, sizeof(positions));
+    for (int i = 0; i < nb_segments; i++) {
+        const int pos = positions[segments[i].bucket]++;
+        order[pos] = i;
+        tnorms[pos] = segments[i].tnorm;
+    }
+
+    /* Evaluate the easings, one pass per easing */
+    for (int bucket = 0; bucket < NB_BUCKETS; bucket++) {
+        const int start = offsets[bucket];
+        const int nb = offsets[bucket + 1] - start;
+        if (!nb)
+            continue;
+        if (bucket == BUCKET_CUSTOM) {
+            for (int pos = start; pos < start + nb; pos++)
+                ratios[pos] = ngli_animation_ease(segments[order[pos]].kf1, tnorms[pos]);
+        } else {
+            const struct animkeyframe_priv *kf1 = segments[order[start]].kf1;
+            kf1->batch_function(ratios + start, tnorms + start, nb, 0, NULL);
+        }
+    }
+
+    /* Write back the interpolated values into the nodes */
+    for (int pos = 0; pos < nb_segments; pos++) {
+        const struct animbatch_segment *segment = &segments[order[pos]];
+        const double ratio = ngli_animation_scale_ratio(segment->kf1, ratios[pos]);
+        mix_values(segment->node, segment->kf0, segment->kf1, ratio);
+        flag_updated(segment->node, t);
+    }
+
+    return 0;
+}
+
+void ngli_animbatch_reset(struct animbatch *s)
+{
+    struct ngl_node **nodes = ngli_darray_data(&s->nodes);
+    for (int i = 0; i < ngli_darray_count(&s->nodes); i++) {
+        struct variable_priv *priv = nodes[i]->priv_data;
+        priv->batch_index = -1;
+    }
+    ngli_darray_reset(&s->nodes);
+    ngli_darray_reset(&s->segments);
+    ngli_darray_reset(&s->order);
+    ngli_darray_reset(&s->tnorms);
+    ngli_darray_reset(&s->ratios);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef ANIMBATCH_H
+#define ANIMBATCH_H
+
+#include "darray.h"
+
+struct ngl_node;
+
+/*
+ * Batch evaluation of the AnimatedFloat and AnimatedVec* nodes of a context.
+ *
+ * Every frame, the active animations are located on their timeline, then their
+ * easings are evaluated in a structure-of-arrays form, one pass per easing,
+ * instead of one indirect call per animation. The results are written back
+ * into the nodes which are then flagged as updated for the frame time.
+ */
+struct animbatch {
+    struct darray nodes;    /* struct ngl_node *, registered animations */
+
+    /* Per frame structures of arrays, reused across frames */
+    struct darray segments; /* struct animbatch_segment, in registration order */
+    struct darray order;    /* int, segment indexes sorted by easing */
+    struct darray tnorms;   /* double, easing inputs sorted by easing */
+    struct darray ratios;   /* double, easing outputs sorted by easing */
+};
+
+void ngli_animbatch_init(struct animbatch *s);
+int ngli_animbatch_add(struct animbatch *s, struct ngl_node *node);
+void ngli_animbatch_remove(struct animbatch *s, struct ngl_node *node);
+int ngli_animbatch_update(struct animbatch *s, double t);
+void ngli_animbatch_reset(struct animbatch *s);
+
+#endif
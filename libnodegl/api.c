@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include <stdio.h>
+#include <string.h>
 
 #if defined(TARGET_ANDROID)
 #include <jni.h>
@@ -37,6 +38,9 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "rnode.h"
+#include "scenemerge.h"
+#include "threadpool.h"
+#include "utils.h"
 
 #if defined(TARGET_DARWIN) || defined(TARGET_IPHONE)
 #if defined(BACKEND_GL)
@@ -67,13 +71,19 @@ static int get_default_platform(void)
 #endif
 }
 
+static void reset_rnode_tree(struct ngl_ctx *s)
+{
+    ngli_rnode_clear(&s->rnode);
+    s->rnode_generation++;
+}
+
 static int cmd_configure(struct ngl_ctx *s, void *arg)
 {
     struct ngl_config *config = arg;
 
     if (s->scene)
         ngli_node_detach_ctx(s->scene, s);
-    ngli_rnode_clear(&s->rnode);
+    reset_rnode_tree(s);
 
     ngli_gctx_freep(&s->gctx);
 
@@ -89,6 +99,12 @@ static int cmd_configure(struct ngl_ctx *s, void *arg)
 
     s->config = *config;
 
+    /* The scene has been detached so the residency cache is empty at this point */
+    s->rescache.budget = config->residency_budget;
+
+    ngli_profiler_reset(&s->profiler);
+    ngli_profiler_init(&s->profiler, config->profiling);
+
     s->gctx = ngli_gctx_create(s);
     if (!s->gctx)
         return NGL_ERROR_MEMORY;
@@ -131,7 +147,7 @@ static int cmd_set_scene(struct ngl_ctx *s, void *arg)
         ngli_node_detach_ctx(s->scene, s);
         ngl_node_unrefp(&s->scene);
     }
-    ngli_rnode_clear(&s->rnode);
+    reset_rnode_tree(s);
 
     struct ngl_node *scene = arg;
     if (!scene)
@@ -147,10 +163,46 @@ static int cmd_set_scene(struct ngl_ctx *s, void *arg)
     return 0;
 }
 
+static int cmd_update_scene(struct ngl_ctx *s, void *arg)
+{
+    struct ngl_node *scene = arg;
+    if (!s->scene || !scene)
+        return cmd_set_scene(s, scene);
+
+    struct ngl_node *merged_scene;
+    int ret = ngli_scene_merge(s->scene, scene, &merged_scene);
+    if (ret < 0)
+        return ret;
+
+    /*
+     * The merged scene is attached before the current one is detached so the
+     * shared nodes are not uninitialized in between. They are however
+     * prepared again for the new render node tree.
+     */
+    struct ngl_node *prev_scene = s->scene;
+    s->scene = NULL;
+    reset_rnode_tree(s);
+
+    ret = ngli_node_attach_ctx(merged_scene, s);
+    if (ret < 0)
+        ngli_node_detach_ctx(merged_scene, s);
+    else
+        s->scene = ngl_node_ref(merged_scene);
+
+    ngli_node_detach_ctx(prev_scene, s);
+    ngl_node_unrefp(&prev_scene);
+
+    return ret;
+}
+
 static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
 {
     const double t = *(double *)arg;
 
+    ngli_profiler_frame_start(&s->profiler);
+    ngli_gctx_reset_counters(s->gctx);
+    s->nb_updated_nodes = 0;
+
     struct ngl_node *scene = s->scene;
     if (!scene) {
         return 0;
@@ -163,7 +215,11 @@ static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
     if (ret < 0)
         return ret;
 
-    ret = ngli_node_honor_release_prefetch(&s->activitycheck_nodes);
+    ret = ngli_node_honor_release_prefetch(s);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_animbatch_update(&s->animbatch, t);
     if (ret < 0)
         return ret;
 
@@ -185,6 +241,72 @@ static int cmd_draw(struct ngl_ctx *s, void *arg)
     return ngli_gctx_draw(s->gctx, t);
 }
 
+static int cmd_get_stats(struct ngl_ctx *s, void *arg)
+{
+    struct ngl_stats *stats = arg;
+    const struct rescache_stats *rescache_stats = &s->rescache.stats;
+    const struct profiler *profiler = &s->profiler;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->residency_size         = rescache_stats->size;
+    stats->residency_max_size     = rescache_stats->max_size;
+    stats->residency_nb_nodes     = rescache_stats->nb_nodes;
+    stats->residency_nb_hits      = rescache_stats->nb_hits;
+    stats->residency_nb_evictions = rescache_stats->nb_evictions;
+    stats->residency_evicted_size = rescache_stats->evicted_size;
+
+    stats->visit_time    = profiler->totals[NGLI_PROFILER_PHASE_VISIT]    / 1000;
+    stats->prefetch_time = profiler->totals[NGLI_PROFILER_PHASE_PREFETCH] / 1000;
+    stats->release_time  = profiler->totals[NGLI_PROFILER_PHASE_RELEASE]  / 1000;
+    stats->update_time   = profiler->totals[NGLI_PROFILER_PHASE_UPDATE]   / 1000;
+    stats->draw_time     = profiler->totals[NGLI_PROFILER_PHASE_DRAW]     / 1000;
+    stats->capture_time  = profiler->totals[NGLI_PROFILER_PHASE_CAPTURE]  / 1000;
+    stats->gpu_draw_time = profiler->totals[NGLI_PROFILER_PHASE_GPU]      / 1000;
+
+    ngli_gctx_get_counters(s->gctx, stats);
+    stats->nb_updated_nodes = s->nb_updated_nodes;
+
+    const struct memtrack_stats *memtrack_stats = &s->gctx->memtrack.stats;
+    stats->memory_buffers_size         = memtrack_stats->sizes[NGLI_MEMTRACK_BUFFER];
+    stats->memory_buffers_max_size     = memtrack_stats->max_sizes[NGLI_MEMTRACK_BUFFER];
+    stats->memory_textures_size        = memtrack_stats->sizes[NGLI_MEMTRACK_TEXTURE];
+    stats->memory_textures_max_size    = memtrack_stats->max_sizes[NGLI_MEMTRACK_TEXTURE];
+    stats->memory_attachments_size     = memtrack_stats->sizes[NGLI_MEMTRACK_ATTACHMENT];
+    stats->memory_attachments_max_size = memtrack_stats->max_sizes[NGLI_MEMTRACK_ATTACHMENT];
+    stats->memory_total_size           = memtrack_stats->total_size;
+    stats->memory_total_max_size       = memtrack_stats->max_total_size;
+    stats->memory_nb_buffers           = memtrack_stats->nb_resources[NGLI_MEMTRACK_BUFFER];
+    stats->memory_nb_textures          = memtrack_stats->nb_resources[NGLI_MEMTRACK_TEXTURE];
+    stats->memory_nb_attachments       = memtrack_stats->nb_resources[NGLI_MEMTRACK_ATTACHMENT];
+    return 0;
+}
+
+static int cmd_export_api_calls(struct ngl_ctx *s, void *arg)
+{
+    char **strp = arg;
+    *strp = ngli_gctx_export_api_calls(s->gctx);
+    return *strp ? 0 : NGL_ERROR_MEMORY;
+}
+
+static int cmd_export_memory(struct ngl_ctx *s, void *arg)
+{
+    char **strp = arg;
+    *strp = ngli_gctx_export_memory(s->gctx);
+    return *strp ? 0 : NGL_ERROR_MEMORY;
+}
+
+struct export_profile_params {
+    int format;
+    char *str;
+};
+
+static int cmd_export_profile(struct ngl_ctx *s, void *arg)
+{
+    struct export_profile_params *params = arg;
+    params->str = ngli_profiler_export(&s->profiler, params->format);
+    return params->str ? 0 : NGL_ERROR_GENERIC;
+}
+
 static int cmd_stop(struct ngl_ctx *s, void *arg)
 {
     ngli_gctx_freep(&s->gctx);
@@ -282,6 +404,8 @@ static void stop_thread(struct ngl_ctx *s)
 
 struct ngl_ctx *ngl_create(void)
 {
+    ngli_math_init();
+
     struct ngl_ctx *s = ngli_calloc(1, sizeof(*s));
     if (!s)
         return NULL;
@@ -303,6 +427,12 @@ struct ngl_ctx *ngl_create(void)
     ngli_darray_init(&s->modelview_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->projection_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->activitycheck_nodes, sizeof(struct ngl_node *), 0);
+    ngli_rescache_init(&s->rescache, 0);
+    ngli_profiler_init(&s->profiler, 0);
+    ngli_animbatch_init(&s->animbatch);
+    ngli_glyphatlas_init(&s->glyphatlas);
+    ngli_geompool_init(&s->geompool);
+    ngli_attachpool_init(&s->attachpool);
 
     static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
     if (!ngli_darray_push(&s->modelview_matrix_stack, id_matrix) ||
@@ -342,6 +472,11 @@ int ngl_configure(struct ngl_ctx *s, struct ngl_config *config)
         }
     }
 
+    if (config->residency_budget < 0) {
+        LOG(ERROR, "residency budget cannot be negative");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
     s->configured = 0;
 #if defined(TARGET_IPHONE) || defined(TARGET_DARWIN)
     int ret = configure_ios(s, config);
@@ -390,6 +525,37 @@ int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene)
     return dispatch_cmd(s, cmd_set_scene, scene);
 }
 
+int ngl_update_scene(struct ngl_ctx *s, struct ngl_node *scene)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before updating a scene");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    return dispatch_cmd(s, cmd_update_scene, scene);
+}
+
+#define MAX_POOL_THREADS 8
+
+/*
+ * The thread pool is only created the first time a job is large enough to be
+ * split, so contexts never running such jobs do not spawn idle threads.
+ */
+struct threadpool *ngli_get_threadpool(struct ngl_ctx *s)
+{
+    if (s->threadpool_probed)
+        return s->threadpool;
+    s->threadpool_probed = 1;
+
+    const int nb_threads = NGLI_MIN(ngli_threadpool_get_nb_cpus() - 1, MAX_POOL_THREADS);
+    if (nb_threads > 0) {
+        s->threadpool = ngli_threadpool_create(nb_threads);
+        if (!s->threadpool)
+            LOG(WARNING, "could not create the thread pool, data-parallel jobs will run on a single thread");
+    }
+    return s->threadpool;
+}
+
 int ngli_prepare_draw(struct ngl_ctx *s, double t)
 {
     if (!s->configured) {
@@ -410,6 +576,58 @@ int ngl_draw(struct ngl_ctx *s, double t)
     return dispatch_cmd(s, cmd_draw, &t);
 }
 
+int ngl_get_stats(struct ngl_ctx *s, struct ngl_stats *stats)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before getting statistics");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    return dispatch_cmd(s, cmd_get_stats, stats);
+}
+
+char *ngl_export_api_calls(struct ngl_ctx *s)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before exporting the API calls");
+        return NULL;
+    }
+
+    char *str = NULL;
+    int ret = dispatch_cmd(s, cmd_export_api_calls, &str);
+    if (ret < 0)
+        return NULL;
+    return str;
+}
+
+char *ngl_export_memory(struct ngl_ctx *s)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before exporting the memory usage");
+        return NULL;
+    }
+
+    char *str = NULL;
+    int ret = dispatch_cmd(s, cmd_export_memory, &str);
+    if (ret < 0)
+        return NULL;
+    return str;
+}
+
+char *ngl_export_profile(struct ngl_ctx *s, int format)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before exporting the profile");
+        return NULL;
+    }
+
+    struct export_profile_params params = {.format = format};
+    int ret = dispatch_cmd(s, cmd_export_profile, &params);
+    if (ret < 0)
+        return NULL;
+    return params.str;
+}
+
 void ngl_freep(struct ngl_ctx **ss)
 {
     struct ngl_ctx *s = *ss;
@@ -425,6 +643,13 @@ void ngl_freep(struct ngl_ctx **ss)
     ngli_darray_reset(&s->modelview_matrix_stack);
     ngli_darray_reset(&s->projection_matrix_stack);
     ngli_darray_reset(&s->activitycheck_nodes);
+    ngli_rescache_reset(&s->rescache);
+    ngli_profiler_reset(&s->profiler);
+    ngli_animbatch_reset(&s->animbatch);
+    ngli_glyphatlas_reset(&s->glyphatlas);
+    ngli_geompool_reset(&s->geompool);
+    ngli_attachpool_reset(&s->attachpool);
+    ngli_threadpool_freep(&s->threadpool);
     ngli_freep(ss);
 }
 
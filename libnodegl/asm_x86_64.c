@@ -0,0 +1,349 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <immintrin.h>
+
+#include "easing.h"
+#include "math_utils.h"
+
+/*
+ * SSE2 is part of the x86-64 baseline so these versions are always available
+ * and used by default. The AVX and FMA versions are selected at runtime by
+ * ngli_math_init() depending on the CPU features.
+ */
+
+void (*ngli_mat4_mul_x86_64)(float *dst, const float *m1, const float *m2) = ngli_mat4_mul_sse2;
+void (*ngli_mat4_mul_vec4_x86_64)(float *dst, const float *m, const float *v) = ngli_mat4_mul_vec4_sse2;
+void (*ngli_mat3_normal_from_mat4_x86_64)(float *dst, const float *m) = ngli_mat3_normal_from_mat4_sse2;
+void (*ngli_quat_slerp_x86_64)(float *dst, const float *q1, const float *q2, float t) = ngli_quat_slerp_sse2;
+void (*ngli_mix_floats_x86_64)(float *dst, const float *a, const float *b, float c, int n) = ngli_mix_floats_sse2;
+void (*ngli_ease_poly_x86_64)(double *dst, const double *x, int n, int degree, int transform) = ngli_ease_poly_sse2;
+
+int ngli_cpu_get_flags_x86_64(void)
+{
+    int flags = NGLI_CPU_FLAG_SSE2;
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) {
+        flags |= NGLI_CPU_FLAG_AVX;
+        if (__builtin_cpu_supports("fma"))
+            flags |= NGLI_CPU_FLAG_FMA;
+    }
+    return flags;
+}
+
+static void init_funcs(void)
+{
+    const int flags = ngli_cpu_get_flags_x86_64();
+
+    if (flags & NGLI_CPU_FLAG_AVX) {
+        ngli_mat4_mul_x86_64 = ngli_mat4_mul_avx;
+        ngli_mix_floats_x86_64 = ngli_mix_floats_avx;
+        ngli_ease_poly_x86_64 = ngli_ease_poly_avx;
+    }
+
+    if (flags & NGLI_CPU_FLAG_FMA) {
+        ngli_mat4_mul_x86_64 = ngli_mat4_mul_fma;
+        ngli_mat4_mul_vec4_x86_64 = ngli_mat4_mul_vec4_fma;
+        ngli_mix_floats_x86_64 = ngli_mix_floats_fma;
+    }
+}
+
+void ngli_math_init_x86_64(void)
+{
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once(&once, init_funcs);
+}
+
+#define SPLAT(v, i) _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+
+static inline __m128 mul_vec4_sse2(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 v)
+{
+    const __m128 r01 = _mm_add_ps(_mm_mul_ps(c0, SPLAT(v, 0)), _mm_mul_ps(c1, SPLAT(v, 1)));
+    const __m128 r23 = _mm_add_ps(_mm_mul_ps(c2, SPLAT(v, 2)), _mm_mul_ps(c3, SPLAT(v, 3)));
+    return _mm_add_ps(r01, r23);
+}
+
+void ngli_mat4_mul_sse2(float *dst, const float *m1, const float *m2)
+{
+    const __m128 c0 = _mm_loadu_ps(m1);
+    const __m128 c1 = _mm_loadu_ps(m1 + 4);
+    const __m128 c2 = _mm_loadu_ps(m1 + 8);
+    const __m128 c3 = _mm_loadu_ps(m1 + 12);
+
+    /* dst may alias m2 so all the columns are computed before being stored */
+    const __m128 r0 = mul_vec4_sse2(c0, c1, c2, c3, _mm_loadu_ps(m2));
+    const __m128 r1 = mul_vec4_sse2(c0, c1, c2, c3, _mm_loadu_ps(m2 + 4));
+    const __m128 r2 = mul_vec4_sse2(c0, c1, c2, c3, _mm_loadu_ps(m2 + 8));
+    const __m128 r3 = mul_vec4_sse2(c0, c1, c2, c3, _mm_loadu_ps(m2 + 12));
+
+    _mm_storeu_ps(dst,      r0);
+    _mm_storeu_ps(dst + 4,  r1);
+    _mm_storeu_ps(dst + 8,  r2);
+    _mm_storeu_ps(dst + 12, r3);
+}
+
+void ngli_mat4_mul_vec4_sse2(float *dst, const float *m, const float *v)
+{
+    const __m128 r = mul_vec4_sse2(_mm_loadu_ps(m),
+                                   _mm_loadu_ps(m + 4),
+                                   _mm_loadu_ps(m + 8),
+                                   _mm_loadu_ps(m + 12),
+                                   _mm_loadu_ps(v));
+    _mm_storeu_ps(dst, r);
+}
+
+/*
+ * Each 256-bit register holds 2 columns of the output matrix: the columns of
+ * m1 are duplicated in both lanes while the coefficients of the 2 columns of
+ * m2 are splatted within their own lane.
+ */
+#define MAT4_MUL_256(name, isa, madd)                                           \
+__attribute__((target(isa)))                                                    \
+void ngli_mat4_mul_##name(float *dst, const float *m1, const float *m2)         \
+{                                                                               \
+    const __m256 c0 = _mm256_broadcast_ps((const __m128 *)m1);                  \
+    const __m256 c1 = _mm256_broadcast_ps((const __m128 *)(m1 + 4));            \
+    const __m256 c2 = _mm256_broadcast_ps((const __m128 *)(m1 + 8));            \
+    const __m256 c3 = _mm256_broadcast_ps((const __m128 *)(m1 + 12));           \
+    const __m256 v01 = _mm256_loadu_ps(m2);                                     \
+    const __m256 v23 = _mm256_loadu_ps(m2 + 8);                                 \
+                                                                                \
+    __m256 r01 = _mm256_mul_ps(c0, _mm256_permute_ps(v01, 0x00));               \
+    __m256 r23 = _mm256_mul_ps(c0, _mm256_permute_ps(v23, 0x00));               \
+    r01 = madd(c1, _mm256_permute_ps(v01, 0x55), r01);                          \
+    r23 = madd(c1, _mm256_permute_ps(v23, 0x55), r23);                          \
+    r01 = madd(c2, _mm256_permute_ps(v01, 0xaa), r01);                          \
+    r23 = madd(c2, _mm256_permute_ps(v23, 0xaa), r23);                          \
+    r01 = madd(c3, _mm256_permute_ps(v01, 0xff), r01);                          \
+    r23 = madd(c3, _mm256_permute_ps(v23, 0xff), r23);                          \
+                                                                                \
+    _mm256_storeu_ps(dst,     r01);                                             \
+    _mm256_storeu_ps(dst + 8, r23);                                             \
+}
+
+#define MADD_AVX(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+
+MAT4_MUL_256(avx, "avx",     MADD_AVX)
+MAT4_MUL_256(fma, "avx,fma", _mm256_fmadd_ps)
+
+__attribute__((target("avx,fma")))
+void ngli_mat4_mul_vec4_fma(float *dst, const float *m, const float *v)
+{
+    const __m128 vec = _mm_loadu_ps(v);
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(m), SPLAT(vec, 0));
+    r = _mm_fmadd_ps(_mm_loadu_ps(m + 4),  SPLAT(vec, 1), r);
+    r = _mm_fmadd_ps(_mm_loadu_ps(m + 8),  SPLAT(vec, 2), r);
+    r = _mm_fmadd_ps(_mm_loadu_ps(m + 12), SPLAT(vec, 3), r);
+    _mm_storeu_ps(dst, r);
+}
+
+static inline __m128 cross_sse2(__m128 a, __m128 b)
+{
+    const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+/* Returns the dot product in all the components */
+static inline __m128 dot_sse2(__m128 a, __m128 b)
+{
+    const __m128 m = _mm_mul_ps(a, b);
+    const __m128 s = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+/*
+ * The transposed inverse of a 3x3 matrix is its cofactor matrix divided by its
+ * determinant, and the columns of the cofactor matrix are the cross products
+ * of the columns of the original matrix.
+ */
+void ngli_mat3_normal_from_mat4_sse2(float *dst, const float *m)
+{
+    /* The 4th component is cleared so it stays neutral in the cross products */
+    const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 c0 = _mm_and_ps(_mm_loadu_ps(m),     mask);
+    const __m128 c1 = _mm_and_ps(_mm_loadu_ps(m + 4), mask);
+    const __m128 c2 = _mm_and_ps(_mm_loadu_ps(m + 8), mask);
+
+    const __m128 r0 = cross_sse2(c1, c2);
+    const __m128 det = dot_sse2(c0, r0);
+    if (_mm_cvtss_f32(det) == 0.0f) {
+        ngli_mat3_normal_from_mat4_c(dst, m);
+        return;
+    }
+    const __m128 r1 = cross_sse2(c2, c0);
+    const __m128 r2 = cross_sse2(c0, c1);
+
+    const __m128 inv_det = _mm_div_ps(_mm_set1_ps(1.0f), det);
+    const __m128 n0 = _mm_mul_ps(r0, inv_det);
+    const __m128 n1 = _mm_mul_ps(r1, inv_det);
+    const __m128 n2 = _mm_mul_ps(r2, inv_det);
+
+    /* The 4th component of each store is overwritten by the next column */
+    _mm_storeu_ps(dst,     n0);
+    _mm_storeu_ps(dst + 3, n1);
+    _mm_storel_pi((__m64 *)(dst + 6), n2);
+    _mm_store_ss(dst + 8, _mm_movehl_ps(n2, n2));
+}
+
+#define COS_ALPHA_THRESHOLD 0.9995f
+
+static inline __m128 norm_sse2(__m128 v)
+{
+    const __m128 len2 = dot_sse2(v, v);
+    if (_mm_cvtss_f32(len2) == 0.0f)
+        return _mm_setzero_ps();
+    return _mm_div_ps(v, _mm_sqrt_ps(len2));
+}
+
+void ngli_quat_slerp_sse2(float *dst, const float *q1, const float *q2, float t)
+{
+    __m128 v1 = _mm_loadu_ps(q1);
+    const __m128 v2 = _mm_loadu_ps(q2);
+
+    float cos_alpha = _mm_cvtss_f32(dot_sse2(v1, v2));
+
+    if (cos_alpha < 0.0f) {
+        cos_alpha = -cos_alpha;
+        v1 = _mm_sub_ps(_mm_setzero_ps(), v1);
+    }
+
+    if (cos_alpha > COS_ALPHA_THRESHOLD) {
+        const __m128 lerp = _mm_add_ps(v1, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(v2, v1)));
+        _mm_storeu_ps(dst, norm_sse2(lerp));
+        return;
+    }
+
+    if (cos_alpha > 1.0f)
+        cos_alpha = 1.0f;
+
+    const float alpha = acosf(cos_alpha);
+    const float theta = alpha * t;
+
+    const __m128 v = norm_sse2(_mm_sub_ps(v2, _mm_mul_ps(v1, _mm_set1_ps(cos_alpha))));
+    const __m128 r = _mm_add_ps(_mm_mul_ps(v1, _mm_set1_ps(cosf(theta))),
+                                _mm_mul_ps(v,  _mm_set1_ps(sinf(theta))));
+    _mm_storeu_ps(dst, r);
+}
+
+/* dst = a*(1-c) + b*c, exact at both ends of the [0,1] range */
+void ngli_mix_floats_sse2(float *dst, const float *a, const float *b, float c, int n)
+{
+    const __m128 vc  = _mm_set1_ps(c);
+    const __m128 vc1 = _mm_set1_ps(1.f - c);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), vc1),
+                                    _mm_mul_ps(_mm_loadu_ps(b + i), vc));
+        _mm_storeu_ps(dst + i, r);
+    }
+    ngli_mix_floats_c(dst + i, a + i, b + i, c, n - i);
+}
+
+#define MIX_FLOATS_256(name, isa, madd)                                         \
+__attribute__((target(isa)))                                                    \
+void ngli_mix_floats_##name(float *dst, const float *a, const float *b, float c, int n) \
+{                                                                               \
+    const __m256 vc  = _mm256_set1_ps(c);                                       \
+    const __m256 vc1 = _mm256_set1_ps(1.f - c);                                 \
+    int i = 0;                                                                  \
+    for (; i + 16 <= n; i += 16) {                                              \
+        const __m256 r0 = madd(_mm256_loadu_ps(b + i), vc,                      \
+                               _mm256_mul_ps(_mm256_loadu_ps(a + i), vc1));     \
+        const __m256 r1 = madd(_mm256_loadu_ps(b + i + 8), vc,                  \
+                               _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), vc1)); \
+        _mm256_storeu_ps(dst + i,     r0);                                      \
+        _mm256_storeu_ps(dst + i + 8, r1);                                      \
+    }                                                                           \
+    ngli_mix_floats_sse2(dst + i, a + i, b + i, c, n - i);                      \
+}
+
+MIX_FLOATS_256(avx, "avx",     MADD_AVX)
+MIX_FLOATS_256(fma, "avx,fma", _mm256_fmadd_ps)
+
+/*
+ * Both sides of the in-out and out-in transforms are computed and merged
+ * with a mask so the loops are free of branches; the operations are the same
+ * as the C version so the results are identical.
+ */
+#define DECLARE_EASE_POLY(name, isa, type, width, set1, loadu, storeu, add, sub, mul, cmplt, select, tail) \
+__attribute__((target(isa)))                                                    \
+static inline type ipow_##name(type x, int degree)                              \
+{                                                                               \
+    type r = x;                                                                 \
+    for (int i = 1; i < degree; i++)                                            \
+        r = mul(r, x);                                                          \
+    return r;                                                                   \
+}                                                                               \
+                                                                                \
+__attribute__((target(isa)))                                                    \
+void ngli_ease_poly_##name(double *dst, const double *x, int n, int degree, int transform) \
+{                                                                               \
+    const type one  = set1(1.0);                                                \
+    const type two  = set1(2.0);                                                \
+    const type half = set1(0.5);                                                \
+    int i = 0;                                                                  \
+    switch (transform) {                                                        \
+    case NGLI_EASE_IN:                                                          \
+        for (; i + width <= n; i += width) {                                    \
+            const type v = loadu(x + i);                                        \
+            storeu(dst + i, ipow_##name(v, degree));                            \
+        }                                                                       \
+        break;                                                                  \
+    case NGLI_EASE_OUT:                                                         \
+        for (; i + width <= n; i += width) {                                    \
+            const type v = loadu(x + i);                                        \
+            storeu(dst + i, sub(one, ipow_##name(sub(one, v), degree)));        \
+        }                                                                       \
+        break;                                                                  \
+    case NGLI_EASE_IN_OUT:                                                      \
+        for (; i + width <= n; i += width) {                                    \
+            const type v = loadu(x + i);                                        \
+            const type lo = mul(ipow_##name(mul(two, v), degree), half);        \
+            const type hi = sub(one, mul(ipow_##name(mul(two, sub(one, v)), degree), half)); \
+            storeu(dst + i, select(cmplt(v, half), lo, hi));                    \
+        }                                                                       \
+        break;                                                                  \
+    case NGLI_EASE_OUT_IN:                                                      \
+        for (; i + width <= n; i += width) {                                    \
+            const type v = loadu(x + i);                                        \
+            const type v2 = mul(two, v);                                        \
+            const type lo = mul(sub(one, ipow_##name(sub(one, v2), degree)), half); \
+            const type hi = mul(add(one, ipow_##name(sub(v2, one), degree)), half); \
+            storeu(dst + i, select(cmplt(v, half), lo, hi));                    \
+        }                                                                       \
+        break;                                                                  \
+    }                                                                           \
+    tail(dst + i, x + i, n - i, degree, transform);                             \
+}
+
+#define SELECT_SSE2(m, a, b) _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b))
+#define CMPLT_AVX(a, b)      _mm256_cmp_pd(a, b, _CMP_LT_OQ)
+#define SELECT_AVX(m, a, b)  _mm256_blendv_pd(b, a, m)
+
+DECLARE_EASE_POLY(sse2, "sse2", __m128d, 2, _mm_set1_pd, _mm_loadu_pd, _mm_storeu_pd,
+                  _mm_add_pd, _mm_sub_pd, _mm_mul_pd, _mm_cmplt_pd, SELECT_SSE2, ngli_ease_poly_c)
+DECLARE_EASE_POLY(avx, "avx", __m256d, 4, _mm256_set1_pd, _mm256_loadu_pd, _mm256_storeu_pd,
+                  _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, CMPLT_AVX, SELECT_AVX, ngli_ease_poly_sse2)
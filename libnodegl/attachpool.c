@@ -0,0 +1,154 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "attachpool.h"
+#include "gctx.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+struct attachpool_entry {
+    int format;
+    int width;
+    int height;
+    int samples;
+    int level;
+    struct darray owners; /* const void * */
+    struct texture *texture;
+};
+
+void ngli_attachpool_init(struct attachpool *s)
+{
+    ngli_darray_init(&s->entries, sizeof(struct attachpool_entry), 0);
+}
+
+static int has_owner(const struct attachpool_entry *entry, const void *owner)
+{
+    const void **owners = ngli_darray_data(&entry->owners);
+    for (int i = 0; i < ngli_darray_count(&entry->owners); i++)
+        if (owners[i] == owner)
+            return 1;
+    return 0;
+}
+
+struct texture *ngli_attachpool_acquire(struct attachpool *s, struct gctx *gctx,
+                                        const struct texture_params *params, int level,
+                                        const void *owner)
+{
+    ngli_assert(params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY);
+
+    struct attachpool_entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct attachpool_entry *entry = &entries[i];
+        if (entry->format  == params->format &&
+            entry->width   == params->width &&
+            entry->height  == params->height &&
+            entry->samples == params->samples &&
+            entry->level   == level &&
+            !has_owner(entry, owner)) {
+            if (!ngli_darray_push(&entry->owners, &owner))
+                return NULL;
+            return entry->texture;
+        }
+    }
+
+    struct texture *texture = ngli_texture_create(gctx);
+    if (!texture)
+        return NULL;
+
+    /* The attachment may be handed to other owners so it is charged to the context */
+    struct ngl_ctx *ctx = gctx->ctx;
+    struct ngl_node *cur_node = ctx->cur_node;
+    ctx->cur_node = NULL;
+    int ret = ngli_texture_init(texture, params);
+    ctx->cur_node = cur_node;
+    if (ret < 0) {
+        ngli_texture_freep(&texture);
+        return NULL;
+    }
+
+    struct attachpool_entry entry = {
+        .format   = params->format,
+        .width    = params->width,
+        .height   = params->height,
+        .samples  = params->samples,
+        .level    = level,
+        .texture  = texture,
+    };
+    ngli_darray_init(&entry.owners, sizeof(const void *), 0);
+    if (!ngli_darray_push(&entry.owners, &owner) ||
+        !ngli_darray_push(&s->entries, &entry)) {
+        ngli_darray_reset(&entry.owners);
+        ngli_texture_freep(&texture);
+        return NULL;
+    }
+
+    return texture;
+}
+
+static int find_entry(const struct attachpool *s, const struct texture *texture)
+{
+    const struct attachpool_entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++)
+        if (entries[i].texture == texture)
+            return i;
+    return -1;
+}
+
+void ngli_attachpool_release(struct attachpool *s, const void *owner, struct texture **texturep)
+{
+    if (!*texturep)
+        return;
+
+    const int index = find_entry(s, *texturep);
+    ngli_assert(index >= 0);
+    *texturep = NULL;
+
+    struct attachpool_entry *entry = ngli_darray_get(&s->entries, index);
+    const void **owners = ngli_darray_data(&entry->owners);
+    for (int i = 0; i < ngli_darray_count(&entry->owners); i++) {
+        if (owners[i] == owner) {
+            ngli_darray_remove(&entry->owners, i);
+            break;
+        }
+    }
+    if (ngli_darray_count(&entry->owners))
+        return;
+
+    ngli_darray_reset(&entry->owners);
+    ngli_texture_freep(&entry->texture);
+    ngli_darray_remove(&s->entries, index);
+}
+
+int ngli_attachpool_is_shared(const struct attachpool *s, const struct texture *texture)
+{
+    const int index = find_entry(s, texture);
+    if (index < 0)
+        return 0;
+    const struct attachpool_entry *entry = ngli_darray_get(&s->entries, index);
+    return ngli_darray_count(&entry->owners) > 1;
+}
+
+void ngli_attachpool_reset(struct attachpool *s)
+{
+    ngli_assert(!ngli_darray_count(&s->entries));
+    ngli_darray_reset(&s->entries);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef ATTACHPOOL_H
+#define ATTACHPOOL_H
+
+#include "darray.h"
+#include "texture.h"
+
+struct gctx;
+
+/*
+ * Pool of the transient render target attachments (implicit depth/stencil
+ * buffers and multisampled attachments) of the RenderToTexture nodes.
+ *
+ * The content of these attachments only lives during the draw of their
+ * RenderToTexture node. Two RenderToTexture nodes can not be drawn at the same
+ * time unless one is nested in the other, so the attachments are aliased
+ * between all the RenderToTexture nodes of the same nesting level requesting
+ * the same dimensions, format and number of samples. An attachment is never
+ * handed twice to the same owner, so a node requesting several attachments
+ * with identical parameters (the faces of a multisampled cube map for
+ * instance) gets distinct textures.
+ */
+struct attachpool {
+    struct darray entries; /* struct attachpool_entry */
+};
+
+void ngli_attachpool_init(struct attachpool *s);
+struct texture *ngli_attachpool_acquire(struct attachpool *s, struct gctx *gctx,
+                                        const struct texture_params *params, int level,
+                                        const void *owner);
+void ngli_attachpool_release(struct attachpool *s, const void *owner, struct texture **texturep);
+int ngli_attachpool_is_shared(const struct attachpool *s, const struct texture *texture);
+void ngli_attachpool_reset(struct attachpool *s);
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "utils.h"
+
+#define DEFAULT_NB_RUNS  9
+#define DEFAULT_MIN_TIME 20 /* milliseconds */
+#define MAX_NB_RUNS      101
+
+static const char *filter;
+static int nb_runs = DEFAULT_NB_RUNS;
+static int64_t min_time = DEFAULT_MIN_TIME * 1000;
+
+static volatile const void *bench_sink;
+
+void bench_use(const void *ptr)
+{
+    bench_sink = ptr;
+}
+
+void bench_init(int argc, char *argv[])
+{
+    filter = argc > 1 ? argv[1] : NULL;
+
+    const char *runs_str = getenv("NGL_BENCH_RUNS");
+    if (runs_str)
+        nb_runs = NGLI_MAX(NGLI_MIN(atoi(runs_str), MAX_NB_RUNS), 1);
+
+    const char *min_time_str = getenv("NGL_BENCH_MIN_TIME");
+    if (min_time_str)
+        min_time = NGLI_MAX(atoi(min_time_str), 1) * 1000;
+
+    printf("%-48s %12s %12s %12s %12s\n", "benchmark", "iterations",
+           "min ns/it", "median ns/it", "max ns/it");
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    const double va = *(const double *)a;
+    const double vb = *(const double *)b;
+    return (va > vb) - (va < vb);
+}
+
+static int64_t time_run(bench_func_type func, void *arg, int64_t nb_iter)
+{
+    const int64_t start = ngli_gettime_relative();
+    int ret = func(arg, nb_iter);
+    if (ret < 0)
+        return ret;
+    return ngli_gettime_relative() - start;
+}
+
+int bench_run(const char *name, bench_func_type func, void *arg)
+{
+    if (filter && !strstr(name, filter))
+        return 0;
+
+    /*
+     * The first iteration is not timed: it absorbs the one-time costs, such
+     * as the shader compilations filling a program cache, which would
+     * otherwise mislead the calibration into too few iterations.
+     */
+    int ret = func(arg, 1);
+    if (ret < 0) {
+        fprintf(stderr, "%s: benchmark failed\n", name);
+        return ret;
+    }
+
+    /*
+     * Calibration: grow the number of iterations until a run lasts long
+     * enough to make the timer resolution and the call overhead negligible.
+     * This also acts as a warmup for the caches and the branch predictors.
+     */
+    int64_t nb_iter = 1;
+    for (;;) {
+        const int64_t t = time_run(func, arg, nb_iter);
+        if (t < 0) {
+            fprintf(stderr, "%s: benchmark failed\n", name);
+            return (int)t;
+        }
+        if (t >= min_time)
+            break;
+        const int64_t factor = t > 0 ? NGLI_MIN(min_time * 3 / (t * 2) + 1, 100) : 100;
+        nb_iter *= factor;
+    }
+
+    double times[MAX_NB_RUNS];
+    for (int i = 0; i < nb_runs; i++) {
+        const int64_t t = time_run(func, arg, nb_iter);
+        if (t < 0) {
+            fprintf(stderr, "%s: benchmark failed\n", name);
+            return (int)t;
+        }
+        times[i] = t * 1000. / nb_iter;
+    }
+    qsort(times, nb_runs, sizeof(*times), cmp_double);
+
+    printf("%-48s %12" PRId64 " %12.2f %12.2f %12.2f\n", name, nb_iter,
+           times[0], times[nb_runs / 2], times[nb_runs - 1]);
+    return 0;
+}
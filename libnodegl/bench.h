@@ -0,0 +1,56 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+/*
+ * Minimal benchmarking harness shared by the bench_*.c programs.
+ *
+ * Every benchmark is a function running its workload nb_iter times. The
+ * harness first runs a single untimed iteration to absorb the one-time costs
+ * (such as shader compilations), then calibrates the number of iterations so
+ * that a single run lasts at least the minimum run time, then executes a
+ * fixed number of runs
+ * and reports the min, median and max time per iteration. The median is the
+ * reference value to compare between builds; the min/max spread gives an
+ * idea of the noise.
+ *
+ * The following environment variables can be used to tune the runs:
+ *   - NGL_BENCH_RUNS: number of measured runs (default: 9)
+ *   - NGL_BENCH_MIN_TIME: minimum duration of a run in milliseconds
+ *     (default: 20)
+ *
+ * The first command line argument, if any, is used as a filter: only the
+ * benchmarks whose name contains it are executed.
+ */
+
+typedef int (*bench_func_type)(void *arg, int64_t nb_iter);
+
+void bench_init(int argc, char *argv[]);
+int bench_run(const char *name, bench_func_type func, void *arg);
+
+/* Prevent the compiler from optimizing out the benchmarked computation */
+void bench_use(const void *ptr);
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "nodegl.h"
+#include "utils.h"
+
+#define NB_TIMES 1024 /* must be a power of 2 */
+
+struct anim_bench {
+    struct ngl_node *anim;
+    double times[NB_TIMES];
+};
+
+static int bench_evaluate(void *arg, int64_t nb_iter)
+{
+    struct anim_bench *s = arg;
+    float v;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        int ret = ngl_anim_evaluate(s->anim, &v, s->times[n & (NB_TIMES - 1)]);
+        if (ret < 0)
+            return ret;
+        bench_use(&v);
+    }
+    return 0;
+}
+
+static struct ngl_node *create_anim(const char *easing, int nb_kfs)
+{
+    struct ngl_node *anim = ngl_node_create(NGL_NODE_ANIMATEDFLOAT);
+    if (!anim)
+        return NULL;
+
+    for (int i = 0; i < nb_kfs; i++) {
+        struct ngl_node *kf = ngl_node_create(NGL_NODE_ANIMKEYFRAMEFLOAT);
+        if (!kf ||
+            ngl_node_param_set(kf, "time", (double)i) < 0 ||
+            ngl_node_param_set(kf, "value", (double)(i & 1)) < 0 ||
+            ngl_node_param_set(kf, "easing", easing) < 0 ||
+            ngl_node_param_add(anim, "keyframes", 1, &kf) < 0) {
+            ngl_node_unrefp(&kf);
+            ngl_node_unrefp(&anim);
+            return NULL;
+        }
+        ngl_node_unrefp(&kf);
+    }
+
+    return anim;
+}
+
+/*
+ * The sequential access pattern mimics a regular playback while the random
+ * one defeats the current key frame caching (seeking).
+ */
+static void fill_times(double *times, int nb_kfs, int random)
+{
+    const double duration = nb_kfs - 1;
+    uint32_t seed = 0x1234;
+    for (int i = 0; i < NB_TIMES; i++) {
+        if (random) {
+            seed = seed * 1664525 + 1013904223;
+            times[i] = duration * (seed >> 8) / (double)(1 << 24);
+        } else {
+            times[i] = duration * i / NB_TIMES;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const char * const easings[] = {
+        "linear",
+        "quadratic_in_out",
+        "exp_in",
+        "elastic_out",
+        "bounce_out",
+        "back_in_out",
+    };
+    static const int nb_kfs[] = {2, 16, 256};
+
+    struct anim_bench s;
+
+    bench_init(argc, argv);
+
+    for (int e = 0; e < NGLI_ARRAY_NB(easings); e++) {
+        for (int k = 0; k < NGLI_ARRAY_NB(nb_kfs); k++) {
+            s.anim = create_anim(easings[e], nb_kfs[k]);
+            if (!s.anim)
+                return 1;
+
+            for (int random = 0; random <= 1; random++) {
+                char name[64];
+                snprintf(name, sizeof(name), "anim %s %d kfs %s",
+                         easings[e], nb_kfs[k], random ? "random" : "sequential");
+                fill_times(s.times, nb_kfs[k], random);
+                if (bench_run(name, bench_evaluate, &s) < 0) {
+                    ngl_node_unrefp(&s.anim);
+                    return 1;
+                }
+            }
+
+            ngl_node_unrefp(&s.anim);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "easing.h"
+#include "math_utils.h"
+#include "utils.h"
+
+typedef void (*mat4_mul_func_type)(float *dst, const float *m1, const float *m2);
+typedef void (*mat4_mul_vec4_func_type)(float *dst, const float *m, const float *v);
+typedef void (*mat3_normal_func_type)(float *dst, const float *m);
+typedef void (*quat_slerp_func_type)(float *dst, const float *q1, const float *q2, float t);
+typedef void (*mix_floats_func_type)(float *dst, const float *a, const float *b, float c, int n);
+typedef void (*ease_poly_func_type)(double *dst, const double *x, int n, int degree, int transform);
+
+#define MIX_SIZE 4096
+
+struct mat_bench {
+    NGLI_ALIGNED_MAT(m1);
+    NGLI_ALIGNED_MAT(m2);
+    NGLI_ALIGNED_MAT(out);
+    NGLI_ALIGNED_VEC(v);
+    NGLI_ALIGNED_VEC(vout);
+    NGLI_ALIGNED_VEC(q1);
+    NGLI_ALIGNED_VEC(q2);
+    float nout[3*3];
+    mat4_mul_func_type mat4_mul;
+    mat4_mul_vec4_func_type mat4_mul_vec4;
+    mat3_normal_func_type mat3_normal;
+    quat_slerp_func_type quat_slerp;
+    mix_floats_func_type mix_floats;
+    ease_poly_func_type ease_poly;
+    double ease_x[MIX_SIZE];
+    double ease_out[MIX_SIZE];
+    float mix_a[MIX_SIZE];
+    float mix_b[MIX_SIZE];
+    float mix_out[MIX_SIZE];
+};
+
+static int bench_mat4_mul(void *arg, int64_t nb_iter)
+{
+    struct mat_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        s->mat4_mul(s->out, s->m1, s->m2);
+        bench_use(s->out);
+    }
+    return 0;
+}
+
+static int bench_mat4_mul_vec4(void *arg, int64_t nb_iter)
+{
+    struct mat_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        s->mat4_mul_vec4(s->vout, s->m1, s->v);
+        bench_use(s->vout);
+    }
+    return 0;
+}
+
+static int bench_mat3_normal(void *arg, int64_t nb_iter)
+{
+    struct mat_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        s->mat3_normal(s->nout, s->m1);
+        bench_use(s->nout);
+    }
+    return 0;
+}
+
+static int bench_quat_slerp(void *arg, int64_t nb_iter)
+{
+    struct mat_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        s->quat_slerp(s->vout, s->q1, s->q2, (n & 0xff) / 255.f);
+        bench_use(s->vout);
+    }
+    return 0;
+}
+
+static int bench_mix_floats(void *arg, int64_t nb_iter)
+{
+    struct mat_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        s->mix_floats(s->mix_out, s->mix_a, s->mix_b, (n & 0xff) / 255.f, MIX_SIZE);
+        bench_use(s->mix_out);
+    }
+    return 0;
+}
+
+static int bench_ease_poly(void *arg, int64_t nb_iter)
+{
+    struct mat_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        s->ease_poly(s->ease_out, s->ease_x, MIX_SIZE, 3, NGLI_EASE_IN_OUT);
+        bench_use(s->ease_out);
+    }
+    return 0;
+}
+
+struct variant {
+    const char *name;
+    int cpu_flags;
+    bench_func_type bench;
+    mat4_mul_func_type mat4_mul;
+    mat4_mul_vec4_func_type mat4_mul_vec4;
+    mat3_normal_func_type mat3_normal;
+    quat_slerp_func_type quat_slerp;
+    mix_floats_func_type mix_floats;
+    ease_poly_func_type ease_poly;
+};
+
+int main(int argc, char *argv[])
+{
+    static struct mat_bench s = {
+        .m1 = {
+            0.73016,  0.51184, 0.20930, -7.42311,
+           -9.42693,  1.47287, 0.34995,  0.42049,
+            0.42603, -1.50442, 1.34210,  3.04868,
+            0.53013,  0.68963, 0.25207,  1.96254,
+        },
+        .m2 = {
+            0.08222, 0.62387, 0.79754,  0.64541,
+            1.70126, 2.24977, 0.05395, -3.00599,
+            0.30858, 0.90973, 0.84432, -4.01016,
+            6.19681, 5.45165, 0.77647,  0.59262,
+        },
+        .v = {0.4, -1.3, 2.7, 1.0},
+        .q1 = {0.18257, 0.36515, 0.54772, 0.73030},
+        .q2 = {-0.51450, 0.68599, 0.34300, 0.38590},
+    };
+
+    const struct variant variants[] = {
+        {"mat4 mul (C)",                 0,                  bench_mat4_mul,       .mat4_mul = ngli_mat4_mul_c},
+        {"mat4 mul vec4 (C)",            0,                  bench_mat4_mul_vec4,  .mat4_mul_vec4 = ngli_mat4_mul_vec4_c},
+        {"mat3 normal from mat4 (C)",    0,                  bench_mat3_normal,    .mat3_normal = ngli_mat3_normal_from_mat4_c},
+        {"quat slerp (C)",               0,                  bench_quat_slerp,     .quat_slerp = ngli_quat_slerp_c},
+        {"mix 4096 floats (C)",          0,                  bench_mix_floats,     .mix_floats = ngli_mix_floats_c},
+        {"cubic in-out 4096 (C)",        0,                  bench_ease_poly,      .ease_poly = ngli_ease_poly_c},
+#if defined(ARCH_AARCH64)
+        {"mat4 mul (aarch64)",           0,                  bench_mat4_mul,       .mat4_mul = ngli_mat4_mul_aarch64},
+        {"mat4 mul vec4 (aarch64)",      0,                  bench_mat4_mul_vec4,  .mat4_mul_vec4 = ngli_mat4_mul_vec4_aarch64},
+#elif defined(ARCH_X86_64)
+        {"mat4 mul (sse2)",              NGLI_CPU_FLAG_SSE2, bench_mat4_mul,       .mat4_mul = ngli_mat4_mul_sse2},
+        {"mat4 mul (avx)",               NGLI_CPU_FLAG_AVX,  bench_mat4_mul,       .mat4_mul = ngli_mat4_mul_avx},
+        {"mat4 mul (fma)",               NGLI_CPU_FLAG_FMA,  bench_mat4_mul,       .mat4_mul = ngli_mat4_mul_fma},
+        {"mat4 mul vec4 (sse2)",         NGLI_CPU_FLAG_SSE2, bench_mat4_mul_vec4,  .mat4_mul_vec4 = ngli_mat4_mul_vec4_sse2},
+        {"mat4 mul vec4 (fma)",          NGLI_CPU_FLAG_FMA,  bench_mat4_mul_vec4,  .mat4_mul_vec4 = ngli_mat4_mul_vec4_fma},
+        {"mat3 normal from mat4 (sse2)", NGLI_CPU_FLAG_SSE2, bench_mat3_normal,    .mat3_normal = ngli_mat3_normal_from_mat4_sse2},
+        {"quat slerp (sse2)",            NGLI_CPU_FLAG_SSE2, bench_quat_slerp,     .quat_slerp = ngli_quat_slerp_sse2},
+        {"mix 4096 floats (sse2)",       NGLI_CPU_FLAG_SSE2, bench_mix_floats,     .mix_floats = ngli_mix_floats_sse2},
+        {"mix 4096 floats (avx)",        NGLI_CPU_FLAG_AVX,  bench_mix_floats,     .mix_floats = ngli_mix_floats_avx},
+        {"mix 4096 floats (fma)",        NGLI_CPU_FLAG_FMA,  bench_mix_floats,     .mix_floats = ngli_mix_floats_fma},
+        {"cubic in-out 4096 (sse2)",     NGLI_CPU_FLAG_SSE2, bench_ease_poly,      .ease_poly = ngli_ease_poly_sse2},
+        {"cubic in-out 4096 (avx)",      NGLI_CPU_FLAG_AVX,  bench_ease_poly,      .ease_poly = ngli_ease_poly_avx},
+#endif
+    };
+
+#if defined(ARCH_X86_64)
+    const int cpu_flags = ngli_cpu_get_flags_x86_64();
+#else
+    const int cpu_flags = 0;
+#endif
+
+    for (int i = 0; i < MIX_SIZE; i++) {
+        s.mix_a[i] = i * 0.25f;
+        s.mix_b[i] = -i * 0.5f;
+        s.ease_x[i] = (double)i / (MIX_SIZE - 1);
+    }
+
+    bench_init(argc, argv);
+
+    for (int i = 0; i < NGLI_ARRAY_NB(variants); i++) {
+        const struct variant *variant = &variants[i];
+        if ((variant->cpu_flags & cpu_flags) != variant->cpu_flags) {
+            printf("%s: unsupported by the CPU\n", variant->name);
+            continue;
+        }
+        s.mat4_mul      = variant->mat4_mul;
+        s.mat4_mul_vec4 = variant->mat4_mul_vec4;
+        s.mat3_normal   = variant->mat3_normal;
+        s.quat_slerp    = variant->quat_slerp;
+        s.mix_floats    = variant->mix_floats;
+        s.ease_poly     = variant->ease_poly;
+        if (bench_run(variant->name, variant->bench, &s) < 0)
+            return 1;
+    }
+
+    return 0;
+}
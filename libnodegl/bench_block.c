@@ -0,0 +1,92 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "block.h"
+#include "type.h"
+#include "utils.h"
+
+struct block_bench {
+    enum block_layout layout;
+    int nb_fields;
+};
+
+/* Mix of scalars, vectors, matrices and arrays exercising the alignment rules */
+static const struct {
+    int type;
+    int count;
+} fields[] = {
+    {NGLI_TYPE_FLOAT, 0},
+    {NGLI_TYPE_VEC3,  0},
+    {NGLI_TYPE_MAT4,  0},
+    {NGLI_TYPE_VEC2,  0},
+    {NGLI_TYPE_INT,   0},
+    {NGLI_TYPE_IVEC3, 0},
+    {NGLI_TYPE_VEC4,  0},
+    {NGLI_TYPE_FLOAT, 8},
+    {NGLI_TYPE_VEC3,  4},
+    {NGLI_TYPE_MAT4,  2},
+};
+
+static int bench_add_field(void *arg, int64_t nb_iter)
+{
+    const struct block_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        struct block block;
+        ngli_block_init(&block, s->layout);
+        for (int i = 0; i < s->nb_fields; i++) {
+            const int k = i % NGLI_ARRAY_NB(fields);
+            if (ngli_block_add_field(&block, "field", fields[k].type, fields[k].count) < 0) {
+                ngli_block_reset(&block);
+                return -1;
+            }
+        }
+        bench_use(&block.size);
+        ngli_block_reset(&block);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const char * const layout_names[] = {
+        [NGLI_BLOCK_LAYOUT_STD140] = "std140",
+        [NGLI_BLOCK_LAYOUT_STD430] = "std430",
+    };
+    static const int nb_fields[] = {10, 100};
+
+    bench_init(argc, argv);
+
+    for (int layout = 0; layout < NGLI_BLOCK_NB_LAYOUTS; layout++) {
+        for (int i = 0; i < NGLI_ARRAY_NB(nb_fields); i++) {
+            struct block_bench s = {.layout = layout, .nb_fields = nb_fields[i]};
+            char name[64];
+            snprintf(name, sizeof(name), "block add %d fields %s",
+                     s.nb_fields, layout_names[layout]);
+            if (bench_run(name, bench_add_field, &s) < 0)
+                return 1;
+        }
+    }
+
+    return 0;
+}
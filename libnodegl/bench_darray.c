@@ -0,0 +1,76 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "darray.h"
+#include "utils.h"
+
+struct darray_bench {
+    int nb_elems;
+    int element_size;
+    int aligned;
+};
+
+static int bench_push(void *arg, int64_t nb_iter)
+{
+    const struct darray_bench *s = arg;
+    const uint8_t element[64] = {0};
+
+    for (int64_t n = 0; n < nb_iter; n++) {
+        struct darray darray;
+        ngli_darray_init(&darray, s->element_size, s->aligned);
+        for (int i = 0; i < s->nb_elems; i++) {
+            if (!ngli_darray_push(&darray, element)) {
+                ngli_darray_reset(&darray);
+                return -1;
+            }
+        }
+        bench_use(ngli_darray_data(&darray));
+        ngli_darray_reset(&darray);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct darray_bench benchs[] = {
+        {.nb_elems = 16,    .element_size = sizeof(int)},
+        {.nb_elems = 1024,  .element_size = sizeof(int)},
+        {.nb_elems = 65536, .element_size = sizeof(int)},
+        {.nb_elems = 1024,  .element_size = 64},
+        {.nb_elems = 1024,  .element_size = 64, .aligned = 1},
+    };
+
+    bench_init(argc, argv);
+
+    for (int i = 0; i < NGLI_ARRAY_NB(benchs); i++) {
+        const struct darray_bench *s = &benchs[i];
+        char name[64];
+        snprintf(name, sizeof(name), "darray push %d x %dB%s",
+                 s->nb_elems, s->element_size, s->aligned ? " aligned" : "");
+        if (bench_run(name, bench_push, (void *)s) < 0)
+            return 1;
+    }
+
+    return 0;
+}
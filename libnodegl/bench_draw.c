@@ -0,0 +1,265 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "nodegl.h"
+#include "utils.h"
+
+/*
+ * Scene level benchmarks: the draws are executed on the null backend so that
+ * only the CPU cost of the graph traversal, update and command submission is
+ * measured, independently of any GPU or graphics driver.
+ */
+
+enum {
+    SCENE_STATIC,       /* static transforms and uniforms */
+    SCENE_ANIMATED,     /* animated transform and uniform on every render */
+    SCENE_UNBATCHED,    /* consecutive renders alternating programs */
+};
+
+static const char * const scene_names[] = {
+    [SCENE_STATIC]    = "static",
+    [SCENE_ANIMATED]  = "animated",
+    [SCENE_UNBATCHED] = "unbatched",
+};
+
+static const char vert[] =
+    "void main()"                                                               "\n"
+    "{"                                                                         "\n"
+    "    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * ngl_position;\n"
+    "    var_uvcoord = ngl_uvcoord;"                                            "\n"
+    "}";
+
+static const char * const frags[] = {
+    "void main()"                                                               "\n"
+    "{"                                                                         "\n"
+    "    ngl_out_color = color * vec4(var_uvcoord, 1.0, 1.0);"                  "\n"
+    "}",
+    "void main()"                                                               "\n"
+    "{"                                                                         "\n"
+    "    ngl_out_color = color * vec4(1.0, var_uvcoord, 1.0);"                  "\n"
+    "}",
+};
+
+struct draw_bench {
+    struct ngl_ctx *ctx;
+    int64_t frame;
+};
+
+static int bench_draw(void *arg, int64_t nb_iter)
+{
+    struct draw_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        const double t = (s->frame++ % 60) / 60.;
+        int ret = ngl_draw(s->ctx, t);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+#define CHECK(expr) do { if ((expr) < 0) goto fail; } while (0)
+
+static struct ngl_node *create_program(const char *frag)
+{
+    struct ngl_node *program = ngl_node_create(NGL_NODE_PROGRAM);
+    struct ngl_node *var_uvcoord = ngl_node_create(NGL_NODE_IOVEC2);
+    if (!program || !var_uvcoord)
+        goto fail;
+    CHECK(ngl_node_param_set(program, "vertex", vert));
+    CHECK(ngl_node_param_set(program, "fragment", frag));
+    CHECK(ngl_node_param_set(program, "vert_out_vars", "var_uvcoord", var_uvcoord));
+    ngl_node_unrefp(&var_uvcoord);
+    return program;
+
+fail:
+    ngl_node_unrefp(&var_uvcoord);
+    ngl_node_unrefp(&program);
+    return NULL;
+}
+
+static struct ngl_node *create_anim(int type, int kf_type, const float *v0, const float *v1)
+{
+    struct ngl_node *anim = ngl_node_create(type);
+    if (!anim)
+        return NULL;
+    for (int i = 0; i < 2; i++) {
+        struct ngl_node *kf = ngl_node_create(kf_type);
+        if (!kf ||
+            ngl_node_param_set(kf, "time", (double)i) < 0 ||
+            ngl_node_param_set(kf, "value", i ? v1 : v0) < 0 ||
+            ngl_node_param_add(anim, "keyframes", 1, &kf) < 0) {
+            ngl_node_unrefp(&kf);
+            ngl_node_unrefp(&anim);
+            return NULL;
+        }
+        ngl_node_unrefp(&kf);
+    }
+    return anim;
+}
+
+static struct ngl_node *create_render(int scene, int i, int nb_renders,
+                                      struct ngl_node *geometry, struct ngl_node **programs)
+{
+    struct ngl_node *render = NULL;
+    struct ngl_node *color = NULL;
+    struct ngl_node *translate = ngl_node_create(NGL_NODE_TRANSLATE);
+    if (!translate)
+        return NULL;
+
+    const float pos[3] = {-1.f + 2.f * i / nb_renders, 0.f, 0.f};
+    const float rgba[4] = {(i % 7) / 7.f, (i % 5) / 5.f, (i % 3) / 3.f, 1.f};
+    if (scene == SCENE_ANIMATED) {
+        const float pos_end[3] = {pos[0], 0.5f, 0.f};
+        const float rgba_end[4] = {1.f, 1.f, 1.f, 1.f};
+        struct ngl_node *anim = create_anim(NGL_NODE_ANIMATEDVEC3, NGL_NODE_ANIMKEYFRAMEVEC3, pos, pos_end);
+        if (!anim || ngl_node_param_set(translate, "anim", anim) < 0) {
+            ngl_node_unrefp(&anim);
+            goto fail;
+        }
+        ngl_node_unrefp(&anim);
+        color = create_anim(NGL_NODE_ANIMATEDVEC4, NGL_NODE_ANIMKEYFRAMEVEC4, rgba, rgba_end);
+        if (!color)
+            goto fail;
+    } else {
+        CHECK(ngl_node_param_set(translate, "vector", pos));
+        color = ngl_node_create(NGL_NODE_UNIFORMVEC4);
+        if (!color)
+            goto fail;
+        CHECK(ngl_node_param_set(color, "value", rgba));
+    }
+
+    render = ngl_node_create(NGL_NODE_RENDER);
+    if (!render)
+        goto fail;
+    struct ngl_node *program = programs[scene == SCENE_UNBATCHED ? i & 1 : 0];
+    CHECK(ngl_node_param_set(render, "geometry", geometry));
+    CHECK(ngl_node_param_set(render, "program", program));
+    CHECK(ngl_node_param_set(render, "frag_resources", "color", color));
+    CHECK(ngl_node_param_set(translate, "child", render));
+
+    ngl_node_unrefp(&color);
+    ngl_node_unrefp(&render);
+    return translate;
+
+fail:
+    ngl_node_unrefp(&color);
+    ngl_node_unrefp(&render);
+    ngl_node_unrefp(&translate);
+    return NULL;
+}
+
+static struct ngl_node *create_scene(int scene, int nb_renders)
+{
+    struct ngl_node *programs[2] = {NULL};
+    struct ngl_node *geometry = ngl_node_create(NGL_NODE_QUAD);
+    struct ngl_node *group = ngl_node_create(NGL_NODE_GROUP);
+    if (!geometry || !group)
+        goto fail;
+
+    const float corner[3] = {-0.05f, -0.05f, 0.f};
+    const float width[3]  = {0.1f, 0.f, 0.f};
+    const float height[3] = {0.f, 0.1f, 0.f};
+    CHECK(ngl_node_param_set(geometry, "corner", corner));
+    CHECK(ngl_node_param_set(geometry, "width", width));
+    CHECK(ngl_node_param_set(geometry, "height", height));
+
+    for (int i = 0; i < NGLI_ARRAY_NB(programs); i++) {
+        programs[i] = create_program(frags[i]);
+        if (!programs[i])
+            goto fail;
+    }
+
+    for (int i = 0; i < nb_renders; i++) {
+        struct ngl_node *child = create_render(scene, i, nb_renders, geometry, programs);
+        if (!child || ngl_node_param_add(group, "children", 1, &child) < 0) {
+            ngl_node_unrefp(&child);
+            goto fail;
+        }
+        ngl_node_unrefp(&child);
+    }
+
+    for (int i = 0; i < NGLI_ARRAY_NB(programs); i++)
+        ngl_node_unrefp(&programs[i]);
+    ngl_node_unrefp(&geometry);
+    return group;
+
+fail:
+    for (int i = 0; i < NGLI_ARRAY_NB(programs); i++)
+        ngl_node_unrefp(&programs[i]);
+    ngl_node_unrefp(&geometry);
+    ngl_node_unrefp(&group);
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int nb_renders[] = {16, 256};
+
+    struct ngl_config config = {
+        .backend   = NGL_BACKEND_NULL,
+        .offscreen = 1,
+        .width     = 1280,
+        .height    = 720,
+    };
+
+    bench_init(argc, argv);
+
+    int ret = 1;
+    struct draw_bench s = {0};
+    s.ctx = ngl_create();
+    if (!s.ctx)
+        goto end;
+
+    /* The draw phase is measured with its commands submitted directly, then recorded */
+    for (int record = 0; record < 2; record++) {
+        config.record_commands = record;
+        if (ngl_configure(s.ctx, &config) < 0)
+            goto end;
+
+        for (int scene = 0; scene < NGLI_ARRAY_NB(scene_names); scene++) {
+            for (int k = 0; k < NGLI_ARRAY_NB(nb_renders); k++) {
+                struct ngl_node *root = create_scene(scene, nb_renders[k]);
+                if (!root)
+                    goto end;
+                int err = ngl_set_scene(s.ctx, root);
+                ngl_node_unrefp(&root);
+                if (err < 0)
+                    goto end;
+
+                char name[64];
+                snprintf(name, sizeof(name), "draw %s %d renders%s",
+                         scene_names[scene], nb_renders[k], record ? " (recorded)" : "");
+                s.frame = 0;
+                if (bench_run(name, bench_draw, &s) < 0)
+                    goto end;
+            }
+        }
+    }
+
+    ret = 0;
+
+end:
+    ngl_freep(&s.ctx);
+    return ret;
+}
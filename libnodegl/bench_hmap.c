@@ -0,0 +1,120 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "hmap.h"
+#include "memory.h"
+#include "utils.h"
+
+#define MAX_KEYS 4096
+
+struct hmap_bench {
+    char keys[MAX_KEYS][16];
+    int nb_keys;
+    struct hmap *hm;
+};
+
+static int bench_set(void *arg, int64_t nb_iter)
+{
+    struct hmap_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        struct hmap *hm = ngli_hmap_create();
+        if (!hm)
+            return -1;
+        for (int i = 0; i < s->nb_keys; i++) {
+            if (ngli_hmap_set(hm, s->keys[i], s->keys[i]) < 0) {
+                ngli_hmap_freep(&hm);
+                return -1;
+            }
+        }
+        bench_use(hm);
+        ngli_hmap_freep(&hm);
+    }
+    return 0;
+}
+
+static int bench_get(void *arg, int64_t nb_iter)
+{
+    struct hmap_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++)
+        for (int i = 0; i < s->nb_keys; i++)
+            bench_use(ngli_hmap_get(s->hm, s->keys[i]));
+    return 0;
+}
+
+static int bench_iterate(void *arg, int64_t nb_iter)
+{
+    struct hmap_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        const struct hmap_entry *e = NULL;
+        while ((e = ngli_hmap_next(s->hm, e)))
+            bench_use(e->data);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int nb_keys[] = {16, 256, MAX_KEYS};
+
+    struct hmap_bench *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return 1;
+
+    for (int i = 0; i < MAX_KEYS; i++)
+        snprintf(s->keys[i], sizeof(s->keys[i]), "key_%d", i);
+
+    bench_init(argc, argv);
+
+    int ret = 0;
+    for (int k = 0; k < NGLI_ARRAY_NB(nb_keys) && ret >= 0; k++) {
+        s->nb_keys = nb_keys[k];
+
+        s->hm = ngli_hmap_create();
+        if (!s->hm) {
+            ret = -1;
+            break;
+        }
+        for (int i = 0; i < s->nb_keys && ret >= 0; i++)
+            ret = ngli_hmap_set(s->hm, s->keys[i], s->keys[i]);
+
+        char name[64];
+        if (ret >= 0) {
+            snprintf(name, sizeof(name), "hmap set %d keys", s->nb_keys);
+            ret = bench_run(name, bench_set, s);
+        }
+        if (ret >= 0) {
+            snprintf(name, sizeof(name), "hmap get %d keys", s->nb_keys);
+            ret = bench_run(name, bench_get, s);
+        }
+        if (ret >= 0) {
+            snprintf(name, sizeof(name), "hmap iterate %d keys", s->nb_keys);
+            ret = bench_run(name, bench_iterate, s);
+        }
+
+        ngli_hmap_freep(&s->hm);
+    }
+
+    ngli_free(s);
+    return ret < 0;
+}
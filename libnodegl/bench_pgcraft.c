@@ -0,0 +1,137 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+
+#include "bench.h"
+#include "block.h"
+#include "format.h"
+#include "log.h"
+#include "math_utils.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "pgcraft.h"
+#include "type.h"
+#include "utils.h"
+
+static const char vert_base[] =
+    "void main()"                                                               "\n"
+    "{"                                                                         "\n"
+    "    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * ngl_position;\n"
+    "    var_uvcoord = ngl_uvcoord;"                                            "\n"
+    "}";
+
+static const char frag_base[] =
+    "void main()"                                                               "\n"
+    "{"                                                                         "\n"
+    "    ngl_out_color = color * opacity + ngl_texvideo(tex0, var_uvcoord);"    "\n"
+    "}";
+
+struct pgcraft_bench {
+    struct ngl_ctx *ctx;
+    const struct pgcraft_params *params;
+};
+
+static int bench_craft(void *arg, int64_t nb_iter)
+{
+    const struct pgcraft_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        struct pgcraft *crafter = ngli_pgcraft_create(s->ctx);
+        if (!crafter)
+            return -1;
+        struct pipeline_params pipeline_params = {0};
+        int ret = ngli_pgcraft_craft(crafter, &pipeline_params, s->params);
+        bench_use(pipeline_params.program);
+        ngli_pgcraft_freep(&crafter);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const float color[4] = {1.f, 0.5f, 0.f, 1.f};
+    static const float opacity = 0.5f;
+    static const float matrix[16] = NGLI_MAT4_IDENTITY;
+
+    const struct pgcraft_uniform uniforms[] = {
+        {.name = "ngl_modelview_matrix",  .type = NGLI_TYPE_MAT4, .stage = NGLI_PROGRAM_SHADER_VERT, .data = matrix},
+        {.name = "ngl_projection_matrix", .type = NGLI_TYPE_MAT4, .stage = NGLI_PROGRAM_SHADER_VERT, .data = matrix},
+        {.name = "ngl_normal_matrix",     .type = NGLI_TYPE_MAT3, .stage = NGLI_PROGRAM_SHADER_VERT},
+        {.name = "color",                 .type = NGLI_TYPE_VEC4, .stage = NGLI_PROGRAM_SHADER_FRAG, .data = color},
+        {.name = "opacity",               .type = NGLI_TYPE_FLOAT, .stage = NGLI_PROGRAM_SHADER_FRAG, .data = &opacity},
+    };
+
+    const struct pgcraft_texture textures[] = {
+        {.name = "tex0", .type = NGLI_PGCRAFT_SHADER_TEX_TYPE_TEXTURE2D, .stage = NGLI_PROGRAM_SHADER_FRAG},
+    };
+
+    const struct pgcraft_attribute attributes[] = {
+        {.name = "ngl_position", .type = NGLI_TYPE_VEC4, .format = NGLI_FORMAT_R32G32B32_SFLOAT, .stride = 3 * 4},
+        {.name = "ngl_uvcoord",  .type = NGLI_TYPE_VEC2, .format = NGLI_FORMAT_R32G32_SFLOAT,    .stride = 2 * 4},
+    };
+
+    const struct pgcraft_iovar vert_out_vars[] = {
+        {.name = "var_uvcoord", .type = NGLI_TYPE_VEC2},
+    };
+
+    const struct pgcraft_params params = {
+        .vert_base        = vert_base,
+        .frag_base        = frag_base,
+        .uniforms         = uniforms,
+        .nb_uniforms      = NGLI_ARRAY_NB(uniforms),
+        .textures         = textures,
+        .nb_textures      = NGLI_ARRAY_NB(textures),
+        .attributes       = attributes,
+        .nb_attributes    = NGLI_ARRAY_NB(attributes),
+        .vert_out_vars    = vert_out_vars,
+        .nb_vert_out_vars = NGLI_ARRAY_NB(vert_out_vars),
+        .nb_frag_output   = 0,
+    };
+
+    bench_init(argc, argv);
+
+    /*
+     * The context is configured with the null backend so that only the CPU
+     * cost of the crafting is measured: the source generation, the program
+     * cache lookup and the pipeline elements probing. The program is only
+     * compiled on the first run, which the harness does not time.
+     */
+    struct ngl_config config = {
+        .backend   = NGL_BACKEND_NULL,
+        .offscreen = 1,
+        .width     = 16,
+        .height    = 16,
+    };
+
+    int ret = 1;
+    struct ngl_ctx *ctx = ngl_create();
+    if (!ctx || ngl_configure(ctx, &config) < 0)
+        goto end;
+
+    struct pgcraft_bench s = {.ctx = ctx, .params = &params};
+    ret = bench_run("pgcraft graphics program", bench_craft, &s) < 0;
+
+end:
+    ngl_freep(&ctx);
+    return ret;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "nodegl.h"
+#include "utils.h"
+
+struct serialize_bench {
+    struct ngl_node *scene;
+    char *serialized;
+};
+
+static int bench_serialize(void *arg, int64_t nb_iter)
+{
+    const struct serialize_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        char *str = ngl_node_serialize(s->scene);
+        if (!str)
+            return -1;
+        bench_use(str);
+        free(str);
+    }
+    return 0;
+}
+
+static int bench_deserialize(void *arg, int64_t nb_iter)
+{
+    const struct serialize_bench *s = arg;
+    for (int64_t n = 0; n < nb_iter; n++) {
+        struct ngl_node *scene = ngl_node_deserialize(s->serialized);
+        if (!scene)
+            return -1;
+        bench_use(scene);
+        ngl_node_unrefp(&scene);
+    }
+    return 0;
+}
+
+static struct ngl_node *create_animation(int index)
+{
+    struct ngl_node *anim = ngl_node_create(NGL_NODE_ANIMATEDFLOAT);
+    if (!anim)
+        return NULL;
+
+    for (int i = 0; i < 4; i++) {
+        struct ngl_node *kf = ngl_node_create(NGL_NODE_ANIMKEYFRAMEFLOAT);
+        if (!kf ||
+            ngl_node_param_set(kf, "time", (double)i) < 0 ||
+            ngl_node_param_set(kf, "value", (index + i) / 10.) < 0 ||
+            ngl_node_param_set(kf, "easing", i & 1 ? "quadratic_in" : "exp_out") < 0 ||
+            ngl_node_param_add(anim, "keyframes", 1, &kf) < 0) {
+            ngl_node_unrefp(&kf);
+            ngl_node_unrefp(&anim);
+            return NULL;
+        }
+        ngl_node_unrefp(&kf);
+    }
+
+    return anim;
+}
+
+/*
+ * Synthetic scene made of a group of translated renders, each with its own
+ * geometry, a constant uniform and an animated uniform, all sharing the same
+ * program.
+ */
+static struct ngl_node *create_scene(int nb_renders)
+{
+    struct ngl_node *group   = ngl_node_create(NGL_NODE_GROUP);
+    struct ngl_node *program = ngl_node_create(NGL_NODE_PROGRAM);
+    if (!group || !program) {
+        ngl_node_unrefp(&program);
+        ngl_node_unrefp(&group);
+        return NULL;
+    }
+
+    int ret = 0;
+    for (int i = 0; i < nb_renders && ret >= 0; i++) {
+        const float corner[3] = {-0.5f + i / 1000.f, -0.5f, 0.f};
+        const float color[4]  = {i / 255.f, 0.5f, 1.f - i / 255.f, 1.f};
+        const float vector[3] = {i / 100.f, -i / 100.f, 0.f};
+
+        struct ngl_node *quad      = ngl_node_create(NGL_NODE_QUAD);
+        struct ngl_node *ucolor    = ngl_node_create(NGL_NODE_UNIFORMVEC4);
+        struct ngl_node *uopacity  = create_animation(i);
+        struct ngl_node *render    = ngl_node_create(NGL_NODE_RENDER);
+        struct ngl_node *translate = ngl_node_create(NGL_NODE_TRANSLATE);
+
+        if (!quad || !ucolor || !uopacity || !render || !translate ||
+            ngl_node_param_set(quad, "corner", corner) < 0 ||
+            ngl_node_param_set(ucolor, "value", color) < 0 ||
+            ngl_node_param_set(render, "geometry", quad) < 0 ||
+            ngl_node_param_set(render, "program", program) < 0 ||
+            ngl_node_param_set(render, "frag_resources", "color", ucolor) < 0 ||
+            ngl_node_param_set(render, "frag_resources", "opacity", uopacity) < 0 ||
+            ngl_node_param_set(translate, "child", render) < 0 ||
+            ngl_node_param_set(translate, "vector", vector) < 0 ||
+            ngl_node_param_add(group, "children", 1, &translate) < 0)
+            ret = -1;
+
+        ngl_node_unrefp(&translate);
+        ngl_node_unrefp(&render);
+        ngl_node_unrefp(&uopacity);
+        ngl_node_unrefp(&ucolor);
+        ngl_node_unrefp(&quad);
+    }
+
+    ngl_node_unrefp(&program);
+    if (ret < 0)
+        ngl_node_unrefp(&group);
+    return group;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int nb_renders[] = {10, 100, 1000};
+
+    bench_init(argc, argv);
+
+    for (int i = 0; i < NGLI_ARRAY_NB(nb_renders); i++) {
+        struct serialize_bench s = {.scene = create_scene(nb_renders[i])};
+        if (!s.scene)
+            return 1;
+
+        s.serialized = ngl_node_serialize(s.scene);
+        if (!s.serialized) {
+            ngl_node_unrefp(&s.scene);
+            return 1;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "serialize %d renders", nb_renders[i]);
+        int ret = bench_run(name, bench_serialize, &s);
+        if (ret >= 0) {
+            snprintf(name, sizeof(name), "deserialize %d renders", nb_renders[i]);
+            ret = bench_run(name, bench_deserialize, &s);
+        }
+
+        free(s.serialized);
+        ngl_node_unrefp(&s.scene);
+        if (ret < 0)
+            return 1;
+    }
+
+    return 0;
+}
@@ -106,6 +106,24 @@ void ngli_bstr_printf(struct bstr *b, const char *fmt, ...)
     b->len = b->len + len;
 }
 
+/* Print a CSV field, quoted and escaped only when necessary */
+void ngli_bstr_print_csv(struct bstr *b, const char *str)
+{
+    if (!strchr(str, ',') && !strchr(str, '"') && !strchr(str, '\n')) {
+        ngli_bstr_print(b, str);
+        return;
+    }
+
+    ngli_bstr_print(b, "\"");
+    for (int i = 0; str[i]; i++) {
+        if (str[i] == '"')
+            ngli_bstr_print(b, "\"\"");
+        else
+            ngli_bstr_printf(b, "%c", str[i]);
+    }
+    ngli_bstr_print(b, "\"");
+}
+
 void ngli_bstr_clear(struct bstr *b)
 {
     b->len = 0;
@@ -31,6 +31,7 @@ struct bstr;
 struct bstr *ngli_bstr_create(void);
 void ngli_bstr_print(struct bstr *b, const char *str);
 void ngli_bstr_printf(struct bstr *b, const char *fmt, ...) ngli_printf_format(2, 3);
+void ngli_bstr_print_csv(struct bstr *b, const char *str);
 void ngli_bstr_clear(struct bstr *b);
 int ngli_bstr_truncate(struct bstr *b, int len);
 char *ngli_bstr_strdup(const struct bstr *b);
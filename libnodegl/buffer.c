@@ -23,6 +23,7 @@
 
 #include "buffer.h"
 #include "gctx.h"
+#include "nodes.h"
 
 struct buffer *ngli_buffer_create(struct gctx *gctx)
 {
@@ -31,17 +32,51 @@ struct buffer *ngli_buffer_create(struct gctx *gctx)
 
 int ngli_buffer_init(struct buffer *s, int size, int usage)
 {
-    return s->gctx->class->buffer_init(s, size, usage);
+    struct gctx *gctx = s->gctx;
+    int ret = gctx->class->buffer_init(s, size, usage);
+    if (ret < 0)
+        return ret;
+    return ngli_memtrack_add(&gctx->memtrack, &s->mem, gctx->ctx->cur_node, NGLI_MEMTRACK_BUFFER, size);
+}
+
+int ngli_buffer_init_shared(struct buffer *s, const void *data, int size, int usage)
+{
+    struct gctx *gctx = s->gctx;
+    if (!gctx->class->buffer_init_shared) {
+        int ret = ngli_buffer_init(s, size, usage);
+        if (ret < 0)
+            return ret;
+        return ngli_buffer_upload(s, data, size);
+    }
+
+    int ret = gctx->class->buffer_init_shared(s, data, size, usage);
+    if (ret < 0)
+        return ret;
+    return ngli_memtrack_add(&gctx->memtrack, &s->mem, gctx->ctx->cur_node, NGLI_MEMTRACK_BUFFER, size);
 }
 
 int ngli_buffer_upload(struct buffer *s, const void *data, int size)
 {
-    return s->gctx->class->buffer_upload(s, data, size);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        return ngli_cmdbuffer_buffer_upload(&gctx->cmdbuffer, s, data, size);
+    return gctx->class->buffer_upload(s, data, size);
+}
+
+int ngli_buffer_upload_range(struct buffer *s, const void *data, int offset, int size)
+{
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        return ngli_cmdbuffer_buffer_upload_range(&gctx->cmdbuffer, s, data, offset, size);
+    return gctx->class->buffer_upload_range(s, data, offset, size);
 }
 
 void ngli_buffer_freep(struct buffer **sp)
 {
     if (!*sp)
         return;
-    (*sp)->gctx->class->buffer_freep(sp);
+    struct gctx *gctx = (*sp)->gctx;
+    ngli_cmdbuffer_sync(&gctx->cmdbuffer);
+    ngli_memtrack_remove(&gctx->memtrack, &(*sp)->mem);
+    gctx->class->buffer_freep(sp);
 }
@@ -22,6 +22,8 @@
 #ifndef BUFFER_H
 #define BUFFER_H
 
+#include "memtrack.h"
+
 struct gctx;
 
 enum {
@@ -34,11 +36,20 @@ struct buffer {
     struct gctx *gctx;
     int size;
     int usage;
+    struct memtrack_entry mem;
 };
 
 struct buffer *ngli_buffer_create(struct gctx *gctx);
 int ngli_buffer_init(struct buffer *s, int size, int usage);
+
+/*
+ * Initialize the buffer with its final content, which must not be changed
+ * afterwards; this allows the buffer to be shared with the other contexts of
+ * the share group holding the same content.
+ */
+int ngli_buffer_init_shared(struct buffer *s, const void *data, int size, int usage);
 int ngli_buffer_upload(struct buffer *s, const void *data, int size);
+int ngli_buffer_upload_range(struct buffer *s, const void *data, int offset, int size);
 void ngli_buffer_freep(struct buffer **sp);
 
 #endif
@@ -19,6 +19,8 @@
  * under the License.
  */
 
+#include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "buffer_gl.h"
@@ -61,16 +63,88 @@ int ngli_buffer_gl_init(struct buffer *s, int size, int usage)
     return 0;
 }
 
+static void require_update_barrier(struct buffer *s)
+{
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    const struct buffer_gl *s_priv = (struct buffer_gl *)s;
+    ngli_memorybarrier_gl_require(&gctx_gl->memorybarrier, gl, s_priv->last_shader_write, GL_BUFFER_UPDATE_BARRIER_BIT);
+    ngli_memorybarrier_gl_flush(&gctx_gl->memorybarrier, gl);
+}
+
 int ngli_buffer_gl_upload(struct buffer *s, const void *data, int size)
 {
     struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
     struct glcontext *gl = gctx_gl->glcontext;
     const struct buffer_gl *s_priv = (struct buffer_gl *)s;
+    require_update_barrier(s);
     ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s_priv->id);
     ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, 0, size, data);
     return 0;
 }
 
+int ngli_buffer_gl_upload_range(struct buffer *s, const void *data, int offset, int size)
+{
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    const struct buffer_gl *s_priv = (struct buffer_gl *)s;
+    require_update_barrier(s);
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s_priv->id);
+    ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, offset, size, data);
+    return 0;
+}
+
+int ngli_buffer_gl_init_shared(struct buffer *s, const void *data, int size, int usage)
+{
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    struct buffer_gl *s_priv = (struct buffer_gl *)s;
+    struct sharegroup *sharegroup = s->gctx->sharegroup;
+    const struct sharegroup_chunk chunks[] = {
+        {&usage, sizeof(usage)},
+        {data, size},
+    };
+    char key[NGLI_SHAREGROUP_KEY_LEN];
+
+    ngli_sharegroup_lock(sharegroup);
+    const int shared = ngli_sharegroup_is_shared(sharegroup);
+    if (shared) {
+        snprintf(key, sizeof(key), "buffer:%016" PRIx64,
+                 ngli_sharegroup_hash(chunks, NGLI_ARRAY_NB(chunks)));
+
+        uintptr_t handle;
+        if (ngli_sharegroup_acquire(sharegroup, key, chunks, NGLI_ARRAY_NB(chunks), &handle)) {
+            ngli_sharegroup_unlock(sharegroup);
+            s->size = size;
+            s->usage = usage;
+            s_priv->id = (GLuint)handle;
+            snprintf(s_priv->share_key, sizeof(s_priv->share_key), "%s", key);
+            return 0;
+        }
+    }
+    ngli_sharegroup_unlock(sharegroup);
+
+    int ret = ngli_buffer_gl_init(s, size, usage);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_buffer_gl_upload(s, data, size);
+    if (ret < 0 || !shared)
+        return ret;
+
+    /* The upload must be complete before the buffer is used by another context */
+    ngli_glFinish(gl);
+
+    ngli_sharegroup_lock(sharegroup);
+    ret = ngli_sharegroup_publish(sharegroup, key, chunks, NGLI_ARRAY_NB(chunks), s_priv->id);
+    ngli_sharegroup_unlock(sharegroup);
+    if (ret < 0)
+        return ret;
+    if (ret)
+        snprintf(s_priv->share_key, sizeof(s_priv->share_key), "%s", key);
+    return 0;
+}
+
 void ngli_buffer_gl_freep(struct buffer **sp)
 {
     if (!*sp)
@@ -79,6 +153,14 @@ void ngli_buffer_gl_freep(struct buffer **sp)
     struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
     struct glcontext *gl = gctx_gl->glcontext;
     struct buffer_gl *s_priv = (struct buffer_gl *)s;
-    ngli_glDeleteBuffers(gl, 1, &s_priv->id);
+    int last_user = 1;
+    if (s_priv->share_key[0]) {
+        struct sharegroup *sharegroup = s->gctx->sharegroup;
+        ngli_sharegroup_lock(sharegroup);
+        last_user = ngli_sharegroup_release(sharegroup, s_priv->share_key);
+        ngli_sharegroup_unlock(sharegroup);
+    }
+    if (last_user)
+        ngli_glDeleteBuffers(gl, 1, &s_priv->id);
     ngli_freep(sp);
 }
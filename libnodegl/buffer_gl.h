@@ -24,17 +24,22 @@
 
 #include "buffer.h"
 #include "glincludes.h"
+#include "sharegroup.h"
 
 struct buffer_gl {
     struct buffer parent;
     GLuint id;
+    int64_t last_shader_write; /* see memorybarrier_gl.h */
+    char share_key[NGLI_SHAREGROUP_KEY_LEN]; /* set if the buffer is shared */
 };
 
 struct gctx;
 
 struct buffer *ngli_buffer_gl_create(struct gctx *gctx);
 int ngli_buffer_gl_init(struct buffer *s, int size, int usage);
+int ngli_buffer_gl_init_shared(struct buffer *s, const void *data, int size, int usage);
 int ngli_buffer_gl_upload(struct buffer *s, const void *data, int size);
+int ngli_buffer_gl_upload_range(struct buffer *s, const void *data, int offset, int size);
 void ngli_buffer_gl_freep(struct buffer **sp);
 
 #endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "buffer_null.h"
+#include "gctx_null.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+
+struct buffer *ngli_buffer_null_create(struct gctx *gctx)
+{
+    struct buffer *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gctx = gctx;
+    return s;
+}
+
+int ngli_buffer_null_init(struct buffer *s, int size, int usage)
+{
+    s->size = size;
+    s->usage = usage;
+    return 0;
+}
+
+int ngli_buffer_null_upload(struct buffer *s, const void *data, int size)
+{
+    return ngli_buffer_null_upload_range(s, data, 0, size);
+}
+
+int ngli_buffer_null_upload_range(struct buffer *s, const void *data, int offset, int size)
+{
+    if (offset < 0 || size < 0 || offset + size > s->size) {
+        LOG(ERROR, "upload of %d bytes at offset %d exceeds the buffer size (%d)", size, offset, s->size);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_BUFFER_UPLOAD,
+        .object = s,
+        .args   = {size, offset},
+    });
+    return 0;
+}
+
+void ngli_buffer_null_freep(struct buffer **sp)
+{
+    ngli_freep(sp);
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BUFFER_NULL_H
+#define BUFFER_NULL_H
+
+#include "buffer.h"
+
+struct gctx;
+
+struct buffer *ngli_buffer_null_create(struct gctx *gctx);
+int ngli_buffer_null_init(struct buffer *s, int size, int usage);
+int ngli_buffer_null_upload(struct buffer *s, const void *data, int size);
+int ngli_buffer_null_upload_range(struct buffer *s, const void *data, int offset, int size);
+void ngli_buffer_null_freep(struct buffer **sp);
+
+#endif
@@ -0,0 +1,474 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "buffer.h"
+#include "cmdbuffer.h"
+#include "gctx.h"
+#include "gtimer.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "pipeline.h"
+#include "rendertarget.h"
+#include "texture.h"
+#include "utils.h"
+
+enum {
+    CMD_SET_RENDERTARGET,
+    CMD_SET_VIEWPORT,
+    CMD_SET_SCISSOR,
+    CMD_SET_CLEAR_COLOR,
+    CMD_CLEAR_COLOR,
+    CMD_CLEAR_DEPTH_STENCIL,
+    CMD_INVALIDATE_DEPTH_STENCIL,
+    CMD_BUFFER_UPLOAD,
+    CMD_BUFFER_UPLOAD_RANGE,
+    CMD_TEXTURE_UPLOAD,
+    CMD_TEXTURE_UPLOAD_RECT,
+    CMD_TEXTURE_GENERATE_MIPMAP,
+    CMD_PIPELINE_UPDATE_ATTRIBUTE,
+    CMD_PIPELINE_UPDATE_UNIFORM,
+    CMD_PIPELINE_UPDATE_TEXTURE,
+    CMD_PIPELINE_DRAW,
+    CMD_PIPELINE_DRAW_INDEXED,
+    CMD_PIPELINE_DRAW_INDIRECT,
+    CMD_PIPELINE_DRAW_INDEXED_INDIRECT,
+    CMD_PIPELINE_DISPATCH,
+    CMD_GTIMER_START,
+    CMD_GTIMER_STOP,
+    CMD_RENDERTARGET_BLIT,
+    CMD_RENDERTARGET_RESOLVE,
+};
+
+struct cmd {
+    int type;
+    int size;       /* size of the command and its payload */
+    void *object;   /* pipeline, buffer, texture, gtimer or rendertarget the command applies to */
+    void *arg0;     /* buffer, texture or rendertarget argument */
+    void *arg1;
+    int args[5];
+};
+
+/* Commands only need the alignment of their pointers, the payloads are copied by the backends */
+#define CMD_ALIGN       ((int)sizeof(void *))
+#define CMD_HEADER_SIZE NGLI_ALIGN((int)sizeof(struct cmd), CMD_ALIGN)
+
+void ngli_cmdbuffer_init(struct cmdbuffer *s, struct gctx *gctx)
+{
+    s->gctx = gctx;
+}
+
+void ngli_cmdbuffer_begin(struct cmdbuffer *s)
+{
+    const struct gctx_class *class = s->gctx->class;
+
+    ngli_assert(!s->recording);
+    s->rendertarget = class->get_rendertarget(s->gctx);
+    class->get_viewport(s->gctx, s->viewport);
+    class->get_scissor(s->gctx, s->scissor);
+    class->get_clear_color(s->gctx, s->clear_color);
+    s->recording = 1;
+    s->failed = 0;
+    s->error = 0;
+}
+
+static int replay(struct cmdbuffer *s, const struct cmd *cmd)
+{
+    struct gctx *gctx = s->gctx;
+    const struct gctx_class *class = gctx->class;
+    const void *data = (const uint8_t *)cmd + CMD_HEADER_SIZE;
+    const int *args = cmd->args;
+
+    switch (cmd->type) {
+    case CMD_SET_RENDERTARGET:          class->set_rendertarget(gctx, cmd->object);                                     break;
+    case CMD_SET_VIEWPORT:              class->set_viewport(gctx, args);                                                break;
+    case CMD_SET_SCISSOR:               class->set_scissor(gctx, args);                                                 break;
+    case CMD_SET_CLEAR_COLOR:           class->set_clear_color(gctx, data);                                             break;
+    case CMD_CLEAR_COLOR:               class->clear_color(gctx);                                                       break;
+    case CMD_CLEAR_DEPTH_STENCIL:       class->clear_depth_stencil(gctx);                                               break;
+    case CMD_INVALIDATE_DEPTH_STENCIL:  class->invalidate_depth_stencil(gctx);                                          break;
+    case CMD_BUFFER_UPLOAD:             return class->buffer_upload(cmd->object, data, args[0]);
+    case CMD_BUFFER_UPLOAD_RANGE:       return class->buffer_upload_range(cmd->object, data, args[1], args[0]);
+    case CMD_TEXTURE_UPLOAD:            return class->texture_upload(cmd->object, data, args[0]);
+    case CMD_TEXTURE_UPLOAD_RECT:       return class->texture_upload_rect(cmd->object, data, args[0],
+                                                                          args[1], args[2], args[3], args[4]);
+    case CMD_TEXTURE_GENERATE_MIPMAP:   return class->texture_generate_mipmap(cmd->object);
+    case CMD_PIPELINE_UPDATE_ATTRIBUTE: return class->pipeline_update_attribute(cmd->object, args[0], cmd->arg0);
+    case CMD_PIPELINE_UPDATE_UNIFORM:   return class->pipeline_update_uniform(cmd->object, args[0], data);
+    case CMD_PIPELINE_UPDATE_TEXTURE:   return class->pipeline_update_texture(cmd->object, args[0], cmd->arg0);
+    case CMD_PIPELINE_DRAW:             class->pipeline_draw(cmd->object, args[0], args[1]);                            break;
+    case CMD_PIPELINE_DRAW_INDEXED:     class->pipeline_draw_indexed(cmd->object, cmd->arg0, args[0], args[1], args[2]); break;
+    case CMD_PIPELINE_DRAW_INDIRECT:    class->pipeline_draw_indirect(cmd->object, cmd->arg0, args[0]);                 break;
+    case CMD_PIPELINE_DRAW_INDEXED_INDIRECT:
+        class->pipeline_draw_indexed_indirect(cmd->object, cmd->arg0, args[0], cmd->arg1, args[1]);
+        break;
+    case CMD_PIPELINE_DISPATCH:         class->pipeline_dispatch(cmd->object, args[0], args[1], args[2]);               break;
+    case CMD_GTIMER_START:              return class->gtimer_start(cmd->object);
+    case CMD_GTIMER_STOP:               return class->gtimer_stop(cmd->object);
+    case CMD_RENDERTARGET_BLIT:         class->rendertarget_blit(cmd->object, cmd->arg0, args[0]);                      break;
+    case CMD_RENDERTARGET_RESOLVE:      class->rendertarget_resolve(cmd->object);                                       break;
+    default:
+        ngli_assert(0);
+    }
+    return 0;
+}
+
+int ngli_cmdbuffer_flush(struct cmdbuffer *s)
+{
+    if (!s->data_size)
+        return s->error;
+
+    if (s->failed) {
+        /* The recorded stream is incomplete, none of it is submitted */
+        s->data_size = 0;
+        s->serial++;
+        return s->error;
+    }
+
+    /*
+     * Some state of the objects shared with other contexts is set during the
+     * replay. The replay goes on after an error so the state changes (such
+     * as the GPU timers) stay balanced, only the first error is reported.
+     */
+    struct sharegroup *sharegroup = s->gctx->sharegroup;
+    ngli_sharegroup_lock_submit(sharegroup);
+    for (int offset = 0; offset < s->data_size;) {
+        const struct cmd *cmd = (const struct cmd *)(s->data + offset);
+        const int ret = replay(s, cmd);
+        if (ret < 0 && !s->error) {
+            LOG(ERROR, "replay of graphics command %d failed", cmd->type);
+            s->error = ret;
+        }
+        offset += cmd->size;
+    }
+    ngli_sharegroup_unlock_submit(sharegroup);
+    s->data_size = 0;
+    s->serial++;
+    return s->error;
+}
+
+int ngli_cmdbuffer_end(struct cmdbuffer *s)
+{
+    ngli_assert(s->recording);
+    s->recording = 0;
+    const int ret = ngli_cmdbuffer_flush(s);
+    s->failed = 0;
+    s->error = 0;
+    return ret;
+}
+
+void ngli_cmdbuffer_sync(struct cmdbuffer *s)
+{
+    if (!s->recording)
+        return;
+
+    /* The recording is suspended so the backend is called directly */
+    s->recording = 0;
+    ngli_cmdbuffer_flush(s);
+    s->recording = 1;
+}
+
+void ngli_cmdbuffer_reset(struct cmdbuffer *s)
+{
+    ngli_freep(&s->data);
+    memset(s, 0, sizeof(*s));
+}
+
+/*
+ * Reserve a command of the given type followed by a copy of its payload at
+ * the end of the buffer. The other fields are left for the caller to fill.
+ * Once a command could not be recorded, the following ones are dropped.
+ */
+static struct cmd *push_cmd(struct cmdbuffer *s, int type, const void *data, int size)
+{
+    if (s->failed)
+        return NULL;
+
+    const int cmd_size = NGLI_ALIGN(CMD_HEADER_SIZE + size, CMD_ALIGN);
+    if (s->data_size + cmd_size > s->data_capacity) {
+        const int capacity = NGLI_MAX(s->data_size + cmd_size, s->data_capacity * 2);
+        uint8_t *new_data = ngli_realloc(s->data, capacity);
+        if (!new_data) {
+            LOG(ERROR, "unable to record graphics command %d", type);
+            s->failed = 1;
+            if (!s->error)
+                s->error = NGL_ERROR_MEMORY;
+            return NULL;
+        }
+        s->data = new_data;
+        s->data_capacity = capacity;
+    }
+
+    struct cmd *cmd = (struct cmd *)(s->data + s->data_size);
+    cmd->type = type;
+    cmd->size = cmd_size;
+    if (size)
+        memcpy((uint8_t *)cmd + CMD_HEADER_SIZE, data, size);
+    s->data_size += cmd_size;
+    return cmd;
+}
+
+void ngli_cmdbuffer_set_rendertarget(struct cmdbuffer *s, struct rendertarget *rt)
+{
+    s->rendertarget = rt;
+    struct cmd *cmd = push_cmd(s, CMD_SET_RENDERTARGET, NULL, 0);
+    if (cmd)
+        cmd->object = rt;
+}
+
+void ngli_cmdbuffer_set_viewport(struct cmdbuffer *s, const int *viewport)
+{
+    memcpy(s->viewport, viewport, sizeof(s->viewport));
+    struct cmd *cmd = push_cmd(s, CMD_SET_VIEWPORT, NULL, 0);
+    if (cmd)
+        memcpy(cmd->args, viewport, sizeof(s->viewport));
+}
+
+void ngli_cmdbuffer_set_scissor(struct cmdbuffer *s, const int *scissor)
+{
+    memcpy(s->scissor, scissor, sizeof(s->scissor));
+    struct cmd *cmd = push_cmd(s, CMD_SET_SCISSOR, NULL, 0);
+    if (cmd)
+        memcpy(cmd->args, scissor, sizeof(s->scissor));
+}
+
+void ngli_cmdbuffer_set_clear_color(struct cmdbuffer *s, const float *color)
+{
+    memcpy(s->clear_color, color, sizeof(s->clear_color));
+    push_cmd(s, CMD_SET_CLEAR_COLOR, color, sizeof(s->clear_color));
+}
+
+void ngli_cmdbuffer_clear_color(struct cmdbuffer *s)
+{
+    push_cmd(s, CMD_CLEAR_COLOR, NULL, 0);
+}
+
+void ngli_cmdbuffer_clear_depth_stencil(struct cmdbuffer *s)
+{
+    push_cmd(s, CMD_CLEAR_DEPTH_STENCIL, NULL, 0);
+}
+
+void ngli_cmdbuffer_invalidate_depth_stencil(struct cmdbuffer *s)
+{
+    push_cmd(s, CMD_INVALIDATE_DEPTH_STENCIL, NULL, 0);
+}
+
+int ngli_cmdbuffer_buffer_upload(struct cmdbuffer *s, struct buffer *buffer, const void *data, int size)
+{
+    struct cmd *cmd = push_cmd(s, CMD_BUFFER_UPLOAD, data, size);
+    if (!cmd)
+        return NGL_ERROR_MEMORY;
+    cmd->object = buffer;
+    cmd->args[0] = size;
+    return 0;
+}
+
+int ngli_cmdbuffer_buffer_upload_range(struct cmdbuffer *s, struct buffer *buffer, const void *data, int offset, int size)
+{
+    struct cmd *cmd = push_cmd(s, CMD_BUFFER_UPLOAD_RANGE, data, size);
+    if (!cmd)
+        return NGL_ERROR_MEMORY;
+    cmd->object = buffer;
+    cmd->args[0] = size;
+    cmd->args[1] = offset;
+    return 0;
+}
+
+static int get_texture_data_size(const struct texture *s, int linesize, int height)
+{
+    const struct texture_params *params = &s->params;
+    int size = s->bytes_per_pixel * (linesize ? linesize : params->width) * height;
+    if (params->type == NGLI_TEXTURE_TYPE_3D)
+        size *= params->depth;
+    else if (params->type == NGLI_TEXTURE_TYPE_CUBE)
+        size *= 6;
+    return size;
+}
+
+int ngli_cmdbuffer_texture_upload(struct cmdbuffer *s, struct texture *texture, const uint8_t *data, int linesize)
+{
+    const int size = get_texture_data_size(texture, linesize, texture->params.height);
+    struct cmd *cmd = push_cmd(s, CMD_TEXTURE_UPLOAD, data, size);
+    if (!cmd)
+        return NGL_ERROR_MEMORY;
+    cmd->object = texture;
+    cmd->args[0] = linesize;
+    return 0;
+}
+
+int ngli_cmdbuffer_texture_upload_rect(struct cmdbuffer *s, struct texture *texture, const uint8_t *data, int linesize,
+                                       int x, int y, int width, int height)
+{
+    const int size = get_texture_data_size(texture, linesize ? linesize : width, height);
+    struct cmd *cmd = push_cmd(s, CMD_TEXTURE_UPLOAD_RECT, data, size);
+    if (!cmd)
+        return NGL_ERROR_MEMORY;
+    cmd->object = texture;
+    cmd->args[0] = linesize;
+    cmd->args[1] = x;
+    cmd->args[2] = y;
+    cmd->args[3] = width;
+    cmd->args[4] = height;
+    return 0;
+}
+
+int ngli_cmdbuffer_texture_generate_mipmap(struct cmdbuffer *s, struct texture *texture)
+{
+    struct cmd *cmd = push_cmd(s, CMD_TEXTURE_GENERATE_MIPMAP, NULL, 0);
+    if (!cmd)
+        return NGL_ERROR_MEMORY;
+    cmd->object = texture;
+    return 0;
+}
+
+int ngli_cmdbuffer_pipeline_update_attribute(struct cmdbuffer *s, struct pipeline *pipeline, int index, struct buffer *buffer)
+{
+    if (index == -1)
+        return NGL_ERROR_NOT_FOUND;
+
+    struct cmd *cmd = push_cmd(s, CMD_PIPELINE_UPDATE_ATTRIBUTE, NULL, 0);
+    if (!cmd)
+        return NGL_ERROR_MEMORY;
+    cmd->object = pipeline;
+    cmd->arg0 = buffer;
+    cmd->args[0] = index;
+    return 0;
+}
+
+int ngli_cmdbuffer_pipeline_update_uniform(struct cmdbuffer *s, struct pipeline *pipeline, int index, const void *value)
+{
+    if (index == -1)
+        return NGL_ERROR_NOT_FOUND;
+
+    ngli_assert(index >= 0 && index < ngli_darray_count(&pipeline->uniform_sizes));
+    const int *sizes = ngli_darray_data(&pipeline->uniform_sizes);
+    struct cmd *cmd = push_cmd(s, CMD_PIPELINE_UPDATE_UNIFORM, value, sizes[index]);
+    if (!cmd)
+        return NGL_ERROR_MEMORY;
+    cmd->object = pipeline;
+    cmd->args[0] = index;
+    return 0;
+}
+
+int ngli_cmdbuffer_pipeline_update_texture(struct cmdbuffer *s, struct pipeline *pipeline, int index, struct texture *texture)
+{
+    if (index == -1)
+        return NGL_ERROR_NOT_FOUND;
+
+    struct cmd *cmd = push_cmd(s, CMD_PIPELINE_UPDATE_TEXTURE, NULL, 0);
+    if (!cmd)
+        return NGL_ERROR_MEMORY;
+    cmd->object = pipeline;
+    cmd->arg0 = texture;
+    cmd->args[0] = index;
+    return 0;
+}
+
+void ngli_cmdbuffer_pipeline_draw(struct cmdbuffer *s, struct pipeline *pipeline, int nb_vertices, int nb_instances)
+{
+    struct cmd *cmd = push_cmd(s, CMD_PIPELINE_DRAW, NULL, 0);
+    if (!cmd)
+        return;
+    cmd->object = pipeline;
+    cmd->args[0] = nb_vertices;
+    cmd->args[1] = nb_instances;
+}
+
+void ngli_cmdbuffer_pipeline_draw_indexed(struct cmdbuffer *s, struct pipeline *pipeline,
+                                          struct buffer *indices, int indices_format, int nb_indices, int nb_instances)
+{
+    struct cmd *cmd = push_cmd(s, CMD_PIPELINE_DRAW_INDEXED, NULL, 0);
+    if (!cmd)
+        return;
+    cmd->object = pipeline;
+    cmd->arg0 = indices;
+    cmd->args[0] = indices_format;
+    cmd->args[1] = nb_indices;
+    cmd->args[2] = nb_instances;
+}
+
+void ngli_cmdbuffer_pipeline_draw_indirect(struct cmdbuffer *s, struct pipeline *pipeline, struct buffer *indirect, int nb_draws)
+{
+    struct cmd *cmd = push_cmd(s, CMD_PIPELINE_DRAW_INDIRECT, NULL, 0);
+    if (!cmd)
+        return;
+    cmd->object = pipeline;
+    cmd->arg0 = indirect;
+    cmd->args[0] = nb_draws;
+}
+
+void ngli_cmdbuffer_pipeline_draw_indexed_indirect(struct cmdbuffer *s, struct pipeline *pipeline,
+                                                   struct buffer *indices, int indices_format,
+                                                   struct buffer *indirect, int nb_draws)
+{
+    struct cmd *cmd = push_cmd(s, CMD_PIPELINE_DRAW_INDEXED_INDIRECT, NULL, 0);
+    if (!cmd)
+        return;
+    cmd->object = pipeline;
+    cmd->arg0 = indices;
+    cmd->arg1 = indirect;
+    cmd->args[0] = indices_format;
+    cmd->args[1] = nb_draws;
+}
+
+void ngli_cmdbuffer_pipeline_dispatch(struct cmdbuffer *s, struct pipeline *pipeline, int nb_group_x, int nb_group_y, int nb_group_z)
+{
+    struct cmd *cmd = push_cmd(s, CMD_PIPELINE_DISPATCH, NULL, 0);
+    if (!cmd)
+        return;
+    cmd->object = pipeline;
+    cmd->args[0] = nb_group_x;
+    cmd->args[1] = nb_group_y;
+    cmd->args[2] = nb_group_z;
+}
+
+void ngli_cmdbuffer_gtimer_start(struct cmdbuffer *s, struct gtimer *gtimer)
+{
+    struct cmd *cmd = push_cmd(s, CMD_GTIMER_START, NULL, 0);
+    if (cmd)
+        cmd->object = gtimer;
+}
+
+void ngli_cmdbuffer_gtimer_stop(struct cmdbuffer *s, struct gtimer *gtimer)
+{
+    struct cmd *cmd = push_cmd(s, CMD_GTIMER_STOP, NULL, 0);
+    if (cmd)
+        cmd->object = gtimer;
+}
+
+void ngli_cmdbuffer_rendertarget_blit(struct cmdbuffer *s, struct rendertarget *rt, struct rendertarget *dst, int vflip)
+{
+    struct cmd *cmd = push_cmd(s, CMD_RENDERTARGET_BLIT, NULL, 0);
+    if (!cmd)
+        return;
+    cmd->object = rt;
+    cmd->arg0 = dst;
+    cmd->args[0] = vflip;
+}
+
+void ngli_cmdbuffer_rendertarget_resolve(struct cmdbuffer *s, struct rendertarget *rt)
+{
+    struct cmd *cmd = push_cmd(s, CMD_RENDERTARGET_RESOLVE, NULL, 0);
+    if (cmd)
+        cmd->object = rt;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CMDBUFFER_H
+#define CMDBUFFER_H
+
+#include <stdint.h>
+
+struct buffer;
+struct gctx;
+struct gtimer;
+struct pipeline;
+struct rendertarget;
+struct texture;
+
+/*
+ * Linear buffer of backend agnostic graphics commands.
+ *
+ * When enabled with ngl_config.record_commands, the graphics context state
+ * changes, the pipeline updates and draws, and the resource uploads are not
+ * executed while the scene is being drawn but recorded into the command
+ * buffer along with a copy of their data, stored right after each command in
+ * a single allocation reused across frames. The commands are then replayed
+ * in order on the backend when the draw phase ends, so the graph traversal
+ * is decoupled from the graphics API submission.
+ *
+ * The operations requiring a synchronization with the backend (GPU timer
+ * results, pixels read-back, objects release) flush the recorded commands
+ * before being executed.
+ *
+ * During the recording, the graphics context getters return the state set
+ * by the last recorded commands.
+ *
+ * The first error returned by the backend during the replay is kept and
+ * reported by ngli_cmdbuffer_end(). If a command can not be recorded, the
+ * buffer is marked as failed: the commands recorded until the end are
+ * discarded instead of being replayed partially, and ngli_cmdbuffer_end()
+ * returns NGL_ERROR_MEMORY.
+ */
+struct cmdbuffer {
+    struct gctx *gctx;
+    int recording;
+    int failed;         /* a command could not be recorded */
+    int error;          /* first error of the recording or the replay */
+    int64_t serial;     /* number of submissions of recorded commands */
+
+    uint8_t *data;      /* struct cmd, each followed by its payload */
+    int data_size;
+    int data_capacity;
+
+    struct rendertarget *rendertarget;
+    int viewport[4];
+    int scissor[4];
+    float clear_color[4];
+};
+
+void ngli_cmdbuffer_init(struct cmdbuffer *s, struct gctx *gctx);
+void ngli_cmdbuffer_begin(struct cmdbuffer *s);
+int ngli_cmdbuffer_flush(struct cmdbuffer *s);
+int ngli_cmdbuffer_end(struct cmdbuffer *s);
+void ngli_cmdbuffer_sync(struct cmdbuffer *s);
+void ngli_cmdbuffer_reset(struct cmdbuffer *s);
+
+void ngli_cmdbuffer_set_rendertarget(struct cmdbuffer *s, struct rendertarget *rt);
+void ngli_cmdbuffer_set_viewport(struct cmdbuffer *s, const int *viewport);
+void ngli_cmdbuffer_set_scissor(struct cmdbuffer *s, const int *scissor);
+void ngli_cmdbuffer_set_clear_color(struct cmdbuffer *s, const float *color);
+void ngli_cmdbuffer_clear_color(struct cmdbuffer *s);
+void ngli_cmdbuffer_clear_depth_stencil(struct cmdbuffer *s);
+void ngli_cmdbuffer_invalidate_depth_stencil(struct cmdbuffer *s);
+
+int ngli_cmdbuffer_buffer_upload(struct cmdbuffer *s, struct buffer *buffer, const void *data, int size);
+int ngli_cmdbuffer_buffer_upload_range(struct cmdbuffer *s, struct buffer *buffer, const void *data, int offset, int size);
+
+int ngli_cmdbuffer_texture_upload(struct cmdbuffer *s, struct texture *texture, const uint8_t *data, int linesize);
+int ngli_cmdbuffer_texture_upload_rect(struct cmdbuffer *s, struct texture *texture, const uint8_t *data, int linesize,
+                                       int x, int y, int width, int height);
+int ngli_cmdbuffer_texture_generate_mipmap(struct cmdbuffer *s, struct texture *texture);
+
+int ngli_cmdbuffer_pipeline_update_attribute(struct cmdbuffer *s, struct pipeline *pipeline, int index, struct buffer *buffer);
+int ngli_cmdbuffer_pipeline_update_uniform(struct cmdbuffer *s, struct pipeline *pipeline, int index, const void *value);
+int ngli_cmdbuffer_pipeline_update_texture(struct cmdbuffer *s, struct pipeline *pipeline, int index, struct texture *texture);
+void ngli_cmdbuffer_pipeline_draw(struct cmdbuffer *s, struct pipeline *pipeline, int nb_vertices, int nb_instances);
+void ngli_cmdbuffer_pipeline_draw_indexed(struct cmdbuffer *s, struct pipeline *pipeline,
+                                          struct buffer *indices, int indices_format, int nb_indices, int nb_instances);
+void ngli_cmdbuffer_pipeline_draw_indirect(struct cmdbuffer *s, struct pipeline *pipeline, struct buffer *indirect, int nb_draws);
+void ngli_cmdbuffer_pipeline_draw_indexed_indirect(struct cmdbuffer *s, struct pipeline *pipeline,
+                                                   struct buffer *indices, int indices_format,
+                                                   struct buffer *indirect, int nb_draws);
+void ngli_cmdbuffer_pipeline_dispatch(struct cmdbuffer *s, struct pipeline *pipeline, int nb_group_x, int nb_group_y, int nb_group_z);
+
+void ngli_cmdbuffer_gtimer_start(struct cmdbuffer *s, struct gtimer *gtimer);
+void ngli_cmdbuffer_gtimer_stop(struct cmdbuffer *s, struct gtimer *gtimer);
+
+void ngli_cmdbuffer_rendertarget_blit(struct cmdbuffer *s, struct rendertarget *rt, struct rendertarget *dst, int vflip);
+void ngli_cmdbuffer_rendertarget_resolve(struct cmdbuffer *s, struct rendertarget *rt);
+
+#endif
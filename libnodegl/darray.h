@@ -38,6 +38,7 @@ void *ngli_darray_push(struct darray *darray, const void *element);
 void *ngli_darray_pop(struct darray *darray);
 void *ngli_darray_tail(const struct darray *darray);
 void *ngli_darray_get(const struct darray *darray, int index);
+void ngli_darray_remove(struct darray *darray, int index);
 void ngli_darray_reset(struct darray *darray);
 
 static inline int ngli_darray_count(const struct darray *darray)
@@ -0,0 +1,234 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "easing.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "utils.h"
+
+#define SOLVE_MIN_DEPTH     3
+#define SOLVE_MAX_DEPTH     7
+#define SOLVE_MAX_ITER      64
+#define SOLVE_EPSILON       1e-12
+#define DERIVATIVE_STEP     1e-7
+
+#define LUT_MIN_INTERVALS   16
+#define LUT_MAX_INTERVALS   (1 << 16)
+
+struct solver {
+    easing_function f;
+    int nb_args;
+    const easing_type *args;
+    double v;
+};
+
+struct solver_sample {
+    double x;
+    double fx; /* f(x) - v */
+    double d;  /* f'(x) */
+};
+
+static struct solver_sample get_sample(const struct solver *s, double x, double x0, double x1)
+{
+    /* The derivative is estimated without evaluating the easing out of [x0,x1] */
+    const double lo = NGLI_MAX(x - DERIVATIVE_STEP, x0);
+    const double hi = NGLI_MIN(x + DERIVATIVE_STEP, x1);
+    const struct solver_sample sample = {
+        .x  = x,
+        .fx = s->f(x, s->nb_args, s->args) - s->v,
+        .d  = (s->f(hi, s->nb_args, s->args) - s->f(lo, s->nb_args, s->args)) / (hi - lo),
+    };
+    return sample;
+}
+
+static double refine_root(const struct solver *s, double a, double b, double fa)
+{
+    double x = (a + b) / 2.;
+    for (int i = 0; i < SOLVE_MAX_ITER && b - a > SOLVE_EPSILON; i++) {
+        const double fx = s->f(x, s->nb_args, s->args) - s->v;
+        if (fabs(fx) < SOLVE_EPSILON)
+            break;
+
+        /* Shrink the bracket around the root */
+        if ((fx < 0.) == (fa < 0.)) {
+            a = x;
+            fa = fx;
+        } else {
+            b = x;
+        }
+
+        /* Newton step, rejected if it escapes the bracket */
+        const double h = DERIVATIVE_STEP;
+        const double d = (s->f(x + h, s->nb_args, s->args) - s->f(x - h, s->nb_args, s->args)) / (2. * h);
+        const double next = d ? x - fx / d : NAN;
+        x = next > a && next < b ? next : (a + b) / 2.;
+    }
+    return x;
+}
+
+/*
+ * The easing is considered monotonic over an interval if its derivative has
+ * the same sign at both ends and in the middle, and so does its variation
+ * over both halves.
+ */
+static int is_monotonic(const struct solver_sample *a, const struct solver_sample *m,
+                        const struct solver_sample *b)
+{
+    const double values[] = {a->d, m->d, b->d, m->fx - a->fx, b->fx - m->fx};
+    int nb_pos = 0, nb_neg = 0;
+    for (int i = 0; i < NGLI_ARRAY_NB(values); i++) {
+        nb_pos += values[i] > 0.;
+        nb_neg += values[i] < 0.;
+    }
+    return !nb_pos || !nb_neg;
+}
+
+static int resolve_crossing(const struct solver *s, const struct solver_sample *a,
+                            const struct solver_sample *b, double *x)
+{
+    *x = fabs(b->fx) < SOLVE_EPSILON ? b->x : refine_root(s, a->x, b->x, a->fx);
+    return 1;
+}
+
+static int find_first_root(const struct solver *s, const struct solver_sample *a,
+                           const struct solver_sample *b, int depth, double *x)
+{
+    if (fabs(a->fx) < SOLVE_EPSILON) {
+        *x = a->x;
+        return 1;
+    }
+
+    const int crossing = (a->fx < 0.) != (b->fx < 0.) || fabs(b->fx) < SOLVE_EPSILON;
+    if (depth == SOLVE_MAX_DEPTH)
+        return crossing && resolve_crossing(s, a, b, x);
+
+    /*
+     * Over a monotonic interval, the value is reached at most once: either
+     * the root is refined directly, or the whole interval is skipped.
+     * Otherwise, the interval is split to look for the extrema of the easing.
+     */
+    const struct solver_sample m = get_sample(s, (a->x + b->x) / 2., a->x, b->x);
+    if (depth >= SOLVE_MIN_DEPTH && is_monotonic(a, &m, b))
+        return crossing && resolve_crossing(s, a, b, x);
+
+    return find_first_root(s, a, &m, depth + 1, x) ||
+           find_first_root(s, &m, b, depth + 1, x);
+}
+
+int ngli_easing_solve_numeric(easing_function f, int nb_args, const easing_type *args,
+                              double x0, double x1, double v, double *x)
+{
+    const struct solver s = {.f = f, .nb_args = nb_args, .args = args, .v = v};
+    const struct solver_sample a = get_sample(&s, x0, x0, x1);
+    const struct solver_sample b = get_sample(&s, x1, x0, x1);
+    return find_first_root(&s, &a, &b, 0, x) ? 0 : NGL_ERROR_INVALID_ARG;
+}
+
+static double lut_max_error(const struct easing_lut *s, easing_function f,
+                            int nb_args, const easing_type *args)
+{
+    static const double probes[] = {0.25, 0.5, 0.75};
+    const double step = 1. / s->inv_step;
+    double max_err = 0.;
+    for (int i = 0; i < s->nb_intervals; i++) {
+        for (int j = 0; j < NGLI_ARRAY_NB(probes); j++) {
+            const double x = s->x0 + (i + probes[j]) * step;
+            const double err = fabs(ngli_easing_lut_evaluate(s, x) - f(x, nb_args, args));
+            max_err = NGLI_MAX(max_err, err);
+        }
+    }
+    return max_err;
+}
+
+int ngli_easing_lut_init(struct easing_lut *s, easing_function f, int nb_args, const easing_type *args,
+                         double x0, double x1, double tolerance)
+{
+    memset(s, 0, sizeof(*s));
+    s->x0 = x0;
+    s->x1 = x1;
+
+    for (int nb_intervals = LUT_MIN_INTERVALS; nb_intervals <= LUT_MAX_INTERVALS; nb_intervals <<= 1) {
+        double *samples = ngli_realloc(s->samples, (nb_intervals + 1) * sizeof(*samples));
+        if (!samples) {
+            ngli_easing_lut_reset(s);
+            return NGL_ERROR_MEMORY;
+        }
+        s->samples = samples;
+        s->nb_intervals = nb_intervals;
+        s->inv_step = nb_intervals / (x1 - x0);
+        for (int i = 0; i <= nb_intervals; i++)
+            samples[i] = f(NGLI_MIX(x0, x1, i / (double)nb_intervals), nb_args, args);
+
+        if (lut_max_error(s, f, nb_args, args) <= tolerance)
+            return 0;
+    }
+
+    ngli_easing_lut_reset(s);
+    return NGL_ERROR_LIMIT_EXCEEDED;
+}
+
+double ngli_easing_lut_evaluate(const struct easing_lut *s, double x)
+{
+    const double pos = (x - s->x0) * s->inv_step;
+    const int i = NGLI_MIN(NGLI_MAX((int)pos, 0), s->nb_intervals - 1);
+    return NGLI_MIX(s->samples[i], s->samples[i + 1], pos - i);
+}
+
+void ngli_easing_lut_reset(struct easing_lut *s)
+{
+    ngli_freep(&s->samples);
+    memset(s, 0, sizeof(*s));
+}
+
+static inline double ipow(double x, int degree)
+{
+    double r = x;
+    for (int i = 1; i < degree; i++)
+        r *= x;
+    return r;
+}
+
+void ngli_ease_poly_c(double *dst, const double *x, int n, int degree, int transform)
+{
+    for (int i = 0; i < n; i++) {
+        const double v = x[i];
+        switch (transform) {
+        case NGLI_EASE_IN:
+            dst[i] = ipow(v, degree);
+            break;
+        case NGLI_EASE_OUT:
+            dst[i] = 1.0 - ipow(1.0 - v, degree);
+            break;
+        case NGLI_EASE_IN_OUT:
+            dst[i] = v < 0.5 ? ipow(2.0 * v, degree) / 2.0
+                             : 1.0 - ipow(2.0 * (1.0 - v), degree) / 2.0;
+            break;
+        case NGLI_EASE_OUT_IN:
+            dst[i] = v < 0.5 ? (1.0 - ipow(1.0 - 2.0 * v, degree)) / 2.0
+                             : (1.0 + ipow(2.0 * v - 1.0, degree)) / 2.0;
+            break;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef EASING_H
+#define EASING_H
+
+typedef double easing_type;
+typedef easing_type (*easing_function)(easing_type, int, const easing_type *);
+typedef void (*easing_batch_function)(easing_type *, const easing_type *, int, int, const easing_type *);
+
+/*
+ * Find the smallest x in [x0,x1] such that f(x)=v. The interval is split in
+ * 8 parts, which are split further until the easing is monotonic over each
+ * of them (judging from its derivative). The monotonic parts not reaching v
+ * are skipped and the first one bracketing it is refined with a Newton method
+ * falling back on bisection whenever the Newton step leaves the bracket. The
+ * non-monotonic easings are split up to 1/128 of the interval around their
+ * extrema.
+ */
+int ngli_easing_solve_numeric(easing_function f, int nb_args, const easing_type *args,
+                              double x0, double x1, double v, double *x);
+
+/*
+ * Piecewise linear approximation of an easing over [x0,x1], with a number of
+ * samples large enough to keep the estimated error below a given tolerance.
+ */
+struct easing_lut {
+    double x0, x1;
+    double inv_step;
+    double *samples;
+    int nb_intervals;
+};
+
+int ngli_easing_lut_init(struct easing_lut *s, easing_function f, int nb_args, const easing_type *args,
+                         double x0, double x1, double tolerance);
+double ngli_easing_lut_evaluate(const struct easing_lut *s, double x);
+void ngli_easing_lut_reset(struct easing_lut *s);
+
+enum {
+    NGLI_EASE_IN,
+    NGLI_EASE_OUT,
+    NGLI_EASE_IN_OUT,
+    NGLI_EASE_OUT_IN,
+};
+
+/*
+ * Polynomial easings x^degree applied to n values, with one of the
+ * NGLI_EASE_* transforms. The results are identical to the scalar easings.
+ */
+void ngli_ease_poly_c(double *dst, const double *x, int n, int degree, int transform);
+
+/* Arch specific versions, selected by ngli_math_init() */
+
+#if defined(ARCH_X86_64)
+# define ngli_ease_poly ngli_ease_poly_x86_64
+#else
+# define ngli_ease_poly ngli_ease_poly_c
+#endif
+
+extern void (*ngli_ease_poly_x86_64)(double *dst, const double *x, int n, int degree, int transform);
+
+void ngli_ease_poly_sse2(double *dst, const double *x, int n, int degree, int transform);
+void ngli_ease_poly_avx(double *dst, const double *x, int n, int degree, int transform);
+
+#endif
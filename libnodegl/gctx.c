@@ -26,15 +26,20 @@
 #include "memory.h"
 #include "nodes.h"
 #include "rendertarget.h"
+#include "sharegroup.h"
 
 extern const struct gctx_class ngli_gctx_gl;
 extern const struct gctx_class ngli_gctx_gles;
+extern const struct gctx_class ngli_gctx_null;
 
 static const struct gctx_class *backend_map[] = {
 #ifdef BACKEND_GL
     [NGL_BACKEND_OPENGL]   = &ngli_gctx_gl,
     [NGL_BACKEND_OPENGLES] = &ngli_gctx_gles,
 #endif
+#ifdef BACKEND_NULL
+    [NGL_BACKEND_NULL]     = &ngli_gctx_null,
+#endif
 };
 
 struct gctx *ngli_gctx_create(struct ngl_ctx *ctx)
@@ -53,11 +58,37 @@ struct gctx *ngli_gctx_create(struct ngl_ctx *ctx)
         return NULL;
     s->ctx = ctx;
     s->class = class;
+    ngli_cmdbuffer_init(&s->cmdbuffer, s);
+    if (ngli_memtrack_init(&s->memtrack) < 0) {
+        ngli_gctx_freep(&s);
+        return NULL;
+    }
     return s;
 }
 
 int ngli_gctx_init(struct gctx *s)
 {
+    const struct ngl_config *config = &s->ctx->config;
+    const struct ngl_ctx *share_ctx = config->share_ctx;
+
+    if (share_ctx) {
+        const struct gctx *share_gctx = share_ctx->gctx;
+        if (!share_gctx) {
+            LOG(ERROR, "the share context is not configured");
+            return NGL_ERROR_INVALID_USAGE;
+        }
+        if (share_ctx->config.platform != config->platform ||
+            share_ctx->config.backend  != config->backend) {
+            LOG(ERROR, "the share context must use the same platform and backend");
+            return NGL_ERROR_INVALID_ARG;
+        }
+        s->sharegroup = ngli_sharegroup_ref(share_gctx->sharegroup);
+    } else {
+        s->sharegroup = ngli_sharegroup_create();
+        if (!s->sharegroup)
+            return NGL_ERROR_MEMORY;
+    }
+
     return s->class->init(s);
 }
 
@@ -78,7 +109,13 @@ int ngli_gctx_draw(struct gctx *s, double t)
 
     if (ctx->scene) {
         LOG(DEBUG, "draw scene %s @ t=%f", ctx->scene->label, t);
-        ngli_node_draw(ctx->scene);
+        if (ctx->config.record_commands) {
+            ngli_cmdbuffer_begin(&s->cmdbuffer);
+            ngli_node_draw(ctx->scene);
+            ret = ngli_cmdbuffer_end(&s->cmdbuffer);
+        } else {
+            ngli_node_draw(ctx->scene);
+        }
     }
 
 end:;
@@ -99,62 +136,117 @@ void ngli_gctx_freep(struct gctx **sp)
     if (class)
         class->destroy(s);
 
+    ngli_sharegroup_unrefp(&s->sharegroup);
+    ngli_cmdbuffer_reset(&s->cmdbuffer);
+    ngli_memtrack_reset(&s->memtrack);
     ngli_freep(sp);
 }
 
+void ngli_gctx_reset_counters(struct gctx *s)
+{
+    s->class->reset_counters(s);
+}
+
+void ngli_gctx_get_counters(struct gctx *s, struct ngl_stats *stats)
+{
+    s->class->get_counters(s, stats);
+}
+
+char *ngli_gctx_export_api_calls(struct gctx *s)
+{
+    return s->class->export_api_calls(s);
+}
+
+char *ngli_gctx_export_memory(struct gctx *s)
+{
+    return ngli_memtrack_export(&s->memtrack);
+}
+
 void ngli_gctx_set_rendertarget(struct gctx *s, struct rendertarget *rt)
 {
-    s->class->set_rendertarget(s, rt);
+    if (s->cmdbuffer.recording)
+        ngli_cmdbuffer_set_rendertarget(&s->cmdbuffer, rt);
+    else
+        s->class->set_rendertarget(s, rt);
 }
 
 struct rendertarget *ngli_gctx_get_rendertarget(struct gctx *s)
 {
+    if (s->cmdbuffer.recording)
+        return s->cmdbuffer.rendertarget;
     return s->class->get_rendertarget(s);
 }
 
 void ngli_gctx_set_viewport(struct gctx *s, const int *viewport)
 {
-    s->class->set_viewport(s, viewport);
+    if (s->cmdbuffer.recording)
+        ngli_cmdbuffer_set_viewport(&s->cmdbuffer, viewport);
+    else
+        s->class->set_viewport(s, viewport);
 }
 
 void ngli_gctx_get_viewport(struct gctx *s, int *viewport)
 {
-    s->class->get_viewport(s, viewport);
+    if (s->cmdbuffer.recording)
+        memcpy(viewport, s->cmdbuffer.viewport, sizeof(s->cmdbuffer.viewport));
+    else
+        s->class->get_viewport(s, viewport);
 }
 
 void ngli_gctx_set_scissor(struct gctx *s, const int *scissor)
 {
-    s->class->set_scissor(s, scissor);
+    if (s->cmdbuffer.recording)
+        ngli_cmdbuffer_set_scissor(&s->cmdbuffer, scissor);
+    else
+        s->class->set_scissor(s, scissor);
 }
 
 void ngli_gctx_get_scissor(struct gctx *s, int *scissor)
 {
-    s->class->get_scissor(s, scissor);
+    if (s->cmdbuffer.recording)
+        memcpy(scissor, s->cmdbuffer.scissor, sizeof(s->cmdbuffer.scissor));
+    else
+        s->class->get_scissor(s, scissor);
 }
 
 void ngli_gctx_set_clear_color(struct gctx *s, const float *color)
 {
-    s->class->set_clear_color(s, color);
+    if (s->cmdbuffer.recording)
+        ngli_cmdbuffer_set_clear_color(&s->cmdbuffer, color);
+    else
+        s->class->set_clear_color(s, color);
 }
 
 void ngli_gctx_get_clear_color(struct gctx *s, float *color)
 {
-    s->class->get_clear_color(s, color);
+    if (s->cmdbuffer.recording)
+        memcpy(color, s->cmdbuffer.clear_color, sizeof(s->cmdbuffer.clear_color));
+    else
+        s->class->get_clear_color(s, color);
 }
 
 void ngli_gctx_clear_color(struct gctx *s)
 {
-    s->class->clear_color(s);
+    if (s->cmdbuffer.recording)
+        ngli_cmdbuffer_clear_color(&s->cmdbuffer);
+    else
+        s->class->clear_color(s);
 }
 
 void ngli_gctx_clear_depth_stencil(struct gctx *s)
 {
-    s->class->clear_depth_stencil(s);
+    if (s->cmdbuffer.recording)
+        ngli_cmdbuffer_clear_depth_stencil(&s->cmdbuffer);
+    else
+        s->class->clear_depth_stencil(s);
 }
 
 void ngli_gctx_invalidate_depth_stencil(struct gctx *s)
 {
-    s->class->invalidate_depth_stencil(s);
+    if (s->cmdbuffer.recording)
+        ngli_cmdbuffer_invalidate_depth_stencil(&s->cmdbuffer);
+    else
+        s->class->invalidate_depth_stencil(s);
 }
 
 int ngli_gctx_get_preferred_depth_format(struct gctx *s)
@@ -23,13 +23,16 @@
 #define GCTX_H
 
 #include "buffer.h"
+#include "cmdbuffer.h"
 #include "features.h"
 #include "gtimer.h"
 #include "limits.h"
+#include "memtrack.h"
 #include "nodegl.h"
 #include "pgcache.h"
 #include "pipeline.h"
 #include "rendertarget.h"
+#include "sharegroup.h"
 #include "texture.h"
 
 struct gctx_class {
@@ -42,6 +45,10 @@ struct gctx_class {
     int (*post_draw)(struct gctx *s, double t);
     void (*destroy)(struct gctx *s);
 
+    void (*reset_counters)(struct gctx *s);
+    void (*get_counters)(struct gctx *s, struct ngl_stats *stats);
+    char *(*export_api_calls)(struct gctx *s);
+
     void (*set_rendertarget)(struct gctx *s, struct rendertarget *rt);
     struct rendertarget *(*get_rendertarget)(struct gctx *s);
     void (*set_viewport)(struct gctx *s, const int *viewport);
@@ -58,7 +65,9 @@ struct gctx_class {
 
     struct buffer *(*buffer_create)(struct gctx *ctx);
     int (*buffer_init)(struct buffer *s, int size, int usage);
+    int (*buffer_init_shared)(struct buffer *s, const void *data, int size, int usage); /* optional */
     int (*buffer_upload)(struct buffer *s, const void *data, int size);
+    int (*buffer_upload_range)(struct buffer *s, const void *data, int offset, int size);
     void (*buffer_freep)(struct buffer **sp);
 
     struct gtimer *(*gtimer_create)(struct gctx *ctx);
@@ -66,6 +75,7 @@ struct gctx_class {
     int (*gtimer_start)(struct gtimer *s);
     int (*gtimer_stop)(struct gtimer *s);
     int64_t (*gtimer_read)(struct gtimer *s);
+    int (*gtimer_poll)(struct gtimer *s, int64_t *result);
     void (*gtimer_freep)(struct gtimer **sp);
 
     struct pipeline *(*pipeline_create)(struct gctx *ctx);
@@ -75,6 +85,8 @@ struct gctx_class {
     int (*pipeline_update_texture)(struct pipeline *s, int index, struct texture *texture);
     void (*pipeline_draw)(struct pipeline *s, int nb_vertices, int nb_instances);
     void (*pipeline_draw_indexed)(struct pipeline *s, struct buffer *indices, int indices_format, int nb_indices, int nb_instances);
+    void (*pipeline_draw_indirect)(struct pipeline *s, struct buffer *indirect, int nb_draws);
+    void (*pipeline_draw_indexed_indirect)(struct pipeline *s, struct buffer *indices, int indices_format, struct buffer *indirect, int nb_draws);
     void (*pipeline_dispatch)(struct pipeline *s, int nb_group_x, int nb_group_y, int nb_group_z);
     void (*pipeline_freep)(struct pipeline **sp);
 
@@ -91,9 +103,12 @@ struct gctx_class {
 
     struct texture *(*texture_create)(struct gctx* ctx);
     int (*texture_init)(struct texture *s, const struct texture_params *params);
+    int (*texture_init_shared)(struct texture *s, const struct texture_params *params, const uint8_t *data); /* optional */
     int (*texture_has_mipmap)(const struct texture *s);
     int (*texture_match_dimensions)(const struct texture *s, int width, int height, int depth);
     int (*texture_upload)(struct texture *s, const uint8_t *data, int linesize);
+    int (*texture_upload_rect)(struct texture *s, const uint8_t *data, int linesize,
+                               int x, int y, int width, int height);
     int (*texture_generate_mipmap)(struct texture *s);
     void (*texture_freep)(struct texture **sp);
 };
@@ -105,6 +120,10 @@ struct gctx {
     int features;
     struct limits limits;
     struct pgcache pgcache;
+    struct memtrack memtrack;
+    struct cmdbuffer cmdbuffer;
+    struct sharegroup *sharegroup;
+    int timer_active;
 };
 
 struct gctx *ngli_gctx_create(struct ngl_ctx *ctx);
@@ -113,6 +132,11 @@ int ngli_gctx_resize(struct gctx *s, int width, int height, const int *viewport)
 int ngli_gctx_draw(struct gctx *s, double t);
 void ngli_gctx_freep(struct gctx **sp);
 
+void ngli_gctx_reset_counters(struct gctx *s);
+void ngli_gctx_get_counters(struct gctx *s, struct ngl_stats *stats);
+char *ngli_gctx_export_api_calls(struct gctx *s);
+char *ngli_gctx_export_memory(struct gctx *s);
+
 void ngli_gctx_set_rendertarget(struct gctx *s, struct rendertarget *rt);
 struct rendertarget *ngli_gctx_get_rendertarget(struct gctx *s);
 
@@ -350,7 +350,22 @@ static int gl_init(struct gctx *s)
     const struct ngl_config *config = &ctx->config;
     struct gctx_gl *s_priv = (struct gctx_gl *)s;
 
-    s_priv->glcontext = ngli_glcontext_new(config);
+    struct ngl_config glcontext_config = *config;
+    if (config->share_ctx) {
+        if (config->handle) {
+            LOG(ERROR, "handle and share_ctx can not be set at the same time");
+            return NGL_ERROR_INVALID_ARG;
+        }
+
+        /* Create the OpenGL context in the share group of the share context */
+        const struct gctx_gl *share_gctx_gl = (struct gctx_gl *)config->share_ctx->gctx;
+        struct glcontext *share_gl = share_gctx_gl->glcontext;
+        if (!glcontext_config.display)
+            glcontext_config.display = ngli_glcontext_get_display(share_gl);
+        glcontext_config.handle = ngli_glcontext_get_handle(share_gl);
+    }
+
+    s_priv->glcontext = ngli_glcontext_new(&glcontext_config);
     if (!s_priv->glcontext)
         return NGL_ERROR_MEMORY;
 
@@ -451,8 +466,13 @@ static int gl_post_draw(struct gctx *s, double t)
 
     ngli_glstate_update(s, &ctx->graphicstate);
 
-    if (s_priv->capture_func)
+    if (s_priv->capture_func) {
+        struct profiler *profiler = &ctx->profiler;
+        const int64_t start = profiler->enabled ? ngli_profiler_begin(profiler, NGLI_PROFILER_PHASE_CAPTURE) : 0;
         s_priv->capture_func(s);
+        if (profiler->enabled)
+            ngli_profiler_end(profiler, NGLI_PROFILER_PHASE_CAPTURE, start, "capture", s->class->name);
+    }
 
     int ret = 0;
     if (ngli_glcontext_check_gl_error(gl, __FUNCTION__))
@@ -478,6 +498,34 @@ static void gl_destroy(struct gctx *s)
     ngli_glcontext_freep(&s_priv->glcontext);
 }
 
+static void gl_reset_counters(struct gctx *s)
+{
+    struct gctx_gl *s_priv = (struct gctx_gl *)s;
+    ngli_glcontext_reset_counters(s_priv->glcontext);
+}
+
+static void gl_get_counters(struct gctx *s, struct ngl_stats *stats)
+{
+    struct gctx_gl *s_priv = (struct gctx_gl *)s;
+    const struct glcontext *gl = s_priv->glcontext;
+    const struct glcounters *counters = gl->counters;
+
+    stats->nb_api_calls        = ngli_glcontext_get_nb_calls(gl, 0);
+    stats->nb_state_changes    = ngli_glcontext_get_nb_calls(gl, NGLI_GLFUNC_FLAG_STATE);
+    stats->nb_draw_calls       = ngli_glcontext_get_nb_calls(gl, NGLI_GLFUNC_FLAG_DRAW);
+    stats->nb_dispatch_calls   = ngli_glcontext_get_nb_calls(gl, NGLI_GLFUNC_FLAG_DISPATCH);
+    stats->buffer_upload_size  = counters->buffer_upload_size;
+    stats->texture_upload_size = counters->texture_upload_size;
+    stats->nb_memory_barriers  = counters->calls[NGLI_GLFUNC_MemoryBarrier];
+    stats->nb_elided_memory_barriers = counters->elided_memory_barriers;
+}
+
+static char *gl_export_api_calls(struct gctx *s)
+{
+    struct gctx_gl *s_priv = (struct gctx_gl *)s;
+    return ngli_glcontext_export_calls(s_priv->glcontext);
+}
+
 static void gl_set_rendertarget(struct gctx *s, struct rendertarget *rt)
 {
     struct gctx_gl *s_priv = (struct gctx_gl *)s;
@@ -486,6 +534,9 @@ static void gl_set_rendertarget(struct gctx *s, struct rendertarget *rt)
     if (rt == s_priv->rendertarget)
         return;
 
+    ngli_memorybarrier_gl_require_rendertarget(&s_priv->memorybarrier, gl, rt);
+    ngli_memorybarrier_gl_flush(&s_priv->memorybarrier, gl);
+
     struct rendertarget_gl *rt_gl = (struct rendertarget_gl *)rt;
     const GLuint fbo_id = rt_gl ? rt_gl->id : ngli_glcontext_get_default_framebuffer(gl);
     ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, fbo_id);
@@ -602,6 +653,10 @@ const struct gctx_class ngli_gctx_gl = {
     .post_draw    = gl_post_draw,
     .destroy      = gl_destroy,
 
+    .reset_counters   = gl_reset_counters,
+    .get_counters     = gl_get_counters,
+    .export_api_calls = gl_export_api_calls,
+
     .set_rendertarget         = gl_set_rendertarget,
     .get_rendertarget         = gl_get_rendertarget,
     .set_viewport             = gl_set_viewport,
@@ -618,7 +673,9 @@ const struct gctx_class ngli_gctx_gl = {
 
     .buffer_create = ngli_buffer_gl_create,
     .buffer_init   = ngli_buffer_gl_init,
+    .buffer_init_shared = ngli_buffer_gl_init_shared,
     .buffer_upload = ngli_buffer_gl_upload,
+    .buffer_upload_range = ngli_buffer_gl_upload_range,
     .buffer_freep  = ngli_buffer_gl_freep,
 
     .gtimer_create = ngli_gtimer_gl_create,
@@ -626,6 +683,7 @@ const struct gctx_class ngli_gctx_gl = {
     .gtimer_start  = ngli_gtimer_gl_start,
     .gtimer_stop   = ngli_gtimer_gl_stop,
     .gtimer_read   = ngli_gtimer_gl_read,
+    .gtimer_poll   = ngli_gtimer_gl_poll,
     .gtimer_freep  = ngli_gtimer_gl_freep,
 
     .pipeline_create         = ngli_pipeline_gl_create,
@@ -635,6 +693,8 @@ const struct gctx_class ngli_gctx_gl = {
     .pipeline_update_texture = ngli_pipeline_gl_update_texture,
     .pipeline_draw           = ngli_pipeline_gl_draw,
     .pipeline_draw_indexed   = ngli_pipeline_gl_draw_indexed,
+    .pipeline_draw_indirect  = ngli_pipeline_gl_draw_indirect,
+    .pipeline_draw_indexed_indirect = ngli_pipeline_gl_draw_indexed_indirect,
     .pipeline_dispatch       = ngli_pipeline_gl_dispatch,
     .pipeline_freep          = ngli_pipeline_gl_freep,
 
@@ -651,9 +711,11 @@ const struct gctx_class ngli_gctx_gl = {
 
     .texture_create           = ngli_texture_gl_create,
     .texture_init             = ngli_texture_gl_init,
+    .texture_init_shared      = ngli_texture_gl_init_shared,
     .texture_has_mipmap       = ngli_texture_gl_has_mipmap,
     .texture_match_dimensions = ngli_texture_gl_match_dimensions,
     .texture_upload           = ngli_texture_gl_upload,
+    .texture_upload_rect      = ngli_texture_gl_upload_rect,
     .texture_generate_mipmap  = ngli_texture_gl_generate_mipmap,
     .texture_freep            = ngli_texture_gl_freep,
 };
@@ -667,6 +729,10 @@ const struct gctx_class ngli_gctx_gles = {
     .post_draw    = gl_post_draw,
     .destroy      = gl_destroy,
 
+    .reset_counters   = gl_reset_counters,
+    .get_counters     = gl_get_counters,
+    .export_api_calls = gl_export_api_calls,
+
     .set_rendertarget         = gl_set_rendertarget,
     .get_rendertarget         = gl_get_rendertarget,
     .set_viewport             = gl_set_viewport,
@@ -683,7 +749,9 @@ const struct gctx_class ngli_gctx_gles = {
 
     .buffer_create = ngli_buffer_gl_create,
     .buffer_init   = ngli_buffer_gl_init,
+    .buffer_init_shared = ngli_buffer_gl_init_shared,
     .buffer_upload = ngli_buffer_gl_upload,
+    .buffer_upload_range = ngli_buffer_gl_upload_range,
     .buffer_freep  = ngli_buffer_gl_freep,
 
     .gtimer_create = ngli_gtimer_gl_create,
@@ -691,6 +759,7 @@ const struct gctx_class ngli_gctx_gles = {
     .gtimer_start  = ngli_gtimer_gl_start,
     .gtimer_stop   = ngli_gtimer_gl_stop,
     .gtimer_read   = ngli_gtimer_gl_read,
+    .gtimer_poll   = ngli_gtimer_gl_poll,
     .gtimer_freep  = ngli_gtimer_gl_freep,
 
     .pipeline_create         = ngli_pipeline_gl_create,
@@ -700,6 +769,8 @@ const struct gctx_class ngli_gctx_gles = {
     .pipeline_update_texture = ngli_pipeline_gl_update_texture,
     .pipeline_draw           = ngli_pipeline_gl_draw,
     .pipeline_draw_indexed   = ngli_pipeline_gl_draw_indexed,
+    .pipeline_draw_indirect  = ngli_pipeline_gl_draw_indirect,
+    .pipeline_draw_indexed_indirect = ngli_pipeline_gl_draw_indexed_indirect,
     .pipeline_dispatch       = ngli_pipeline_gl_dispatch,
     .pipeline_freep          = ngli_pipeline_gl_freep,
 
@@ -716,9 +787,11 @@ const struct gctx_class ngli_gctx_gles = {
 
     .texture_create           = ngli_texture_gl_create,
     .texture_init             = ngli_texture_gl_init,
+    .texture_init_shared      = ngli_texture_gl_init_shared,
     .texture_has_mipmap       = ngli_texture_gl_has_mipmap,
     .texture_match_dimensions = ngli_texture_gl_match_dimensions,
     .texture_upload           = ngli_texture_gl_upload,
+    .texture_upload_rect      = ngli_texture_gl_upload_rect,
     .texture_generate_mipmap  = ngli_texture_gl_generate_mipmap,
     .texture_freep            = ngli_texture_gl_freep,
 };
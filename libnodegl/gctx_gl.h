@@ -33,6 +33,7 @@
 #include "pgcache.h"
 #include "pipeline.h"
 #include "gtimer.h"
+#include "memorybarrier_gl.h"
 #include "gctx.h"
 
 struct ngl_ctx;
@@ -49,7 +50,7 @@ struct gctx_gl {
     int viewport[4];
     int scissor[4];
     float clear_color[4];
-    int timer_active;
+    struct memorybarrier_gl memorybarrier;
     /* Offscreen render target */
     struct rendertarget *rt;
     struct texture *rt_color;
@@ -0,0 +1,411 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "buffer_null.h"
+#include "format.h"
+#include "gctx.h"
+#include "gctx_null.h"
+#include "gtimer_null.h"
+#include "log.h"
+#include "memory.h"
+#include "nodes.h"
+#include "pipeline_null.h"
+#include "program_null.h"
+#include "rendertarget_null.h"
+#include "texture_null.h"
+
+static const char * const cmd_names[NGLI_CMD_NULL_NB] = {
+    [NGLI_CMD_NULL_SET_RENDERTARGET]         = "set_rendertarget",
+    [NGLI_CMD_NULL_SET_VIEWPORT]             = "set_viewport",
+    [NGLI_CMD_NULL_SET_SCISSOR]              = "set_scissor",
+    [NGLI_CMD_NULL_CLEAR_COLOR]              = "clear_color",
+    [NGLI_CMD_NULL_CLEAR_DEPTH_STENCIL]      = "clear_depth_stencil",
+    [NGLI_CMD_NULL_INVALIDATE_DEPTH_STENCIL] = "invalidate_depth_stencil",
+    [NGLI_CMD_NULL_BUFFER_UPLOAD]            = "buffer_upload",
+    [NGLI_CMD_NULL_TEXTURE_UPLOAD]           = "texture_upload",
+    [NGLI_CMD_NULL_TEXTURE_GENERATE_MIPMAP]  = "texture_generate_mipmap",
+    [NGLI_CMD_NULL_PIPELINE_UPDATE_ATTRIBUTE] = "pipeline_update_attribute",
+    [NGLI_CMD_NULL_PIPELINE_UPDATE_UNIFORM]  = "pipeline_update_uniform",
+    [NGLI_CMD_NULL_PIPELINE_UPDATE_TEXTURE]  = "pipeline_update_texture",
+    [NGLI_CMD_NULL_DRAW]                     = "draw",
+    [NGLI_CMD_NULL_DRAW_INDEXED]             = "draw_indexed",
+    [NGLI_CMD_NULL_DRAW_INDIRECT]            = "draw_indirect",
+    [NGLI_CMD_NULL_DRAW_INDEXED_INDIRECT]    = "draw_indexed_indirect",
+    [NGLI_CMD_NULL_DISPATCH]                 = "dispatch",
+    [NGLI_CMD_NULL_RENDERTARGET_BLIT]        = "rendertarget_blit",
+    [NGLI_CMD_NULL_RENDERTARGET_RESOLVE]     = "rendertarget_resolve",
+    [NGLI_CMD_NULL_RENDERTARGET_READ_PIXELS] = "rendertarget_read_pixels",
+};
+
+const char *ngli_gctx_null_get_cmd_name(int type)
+{
+    ngli_assert(type >= 0 && type < NGLI_CMD_NULL_NB);
+    return cmd_names[type];
+}
+
+void ngli_gctx_null_record(struct gctx *s, const struct cmd_null *cmd)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+
+    s_priv->nb_cmds[cmd->type]++;
+    if (cmd->type == NGLI_CMD_NULL_BUFFER_UPLOAD)
+        s_priv->buffer_upload_size += cmd->args[0];
+    else if (cmd->type == NGLI_CMD_NULL_TEXTURE_UPLOAD)
+        s_priv->texture_upload_size += cmd->args[0];
+
+    if (!ngli_darray_push(&s_priv->cmds, cmd))
+        LOG(ERROR, "unable to record %s command", cmd_names[cmd->type]);
+}
+
+static struct gctx *null_create(struct ngl_ctx *ctx)
+{
+    struct gctx_null *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    return (struct gctx *)s;
+}
+
+static int null_init(struct gctx *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    const struct ngl_config *config = &ctx->config;
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+
+    ngli_darray_init(&s_priv->cmds, sizeof(struct cmd_null), 0);
+
+    /* The null backend advertises the capabilities of a desktop OpenGL 4.5 context */
+    s->version = 450;
+    s->features = NGLI_FEATURE_VERTEX_ARRAY_OBJECT
+                | NGLI_FEATURE_TEXTURE_3D
+                | NGLI_FEATURE_TEXTURE_STORAGE
+                | NGLI_FEATURE_COMPUTE_SHADER_ALL
+                | NGLI_FEATURE_FRAMEBUFFER_OBJECT
+                | NGLI_FEATURE_PACKED_DEPTH_STENCIL
+                | NGLI_FEATURE_TIMER_QUERY
+                | NGLI_FEATURE_DRAW_INSTANCED
+                | NGLI_FEATURE_INSTANCED_ARRAY
+                | NGLI_FEATURE_UNIFORM_BUFFER_OBJECT
+                | NGLI_FEATURE_INVALIDATE_SUBDATA
+                | NGLI_FEATURE_DEPTH_TEXTURE
+                | NGLI_FEATURE_RGB8_RGBA8
+                | NGLI_FEATURE_SYNC
+                | NGLI_FEATURE_TEXTURE_NPOT
+                | NGLI_FEATURE_TEXTURE_CUBE_MAP
+                | NGLI_FEATURE_DRAW_BUFFERS
+                | NGLI_FEATURE_ROW_LENGTH
+                | NGLI_FEATURE_UINT_UNIFORMS
+                | NGLI_FEATURE_MULTI_DRAW_INDIRECT;
+    s->limits = (struct limits){
+        .max_texture_image_units = 32,
+        .max_compute_work_group_counts = {65535, 65535, 65535},
+        .max_uniform_block_size = 65536,
+        .max_samples = 8,
+        .max_color_attachments = NGLI_MAX_COLOR_ATTACHMENTS,
+        .max_draw_buffers = NGLI_MAX_COLOR_ATTACHMENTS,
+    };
+
+    const int samples = NGLI_MIN(config->samples, s->limits.max_samples);
+    s_priv->default_rendertarget_desc.nb_colors = 1;
+    s_priv->default_rendertarget_desc.colors[0].format = NGLI_FORMAT_R8G8B8A8_UNORM;
+    s_priv->default_rendertarget_desc.colors[0].samples = samples;
+    s_priv->default_rendertarget_desc.colors[0].resolve = samples > 1;
+    s_priv->default_rendertarget_desc.depth_stencil.format = NGLI_FORMAT_D24_UNORM_S8_UINT;
+    s_priv->default_rendertarget_desc.depth_stencil.samples = samples;
+    s_priv->default_rendertarget_desc.depth_stencil.resolve = samples > 1;
+    ctx->rendertarget_desc = &s_priv->default_rendertarget_desc;
+
+    int ret = ngli_pgcache_init(&s->pgcache, s->ctx);
+    if (ret < 0)
+        return ret;
+
+    const int *viewport = config->viewport;
+    if (viewport[2] > 0 && viewport[3] > 0) {
+        ngli_gctx_set_viewport(s, viewport);
+    } else {
+        const int default_viewport[] = {0, 0, config->width, config->height};
+        ngli_gctx_set_viewport(s, default_viewport);
+    }
+
+    const int scissor[] = {0, 0, config->width, config->height};
+    ngli_gctx_set_scissor(s, scissor);
+
+    ngli_gctx_set_clear_color(s, config->clear_color);
+
+    struct graphicstate *graphicstate = &ctx->graphicstate;
+    ngli_graphicstate_init(graphicstate);
+
+    return 0;
+}
+
+static int null_resize(struct gctx *s, int width, int height, const int *viewport)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct ngl_config *config = &ctx->config;
+    if (config->offscreen)
+        return NGL_ERROR_INVALID_USAGE;
+
+    config->width = width;
+    config->height = height;
+
+    if (viewport && viewport[2] > 0 && viewport[3] > 0) {
+        ngli_gctx_set_viewport(s, viewport);
+    } else {
+        const int default_viewport[] = {0, 0, width, height};
+        ngli_gctx_set_viewport(s, default_viewport);
+    }
+
+    const int scissor[] = {0, 0, width, height};
+    ngli_gctx_set_scissor(s, scissor);
+
+    return 0;
+}
+
+static int null_pre_draw(struct gctx *s, double t)
+{
+    ngli_gctx_clear_color(s);
+    ngli_gctx_clear_depth_stencil(s);
+
+    return 0;
+}
+
+static int null_post_draw(struct gctx *s, double t)
+{
+    return 0;
+}
+
+static void null_destroy(struct gctx *s)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    ngli_pgcache_reset(&s->pgcache);
+    ngli_darray_reset(&s_priv->cmds);
+}
+
+static void null_reset_counters(struct gctx *s)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    s_priv->cmds.count = 0;
+    memset(s_priv->nb_cmds, 0, sizeof(s_priv->nb_cmds));
+    s_priv->buffer_upload_size = 0;
+    s_priv->texture_upload_size = 0;
+}
+
+static void null_get_counters(struct gctx *s, struct ngl_stats *stats)
+{
+    const struct gctx_null *s_priv = (struct gctx_null *)s;
+    const int64_t *nb_cmds = s_priv->nb_cmds;
+
+    stats->nb_api_calls        = ngli_darray_count(&s_priv->cmds);
+    stats->nb_state_changes    = nb_cmds[NGLI_CMD_NULL_SET_RENDERTARGET]
+                               + nb_cmds[NGLI_CMD_NULL_SET_VIEWPORT]
+                               + nb_cmds[NGLI_CMD_NULL_SET_SCISSOR];
+    stats->nb_draw_calls       = nb_cmds[NGLI_CMD_NULL_DRAW]
+                               + nb_cmds[NGLI_CMD_NULL_DRAW_INDEXED]
+                               + nb_cmds[NGLI_CMD_NULL_DRAW_INDIRECT]
+                               + nb_cmds[NGLI_CMD_NULL_DRAW_INDEXED_INDIRECT];
+    stats->nb_dispatch_calls   = nb_cmds[NGLI_CMD_NULL_DISPATCH];
+    stats->buffer_upload_size  = s_priv->buffer_upload_size;
+    stats->texture_upload_size = s_priv->texture_upload_size;
+    stats->nb_memory_barriers  = 0;
+    stats->nb_elided_memory_barriers = 0;
+}
+
+static char *null_export_api_calls(struct gctx *s)
+{
+    const struct gctx_null *s_priv = (struct gctx_null *)s;
+
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    ngli_bstr_print(b, "function,calls\n");
+    for (int i = 0; i < NGLI_CMD_NULL_NB; i++) {
+        const int64_t nb_calls = s_priv->nb_cmds[i];
+        if (nb_calls)
+            ngli_bstr_printf(b, "%s,%" PRId64 "\n", cmd_names[i], nb_calls);
+    }
+
+    char *str = ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return str;
+}
+
+static void null_set_rendertarget(struct gctx *s, struct rendertarget *rt)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    if (rt == s_priv->rendertarget)
+        return;
+    ngli_gctx_null_record(s, &(struct cmd_null){.type = NGLI_CMD_NULL_SET_RENDERTARGET, .object = rt});
+    s_priv->rendertarget = rt;
+}
+
+static struct rendertarget *null_get_rendertarget(struct gctx *s)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    return s_priv->rendertarget;
+}
+
+static void null_set_viewport(struct gctx *s, const int *viewport)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    struct cmd_null cmd = {.type = NGLI_CMD_NULL_SET_VIEWPORT};
+    memcpy(cmd.args, viewport, sizeof(cmd.args));
+    ngli_gctx_null_record(s, &cmd);
+    memcpy(&s_priv->viewport, viewport, sizeof(s_priv->viewport));
+}
+
+static void null_get_viewport(struct gctx *s, int *viewport)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    memcpy(viewport, &s_priv->viewport, sizeof(s_priv->viewport));
+}
+
+static void null_set_scissor(struct gctx *s, const int *scissor)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    struct cmd_null cmd = {.type = NGLI_CMD_NULL_SET_SCISSOR};
+    memcpy(cmd.args, scissor, sizeof(cmd.args));
+    ngli_gctx_null_record(s, &cmd);
+    memcpy(&s_priv->scissor, scissor, sizeof(s_priv->scissor));
+}
+
+static void null_get_scissor(struct gctx *s, int *scissor)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    memcpy(scissor, &s_priv->scissor, sizeof(s_priv->scissor));
+}
+
+static void null_set_clear_color(struct gctx *s, const float *color)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    memcpy(s_priv->clear_color, color, sizeof(s_priv->clear_color));
+}
+
+static void null_get_clear_color(struct gctx *s, float *color)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    memcpy(color, &s_priv->clear_color, sizeof(s_priv->clear_color));
+}
+
+static void null_clear_color(struct gctx *s)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    ngli_gctx_null_record(s, &(struct cmd_null){.type = NGLI_CMD_NULL_CLEAR_COLOR, .object = s_priv->rendertarget});
+}
+
+static void null_clear_depth_stencil(struct gctx *s)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    ngli_gctx_null_record(s, &(struct cmd_null){.type = NGLI_CMD_NULL_CLEAR_DEPTH_STENCIL, .object = s_priv->rendertarget});
+}
+
+static void null_invalidate_depth_stencil(struct gctx *s)
+{
+    struct gctx_null *s_priv = (struct gctx_null *)s;
+    ngli_gctx_null_record(s, &(struct cmd_null){.type = NGLI_CMD_NULL_INVALIDATE_DEPTH_STENCIL, .object = s_priv->rendertarget});
+}
+
+static int null_get_preferred_depth_format(struct gctx *s)
+{
+    return NGLI_FORMAT_D16_UNORM;
+}
+
+static int null_get_preferred_depth_stencil_format(struct gctx *s)
+{
+    return NGLI_FORMAT_D24_UNORM_S8_UINT;
+}
+
+const struct gctx_class ngli_gctx_null = {
+    .name         = "Null",
+    .create       = null_create,
+    .init         = null_init,
+    .resize       = null_resize,
+    .pre_draw     = null_pre_draw,
+    .post_draw    = null_post_draw,
+    .destroy      = null_destroy,
+
+    .reset_counters   = null_reset_counters,
+    .get_counters     = null_get_counters,
+    .export_api_calls = null_export_api_calls,
+
+    .set_rendertarget         = null_set_rendertarget,
+    .get_rendertarget         = null_get_rendertarget,
+    .set_viewport             = null_set_viewport,
+    .get_viewport             = null_get_viewport,
+    .set_scissor              = null_set_scissor,
+    .get_scissor              = null_get_scissor,
+    .set_clear_color          = null_set_clear_color,
+    .get_clear_color          = null_get_clear_color,
+    .clear_color              = null_clear_color,
+    .clear_depth_stencil      = null_clear_depth_stencil,
+    .invalidate_depth_stencil = null_invalidate_depth_stencil,
+    .get_preferred_depth_format = null_get_preferred_depth_format,
+    .get_preferred_depth_stencil_format = null_get_preferred_depth_stencil_format,
+
+    .buffer_create = ngli_buffer_null_create,
+    .buffer_init   = ngli_buffer_null_init,
+    .buffer_upload = ngli_buffer_null_upload,
+    .buffer_upload_range = ngli_buffer_null_upload_range,
+    .buffer_freep  = ngli_buffer_null_freep,
+
+    .gtimer_create = ngli_gtimer_null_create,
+    .gtimer_init   = ngli_gtimer_null_init,
+    .gtimer_start  = ngli_gtimer_null_start,
+    .gtimer_stop   = ngli_gtimer_null_stop,
+    .gtimer_read   = ngli_gtimer_null_read,
+    .gtimer_poll   = ngli_gtimer_null_poll,
+    .gtimer_freep  = ngli_gtimer_null_freep,
+
+    .pipeline_create         = ngli_pipeline_null_create,
+    .pipeline_init           = ngli_pipeline_null_init,
+    .pipeline_update_attribute = ngli_pipeline_null_update_attribute,
+    .pipeline_update_uniform = ngli_pipeline_null_update_uniform,
+    .pipeline_update_texture = ngli_pipeline_null_update_texture,
+    .pipeline_draw           = ngli_pipeline_null_draw,
+    .pipeline_draw_indexed   = ngli_pipeline_null_draw_indexed,
+    .pipeline_draw_indirect  = ngli_pipeline_null_draw_indirect,
+    .pipeline_draw_indexed_indirect = ngli_pipeline_null_draw_indexed_indirect,
+    .pipeline_dispatch       = ngli_pipeline_null_dispatch,
+    .pipeline_freep          = ngli_pipeline_null_freep,
+
+    .program_create = ngli_program_null_create,
+    .program_init   = ngli_program_null_init,
+    .program_freep  = ngli_program_null_freep,
+
+    .rendertarget_create      = ngli_rendertarget_null_create,
+    .rendertarget_init        = ngli_rendertarget_null_init,
+    .rendertarget_blit        = ngli_rendertarget_null_blit,
+    .rendertarget_resolve     = ngli_rendertarget_null_resolve,
+    .rendertarget_read_pixels = ngli_rendertarget_null_read_pixels,
+    .rendertarget_freep       = ngli_rendertarget_null_freep,
+
+    .texture_create           = ngli_texture_null_create,
+    .texture_init             = ngli_texture_null_init,
+    .texture_has_mipmap       = ngli_texture_null_has_mipmap,
+    .texture_match_dimensions = ngli_texture_null_match_dimensions,
+    .texture_upload           = ngli_texture_null_upload,
+    .texture_upload_rect      = ngli_texture_null_upload_rect,
+    .texture_generate_mipmap  = ngli_texture_null_generate_mipmap,
+    .texture_freep            = ngli_texture_null_freep,
+};
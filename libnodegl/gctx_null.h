@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GCTX_NULL_H
+#define GCTX_NULL_H
+
+#include <stdint.h>
+
+#include "darray.h"
+#include "gctx.h"
+#include "rendertarget.h"
+
+/*
+ * The null backend implements the graphics context without any GPU: every
+ * object is a plain CPU structure and the operations are only recorded into
+ * a command list, which is reset with the counters at the beginning of each
+ * frame. It allows measuring and testing the CPU side of the library
+ * (traversal, update, submission) in isolation.
+ */
+
+enum {
+    NGLI_CMD_NULL_SET_RENDERTARGET,
+    NGLI_CMD_NULL_SET_VIEWPORT,
+    NGLI_CMD_NULL_SET_SCISSOR,
+    NGLI_CMD_NULL_CLEAR_COLOR,
+    NGLI_CMD_NULL_CLEAR_DEPTH_STENCIL,
+    NGLI_CMD_NULL_INVALIDATE_DEPTH_STENCIL,
+    NGLI_CMD_NULL_BUFFER_UPLOAD,
+    NGLI_CMD_NULL_TEXTURE_UPLOAD,
+    NGLI_CMD_NULL_TEXTURE_GENERATE_MIPMAP,
+    NGLI_CMD_NULL_PIPELINE_UPDATE_ATTRIBUTE,
+    NGLI_CMD_NULL_PIPELINE_UPDATE_UNIFORM,
+    NGLI_CMD_NULL_PIPELINE_UPDATE_TEXTURE,
+    NGLI_CMD_NULL_DRAW,
+    NGLI_CMD_NULL_DRAW_INDEXED,
+    NGLI_CMD_NULL_DRAW_INDIRECT,
+    NGLI_CMD_NULL_DRAW_INDEXED_INDIRECT,
+    NGLI_CMD_NULL_DISPATCH,
+    NGLI_CMD_NULL_RENDERTARGET_BLIT,
+    NGLI_CMD_NULL_RENDERTARGET_RESOLVE,
+    NGLI_CMD_NULL_RENDERTARGET_READ_PIXELS,
+    NGLI_CMD_NULL_NB
+};
+
+struct cmd_null {
+    int type;           /* any of NGLI_CMD_NULL_* */
+    const void *object; /* buffer, texture, pipeline or rendertarget the command applies to */
+    int args[4];        /* command specific arguments (sizes, counts, rectangle, ...) */
+};
+
+struct gctx_null {
+    struct gctx parent;
+    struct darray cmds; /* struct cmd_null */
+    int64_t nb_cmds[NGLI_CMD_NULL_NB];
+    int64_t buffer_upload_size;
+    int64_t texture_upload_size;
+    struct rendertarget *rendertarget;
+    struct rendertarget_desc default_rendertarget_desc;
+    int viewport[4];
+    int scissor[4];
+    float clear_color[4];
+};
+
+void ngli_gctx_null_record(struct gctx *s, const struct cmd_null *cmd);
+const char *ngli_gctx_null_get_cmd_name(int type);
+
+#endif
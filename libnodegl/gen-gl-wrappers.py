@@ -85,6 +85,10 @@ cmds_optional = [
     'glDrawElementsInstanced',
     'glVertexAttribDivisor',
 
+    # Multi-draw indirect
+    'glMultiDrawArraysIndirect',
+    'glMultiDrawElementsIndirect',
+
     # Uniform Block Object
     'glGetUniformBlockIndex',
     'glUniformBlockBinding',
@@ -248,6 +252,82 @@ cmds = [
 
 ] + cmds_optional
 
+# Functions accounted in the per-frame counters categories (see glcontext.h)
+cmds_state = [
+    'glActiveTexture',
+    'glBindBuffer',
+    'glBindBufferBase',
+    'glBindBufferRange',
+    'glBindFramebuffer',
+    'glBindImageTexture',
+    'glBindRenderbuffer',
+    'glBindTexture',
+    'glBindVertexArray',
+    'glBlendColor',
+    'glBlendEquation',
+    'glBlendEquationSeparate',
+    'glBlendFunc',
+    'glBlendFuncSeparate',
+    'glClearColor',
+    'glColorMask',
+    'glCullFace',
+    'glDepthFunc',
+    'glDepthMask',
+    'glDisable',
+    'glDisableVertexAttribArray',
+    'glDrawBuffer',
+    'glDrawBuffers',
+    'glEnable',
+    'glEnableVertexAttribArray',
+    'glPixelStorei',
+    'glPolygonMode',
+    'glReadBuffer',
+    'glScissor',
+    'glStencilFunc',
+    'glStencilFuncSeparate',
+    'glStencilMask',
+    'glStencilMaskSeparate',
+    'glStencilOp',
+    'glStencilOpSeparate',
+    'glUseProgram',
+    'glVertexAttribDivisor',
+    'glVertexAttribPointer',
+    'glViewport',
+]
+
+cmds_draw = [
+    'glDrawArrays',
+    'glDrawArraysInstanced',
+    'glDrawElements',
+    'glDrawElementsInstanced',
+    'glMultiDrawArraysIndirect',
+    'glMultiDrawElementsIndirect',
+]
+
+cmds_dispatch = [
+    'glDispatchCompute',
+]
+
+# Amount of data transferred by the upload functions
+_pixels_size = 'pixels ? ngli_glcontext_get_pixels_size(format, type, width, height, %s) : 0'
+cmds_upload_size = {
+    'glBufferData':    ('buffer_upload_size', 'data ? size : 0'),
+    'glBufferSubData': ('buffer_upload_size', 'size'),
+    'glTexImage2D':    ('texture_upload_size', _pixels_size % '1'),
+    'glTexImage3D':    ('texture_upload_size', _pixels_size % 'depth'),
+    'glTexSubImage2D': ('texture_upload_size', _pixels_size % '1'),
+    'glTexSubImage3D': ('texture_upload_size', _pixels_size % 'depth'),
+}
+
+def get_counter_flags(funcname):
+    if funcname in cmds_state:
+        return 'NGLI_GLFUNC_FLAG_STATE'
+    if funcname in cmds_draw:
+        return 'NGLI_GLFUNC_FLAG_DRAW'
+    if funcname in cmds_dispatch:
+        return 'NGLI_GLFUNC_FLAG_DISPATCH'
+    return '0'
+
 def get_proto_elems(xml_node):
     elems = []
     for text in xml_node.itertext():
@@ -269,6 +349,9 @@ def gen(gl_xml):
 #else
 # define check_error_code(gl, glfuncname) do { } while (0)
 #endif
+
+#define count_call(gl, func) (gl)->counters->calls[NGLI_GLFUNC_##func]++
+#define count_size(gl, counter, size) (gl)->counters->counter += (size)
 '''
 
     glfunctions = do_not_edit + '''
@@ -284,6 +367,10 @@ def gen(gl_xml):
 #endif
 
 struct glfunctions {
+'''
+
+    glfunctions_ids = '''
+enum {
 '''
 
     gldefinitions = do_not_edit + '''
@@ -299,6 +386,7 @@ static const struct gldefinition {
     const char *name;
     size_t offset;
     int flags;
+    int counter_flags;
 } gldefinitions[] = {
 '''
 
@@ -339,14 +427,21 @@ static const struct gldefinition {
                 'func_args': ', '.join(func_args),
                 'ret_call': ret_call,
                 'flags': '0' if funcname in cmds_optional else 'M',
+                'counter_flags': get_counter_flags(funcname),
+                'count_size': '',
         }
 
+        if funcname in cmds_upload_size:
+            data['count_size'] = '    count_size(gl, %s, %s);\n' % cmds_upload_size[funcname]
+
         glfunctions   += '    NGLI_GL_APIENTRY %(func_ret)s (*%(func_name_nogl)s)(%(func_args_specs)s);\n' % data
-        gldefinitions += '    {"%(func_name)s", offsetof(struct glfunctions, %(func_name_nogl)s), %(flags)s},\n' % data
+        glfunctions_ids += '    NGLI_GLFUNC_%(func_name_nogl)s,\n' % data
+        gldefinitions += '    {"%(func_name)s", offsetof(struct glfunctions, %(func_name_nogl)s), %(flags)s, %(counter_flags)s},\n' % data
         if funcname == 'glGetError':
             glwrappers += '''
 static inline GLenum ngli_glGetError(const struct glcontext *gl)
 {
+    count_call(gl, GetError);
     return gl->funcs.GetError();
 }
 '''
@@ -354,7 +449,8 @@ static inline GLenum ngli_glGetError(const struct glcontext *gl)
             glwrappers    += '''
 static inline %(func_ret)s ngli_%(func_name)s(%(wrapper_args_specs)s)
 {
-    %(ret_assign)sgl->funcs.%(func_name_nogl)s(%(func_args)s);
+    count_call(gl, %(func_name_nogl)s);
+%(count_size)s    %(ret_assign)sgl->funcs.%(func_name_nogl)s(%(func_args)s);
     check_error_code(gl, "%(func_name)s");
 %(ret_call)s}
 ''' % data
@@ -366,7 +462,8 @@ static inline %(func_ret)s ngli_%(func_name)s(%(wrapper_args_specs)s)
     if cmds:
         print('WARNING: function(s) not found: ' + ', '.join(cmds))
 
-    glfunctions   += '};\n\n#endif\n'
+    glfunctions_ids += '    NGLI_GLFUNC_NB\n};\n'
+    glfunctions   += '};\n' + glfunctions_ids + '\n#endif\n'
     gldefinitions += '};\n'
 
     open('glfunctions.h', 'w').write(glfunctions)
@@ -0,0 +1,374 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "buffer.h"
+#include "gctx.h"
+#include "geompool.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+#define ARENA_SIZE      (64 * 1024)
+#define ARENA_ALIGNMENT 16
+
+struct geompool_entry {
+    uint64_t digest;
+    struct ngl_node *node;
+    int refcount;
+    int arena_id; /* -1 if the node owns its buffer */
+    int offset;
+    int size;
+};
+
+struct geompool_range {
+    int offset;
+    int size;
+};
+
+struct geompool_arena {
+    struct buffer *buffer;
+    int size;
+    int used;
+    int nb_allocs;
+    struct darray free_ranges; /* struct geompool_range, sorted by offset */
+};
+
+void ngli_geompool_init(struct geompool *s)
+{
+    ngli_darray_init(&s->entries, sizeof(struct geompool_entry), 0);
+    ngli_darray_init(&s->arenas, sizeof(struct geompool_arena), 0);
+}
+
+static uint64_t get_digest(int type, int count, int size, const void *data)
+{
+    const int header[] = {type, count, size};
+    uint64_t digest = NGLI_FNV1A_INIT;
+    digest = ngli_fnv1a(digest, header, sizeof(header));
+    return ngli_fnv1a(digest, data, size);
+}
+
+static int is_suballocatable(int type)
+{
+    switch (type) {
+    case NGL_NODE_BUFFERFLOAT:
+    case NGL_NODE_BUFFERVEC2:
+    case NGL_NODE_BUFFERVEC3:
+    case NGL_NODE_BUFFERVEC4:
+        return 1;
+    default:
+        /* Index buffers are always bound from their start */
+        return 0;
+    }
+}
+
+static int alloc_free_range(struct geompool_arena *arena, int size, int *offset)
+{
+    struct geompool_range *ranges = ngli_darray_data(&arena->free_ranges);
+    for (int i = 0; i < ngli_darray_count(&arena->free_ranges); i++) {
+        struct geompool_range *range = &ranges[i];
+        if (range->size < size)
+            continue;
+        *offset = range->offset;
+        range->offset += size;
+        range->size -= size;
+        if (!range->size)
+            ngli_darray_remove(&arena->free_ranges, i);
+        return 1;
+    }
+    return 0;
+}
+
+static int alloc_range(struct geompool *s, struct gctx *gctx, int size, int *offset)
+{
+    int free_id = -1;
+    struct geompool_arena *arenas = ngli_darray_data(&s->arenas);
+    for (int i = 0; i < ngli_darray_count(&s->arenas); i++) {
+        struct geompool_arena *arena = &arenas[i];
+        if (!arena->buffer) {
+            free_id = i;
+            continue;
+        }
+        if (alloc_free_range(arena, size, offset)) {
+            arena->nb_allocs++;
+            return i;
+        }
+        if (arena->size - arena->used >= size) {
+            *offset = arena->used;
+            arena->used += size;
+            arena->nb_allocs++;
+            return i;
+        }
+    }
+
+    struct geompool_arena *arena = free_id >= 0 ? &arenas[free_id] : ngli_darray_push(&s->arenas, NULL);
+    if (!arena)
+        return NGL_ERROR_MEMORY;
+    const int arena_id = free_id >= 0 ? free_id : ngli_darray_count(&s->arenas) - 1;
+    memset(arena, 0, sizeof(*arena));
+    ngli_darray_init(&arena->free_ranges, sizeof(struct geompool_range), 0);
+
+    /* Geometries larger than an arena get a dedicated one */
+    const int arena_size = NGLI_MAX(size, ARENA_SIZE);
+    arena->buffer = ngli_buffer_create(gctx);
+    if (!arena->buffer)
+        return NGL_ERROR_MEMORY;
+
+    /* An arena holds the geometries of many nodes so it is charged to the context */
+    struct ngl_ctx *ctx = gctx->ctx;
+    struct ngl_node *cur_node = ctx->cur_node;
+    ctx->cur_node = NULL;
+    int ret = ngli_buffer_init(arena->buffer, arena_size, NGLI_BUFFER_USAGE_STATIC);
+    ctx->cur_node = cur_node;
+    if (ret < 0) {
+        ngli_buffer_freep(&arena->buffer);
+        return ret;
+    }
+
+    arena->size = arena_size;
+    arena->used = size;
+    arena->nb_allocs = 1;
+    *offset = 0;
+    return arena_id;
+}
+
+static void reset_arena(struct geompool_arena *arena)
+{
+    ngli_buffer_freep(&arena->buffer);
+    ngli_darray_reset(&arena->free_ranges);
+    arena->size = 0;
+    arena->used = 0;
+}
+
+static int insert_free_range(struct geompool_arena *arena, int offset, int size)
+{
+    struct geompool_range *ranges = ngli_darray_data(&arena->free_ranges);
+    const int nb_ranges = ngli_darray_count(&arena->free_ranges);
+
+    int i = 0;
+    while (i < nb_ranges && ranges[i].offset < offset)
+        i++;
+
+    /* Merge with the neighbour ranges to limit the fragmentation */
+    struct geompool_range *prev = i > 0 ? &ranges[i - 1] : NULL;
+    struct geompool_range *next = i < nb_ranges ? &ranges[i] : NULL;
+    const int merge_prev = prev && prev->offset + prev->size == offset;
+    const int merge_next = next && offset + size == next->offset;
+    if (merge_prev && merge_next) {
+        prev->size += size + next->size;
+        ngli_darray_remove(&arena->free_ranges, i);
+    } else if (merge_prev) {
+        prev->size += size;
+    } else if (merge_next) {
+        next->offset = offset;
+        next->size += size;
+    } else {
+        const struct geompool_range range = {.offset = offset, .size = size};
+        if (!ngli_darray_push(&arena->free_ranges, &range))
+            return NGL_ERROR_MEMORY;
+        ranges = ngli_darray_data(&arena->free_ranges);
+        memmove(&ranges[i + 1], &ranges[i], (nb_ranges - i) * sizeof(*ranges));
+        ranges[i] = range;
+    }
+    return 0;
+}
+
+static void release_range(struct geompool *s, int arena_id, int offset, int size)
+{
+    struct geompool_arena *arena = ngli_darray_get(&s->arenas, arena_id);
+    ngli_assert(arena->nb_allocs > 0);
+
+    /* The arena is released once it does not hold any geometry anymore */
+    if (--arena->nb_allocs == 0) {
+        reset_arena(arena);
+        return;
+    }
+
+    /* A range at the end of the arena is given back to the tail */
+    if (offset + size == arena->used) {
+        arena->used = offset;
+    } else if (insert_free_range(arena, offset, size) < 0) {
+        /* Failing to track the range only wastes it until the arena is released */
+        return;
+    }
+
+    const int nb_ranges = ngli_darray_count(&arena->free_ranges);
+    struct geompool_range *last = ngli_darray_get(&arena->free_ranges, nb_ranges - 1);
+    if (last && last->offset + last->size == arena->used) {
+        arena->used = last->offset;
+        ngli_darray_pop(&arena->free_ranges);
+    }
+}
+
+static struct ngl_node *create_node(struct ngl_ctx *ctx, int type, int count, int size, const void *data)
+{
+    struct ngl_node *node = ngl_node_create(type);
+    if (!node)
+        return NULL;
+
+    int ret = ngl_node_param_set(node, "count", count);
+    if (ret < 0)
+        goto fail;
+
+    if (data) {
+        ret = ngl_node_param_set(node, "data", size, data);
+        if (ret < 0)
+            goto fail;
+    }
+
+    ret = ngli_node_attach_ctx(node, ctx);
+    if (ret < 0)
+        goto fail;
+
+    return node;
+
+fail:
+    ngli_node_detach_ctx(node, ctx);
+    ngl_node_unrefp(&node);
+    return NULL;
+}
+
+static int is_same_buffer(const struct ngl_node *node, int type, int count, int size, const void *data)
+{
+    const struct buffer_priv *buffer = node->priv_data;
+    return node->class->id == type &&
+           buffer->count == count &&
+           buffer->data_size == size &&
+           (!size || !memcmp(buffer->data, data, size));
+}
+
+struct ngl_node *ngli_geompool_ref(struct geompool *s, struct ngl_ctx *ctx,
+                                   int type, int count, int size, const void *data)
+{
+    const uint64_t digest = data ? get_digest(type, count, size, data) : 0;
+
+    struct geompool_entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; data && i < ngli_darray_count(&s->entries); i++) {
+        struct geompool_entry *entry = &entries[i];
+        if (entry->digest == digest && is_same_buffer(entry->node, type, count, size, data)) {
+            entry->refcount++;
+            return entry->node;
+        }
+    }
+
+    struct ngl_node *node = create_node(ctx, type, count, size, data);
+    if (!node)
+        return NULL;
+
+    struct geompool_entry entry = {
+        .digest   = digest,
+        .node     = node,
+        .refcount = 1,
+        .arena_id = -1,
+    };
+
+    /* Generated buffers without data are not shared */
+    if (data && is_suballocatable(type)) {
+        struct buffer_priv *buffer = node->priv_data;
+        int offset = 0;
+        const int range_size = NGLI_ALIGN(buffer->data_size, ARENA_ALIGNMENT);
+        int ret = alloc_range(s, ctx->gctx, range_size, &offset);
+        if (ret < 0)
+            goto fail;
+        entry.arena_id = ret;
+        entry.offset = offset;
+        entry.size = range_size;
+
+        struct geompool_arena *arena = ngli_darray_get(&s->arenas, entry.arena_id);
+        ret = ngli_buffer_upload_range(arena->buffer, buffer->data, offset, buffer->data_size);
+        if (ret < 0) {
+            release_range(s, entry.arena_id, entry.offset, entry.size);
+            goto fail;
+        }
+
+        /*
+         * The pool holds a reference on the node GPU buffer so it is never
+         * reallocated by ngli_node_buffer_ref()
+         */
+        buffer->buffer = arena->buffer;
+        buffer->buffer_offset = offset;
+        buffer->buffer_refcount = 1;
+    }
+
+    if (!ngli_darray_push(&s->entries, &entry)) {
+        if (entry.arena_id >= 0) {
+            struct buffer_priv *buffer = node->priv_data;
+            buffer->buffer = NULL;
+            buffer->buffer_refcount = 0;
+            release_range(s, entry.arena_id, entry.offset, entry.size);
+        }
+        goto fail;
+    }
+
+    return node;
+
+fail:
+    ngli_node_detach_ctx(node, ctx);
+    ngl_node_unrefp(&node);
+    return NULL;
+}
+
+void ngli_geompool_unref(struct geompool *s, struct ngl_node **nodep)
+{
+    struct ngl_node *node = *nodep;
+    if (!node)
+        return;
+    *nodep = NULL;
+
+    struct geompool_entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct geompool_entry *entry = &entries[i];
+        if (entry->node != node)
+            continue;
+
+        if (--entry->refcount)
+            return;
+
+        if (entry->arena_id >= 0) {
+            struct buffer_priv *buffer = node->priv_data;
+            ngli_assert(buffer->buffer_refcount == 1);
+            buffer->buffer = NULL;
+            buffer->buffer_offset = 0;
+            buffer->buffer_refcount = 0;
+            release_range(s, entry->arena_id, entry->offset, entry->size);
+        }
+        ngli_darray_remove(&s->entries, i);
+
+        ngli_node_detach_ctx(node, node->ctx);
+        ngl_node_unrefp(&node);
+        return;
+    }
+    ngli_assert(0);
+}
+
+void ngli_geompool_reset(struct geompool *s)
+{
+    ngli_assert(!ngli_darray_count(&s->entries));
+    ngli_darray_reset(&s->entries);
+
+    struct geompool_arena *arenas = ngli_darray_data(&s->arenas);
+    for (int i = 0; i < ngli_darray_count(&s->arenas); i++)
+        reset_arena(&arenas[i]);
+    ngli_darray_reset(&s->arenas);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GEOMPOOL_H
+#define GEOMPOOL_H
+
+#include <stdint.h>
+
+#include "darray.h"
+
+struct ngl_ctx;
+struct ngl_node;
+
+/*
+ * Pool of the buffer nodes generated by the built-in geometries (Quad,
+ * Triangle, Circle) of a context.
+ *
+ * Identical generated buffers are deduplicated by content, and the vertex
+ * data is suballocated from a few large static GPU buffers (arenas) instead
+ * of one small GPU buffer per node. A suballocated buffer node exposes its
+ * location in the arena through its buffer and buffer_offset fields. The
+ * ranges of the released geometries are recycled by the following
+ * allocations of the same arena.
+ */
+struct geompool {
+    struct darray entries; /* struct geompool_entry */
+    struct darray arenas;  /* struct geompool_arena */
+};
+
+void ngli_geompool_init(struct geompool *s);
+struct ngl_node *ngli_geompool_ref(struct geompool *s, struct ngl_ctx *ctx,
+                                   int type, int count, int size, const void *data);
+void ngli_geompool_unref(struct geompool *s, struct ngl_node **nodep);
+void ngli_geompool_reset(struct geompool *s);
+
+#endif
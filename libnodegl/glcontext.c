@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +44,7 @@ NGLI_STATIC_ASSERT(gubyte_size,  sizeof(GLubyte)  == sizeof(unsigned char));
 NGLI_STATIC_ASSERT(gushort_size, sizeof(GLushort) == sizeof(unsigned short));
 NGLI_STATIC_ASSERT(guint_size,   sizeof(GLuint)   == sizeof(unsigned int));
 NGLI_STATIC_ASSERT(gl_bool,      GL_FALSE == 0 && GL_TRUE == 1);
+NGLI_STATIC_ASSERT(gl_func_ids,  NGLI_ARRAY_NB(gldefinitions) == NGLI_GLFUNC_NB);
 
 enum {
     GLPLATFORM_EGL,
@@ -355,9 +357,16 @@ struct glcontext *ngli_glcontext_new(const struct ngl_config *config)
         return NULL;
     glcontext->class = glcontext_class_map[glplatform];
 
+    glcontext->counters = ngli_calloc(1, sizeof(*glcontext->counters));
+    if (!glcontext->counters) {
+        ngli_free(glcontext);
+        return NULL;
+    }
+
     if (glcontext->class->priv_size) {
         glcontext->priv_data = ngli_calloc(1, glcontext->class->priv_size);
         if (!glcontext->priv_data) {
+            ngli_free(glcontext->counters);
             ngli_free(glcontext);
             return NULL;
         }
@@ -457,6 +466,7 @@ void ngli_glcontext_freep(struct glcontext **glcontextp)
         glcontext->class->uninit(glcontext);
 
     ngli_free(glcontext->priv_data);
+    ngli_free(glcontext->counters);
     ngli_freep(glcontextp);
 }
 
@@ -569,3 +579,88 @@ int ngli_glcontext_check_gl_error(const struct glcontext *glcontext, const char
 
     return error;
 }
+
+static int get_nb_comp(GLenum format)
+{
+    switch (format) {
+    case GL_RED:
+    case GL_RED_INTEGER:
+    case GL_LUMINANCE:
+    case GL_DEPTH_COMPONENT:
+    case GL_STENCIL_INDEX:      return 1;
+    case GL_RG:
+    case GL_RG_INTEGER:
+    case GL_LUMINANCE_ALPHA:
+    case GL_DEPTH_STENCIL:      return 2;
+    case GL_RGB:
+    case GL_RGB_INTEGER:        return 3;
+    case GL_RGBA:
+    case GL_RGBA_INTEGER:
+    case GL_BGRA:
+    case GL_BGRA_INTEGER:       return 4;
+    default:                    return 0;
+    }
+}
+
+static int get_comp_size(GLenum type)
+{
+    switch (type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:      return 1;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:         return 2;
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT:              return 4;
+    default:                    return 0;
+    }
+}
+
+int64_t ngli_glcontext_get_pixels_size(GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei depth)
+{
+    int pixel_size;
+
+    /* Packed types hold all the components of a pixel */
+    if (type == GL_UNSIGNED_INT_24_8)
+        pixel_size = 4;
+    else if (type == GL_FLOAT_32_UNSIGNED_INT_24_8_REV)
+        pixel_size = 8;
+    else
+        pixel_size = get_nb_comp(format) * get_comp_size(type);
+
+    return (int64_t)pixel_size * width * height * depth;
+}
+
+void ngli_glcontext_reset_counters(struct glcontext *glcontext)
+{
+    memset(glcontext->counters, 0, sizeof(*glcontext->counters));
+}
+
+int64_t ngli_glcontext_get_nb_calls(const struct glcontext *glcontext, int flags)
+{
+    int64_t nb_calls = 0;
+    for (int i = 0; i < NGLI_GLFUNC_NB; i++) {
+        if (!flags || (gldefinitions[i].counter_flags & flags))
+            nb_calls += glcontext->counters->calls[i];
+    }
+    return nb_calls;
+}
+
+char *ngli_glcontext_export_calls(const struct glcontext *glcontext)
+{
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    ngli_bstr_print(b, "function,calls\n");
+    for (int i = 0; i < NGLI_GLFUNC_NB; i++) {
+        const int64_t nb_calls = glcontext->counters->calls[i];
+        if (nb_calls)
+            ngli_bstr_printf(b, "%s,%" PRId64 "\n", gldefinitions[i].name, nb_calls);
+    }
+
+    char *str = ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return str;
+}
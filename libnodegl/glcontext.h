@@ -31,6 +31,22 @@
 
 struct glcontext_class;
 
+/* Categories of the GL functions, used to aggregate the counters */
+#define NGLI_GLFUNC_FLAG_STATE    (1 << 0)
+#define NGLI_GLFUNC_FLAG_DRAW     (1 << 1)
+#define NGLI_GLFUNC_FLAG_DISPATCH (1 << 2)
+
+/*
+ * Counters updated by every ngli_gl*() wrapper; the pixels/bytes sizes do not
+ * take the unpack alignment and row length into account.
+ */
+struct glcounters {
+    int64_t calls[NGLI_GLFUNC_NB];
+    int64_t buffer_upload_size;
+    int64_t texture_upload_size;
+    int64_t elided_memory_barriers;
+};
+
 struct glcontext {
     /* GL context */
     const struct glcontext_class *class;
@@ -55,6 +71,10 @@ struct glcontext {
 
     /* GL functions */
     struct glfunctions funcs;
+
+    /* GL calls counters, allocated separately so they remain writable from
+     * the wrappers which only get a const context */
+    struct glcounters *counters;
 };
 
 struct glcontext_class {
@@ -88,6 +108,11 @@ void ngli_glcontext_freep(struct glcontext **glcontext);
 int ngli_glcontext_check_extension(const char *extension, const char *extensions);
 int ngli_glcontext_check_gl_error(const struct glcontext *glcontext, const char *context);
 
+int64_t ngli_glcontext_get_pixels_size(GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei depth);
+void ngli_glcontext_reset_counters(struct glcontext *glcontext);
+int64_t ngli_glcontext_get_nb_calls(const struct glcontext *glcontext, int flags);
+char *ngli_glcontext_export_calls(const struct glcontext *glcontext);
+
 #include "glwrappers.h"
 
 #endif /* GLCONTEXT_H */
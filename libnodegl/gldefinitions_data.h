@@ -12,151 +12,154 @@ static const struct gldefinition {
     const char *name;
     size_t offset;
     int flags;
+    int counter_flags;
 } gldefinitions[] = {
-    {"glActiveTexture", offsetof(struct glfunctions, ActiveTexture), M},
-    {"glAttachShader", offsetof(struct glfunctions, AttachShader), M},
-    {"glBeginQuery", offsetof(struct glfunctions, BeginQuery), 0},
-    {"glBeginQueryEXT", offsetof(struct glfunctions, BeginQueryEXT), 0},
-    {"glBindAttribLocation", offsetof(struct glfunctions, BindAttribLocation), M},
-    {"glBindBuffer", offsetof(struct glfunctions, BindBuffer), M},
-    {"glBindBufferBase", offsetof(struct glfunctions, BindBufferBase), 0},
-    {"glBindBufferRange", offsetof(struct glfunctions, BindBufferRange), 0},
-    {"glBindFramebuffer", offsetof(struct glfunctions, BindFramebuffer), M},
-    {"glBindImageTexture", offsetof(struct glfunctions, BindImageTexture), 0},
-    {"glBindRenderbuffer", offsetof(struct glfunctions, BindRenderbuffer), M},
-    {"glBindTexture", offsetof(struct glfunctions, BindTexture), M},
-    {"glBindVertexArray", offsetof(struct glfunctions, BindVertexArray), 0},
-    {"glBlendColor", offsetof(struct glfunctions, BlendColor), M},
-    {"glBlendEquation", offsetof(struct glfunctions, BlendEquation), M},
-    {"glBlendEquationSeparate", offsetof(struct glfunctions, BlendEquationSeparate), M},
-    {"glBlendFunc", offsetof(struct glfunctions, BlendFunc), M},
-    {"glBlendFuncSeparate", offsetof(struct glfunctions, BlendFuncSeparate), M},
-    {"glBlitFramebuffer", offsetof(struct glfunctions, BlitFramebuffer), 0},
-    {"glBufferData", offsetof(struct glfunctions, BufferData), M},
-    {"glBufferSubData", offsetof(struct glfunctions, BufferSubData), M},
-    {"glCheckFramebufferStatus", offsetof(struct glfunctions, CheckFramebufferStatus), M},
-    {"glClear", offsetof(struct glfunctions, Clear), M},
-    {"glClearColor", offsetof(struct glfunctions, ClearColor), M},
-    {"glClientWaitSync", offsetof(struct glfunctions, ClientWaitSync), 0},
-    {"glColorMask", offsetof(struct glfunctions, ColorMask), M},
-    {"glCompileShader", offsetof(struct glfunctions, CompileShader), M},
-    {"glCreateProgram", offsetof(struct glfunctions, CreateProgram), M},
-    {"glCreateShader", offsetof(struct glfunctions, CreateShader), M},
-    {"glCullFace", offsetof(struct glfunctions, CullFace), M},
-    {"glDeleteBuffers", offsetof(struct glfunctions, DeleteBuffers), M},
-    {"glDeleteFramebuffers", offsetof(struct glfunctions, DeleteFramebuffers), M},
-    {"glDeleteProgram", offsetof(struct glfunctions, DeleteProgram), M},
-    {"glDeleteQueries", offsetof(struct glfunctions, DeleteQueries), 0},
-    {"glDeleteQueriesEXT", offsetof(struct glfunctions, DeleteQueriesEXT), 0},
-    {"glDeleteRenderbuffers", offsetof(struct glfunctions, DeleteRenderbuffers), M},
-    {"glDeleteShader", offsetof(struct glfunctions, DeleteShader), M},
-    {"glDeleteTextures", offsetof(struct glfunctions, DeleteTextures), M},
-    {"glDeleteVertexArrays", offsetof(struct glfunctions, DeleteVertexArrays), 0},
-    {"glDepthFunc", offsetof(struct glfunctions, DepthFunc), M},
-    {"glDepthMask", offsetof(struct glfunctions, DepthMask), M},
-    {"glDetachShader", offsetof(struct glfunctions, DetachShader), M},
-    {"glDisable", offsetof(struct glfunctions, Disable), M},
-    {"glDisableVertexAttribArray", offsetof(struct glfunctions, DisableVertexAttribArray), M},
-    {"glDispatchCompute", offsetof(struct glfunctions, DispatchCompute), 0},
-    {"glDrawArrays", offsetof(struct glfunctions, DrawArrays), M},
-    {"glDrawArraysInstanced", offsetof(struct glfunctions, DrawArraysInstanced), 0},
-    {"glDrawBuffer", offsetof(struct glfunctions, DrawBuffer), 0},
-    {"glDrawBuffers", offsetof(struct glfunctions, DrawBuffers), 0},
-    {"glDrawElements", offsetof(struct glfunctions, DrawElements), M},
-    {"glDrawElementsInstanced", offsetof(struct glfunctions, DrawElementsInstanced), 0},
-    {"glEGLImageTargetTexture2DOES", offsetof(struct glfunctions, EGLImageTargetTexture2DOES), 0},
-    {"glEnable", offsetof(struct glfunctions, Enable), M},
-    {"glEnableVertexAttribArray", offsetof(struct glfunctions, EnableVertexAttribArray), M},
-    {"glEndQuery", offsetof(struct glfunctions, EndQuery), 0},
-    {"glEndQueryEXT", offsetof(struct glfunctions, EndQueryEXT), 0},
-    {"glFenceSync", offsetof(struct glfunctions, FenceSync), 0},
-    {"glFinish", offsetof(struct glfunctions, Finish), M},
-    {"glFlush", offsetof(struct glfunctions, Flush), M},
-    {"glFramebufferRenderbuffer", offsetof(struct glfunctions, FramebufferRenderbuffer), M},
-    {"glFramebufferTexture2D", offsetof(struct glfunctions, FramebufferTexture2D), M},
-    {"glGenBuffers", offsetof(struct glfunctions, GenBuffers), M},
-    {"glGenFramebuffers", offsetof(struct glfunctions, GenFramebuffers), M},
-    {"glGenQueries", offsetof(struct glfunctions, GenQueries), 0},
-    {"glGenQueriesEXT", offsetof(struct glfunctions, GenQueriesEXT), 0},
-    {"glGenRenderbuffers", offsetof(struct glfunctions, GenRenderbuffers), M},
-    {"glGenTextures", offsetof(struct glfunctions, GenTextures), M},
-    {"glGenVertexArrays", offsetof(struct glfunctions, GenVertexArrays), 0},
-    {"glGenerateMipmap", offsetof(struct glfunctions, GenerateMipmap), M},
-    {"glGetActiveAttrib", offsetof(struct glfunctions, GetActiveAttrib), M},
-    {"glGetActiveUniform", offsetof(struct glfunctions, GetActiveUniform), M},
-    {"glGetActiveUniformBlockName", offsetof(struct glfunctions, GetActiveUniformBlockName), 0},
-    {"glGetActiveUniformBlockiv", offsetof(struct glfunctions, GetActiveUniformBlockiv), 0},
-    {"glGetAttachedShaders", offsetof(struct glfunctions, GetAttachedShaders), M},
-    {"glGetAttribLocation", offsetof(struct glfunctions, GetAttribLocation), M},
-    {"glGetBooleanv", offsetof(struct glfunctions, GetBooleanv), M},
-    {"glGetError", offsetof(struct glfunctions, GetError), M},
-    {"glGetIntegeri_v", offsetof(struct glfunctions, GetIntegeri_v), M},
-    {"glGetIntegerv", offsetof(struct glfunctions, GetIntegerv), M},
-    {"glGetInternalformativ", offsetof(struct glfunctions, GetInternalformativ), 0},
-    {"glGetProgramInfoLog", offsetof(struct glfunctions, GetProgramInfoLog), M},
-    {"glGetProgramInterfaceiv", offsetof(struct glfunctions, GetProgramInterfaceiv), 0},
-    {"glGetProgramResourceIndex", offsetof(struct glfunctions, GetProgramResourceIndex), 0},
-    {"glGetProgramResourceLocation", offsetof(struct glfunctions, GetProgramResourceLocation), 0},
-    {"glGetProgramResourceName", offsetof(struct glfunctions, GetProgramResourceName), 0},
-    {"glGetProgramResourceiv", offsetof(struct glfunctions, GetProgramResourceiv), 0},
-    {"glGetProgramiv", offsetof(struct glfunctions, GetProgramiv), M},
-    {"glGetQueryObjectui64v", offsetof(struct glfunctions, GetQueryObjectui64v), 0},
-    {"glGetQueryObjectui64vEXT", offsetof(struct glfunctions, GetQueryObjectui64vEXT), 0},
-    {"glGetRenderbufferParameteriv", offsetof(struct glfunctions, GetRenderbufferParameteriv), M},
-    {"glGetShaderInfoLog", offsetof(struct glfunctions, GetShaderInfoLog), M},
-    {"glGetShaderSource", offsetof(struct glfunctions, GetShaderSource), M},
-    {"glGetShaderiv", offsetof(struct glfunctions, GetShaderiv), M},
-    {"glGetString", offsetof(struct glfunctions, GetString), M},
-    {"glGetStringi", offsetof(struct glfunctions, GetStringi), M},
-    {"glGetUniformBlockIndex", offsetof(struct glfunctions, GetUniformBlockIndex), 0},
-    {"glGetUniformLocation", offsetof(struct glfunctions, GetUniformLocation), M},
-    {"glGetUniformiv", offsetof(struct glfunctions, GetUniformiv), M},
-    {"glInvalidateFramebuffer", offsetof(struct glfunctions, InvalidateFramebuffer), 0},
-    {"glLinkProgram", offsetof(struct glfunctions, LinkProgram), M},
-    {"glMemoryBarrier", offsetof(struct glfunctions, MemoryBarrier), 0},
-    {"glPixelStorei", offsetof(struct glfunctions, PixelStorei), M},
-    {"glPolygonMode", offsetof(struct glfunctions, PolygonMode), 0},
-    {"glReadBuffer", offsetof(struct glfunctions, ReadBuffer), 0},
-    {"glReadPixels", offsetof(struct glfunctions, ReadPixels), M},
-    {"glReleaseShaderCompiler", offsetof(struct glfunctions, ReleaseShaderCompiler), M},
-    {"glRenderbufferStorage", offsetof(struct glfunctions, RenderbufferStorage), M},
-    {"glRenderbufferStorageMultisample", offsetof(struct glfunctions, RenderbufferStorageMultisample), 0},
-    {"glScissor", offsetof(struct glfunctions, Scissor), M},
-    {"glShaderBinary", offsetof(struct glfunctions, ShaderBinary), M},
-    {"glShaderSource", offsetof(struct glfunctions, ShaderSource), M},
-    {"glStencilFunc", offsetof(struct glfunctions, StencilFunc), M},
-    {"glStencilFuncSeparate", offsetof(struct glfunctions, StencilFuncSeparate), M},
-    {"glStencilMask", offsetof(struct glfunctions, StencilMask), M},
-    {"glStencilMaskSeparate", offsetof(struct glfunctions, StencilMaskSeparate), M},
-    {"glStencilOp", offsetof(struct glfunctions, StencilOp), M},
-    {"glStencilOpSeparate", offsetof(struct glfunctions, StencilOpSeparate), M},
-    {"glTexImage2D", offsetof(struct glfunctions, TexImage2D), M},
-    {"glTexImage3D", offsetof(struct glfunctions, TexImage3D), 0},
-    {"glTexParameteri", offsetof(struct glfunctions, TexParameteri), M},
-    {"glTexStorage2D", offsetof(struct glfunctions, TexStorage2D), 0},
-    {"glTexStorage3D", offsetof(struct glfunctions, TexStorage3D), 0},
-    {"glTexSubImage2D", offsetof(struct glfunctions, TexSubImage2D), M},
-    {"glTexSubImage3D", offsetof(struct glfunctions, TexSubImage3D), 0},
-    {"glUniform1fv", offsetof(struct glfunctions, Uniform1fv), M},
-    {"glUniform1i", offsetof(struct glfunctions, Uniform1i), M},
-    {"glUniform1iv", offsetof(struct glfunctions, Uniform1iv), M},
-    {"glUniform1uiv", offsetof(struct glfunctions, Uniform1uiv), 0},
-    {"glUniform2fv", offsetof(struct glfunctions, Uniform2fv), M},
-    {"glUniform2iv", offsetof(struct glfunctions, Uniform2iv), M},
-    {"glUniform2uiv", offsetof(struct glfunctions, Uniform2uiv), 0},
-    {"glUniform3fv", offsetof(struct glfunctions, Uniform3fv), M},
-    {"glUniform3iv", offsetof(struct glfunctions, Uniform3iv), M},
-    {"glUniform3uiv", offsetof(struct glfunctions, Uniform3uiv), 0},
-    {"glUniform4fv", offsetof(struct glfunctions, Uniform4fv), M},
-    {"glUniform4iv", offsetof(struct glfunctions, Uniform4iv), M},
-    {"glUniform4uiv", offsetof(struct glfunctions, Uniform4uiv), 0},
-    {"glUniformBlockBinding", offsetof(struct glfunctions, UniformBlockBinding), 0},
-    {"glUniformMatrix2fv", offsetof(struct glfunctions, UniformMatrix2fv), M},
-    {"glUniformMatrix3fv", offsetof(struct glfunctions, UniformMatrix3fv), M},
-    {"glUniformMatrix4fv", offsetof(struct glfunctions, UniformMatrix4fv), M},
-    {"glUseProgram", offsetof(struct glfunctions, UseProgram), M},
-    {"glVertexAttribDivisor", offsetof(struct glfunctions, VertexAttribDivisor), 0},
-    {"glVertexAttribPointer", offsetof(struct glfunctions, VertexAttribPointer), M},
-    {"glViewport", offsetof(struct glfunctions, Viewport), M},
-    {"glWaitSync", offsetof(struct glfunctions, WaitSync), 0},
+    {"glActiveTexture", offsetof(struct glfunctions, ActiveTexture), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glAttachShader", offsetof(struct glfunctions, AttachShader), M, 0},
+    {"glBeginQuery", offsetof(struct glfunctions, BeginQuery), 0, 0},
+    {"glBeginQueryEXT", offsetof(struct glfunctions, BeginQueryEXT), 0, 0},
+    {"glBindAttribLocation", offsetof(struct glfunctions, BindAttribLocation), M, 0},
+    {"glBindBuffer", offsetof(struct glfunctions, BindBuffer), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBindBufferBase", offsetof(struct glfunctions, BindBufferBase), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glBindBufferRange", offsetof(struct glfunctions, BindBufferRange), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glBindFramebuffer", offsetof(struct glfunctions, BindFramebuffer), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBindImageTexture", offsetof(struct glfunctions, BindImageTexture), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glBindRenderbuffer", offsetof(struct glfunctions, BindRenderbuffer), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBindTexture", offsetof(struct glfunctions, BindTexture), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBindVertexArray", offsetof(struct glfunctions, BindVertexArray), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glBlendColor", offsetof(struct glfunctions, BlendColor), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBlendEquation", offsetof(struct glfunctions, BlendEquation), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBlendEquationSeparate", offsetof(struct glfunctions, BlendEquationSeparate), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBlendFunc", offsetof(struct glfunctions, BlendFunc), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBlendFuncSeparate", offsetof(struct glfunctions, BlendFuncSeparate), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glBlitFramebuffer", offsetof(struct glfunctions, BlitFramebuffer), 0, 0},
+    {"glBufferData", offsetof(struct glfunctions, BufferData), M, 0},
+    {"glBufferSubData", offsetof(struct glfunctions, BufferSubData), M, 0},
+    {"glCheckFramebufferStatus", offsetof(struct glfunctions, CheckFramebufferStatus), M, 0},
+    {"glClear", offsetof(struct glfunctions, Clear), M, 0},
+    {"glClearColor", offsetof(struct glfunctions, ClearColor), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glClientWaitSync", offsetof(struct glfunctions, ClientWaitSync), 0, 0},
+    {"glColorMask", offsetof(struct glfunctions, ColorMask), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glCompileShader", offsetof(struct glfunctions, CompileShader), M, 0},
+    {"glCreateProgram", offsetof(struct glfunctions, CreateProgram), M, 0},
+    {"glCreateShader", offsetof(struct glfunctions, CreateShader), M, 0},
+    {"glCullFace", offsetof(struct glfunctions, CullFace), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glDeleteBuffers", offsetof(struct glfunctions, DeleteBuffers), M, 0},
+    {"glDeleteFramebuffers", offsetof(struct glfunctions, DeleteFramebuffers), M, 0},
+    {"glDeleteProgram", offsetof(struct glfunctions, DeleteProgram), M, 0},
+    {"glDeleteQueries", offsetof(struct glfunctions, DeleteQueries), 0, 0},
+    {"glDeleteQueriesEXT", offsetof(struct glfunctions, DeleteQueriesEXT), 0, 0},
+    {"glDeleteRenderbuffers", offsetof(struct glfunctions, DeleteRenderbuffers), M, 0},
+    {"glDeleteShader", offsetof(struct glfunctions, DeleteShader), M, 0},
+    {"glDeleteTextures", offsetof(struct glfunctions, DeleteTextures), M, 0},
+    {"glDeleteVertexArrays", offsetof(struct glfunctions, DeleteVertexArrays), 0, 0},
+    {"glDepthFunc", offsetof(struct glfunctions, DepthFunc), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glDepthMask", offsetof(struct glfunctions, DepthMask), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glDetachShader", offsetof(struct glfunctions, DetachShader), M, 0},
+    {"glDisable", offsetof(struct glfunctions, Disable), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glDisableVertexAttribArray", offsetof(struct glfunctions, DisableVertexAttribArray), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glDispatchCompute", offsetof(struct glfunctions, DispatchCompute), 0, NGLI_GLFUNC_FLAG_DISPATCH},
+    {"glDrawArrays", offsetof(struct glfunctions, DrawArrays), M, NGLI_GLFUNC_FLAG_DRAW},
+    {"glDrawArraysInstanced", offsetof(struct glfunctions, DrawArraysInstanced), 0, NGLI_GLFUNC_FLAG_DRAW},
+    {"glDrawBuffer", offsetof(struct glfunctions, DrawBuffer), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glDrawBuffers", offsetof(struct glfunctions, DrawBuffers), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glDrawElements", offsetof(struct glfunctions, DrawElements), M, NGLI_GLFUNC_FLAG_DRAW},
+    {"glDrawElementsInstanced", offsetof(struct glfunctions, DrawElementsInstanced), 0, NGLI_GLFUNC_FLAG_DRAW},
+    {"glEGLImageTargetTexture2DOES", offsetof(struct glfunctions, EGLImageTargetTexture2DOES), 0, 0},
+    {"glEnable", offsetof(struct glfunctions, Enable), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glEnableVertexAttribArray", offsetof(struct glfunctions, EnableVertexAttribArray), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glEndQuery", offsetof(struct glfunctions, EndQuery), 0, 0},
+    {"glEndQueryEXT", offsetof(struct glfunctions, EndQueryEXT), 0, 0},
+    {"glFenceSync", offsetof(struct glfunctions, FenceSync), 0, 0},
+    {"glFinish", offsetof(struct glfunctions, Finish), M, 0},
+    {"glFlush", offsetof(struct glfunctions, Flush), M, 0},
+    {"glFramebufferRenderbuffer", offsetof(struct glfunctions, FramebufferRenderbuffer), M, 0},
+    {"glFramebufferTexture2D", offsetof(struct glfunctions, FramebufferTexture2D), M, 0},
+    {"glGenBuffers", offsetof(struct glfunctions, GenBuffers), M, 0},
+    {"glGenFramebuffers", offsetof(struct glfunctions, GenFramebuffers), M, 0},
+    {"glGenQueries", offsetof(struct glfunctions, GenQueries), 0, 0},
+    {"glGenQueriesEXT", offsetof(struct glfunctions, GenQueriesEXT), 0, 0},
+    {"glGenRenderbuffers", offsetof(struct glfunctions, GenRenderbuffers), M, 0},
+    {"glGenTextures", offsetof(struct glfunctions, GenTextures), M, 0},
+    {"glGenVertexArrays", offsetof(struct glfunctions, GenVertexArrays), 0, 0},
+    {"glGenerateMipmap", offsetof(struct glfunctions, GenerateMipmap), M, 0},
+    {"glGetActiveAttrib", offsetof(struct glfunctions, GetActiveAttrib), M, 0},
+    {"glGetActiveUniform", offsetof(struct glfunctions, GetActiveUniform), M, 0},
+    {"glGetActiveUniformBlockName", offsetof(struct glfunctions, GetActiveUniformBlockName), 0, 0},
+    {"glGetActiveUniformBlockiv", offsetof(struct glfunctions, GetActiveUniformBlockiv), 0, 0},
+    {"glGetAttachedShaders", offsetof(struct glfunctions, GetAttachedShaders), M, 0},
+    {"glGetAttribLocation", offsetof(struct glfunctions, GetAttribLocation), M, 0},
+    {"glGetBooleanv", offsetof(struct glfunctions, GetBooleanv), M, 0},
+    {"glGetError", offsetof(struct glfunctions, GetError), M, 0},
+    {"glGetIntegeri_v", offsetof(struct glfunctions, GetIntegeri_v), M, 0},
+    {"glGetIntegerv", offsetof(struct glfunctions, GetIntegerv), M, 0},
+    {"glGetInternalformativ", offsetof(struct glfunctions, GetInternalformativ), 0, 0},
+    {"glGetProgramInfoLog", offsetof(struct glfunctions, GetProgramInfoLog), M, 0},
+    {"glGetProgramInterfaceiv", offsetof(struct glfunctions, GetProgramInterfaceiv), 0, 0},
+    {"glGetProgramResourceIndex", offsetof(struct glfunctions, GetProgramResourceIndex), 0, 0},
+    {"glGetProgramResourceLocation", offsetof(struct glfunctions, GetProgramResourceLocation), 0, 0},
+    {"glGetProgramResourceName", offsetof(struct glfunctions, GetProgramResourceName), 0, 0},
+    {"glGetProgramResourceiv", offsetof(struct glfunctions, GetProgramResourceiv), 0, 0},
+    {"glGetProgramiv", offsetof(struct glfunctions, GetProgramiv), M, 0},
+    {"glGetQueryObjectui64v", offsetof(struct glfunctions, GetQueryObjectui64v), 0, 0},
+    {"glGetQueryObjectui64vEXT", offsetof(struct glfunctions, GetQueryObjectui64vEXT), 0, 0},
+    {"glGetRenderbufferParameteriv", offsetof(struct glfunctions, GetRenderbufferParameteriv), M, 0},
+    {"glGetShaderInfoLog", offsetof(struct glfunctions, GetShaderInfoLog), M, 0},
+    {"glGetShaderSource", offsetof(struct glfunctions, GetShaderSource), M, 0},
+    {"glGetShaderiv", offsetof(struct glfunctions, GetShaderiv), M, 0},
+    {"glGetString", offsetof(struct glfunctions, GetString), M, 0},
+    {"glGetStringi", offsetof(struct glfunctions, GetStringi), M, 0},
+    {"glGetUniformBlockIndex", offsetof(struct glfunctions, GetUniformBlockIndex), 0, 0},
+    {"glGetUniformLocation", offsetof(struct glfunctions, GetUniformLocation), M, 0},
+    {"glGetUniformiv", offsetof(struct glfunctions, GetUniformiv), M, 0},
+    {"glInvalidateFramebuffer", offsetof(struct glfunctions, InvalidateFramebuffer), 0, 0},
+    {"glLinkProgram", offsetof(struct glfunctions, LinkProgram), M, 0},
+    {"glMemoryBarrier", offsetof(struct glfunctions, MemoryBarrier), 0, 0},
+    {"glPixelStorei", offsetof(struct glfunctions, PixelStorei), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glPolygonMode", offsetof(struct glfunctions, PolygonMode), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glReadBuffer", offsetof(struct glfunctions, ReadBuffer), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glReadPixels", offsetof(struct glfunctions, ReadPixels), M, 0},
+    {"glReleaseShaderCompiler", offsetof(struct glfunctions, ReleaseShaderCompiler), M, 0},
+    {"glRenderbufferStorage", offsetof(struct glfunctions, RenderbufferStorage), M, 0},
+    {"glRenderbufferStorageMultisample", offsetof(struct glfunctions, RenderbufferStorageMultisample), 0, 0},
+    {"glScissor", offsetof(struct glfunctions, Scissor), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glShaderBinary", offsetof(struct glfunctions, ShaderBinary), M, 0},
+    {"glShaderSource", offsetof(struct glfunctions, ShaderSource), M, 0},
+    {"glStencilFunc", offsetof(struct glfunctions, StencilFunc), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glStencilFuncSeparate", offsetof(struct glfunctions, StencilFuncSeparate), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glStencilMask", offsetof(struct glfunctions, StencilMask), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glStencilMaskSeparate", offsetof(struct glfunctions, StencilMaskSeparate), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glStencilOp", offsetof(struct glfunctions, StencilOp), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glStencilOpSeparate", offsetof(struct glfunctions, StencilOpSeparate), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glTexImage2D", offsetof(struct glfunctions, TexImage2D), M, 0},
+    {"glTexImage3D", offsetof(struct glfunctions, TexImage3D), 0, 0},
+    {"glTexParameteri", offsetof(struct glfunctions, TexParameteri), M, 0},
+    {"glTexStorage2D", offsetof(struct glfunctions, TexStorage2D), 0, 0},
+    {"glTexStorage3D", offsetof(struct glfunctions, TexStorage3D), 0, 0},
+    {"glTexSubImage2D", offsetof(struct glfunctions, TexSubImage2D), M, 0},
+    {"glTexSubImage3D", offsetof(struct glfunctions, TexSubImage3D), 0, 0},
+    {"glUniform1fv", offsetof(struct glfunctions, Uniform1fv), M, 0},
+    {"glUniform1i", offsetof(struct glfunctions, Uniform1i), M, 0},
+    {"glUniform1iv", offsetof(struct glfunctions, Uniform1iv), M, 0},
+    {"glUniform1uiv", offsetof(struct glfunctions, Uniform1uiv), 0, 0},
+    {"glUniform2fv", offsetof(struct glfunctions, Uniform2fv), M, 0},
+    {"glUniform2iv", offsetof(struct glfunctions, Uniform2iv), M, 0},
+    {"glUniform2uiv", offsetof(struct glfunctions, Uniform2uiv), 0, 0},
+    {"glUniform3fv", offsetof(struct glfunctions, Uniform3fv), M, 0},
+    {"glUniform3iv", offsetof(struct glfunctions, Uniform3iv), M, 0},
+    {"glUniform3uiv", offsetof(struct glfunctions, Uniform3uiv), 0, 0},
+    {"glUniform4fv", offsetof(struct glfunctions, Uniform4fv), M, 0},
+    {"glUniform4iv", offsetof(struct glfunctions, Uniform4iv), M, 0},
+    {"glUniform4uiv", offsetof(struct glfunctions, Uniform4uiv), 0, 0},
+    {"glUniformBlockBinding", offsetof(struct glfunctions, UniformBlockBinding), 0, 0},
+    {"glUniformMatrix2fv", offsetof(struct glfunctions, UniformMatrix2fv), M, 0},
+    {"glUniformMatrix3fv", offsetof(struct glfunctions, UniformMatrix3fv), M, 0},
+    {"glUniformMatrix4fv", offsetof(struct glfunctions, UniformMatrix4fv), M, 0},
+    {"glUseProgram", offsetof(struct glfunctions, UseProgram), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glVertexAttribDivisor", offsetof(struct glfunctions, VertexAttribDivisor), 0, NGLI_GLFUNC_FLAG_STATE},
+    {"glVertexAttribPointer", offsetof(struct glfunctions, VertexAttribPointer), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glViewport", offsetof(struct glfunctions, Viewport), M, NGLI_GLFUNC_FLAG_STATE},
+    {"glWaitSync", offsetof(struct glfunctions, WaitSync), 0, 0},
+    {"glMultiDrawArraysIndirect", offsetof(struct glfunctions, MultiDrawArraysIndirect), 0, NGLI_GLFUNC_FLAG_DRAW},
+    {"glMultiDrawElementsIndirect", offsetof(struct glfunctions, MultiDrawElementsIndirect), 0, NGLI_GLFUNC_FLAG_DRAW},
 };
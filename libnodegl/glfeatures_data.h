@@ -251,5 +251,12 @@ static const struct glfeature {
                                            OFFSET(Uniform3uiv),
                                            OFFSET(Uniform4uiv),
                                            -1}
+    }, {
+        .name           = "multi_draw_indirect",
+        .flag           = NGLI_FEATURE_MULTI_DRAW_INDIRECT,
+        .version        = 430,
+        .funcs_offsets  = (const size_t[]){OFFSET(MultiDrawArraysIndirect),
+                                           OFFSET(MultiDrawElementsIndirect),
+                                           -1}
     }
 };
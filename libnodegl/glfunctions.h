@@ -158,6 +158,160 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*VertexAttribPointer)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer);
     NGLI_GL_APIENTRY void (*Viewport)(GLint x, GLint y, GLsizei width, GLsizei height);
     NGLI_GL_APIENTRY void (*WaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+    NGLI_GL_APIENTRY void (*MultiDrawArraysIndirect)(GLenum mode, const void * indirect, GLsizei drawcount, GLsizei stride);
+    NGLI_GL_APIENTRY void (*MultiDrawElementsIndirect)(GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride);
+};
+
+enum {
+    NGLI_GLFUNC_ActiveTexture,
+    NGLI_GLFUNC_AttachShader,
+    NGLI_GLFUNC_BeginQuery,
+    NGLI_GLFUNC_BeginQueryEXT,
+    NGLI_GLFUNC_BindAttribLocation,
+    NGLI_GLFUNC_BindBuffer,
+    NGLI_GLFUNC_BindBufferBase,
+    NGLI_GLFUNC_BindBufferRange,
+    NGLI_GLFUNC_BindFramebuffer,
+    NGLI_GLFUNC_BindImageTexture,
+    NGLI_GLFUNC_BindRenderbuffer,
+    NGLI_GLFUNC_BindTexture,
+    NGLI_GLFUNC_BindVertexArray,
+    NGLI_GLFUNC_BlendColor,
+    NGLI_GLFUNC_BlendEquation,
+    NGLI_GLFUNC_BlendEquationSeparate,
+    NGLI_GLFUNC_BlendFunc,
+    NGLI_GLFUNC_BlendFuncSeparate,
+    NGLI_GLFUNC_BlitFramebuffer,
+    NGLI_GLFUNC_BufferData,
+    NGLI_GLFUNC_BufferSubData,
+    NGLI_GLFUNC_CheckFramebufferStatus,
+    NGLI_GLFUNC_Clear,
+    NGLI_GLFUNC_ClearColor,
+    NGLI_GLFUNC_ClientWaitSync,
+    NGLI_GLFUNC_ColorMask,
+    NGLI_GLFUNC_CompileShader,
+    NGLI_GLFUNC_CreateProgram,
+    NGLI_GLFUNC_CreateShader,
+    NGLI_GLFUNC_CullFace,
+    NGLI_GLFUNC_DeleteBuffers,
+    NGLI_GLFUNC_DeleteFramebuffers,
+    NGLI_GLFUNC_DeleteProgram,
+    NGLI_GLFUNC_DeleteQueries,
+    NGLI_GLFUNC_DeleteQueriesEXT,
+    NGLI_GLFUNC_DeleteRenderbuffers,
+    NGLI_GLFUNC_DeleteShader,
+    NGLI_GLFUNC_DeleteTextures,
+    NGLI_GLFUNC_DeleteVertexArrays,
+    NGLI_GLFUNC_DepthFunc,
+    NGLI_GLFUNC_DepthMask,
+    NGLI_GLFUNC_DetachShader,
+    NGLI_GLFUNC_Disable,
+    NGLI_GLFUNC_DisableVertexAttribArray,
+    NGLI_GLFUNC_DispatchCompute,
+    NGLI_GLFUNC_DrawArrays,
+    NGLI_GLFUNC_DrawArraysInstanced,
+    NGLI_GLFUNC_DrawBuffer,
+    NGLI_GLFUNC_DrawBuffers,
+    NGLI_GLFUNC_DrawElements,
+    NGLI_GLFUNC_DrawElementsInstanced,
+    NGLI_GLFUNC_EGLImageTargetTexture2DOES,
+    NGLI_GLFUNC_Enable,
+    NGLI_GLFUNC_EnableVertexAttribArray,
+    NGLI_GLFUNC_EndQuery,
+    NGLI_GLFUNC_EndQueryEXT,
+    NGLI_GLFUNC_FenceSync,
+    NGLI_GLFUNC_Finish,
+    NGLI_GLFUNC_Flush,
+    NGLI_GLFUNC_FramebufferRenderbuffer,
+    NGLI_GLFUNC_FramebufferTexture2D,
+    NGLI_GLFUNC_GenBuffers,
+    NGLI_GLFUNC_GenFramebuffers,
+    NGLI_GLFUNC_GenQueries,
+    NGLI_GLFUNC_GenQueriesEXT,
+    NGLI_GLFUNC_GenRenderbuffers,
+    NGLI_GLFUNC_GenTextures,
+    NGLI_GLFUNC_GenVertexArrays,
+    NGLI_GLFUNC_GenerateMipmap,
+    NGLI_GLFUNC_GetActiveAttrib,
+    NGLI_GLFUNC_GetActiveUniform,
+    NGLI_GLFUNC_GetActiveUniformBlockName,
+    NGLI_GLFUNC_GetActiveUniformBlockiv,
+    NGLI_GLFUNC_GetAttachedShaders,
+    NGLI_GLFUNC_GetAttribLocation,
+    NGLI_GLFUNC_GetBooleanv,
+    NGLI_GLFUNC_GetError,
+    NGLI_GLFUNC_GetIntegeri_v,
+    NGLI_GLFUNC_GetIntegerv,
+    NGLI_GLFUNC_GetInternalformativ,
+    NGLI_GLFUNC_GetProgramInfoLog,
+    NGLI_GLFUNC_GetProgramInterfaceiv,
+    NGLI_GLFUNC_GetProgramResourceIndex,
+    NGLI_GLFUNC_GetProgramResourceLocation,
+    NGLI_GLFUNC_GetProgramResourceName,
+    NGLI_GLFUNC_GetProgramResourceiv,
+    NGLI_GLFUNC_GetProgramiv,
+    NGLI_GLFUNC_GetQueryObjectui64v,
+    NGLI_GLFUNC_GetQueryObjectui64vEXT,
+    NGLI_GLFUNC_GetRenderbufferParameteriv,
+    NGLI_GLFUNC_GetShaderInfoLog,
+    NGLI_GLFUNC_GetShaderSource,
+    NGLI_GLFUNC_GetShaderiv,
+    NGLI_GLFUNC_GetString,
+    NGLI_GLFUNC_GetStringi,
+    NGLI_GLFUNC_GetUniformBlockIndex,
+    NGLI_GLFUNC_GetUniformLocation,
+    NGLI_GLFUNC_GetUniformiv,
+    NGLI_GLFUNC_InvalidateFramebuffer,
+    NGLI_GLFUNC_LinkProgram,
+    NGLI_GLFUNC_MemoryBarrier,
+    NGLI_GLFUNC_PixelStorei,
+    NGLI_GLFUNC_PolygonMode,
+    NGLI_GLFUNC_ReadBuffer,
+    NGLI_GLFUNC_ReadPixels,
+    NGLI_GLFUNC_ReleaseShaderCompiler,
+    NGLI_GLFUNC_RenderbufferStorage,
+    NGLI_GLFUNC_RenderbufferStorageMultisample,
+    NGLI_GLFUNC_Scissor,
+    NGLI_GLFUNC_ShaderBinary,
+    NGLI_GLFUNC_ShaderSource,
+    NGLI_GLFUNC_StencilFunc,
+    NGLI_GLFUNC_StencilFuncSeparate,
+    NGLI_GLFUNC_StencilMask,
+    NGLI_GLFUNC_StencilMaskSeparate,
+    NGLI_GLFUNC_StencilOp,
+    NGLI_GLFUNC_StencilOpSeparate,
+    NGLI_GLFUNC_TexImage2D,
+    NGLI_GLFUNC_TexImage3D,
+    NGLI_GLFUNC_TexParameteri,
+    NGLI_GLFUNC_TexStorage2D,
+    NGLI_GLFUNC_TexStorage3D,
+    NGLI_GLFUNC_TexSubImage2D,
+    NGLI_GLFUNC_TexSubImage3D,
+    NGLI_GLFUNC_Uniform1fv,
+    NGLI_GLFUNC_Uniform1i,
+    NGLI_GLFUNC_Uniform1iv,
+    NGLI_GLFUNC_Uniform1uiv,
+    NGLI_GLFUNC_Uniform2fv,
+    NGLI_GLFUNC_Uniform2iv,
+    NGLI_GLFUNC_Uniform2uiv,
+    NGLI_GLFUNC_Uniform3fv,
+    NGLI_GLFUNC_Uniform3iv,
+    NGLI_GLFUNC_Uniform3uiv,
+    NGLI_GLFUNC_Uniform4fv,
+    NGLI_GLFUNC_Uniform4iv,
+    NGLI_GLFUNC_Uniform4uiv,
+    NGLI_GLFUNC_UniformBlockBinding,
+    NGLI_GLFUNC_UniformMatrix2fv,
+    NGLI_GLFUNC_UniformMatrix3fv,
+    NGLI_GLFUNC_UniformMatrix4fv,
+    NGLI_GLFUNC_UseProgram,
+    NGLI_GLFUNC_VertexAttribDivisor,
+    NGLI_GLFUNC_VertexAttribPointer,
+    NGLI_GLFUNC_Viewport,
+    NGLI_GLFUNC_WaitSync,
+    NGLI_GLFUNC_MultiDrawArraysIndirect,
+    NGLI_GLFUNC_MultiDrawElementsIndirect,
+    NGLI_GLFUNC_NB
 };
 
 #endif
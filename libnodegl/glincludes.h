@@ -224,9 +224,14 @@ typedef void* GLeglImageOES;
 # define GL_FRAMEBUFFER_BARRIER_BIT            0x00000400
 # define GL_TRANSFORM_FEEDBACK_BARRIER_BIT     0x00000800
 # define GL_ATOMIC_COUNTER_BARRIER_BIT         0x00001000
+# define GL_SHADER_STORAGE_BARRIER_BIT         0x00002000
 # define GL_ALL_BARRIER_BITS                   0xFFFFFFFF
 # define GL_IMAGE_2D                           0x904D
 # define GL_ACTIVE_RESOURCES                   0x92F5
 #endif
 
+#ifndef GL_DRAW_INDIRECT_BUFFER
+# define GL_DRAW_INDIRECT_BUFFER               0x8F3F
+#endif
+
 #endif /* GLINCLUDES_H */
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "drawutils.h"
+#include "format.h"
+#include "gctx.h"
+#include "glyphatlas.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+/*
+ * The 128 glyphs are laid out on a 16x8 grid. Every cell has a 1 pixel
+ * transparent border to prevent the glyphs from bleeding into each other when
+ * sampled with linear filtering. The first cell (NUL character) is filled
+ * entirely and used for the text background.
+ */
+#define NB_COLS 16
+#define NB_ROWS 8
+#define CELL_W  (NGLI_FONT_W + 2)
+#define CELL_H  (NGLI_FONT_H + 2)
+#define ATLAS_W (NB_COLS * CELL_W)
+#define ATLAS_H (NB_ROWS * CELL_H)
+
+struct glyphatlas_entry {
+    int min_filter;
+    int mag_filter;
+    int mipmap_filter;
+    struct texture *texture;
+    int refcount;
+};
+
+void ngli_glyphatlas_init(struct glyphatlas *s)
+{
+    ngli_darray_init(&s->entries, sizeof(struct glyphatlas_entry), 0);
+}
+
+static int rasterize_glyphs(struct texture *texture)
+{
+    struct canvas canvas = {.w = ATLAS_W, .h = ATLAS_H};
+    canvas.buf = ngli_calloc(canvas.w * canvas.h, 4);
+    if (!canvas.buf)
+        return NGL_ERROR_MEMORY;
+
+    const struct rect solid = {.w = CELL_W, .h = CELL_H};
+    ngli_drawutils_draw_rect(&canvas, &solid, 0xffffffff);
+
+    for (int c = 1; c < NB_COLS * NB_ROWS; c++) {
+        if (c == '\n')
+            continue;
+        const char str[] = {c, 0};
+        const int x = (c % NB_COLS) * CELL_W + 1;
+        const int y = (c / NB_COLS) * CELL_H + 1;
+        ngli_drawutils_print(&canvas, x, y, str, 0xffffffff);
+    }
+
+    int ret = ngli_texture_upload(texture, canvas.buf, 0);
+    ngli_free(canvas.buf);
+    return ret;
+}
+
+struct texture *ngli_glyphatlas_ref(struct glyphatlas *s, struct gctx *gctx,
+                                    int min_filter, int mag_filter, int mipmap_filter)
+{
+    struct glyphatlas_entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct glyphatlas_entry *entry = &entries[i];
+        if (entry->min_filter == min_filter &&
+            entry->mag_filter == mag_filter &&
+            entry->mipmap_filter == mipmap_filter) {
+            entry->refcount++;
+            return entry->texture;
+        }
+    }
+
+    struct texture *texture = ngli_texture_create(gctx);
+    if (!texture)
+        return NULL;
+
+    struct texture_params params = NGLI_TEXTURE_PARAM_DEFAULTS;
+    params.width         = ATLAS_W;
+    params.height        = ATLAS_H;
+    params.format        = NGLI_FORMAT_R8G8B8A8_UNORM;
+    params.min_filter    = min_filter;
+    params.mag_filter    = mag_filter;
+    params.mipmap_filter = mipmap_filter;
+
+    /* The atlas is shared by all the text nodes so it is charged to the context */
+    struct ngl_ctx *ctx = gctx->ctx;
+    struct ngl_node *cur_node = ctx->cur_node;
+    ctx->cur_node = NULL;
+    int ret = ngli_texture_init(texture, &params);
+    ctx->cur_node = cur_node;
+
+    if (ret < 0 || (ret = rasterize_glyphs(texture)) < 0) {
+        LOG(ERROR, "could not create glyph atlas: %s", NGLI_RET_STR(ret));
+        ngli_texture_freep(&texture);
+        return NULL;
+    }
+
+    const struct glyphatlas_entry entry = {
+        .min_filter    = min_filter,
+        .mag_filter    = mag_filter,
+        .mipmap_filter = mipmap_filter,
+        .texture       = texture,
+        .refcount      = 1,
+    };
+    if (!ngli_darray_push(&s->entries, &entry)) {
+        ngli_texture_freep(&texture);
+        return NULL;
+    }
+
+    return texture;
+}
+
+void ngli_glyphatlas_unref(struct glyphatlas *s, struct texture **texturep)
+{
+    struct texture *texture = *texturep;
+    if (!texture)
+        return;
+
+    struct glyphatlas_entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct glyphatlas_entry *entry = &entries[i];
+        if (entry->texture != texture)
+            continue;
+        if (--entry->refcount == 0) {
+            ngli_texture_freep(&entry->texture);
+            ngli_darray_remove(&s->entries, i);
+        }
+        break;
+    }
+    *texturep = NULL;
+}
+
+void ngli_glyphatlas_reset(struct glyphatlas *s)
+{
+    ngli_assert(!ngli_darray_count(&s->entries));
+    ngli_darray_reset(&s->entries);
+}
+
+void ngli_glyphatlas_get_uvs(int c, float *uvs)
+{
+    if (!c) {
+        uvs[0] = uvs[2] = CELL_W / 2.f / ATLAS_W;
+        uvs[1] = uvs[3] = CELL_H / 2.f / ATLAS_H;
+        return;
+    }
+    c &= 0x7f;
+    const int x = (c % NB_COLS) * CELL_W + 1;
+    const int y = (c / NB_COLS) * CELL_H + 1;
+    uvs[0] = x / (float)ATLAS_W;
+    uvs[1] = y / (float)ATLAS_H;
+    uvs[2] = (x + NGLI_FONT_W) / (float)ATLAS_W;
+    uvs[3] = (y + NGLI_FONT_H) / (float)ATLAS_H;
+}
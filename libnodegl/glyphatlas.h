@@ -0,0 +1,46 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include "darray.h"
+#include "texture.h"
+
+/*
+ * Texture atlas of the built-in bitmap font glyphs, shared by all the Text
+ * nodes of a context. An atlas is created for every set of sampling filters
+ * in use, and destroyed once its last user releases it.
+ */
+struct glyphatlas {
+    struct darray entries; /* struct glyphatlas_entry */
+};
+
+void ngli_glyphatlas_init(struct glyphatlas *s);
+struct texture *ngli_glyphatlas_ref(struct glyphatlas *s, struct gctx *gctx,
+                                    int min_filter, int mag_filter, int mipmap_filter);
+void ngli_glyphatlas_unref(struct glyphatlas *s, struct texture **texturep);
+void ngli_glyphatlas_reset(struct glyphatlas *s);
+
+/* Texture coordinates (u0,v0,u1,v1) of a glyph, or of a solid area for c=0 */
+void ngli_glyphatlas_get_uvs(int c, float *uvs);
+
+#endif
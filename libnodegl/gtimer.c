@@ -21,6 +21,7 @@
 
 #include "gctx.h"
 #include "gtimer.h"
+#include "log.h"
 
 struct gtimer *ngli_gtimer_create(struct gctx *gctx)
 {
@@ -34,22 +35,69 @@ int ngli_gtimer_init(struct gtimer *s)
 
 int ngli_gtimer_start(struct gtimer *s)
 {
-    return s->gctx->class->gtimer_start(s);
+    struct gctx *gctx = s->gctx;
+
+    if (gctx->timer_active) {
+        LOG(WARNING, "only one instance of GPU timings can be present "
+            "in the same graph due to OpenGL limitations");
+        return 0;
+    }
+
+    /*
+     * This specific instance of gtimer was able to grab the global
+     * "timer active" lock
+     */
+    gctx->timer_active = 1;
+    s->started = 1;
+
+    if (gctx->cmdbuffer.recording) {
+        ngli_cmdbuffer_gtimer_start(&gctx->cmdbuffer, s);
+        return 0;
+    }
+    return gctx->class->gtimer_start(s);
 }
 
 int ngli_gtimer_stop(struct gtimer *s)
 {
-    return s->gctx->class->gtimer_stop(s);
+    struct gctx *gctx = s->gctx;
+    struct cmdbuffer *cmdbuffer = &gctx->cmdbuffer;
+
+    if (!s->started)
+        return 0;
+
+    s->started = 0;
+    gctx->timer_active = 0;
+
+    if (cmdbuffer->recording) {
+        s->submit_serial = cmdbuffer->serial + 1;
+        ngli_cmdbuffer_gtimer_stop(cmdbuffer, s);
+        return 0;
+    }
+    s->submit_serial = cmdbuffer->serial;
+    return gctx->class->gtimer_stop(s);
 }
 
 int64_t ngli_gtimer_read(struct gtimer *s)
 {
+    struct cmdbuffer *cmdbuffer = &s->gctx->cmdbuffer;
+
+    /* The result is only available once the recorded stop is submitted */
+    if (cmdbuffer->serial < s->submit_serial)
+        ngli_cmdbuffer_sync(cmdbuffer);
     return s->gctx->class->gtimer_read(s);
 }
 
+int ngli_gtimer_poll(struct gtimer *s, int64_t *result)
+{
+    if (s->gctx->cmdbuffer.serial < s->submit_serial)
+        return 0;
+    return s->gctx->class->gtimer_poll(s, result);
+}
+
 void ngli_gtimer_freep(struct gtimer **sp)
 {
     if (!*sp)
         return;
+    ngli_cmdbuffer_sync(&(*sp)->gctx->cmdbuffer);
     (*sp)->gctx->class->gtimer_freep(sp);
 }
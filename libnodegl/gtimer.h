@@ -28,6 +28,8 @@ struct gctx;
 
 struct gtimer {
     struct gctx *gctx;
+    int started;
+    int64_t submit_serial; /* command buffer submission executing the last stop */
 };
 
 struct gtimer *ngli_gtimer_create(struct gctx *gctx);
@@ -35,6 +37,12 @@ int ngli_gtimer_init(struct gtimer *s);
 int ngli_gtimer_start(struct gtimer *s);
 int ngli_gtimer_stop(struct gtimer *s);
 int64_t ngli_gtimer_read(struct gtimer *s);
+
+/*
+ * Non-blocking read: return 1 and set result if the measure of the last
+ * start/stop is available, 0 otherwise
+ */
+int ngli_gtimer_poll(struct gtimer *s, int64_t *result);
 void ngli_gtimer_freep(struct gtimer **sp);
 
 #endif
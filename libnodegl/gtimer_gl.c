@@ -76,18 +76,7 @@ int ngli_gtimer_gl_start(struct gtimer *s)
     struct gctx_gl *gctx = (struct gctx_gl *)s->gctx;
     struct glcontext *gl = gctx->glcontext;
 
-    if (gctx->timer_active) {
-        LOG(WARNING, "only one instance of GPU timings can be present "
-            "in the same graph due to OpenGL limitations");
-        return 0;
-    }
-
-    /*
-     * This specific instance of gtimer was able to grab the global
-     * "timer active" lock
-     */
-    gctx->timer_active = 1;
-    s_priv->started = 1;
+    s_priv->pending = 0;
     s_priv->query_result = 0;
     s_priv->glBeginQuery(gl, GL_TIME_ELAPSED, s_priv->query);
     return 0;
@@ -99,21 +88,42 @@ int ngli_gtimer_gl_stop(struct gtimer *s)
     struct gctx_gl *gctx = (struct gctx_gl *)s->gctx;
     struct glcontext *gl = gctx->glcontext;
 
-    if (s_priv->started) {
-        s_priv->glEndQuery(gl, GL_TIME_ELAPSED);
-        s_priv->glGetQueryObjectui64v(gl, s_priv->query, GL_QUERY_RESULT, &s_priv->query_result);
-        s_priv->started = 0;
-        gctx->timer_active = 0;
-    }
+    s_priv->glEndQuery(gl, GL_TIME_ELAPSED);
+    s_priv->pending = 1;
     return 0;
 }
 
 int64_t ngli_gtimer_gl_read(struct gtimer *s)
 {
     struct gtimer_gl *s_priv = (struct gtimer_gl *)s;
+    struct gctx_gl *gctx = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx->glcontext;
+
+    if (s_priv->pending) {
+        s_priv->glGetQueryObjectui64v(gl, s_priv->query, GL_QUERY_RESULT, &s_priv->query_result);
+        s_priv->pending = 0;
+    }
     return s_priv->query_result;
 }
 
+int ngli_gtimer_gl_poll(struct gtimer *s, int64_t *result)
+{
+    struct gtimer_gl *s_priv = (struct gtimer_gl *)s;
+    struct gctx_gl *gctx = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx->glcontext;
+
+    if (!s_priv->pending)
+        return 0;
+
+    GLuint64 available = 0;
+    s_priv->glGetQueryObjectui64v(gl, s_priv->query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return 0;
+
+    *result = ngli_gtimer_gl_read(s);
+    return 1;
+}
+
 void ngli_gtimer_gl_freep(struct gtimer **sp)
 {
     if (!*sp)
@@ -29,7 +29,7 @@ struct gctx;
 
 struct gtimer_gl {
     struct gtimer parent;
-    int started;
+    int pending;
     GLuint query;
     GLuint64 query_result;
     void (*glGenQueries)(const struct glcontext *gl, GLsizei n, GLuint * ids);
@@ -44,6 +44,7 @@ int ngli_gtimer_gl_init(struct gtimer *s);
 int ngli_gtimer_gl_start(struct gtimer *s);
 int ngli_gtimer_gl_stop(struct gtimer *s);
 int64_t ngli_gtimer_gl_read(struct gtimer *s);
+int ngli_gtimer_gl_poll(struct gtimer *s, int64_t *result);
 void ngli_gtimer_gl_freep(struct gtimer **sp);
 
 #endif
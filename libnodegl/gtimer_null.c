@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gtimer_null.h"
+#include "memory.h"
+
+struct gtimer *ngli_gtimer_null_create(struct gctx *gctx)
+{
+    struct gtimer *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gctx = gctx;
+    return s;
+}
+
+int ngli_gtimer_null_init(struct gtimer *s)
+{
+    return 0;
+}
+
+int ngli_gtimer_null_start(struct gtimer *s)
+{
+    return 0;
+}
+
+int ngli_gtimer_null_stop(struct gtimer *s)
+{
+    return 0;
+}
+
+int64_t ngli_gtimer_null_read(struct gtimer *s)
+{
+    return 0;
+}
+
+int ngli_gtimer_null_poll(struct gtimer *s, int64_t *result)
+{
+    return 0;
+}
+
+void ngli_gtimer_null_freep(struct gtimer **sp)
+{
+    ngli_freep(sp);
+}
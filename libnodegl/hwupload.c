@@ -61,6 +61,11 @@ static const struct hwmap_class *get_hwmap_class(int backend, struct sxplayer_fr
             return NULL;
 
         return hwupload_gl_class_map[frame->pix_fmt];
+    } else if (backend == NGL_BACKEND_NULL) {
+        if (frame->pix_fmt == SXPLAYER_PIXFMT_RGBA ||
+            frame->pix_fmt == SXPLAYER_PIXFMT_BGRA ||
+            frame->pix_fmt == SXPLAYER_SMPFMT_FLT)
+            return &ngli_hwmap_common_class;
     }
 
     return NULL;
@@ -228,6 +228,13 @@ void ngli_mat3_inverse(float *dst, const float *m)
     ngli_mat3_mul_scalar(dst, a, 1.0 / det);
 }
 
+void ngli_mat3_normal_from_mat4_c(float *dst, const float *m)
+{
+    ngli_mat3_from_mat4(dst, m);
+    ngli_mat3_inverse(dst, dst);
+    ngli_mat3_transpose(dst, dst);
+}
+
 void ngli_mat4_mul_c(float *dst, const float *m1, const float *m2)
 {
     float m[4*4];
@@ -453,7 +460,7 @@ void ngli_mat4_scale(float *dst, float x, float y, float z)
 
 #define COS_ALPHA_THRESHOLD 0.9995f
 
-void ngli_quat_slerp(float *dst, const float *q1, const float *q2, float t)
+void ngli_quat_slerp_c(float *dst, const float *q1, const float *q2, float t)
 {
     float tmp_q1[4];
     const float *tmp_q1p = q1;
@@ -491,3 +498,17 @@ void ngli_quat_slerp(float *dst, const float *q1, const float *q2, float t)
     ngli_vec4_scale(tmp2, tmp, sin(theta));
     ngli_vec4_add(dst, tmp1, tmp2);
 }
+
+void ngli_mix_floats_c(float *dst, const float *a, const float *b, float c, int n)
+{
+    const float c1 = 1.f - c;
+    for (int i = 0; i < n; i++)
+        dst[i] = a[i] * c1 + b[i] * c;
+}
+
+void ngli_math_init(void)
+{
+#ifdef ARCH_X86_64
+    ngli_math_init_x86_64();
+#endif
+}
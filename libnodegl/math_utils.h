@@ -50,6 +50,7 @@ void ngli_mat3_transpose(float *dst, const float *m);
 float ngli_mat3_determinant(const float *m);
 void ngli_mat3_adjugate(float *dst, const float* m);
 void ngli_mat3_inverse(float *dst, const float *m);
+void ngli_mat3_normal_from_mat4_c(float *dst, const float *m);
 
 #define NGLI_MAT4_IDENTITY {1.0f, 0.0f, 0.0f, 0.0f, \
                             0.0f, 1.0f, 0.0f, 0.0f, \
@@ -69,19 +70,61 @@ void ngli_mat4_scale(float *dst, float x, float y, float z);
 
 /* Arch specific versions */
 
-#ifdef ARCH_AARCH64
-# define ngli_mat4_mul          ngli_mat4_mul_aarch64
-# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_aarch64
+#if defined(ARCH_AARCH64)
+# define ngli_mat4_mul              ngli_mat4_mul_aarch64
+# define ngli_mat4_mul_vec4         ngli_mat4_mul_vec4_aarch64
+# define ngli_mat3_normal_from_mat4 ngli_mat3_normal_from_mat4_c
+# define ngli_quat_slerp            ngli_quat_slerp_c
+# define ngli_mix_floats            ngli_mix_floats_c
+#elif defined(ARCH_X86_64)
+# define ngli_mat4_mul              ngli_mat4_mul_x86_64
+# define ngli_mat4_mul_vec4         ngli_mat4_mul_vec4_x86_64
+# define ngli_mat3_normal_from_mat4 ngli_mat3_normal_from_mat4_x86_64
+# define ngli_quat_slerp            ngli_quat_slerp_x86_64
+# define ngli_mix_floats            ngli_mix_floats_x86_64
 #else
-# define ngli_mat4_mul          ngli_mat4_mul_c
-# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_c
+# define ngli_mat4_mul              ngli_mat4_mul_c
+# define ngli_mat4_mul_vec4         ngli_mat4_mul_vec4_c
+# define ngli_mat3_normal_from_mat4 ngli_mat3_normal_from_mat4_c
+# define ngli_quat_slerp            ngli_quat_slerp_c
+# define ngli_mix_floats            ngli_mix_floats_c
 #endif
 
 void ngli_mat4_mul_aarch64(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_aarch64(float *dst, const float *m, const float *v);
 
+#define NGLI_CPU_FLAG_SSE2 (1 << 0)
+#define NGLI_CPU_FLAG_AVX  (1 << 1)
+#define NGLI_CPU_FLAG_FMA  (1 << 2)
+
+int ngli_cpu_get_flags_x86_64(void);
+void ngli_math_init_x86_64(void);
+
+/* Pointers to the best versions supported by the CPU */
+extern void (*ngli_mat4_mul_x86_64)(float *dst, const float *m1, const float *m2);
+extern void (*ngli_mat4_mul_vec4_x86_64)(float *dst, const float *m, const float *v);
+extern void (*ngli_mat3_normal_from_mat4_x86_64)(float *dst, const float *m);
+extern void (*ngli_quat_slerp_x86_64)(float *dst, const float *q1, const float *q2, float t);
+extern void (*ngli_mix_floats_x86_64)(float *dst, const float *a, const float *b, float c, int n);
+
+void ngli_mat4_mul_sse2(float *dst, const float *m1, const float *m2);
+void ngli_mat4_mul_avx(float *dst, const float *m1, const float *m2);
+void ngli_mat4_mul_fma(float *dst, const float *m1, const float *m2);
+void ngli_mat4_mul_vec4_sse2(float *dst, const float *m, const float *v);
+void ngli_mat4_mul_vec4_fma(float *dst, const float *m, const float *v);
+void ngli_mat3_normal_from_mat4_sse2(float *dst, const float *m);
+void ngli_quat_slerp_sse2(float *dst, const float *q1, const float *q2, float t);
+void ngli_mix_floats_sse2(float *dst, const float *a, const float *b, float c, int n);
+void ngli_mix_floats_avx(float *dst, const float *a, const float *b, float c, int n);
+void ngli_mix_floats_fma(float *dst, const float *a, const float *b, float c, int n);
+
+/* Select the arch specific versions, must be called before using them */
+void ngli_math_init(void);
+
 #define NGLI_QUAT_IDENTITY {0.0f, 0.0f, 0.0f, 1.0f}
 
-void ngli_quat_slerp(float *dst, const float *q1, const float *q2, float t);
+void ngli_quat_slerp_c(float *dst, const float *q1, const float *q2, float t);
+
+void ngli_mix_floats_c(float *dst, const float *a, const float *b, float c, int n);
 
 #endif
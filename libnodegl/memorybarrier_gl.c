@@ -0,0 +1,87 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "glcontext.h"
+#include "memorybarrier_gl.h"
+#include "rendertarget.h"
+#include "texture_gl.h"
+#include "utils.h"
+
+static int get_bit_index(GLbitfield bit)
+{
+    for (int i = 0; i < NGLI_MEMORYBARRIER_GL_NB_BITS; i++)
+        if (bit == (1U << i))
+            return i;
+    ngli_assert(0);
+}
+
+int64_t ngli_memorybarrier_gl_add_write(struct memorybarrier_gl *s)
+{
+    return ++s->write_id;
+}
+
+void ngli_memorybarrier_gl_require(struct memorybarrier_gl *s, struct glcontext *gl,
+                                   int64_t last_write, GLbitfield barrier)
+{
+    /* The resource has never been written by a shader */
+    if (!last_write)
+        return;
+
+    const int index = get_bit_index(barrier);
+    if (s->barrier_ids[index] < last_write)
+        s->pending_barriers |= barrier;
+    else
+        gl->counters->elided_memory_barriers++;
+}
+
+static void require_attachment(struct memorybarrier_gl *s, struct glcontext *gl,
+                               const struct attachment *attachment)
+{
+    const struct texture_gl *texture_gl = (const struct texture_gl *)attachment->attachment;
+    if (texture_gl)
+        ngli_memorybarrier_gl_require(s, gl, texture_gl->last_shader_write, GL_FRAMEBUFFER_BARRIER_BIT);
+}
+
+void ngli_memorybarrier_gl_require_rendertarget(struct memorybarrier_gl *s, struct glcontext *gl,
+                                                const struct rendertarget *rt)
+{
+    if (!rt)
+        return;
+
+    const struct rendertarget_params *params = &rt->params;
+    for (int i = 0; i < params->nb_colors; i++)
+        require_attachment(s, gl, &params->colors[i]);
+    require_attachment(s, gl, &params->depth_stencil);
+}
+
+void ngli_memorybarrier_gl_flush(struct memorybarrier_gl *s, struct glcontext *gl)
+{
+    if (!s->pending_barriers)
+        return;
+
+    ngli_glMemoryBarrier(gl, s->pending_barriers);
+
+    /* The barrier covers all the writes issued so far */
+    for (int i = 0; i < NGLI_MEMORYBARRIER_GL_NB_BITS; i++)
+        if (s->pending_barriers & (1U << i))
+            s->barrier_ids[i] = s->write_id;
+    s->pending_barriers = 0;
+}
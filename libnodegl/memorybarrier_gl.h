@@ -0,0 +1,58 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef MEMORYBARRIER_GL_H
+#define MEMORYBARRIER_GL_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+
+struct glcontext;
+struct rendertarget;
+
+#define NGLI_MEMORYBARRIER_GL_NB_BITS 14
+
+/*
+ * Tracking of the incoherent memory writes (shader storage blocks and image
+ * stores) made by the shaders.
+ *
+ * Every pipeline execution writing resources gets a new write id, which is
+ * stored in the written buffers and textures. When one of these resources is
+ * later accessed through a given path (vertex fetch, uniform block, texture
+ * fetch, ...), a barrier with the corresponding bit is only required if no
+ * barrier with this bit has been emitted since the write. The required bits
+ * are accumulated and emitted at once with ngli_memorybarrier_gl_flush().
+ */
+struct memorybarrier_gl {
+    int64_t write_id;
+    int64_t barrier_ids[NGLI_MEMORYBARRIER_GL_NB_BITS];
+    GLbitfield pending_barriers;
+};
+
+int64_t ngli_memorybarrier_gl_add_write(struct memorybarrier_gl *s);
+void ngli_memorybarrier_gl_require(struct memorybarrier_gl *s, struct glcontext *gl,
+                                   int64_t last_write, GLbitfield barrier);
+void ngli_memorybarrier_gl_require_rendertarget(struct memorybarrier_gl *s, struct glcontext *gl,
+                                                const struct rendertarget *rt);
+void ngli_memorybarrier_gl_flush(struct memorybarrier_gl *s, struct glcontext *gl);
+
+#endif
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "log.h"
+#include "memory.h"
+#include "memtrack.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+struct memtrack_owner {
+    char key[32];
+    const char *type;
+    char *label;
+    int64_t sizes[NGLI_MEMTRACK_NB];
+    int nb_resources[NGLI_MEMTRACK_NB];
+    int refcount;
+};
+
+static const char * const category_names[NGLI_MEMTRACK_NB] = {
+    [NGLI_MEMTRACK_BUFFER]     = "buffer",
+    [NGLI_MEMTRACK_TEXTURE]    = "texture",
+    [NGLI_MEMTRACK_ATTACHMENT] = "attachment",
+};
+
+static void free_owner(void *user_arg, void *data)
+{
+    struct memtrack_owner *owner = data;
+    ngli_free(owner->label);
+    ngli_free(owner);
+}
+
+int ngli_memtrack_init(struct memtrack *s)
+{
+    memset(s, 0, sizeof(*s));
+    s->owners = ngli_hmap_create();
+    if (!s->owners)
+        return NGL_ERROR_MEMORY;
+    ngli_hmap_set_free(s->owners, free_owner, NULL);
+    return 0;
+}
+
+static void get_owner_key(char *key, size_t size, const struct ngl_node *node)
+{
+    if (node)
+        (void)snprintf(key, size, "%p", node);
+    else
+        (void)snprintf(key, size, "context");
+}
+
+static struct memtrack_owner *get_owner(struct memtrack *s, const struct ngl_node *node)
+{
+    char key[32];
+    get_owner_key(key, sizeof(key), node);
+
+    struct memtrack_owner *owner = ngli_hmap_get(s->owners, key);
+    if (owner)
+        return owner;
+
+    owner = ngli_calloc(1, sizeof(*owner));
+    if (!owner)
+        return NULL;
+    snprintf(owner->key, sizeof(owner->key), "%s", key);
+    owner->type = node ? node->class->name : "context";
+    owner->label = ngli_strdup(node && node->label ? node->label : "");
+    if (!owner->label || ngli_hmap_set(s->owners, key, owner) < 0) {
+        free_owner(NULL, owner);
+        return NULL;
+    }
+    return owner;
+}
+
+int ngli_memtrack_add(struct memtrack *s, struct memtrack_entry *entry,
+                      const struct ngl_node *node, int category, int64_t size)
+{
+    ngli_assert(category >= 0 && category < NGLI_MEMTRACK_NB);
+    ngli_assert(!entry->owner);
+
+    struct memtrack_owner *owner = get_owner(s, node);
+    if (!owner)
+        return NGL_ERROR_MEMORY;
+
+    entry->owner = owner;
+    entry->category = category;
+    entry->size = size;
+
+    owner->sizes[category] += size;
+    owner->nb_resources[category]++;
+    owner->refcount++;
+
+    struct memtrack_stats *stats = &s->stats;
+    stats->sizes[category] += size;
+    stats->max_sizes[category] = NGLI_MAX(stats->max_sizes[category], stats->sizes[category]);
+    stats->nb_resources[category]++;
+    stats->total_size += size;
+    stats->max_total_size = NGLI_MAX(stats->max_total_size, stats->total_size);
+
+    TRACE("ALLOC %s %s/%s: %" PRId64 " bytes (total: %" PRId64 ")",
+          category_names[category], owner->type, owner->label, size, stats->total_size);
+    return 0;
+}
+
+void ngli_memtrack_remove(struct memtrack *s, struct memtrack_entry *entry)
+{
+    struct memtrack_owner *owner = entry->owner;
+    if (!owner)
+        return;
+
+    const int category = entry->category;
+    owner->sizes[category] -= entry->size;
+    owner->nb_resources[category]--;
+
+    struct memtrack_stats *stats = &s->stats;
+    stats->sizes[category] -= entry->size;
+    stats->nb_resources[category]--;
+    stats->total_size -= entry->size;
+
+    TRACE("FREE %s %s/%s: %" PRId64 " bytes (total: %" PRId64 ")",
+          category_names[category], owner->type, owner->label, entry->size, stats->total_size);
+
+    memset(entry, 0, sizeof(*entry));
+    if (--owner->refcount == 0)
+        ngli_hmap_set(s->owners, owner->key, NULL);
+}
+
+int64_t ngli_memtrack_get_node_size(const struct memtrack *s, const struct ngl_node *node)
+{
+    char key[32];
+    get_owner_key(key, sizeof(key), node);
+
+    const struct memtrack_owner *owner = ngli_hmap_get(s->owners, key);
+    if (!owner)
+        return 0;
+
+    int64_t size = 0;
+    for (int i = 0; i < NGLI_MEMTRACK_NB; i++)
+        size += owner->sizes[i];
+    return size;
+}
+
+char *ngli_memtrack_export(const struct memtrack *s)
+{
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    ngli_bstr_print(b, "label,class,category,count,size\n");
+    const struct hmap_entry *e = NULL;
+    while ((e = ngli_hmap_next(s->owners, e))) {
+        const struct memtrack_owner *owner = e->data;
+        for (int i = 0; i < NGLI_MEMTRACK_NB; i++) {
+            if (!owner->nb_resources[i])
+                continue;
+            ngli_bstr_print_csv(b, owner->label);
+            ngli_bstr_printf(b, ",%s,%s,%d,%" PRId64 "\n", owner->type, category_names[i],
+                             owner->nb_resources[i], owner->sizes[i]);
+        }
+    }
+
+    char *str = ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return str;
+}
+
+void ngli_memtrack_reset(struct memtrack *s)
+{
+    if (s->owners && ngli_hmap_count(s->owners))
+        LOG(WARNING, "%d resource owner(s) still hold graphics memory (%" PRId64 " bytes)",
+            ngli_hmap_count(s->owners), s->stats.total_size);
+    ngli_hmap_freep(&s->owners);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef MEMTRACK_H
+#define MEMTRACK_H
+
+#include <stdint.h>
+
+#include "hmap.h"
+
+struct ngl_node;
+
+enum {
+    NGLI_MEMTRACK_BUFFER,     /* vertex, index, uniform and storage buffers */
+    NGLI_MEMTRACK_TEXTURE,    /* sampled and storage textures */
+    NGLI_MEMTRACK_ATTACHMENT, /* render target only textures (depth, stencil, MSAA) */
+    NGLI_MEMTRACK_NB
+};
+
+struct memtrack_stats {
+    int64_t sizes[NGLI_MEMTRACK_NB];        /* memory currently allocated */
+    int64_t max_sizes[NGLI_MEMTRACK_NB];    /* high-water marks of sizes */
+    int nb_resources[NGLI_MEMTRACK_NB];     /* number of live resources */
+    int64_t total_size;                     /* sum of sizes */
+    int64_t max_total_size;                 /* high-water mark of total_size */
+};
+
+struct memtrack_owner;
+
+/*
+ * Accounting record embedded in every tracked resource (buffer, texture)
+ */
+struct memtrack_entry {
+    struct memtrack_owner *owner;
+    int category;
+    int64_t size;
+};
+
+/*
+ * Memory accounting of the graphics resources allocated by a context,
+ * aggregated globally and per owning node. Resources allocated outside of any
+ * node (offscreen and capture render targets) and the pooled resources shared
+ * between nodes (glyph atlas, geometry arenas, transient attachments) are
+ * attributed to the context.
+ */
+struct memtrack {
+    struct hmap *owners;
+    struct memtrack_stats stats;
+};
+
+int ngli_memtrack_init(struct memtrack *s);
+int ngli_memtrack_add(struct memtrack *s, struct memtrack_entry *entry,
+                      const struct ngl_node *node, int category, int64_t size);
+void ngli_memtrack_remove(struct memtrack *s, struct memtrack_entry *entry);
+int64_t ngli_memtrack_get_node_size(const struct memtrack *s, const struct ngl_node *node);
+char *ngli_memtrack_export(const struct memtrack *s);
+void ngli_memtrack_reset(struct memtrack *s);
+
+#endif
@@ -23,6 +23,7 @@
 #include <stddef.h>
 #include <string.h>
 #include "animation.h"
+#include "animbatch.h"
 #include "log.h"
 #include "math_utils.h"
 #include "nodegl.h"
@@ -210,12 +211,21 @@ static int animation_init(struct ngl_node *node)
 {
     struct variable_priv *s = node->priv_data;
     s->dynamic = 1;
+    s->batch_index = -1;
     return ngli_animation_init(&s->anim, NULL,
                                s->animkf, s->nb_animkf,
                                get_mix_func(node->class->id),
                                get_cpy_func(node->class->id));
 }
 
+static int batched_animation_init(struct ngl_node *node)
+{
+    int ret = animation_init(node);
+    if (ret < 0)
+        return ret;
+    return ngli_animbatch_add(&node->ctx->animbatch, node);
+}
+
 #define DECLARE_INIT_FUNC(suffix, class_data, class_data_size, class_data_type) \
 static int animated##suffix##_init(struct ngl_node *node)                       \
 {                                                                               \
@@ -223,7 +233,7 @@ static int animated##suffix##_init(struct ngl_node *node)
     s->data = class_data;                                                       \
     s->data_size = class_data_size;                                             \
     s->data_type = class_data_type;                                             \
-    return animation_init(node);                                                \
+    return batched_animation_init(node);                                        \
 }
 
 DECLARE_INIT_FUNC(float, &s->scalar, sizeof(s->scalar),      NGLI_TYPE_FLOAT)
@@ -277,6 +287,18 @@ static int animation_update(struct ngl_node *node, double t)
     return ngli_animation_evaluate(&s->anim, s->data, t);
 }
 
+static void batched_animation_uninit(struct ngl_node *node)
+{
+    ngli_animbatch_remove(&node->ctx->animbatch, node);
+}
+
+#define animatedtime_uninit  NULL
+#define animatedfloat_uninit batched_animation_uninit
+#define animatedvec2_uninit  batched_animation_uninit
+#define animatedvec3_uninit  batched_animation_uninit
+#define animatedvec4_uninit  batched_animation_uninit
+#define animatedquat_uninit  NULL
+
 #define animatedtime_update  animation_update
 #define animatedfloat_update animation_update
 #define animatedvec2_update  animation_update
@@ -301,6 +323,7 @@ const struct node_class ngli_animated##type##_class = {         \
     .name      = class_name,                                    \
     .init      = animated##type##_init,                         \
     .update    = animated##type##_update,                       \
+    .uninit    = animated##type##_uninit,                       \
     .priv_size = sizeof(struct variable_priv),                  \
     .params    = animated##type##_params,                       \
     .file      = __FILE__,                                      \
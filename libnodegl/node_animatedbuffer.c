@@ -28,7 +28,9 @@
 #include "memory.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "threadpool.h"
 #include "type.h"
+#include "utils.h"
 
 #define OFFSET(x) offsetof(struct buffer_priv, x)
 static const struct node_param animatedbuffer_params[] = {
@@ -39,24 +41,56 @@ static const struct node_param animatedbuffer_params[] = {
     {NULL}
 };
 
+/* Minimum number of floats per job to make parallel interpolation worth it */
+#define MIX_JOB_MIN_SIZE (1 << 15)
+
+struct mix_job {
+    float *dst;
+    const float *d1;
+    const float *d2;
+    float ratio;
+    int nb_floats;
+};
+
+static void mix_job(void *arg, int job_id, int nb_jobs)
+{
+    const struct mix_job *s = arg;
+    const int chunk_size = NGLI_ALIGN(s->nb_floats / nb_jobs, 16);
+    const int start = job_id * chunk_size;
+    const int end = job_id == nb_jobs - 1 ? s->nb_floats : start + chunk_size;
+    ngli_mix_floats(s->dst + start, s->d1 + start, s->d2 + start, s->ratio, end - start);
+}
+
 static void mix_buffer(void *user_arg, void *dst,
                        const struct animkeyframe_priv *kf0,
                        const struct animkeyframe_priv *kf1,
                        double ratio)
 {
-    float *dstf = dst;
-    const struct buffer_priv *s = user_arg;
-    const float *d1 = (const float *)kf0->data;
-    const float *d2 = (const float *)kf1->data;
-    for (int k = 0; k < s->count; k++)
-        for (int i = 0; i < s->data_comp; i++)
-            dstf[k*s->data_comp + i] = NGLI_MIX(d1[k*s->data_comp + i], d2[k*s->data_comp + i], ratio);
+    struct ngl_node *node = user_arg;
+    const struct buffer_priv *s = node->priv_data;
+    struct mix_job job = {
+        .dst       = dst,
+        .d1        = (const float *)kf0->data,
+        .d2        = (const float *)kf1->data,
+        .ratio     = ratio,
+        .nb_floats = s->count * s->data_comp,
+    };
+
+    const int nb_chunks = job.nb_floats / MIX_JOB_MIN_SIZE;
+    struct threadpool *threadpool = nb_chunks > 1 ? ngli_get_threadpool(node->ctx) : NULL;
+    const int max_jobs = threadpool ? ngli_threadpool_get_nb_threads(threadpool) + 1 : 1;
+    const int nb_jobs = NGLI_MIN(nb_chunks, max_jobs);
+    if (nb_jobs > 1)
+        ngli_threadpool_execute(threadpool, mix_job, &job, nb_jobs);
+    else
+        mix_job(&job, 0, 1);
 }
 
 static void cpy_buffer(void *user_arg, void *dst,
                        const struct animkeyframe_priv *kf)
 {
-    const struct buffer_priv *s = user_arg;
+    const struct ngl_node *node = user_arg;
+    const struct buffer_priv *s = node->priv_data;
     memcpy(dst, kf->data, s->data_size);
 }
 
@@ -75,7 +109,7 @@ static int animatedbuffer_init(struct ngl_node *node)
     s->data_comp = ngli_format_get_nb_comp(s->data_format);
     s->data_stride = ngli_format_get_bytes_per_pixel(s->data_format);
 
-    int ret = ngli_animation_init(&s->anim, s,
+    int ret = ngli_animation_init(&s->anim, node,
                                   s->animkf, s->nb_animkf,
                                   mix_buffer, cpy_buffer);
     if (ret < 0)
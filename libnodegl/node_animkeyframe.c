@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "bstr.h"
+#include "easing.h"
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
@@ -84,6 +85,8 @@ static const struct node_param animkeyframe##id##_params[] = {
                              .desc=NGLI_DOCSTRING("starting offset of the truncation of the easing")},  \
     {"easing_end_offset",    PARAM_TYPE_DBL, OFFSET(offsets[1]), {.dbl=1},                              \
                              .desc=NGLI_DOCSTRING("ending offset of the truncation of the easing")},    \
+    {"easing_lut_tolerance", PARAM_TYPE_DBL, OFFSET(lut_tolerance), {.dbl=0},                           \
+                             .desc=NGLI_DOCSTRING("easing look-up table max error, 0 to disable")},    \
     {NULL}                                                                                              \
 }
 
@@ -286,51 +289,114 @@ static easing_type back_out_in(easing_type t, int args_nb, const easing_type *ar
     return (back_in(2.0 * t - 1.0, args_nb, args) + 1.0) / 2.0;
 }
 
+/*
+ * Array versions of the easings, used for the batch evaluation of the
+ * animations: the easing being inlined in the loop, the evaluation of many
+ * animations sharing the same easing does not involve any indirect call.
+ */
+#define DECLARE_BATCH_EASING(name)                                                  \
+static void name##_batch(easing_type *dst, const easing_type *x, int n,             \
+                         int args_nb, const easing_type *args)                      \
+{                                                                                   \
+    for (int i = 0; i < n; i++)                                                     \
+        dst[i] = name(x[i], args_nb, args);                                         \
+}
+
+DECLARE_BATCH_EASING(linear)
+
+/*
+ * The polynomial easings have vectorized versions (see ngli_ease_poly()),
+ * which are identical to their scalar counterparts.
+ */
+#define DECLARE_POLY_BATCH_EASING(name, degree, transform)                          \
+static void name##_batch(easing_type *dst, const easing_type *x, int n,             \
+                         int args_nb, const easing_type *args)                      \
+{                                                                                   \
+    ngli_ease_poly(dst, x, n, degree, transform);                                   \
+}
+
+#define DECLARE_POLY_BATCH_EASINGS(base_name, degree)                               \
+DECLARE_POLY_BATCH_EASING(base_name##_in,     degree, NGLI_EASE_IN)                 \
+DECLARE_POLY_BATCH_EASING(base_name##_out,    degree, NGLI_EASE_OUT)                \
+DECLARE_POLY_BATCH_EASING(base_name##_in_out, degree, NGLI_EASE_IN_OUT)             \
+DECLARE_POLY_BATCH_EASING(base_name##_out_in, degree, NGLI_EASE_OUT_IN)
+
+DECLARE_POLY_BATCH_EASINGS(quadratic, 2)
+DECLARE_POLY_BATCH_EASINGS(cubic,     3)
+DECLARE_POLY_BATCH_EASINGS(quartic,   4)
+DECLARE_POLY_BATCH_EASINGS(quintic,   5)
+
+DECLARE_BATCH_EASING(power_in)
+DECLARE_BATCH_EASING(power_out)
+DECLARE_BATCH_EASING(power_in_out)
+DECLARE_BATCH_EASING(power_out_in)
+DECLARE_BATCH_EASING(sinus_in)
+DECLARE_BATCH_EASING(sinus_out)
+DECLARE_BATCH_EASING(sinus_in_out)
+DECLARE_BATCH_EASING(sinus_out_in)
+DECLARE_BATCH_EASING(exp_in)
+DECLARE_BATCH_EASING(exp_out)
+DECLARE_BATCH_EASING(exp_in_out)
+DECLARE_BATCH_EASING(exp_out_in)
+DECLARE_BATCH_EASING(circular_in)
+DECLARE_BATCH_EASING(circular_out)
+DECLARE_BATCH_EASING(circular_in_out)
+DECLARE_BATCH_EASING(circular_out_in)
+DECLARE_BATCH_EASING(bounce_in)
+DECLARE_BATCH_EASING(bounce_out)
+DECLARE_BATCH_EASING(elastic_in)
+DECLARE_BATCH_EASING(elastic_out)
+DECLARE_BATCH_EASING(back_in)
+DECLARE_BATCH_EASING(back_out)
+DECLARE_BATCH_EASING(back_in_out)
+DECLARE_BATCH_EASING(back_out_in)
+
 static const struct {
     easing_function function;
     easing_function resolution;
+    easing_batch_function batch_function;
 } easings[] = {
-    [EASING_LINEAR]           = {linear,                 linear_resolution},
-    [EASING_QUADRATIC_IN]     = {quadratic_in,           quadratic_in_resolution},
-    [EASING_QUADRATIC_OUT]    = {quadratic_out,          quadratic_out_resolution},
-    [EASING_QUADRATIC_IN_OUT] = {quadratic_in_out,       quadratic_in_out_resolution},
-    [EASING_QUADRATIC_OUT_IN] = {quadratic_out_in,       quadratic_out_in_resolution},
-    [EASING_CUBIC_IN]         = {cubic_in,               cubic_in_resolution},
-    [EASING_CUBIC_OUT]        = {cubic_out,              cubic_out_resolution},
-    [EASING_CUBIC_IN_OUT]     = {cubic_in_out,           cubic_in_out_resolution},
-    [EASING_CUBIC_OUT_IN]     = {cubic_out_in,           cubic_out_in_resolution},
-    [EASING_QUARTIC_IN]       = {quartic_in,             quartic_in_resolution},
-    [EASING_QUARTIC_OUT]      = {quartic_out,            quartic_out_resolution},
-    [EASING_QUARTIC_IN_OUT]   = {quartic_in_out,         quartic_in_out_resolution},
-    [EASING_QUARTIC_OUT_IN]   = {quartic_out_in,         quartic_out_in_resolution},
-    [EASING_QUINTIC_IN]       = {quintic_in,             quintic_in_resolution},
-    [EASING_QUINTIC_OUT]      = {quintic_out,            quintic_out_resolution},
-    [EASING_QUINTIC_IN_OUT]   = {quintic_in_out,         quintic_in_out_resolution},
-    [EASING_QUINTIC_OUT_IN]   = {quintic_out_in,         quintic_out_in_resolution},
-    [EASING_POWER_IN]         = {power_in,               power_in_resolution},
-    [EASING_POWER_OUT]        = {power_out,              power_out_resolution},
-    [EASING_POWER_IN_OUT]     = {power_in_out,           power_in_out_resolution},
-    [EASING_POWER_OUT_IN]     = {power_out_in,           power_out_in_resolution},
-    [EASING_SINUS_IN]         = {sinus_in,               sinus_in_resolution},
-    [EASING_SINUS_OUT]        = {sinus_out,              sinus_out_resolution},
-    [EASING_SINUS_IN_OUT]     = {sinus_in_out,           sinus_in_out_resolution},
-    [EASING_SINUS_OUT_IN]     = {sinus_out_in,           sinus_out_in_resolution},
-    [EASING_EXP_IN]           = {exp_in,                 exp_in_resolution},
-    [EASING_EXP_OUT]          = {exp_out,                exp_out_resolution},
-    [EASING_EXP_IN_OUT]       = {exp_in_out,             exp_in_out_resolution},
-    [EASING_EXP_OUT_IN]       = {exp_out_in,             exp_out_in_resolution},
-    [EASING_CIRCULAR_IN]      = {circular_in,            circular_in_resolution},
-    [EASING_CIRCULAR_OUT]     = {circular_out,           circular_out_resolution},
-    [EASING_CIRCULAR_IN_OUT]  = {circular_in_out,        circular_in_out_resolution},
-    [EASING_CIRCULAR_OUT_IN]  = {circular_out_in,        circular_out_in_resolution},
-    [EASING_BOUNCE_IN]        = {bounce_in,              NULL},
-    [EASING_BOUNCE_OUT]       = {bounce_out,             NULL},
-    [EASING_ELASTIC_IN]       = {elastic_in,             NULL},
-    [EASING_ELASTIC_OUT]      = {elastic_out,            NULL},
-    [EASING_BACK_IN]          = {back_in,                NULL},
-    [EASING_BACK_OUT]         = {back_out,               NULL},
-    [EASING_BACK_IN_OUT]      = {back_in_out,            NULL},
-    [EASING_BACK_OUT_IN]      = {back_out_in,            NULL},
+    [EASING_LINEAR]           = {linear,                 linear_resolution,           linear_batch},
+    [EASING_QUADRATIC_IN]     = {quadratic_in,           quadratic_in_resolution,     quadratic_in_batch},
+    [EASING_QUADRATIC_OUT]    = {quadratic_out,          quadratic_out_resolution,    quadratic_out_batch},
+    [EASING_QUADRATIC_IN_OUT] = {quadratic_in_out,       quadratic_in_out_resolution, quadratic_in_out_batch},
+    [EASING_QUADRATIC_OUT_IN] = {quadratic_out_in,       quadratic_out_in_resolution, quadratic_out_in_batch},
+    [EASING_CUBIC_IN]         = {cubic_in,               cubic_in_resolution,         cubic_in_batch},
+    [EASING_CUBIC_OUT]        = {cubic_out,              cubic_out_resolution,        cubic_out_batch},
+    [EASING_CUBIC_IN_OUT]     = {cubic_in_out,           cubic_in_out_resolution,     cubic_in_out_batch},
+    [EASING_CUBIC_OUT_IN]     = {cubic_out_in,           cubic_out_in_resolution,     cubic_out_in_batch},
+    [EASING_QUARTIC_IN]       = {quartic_in,             quartic_in_resolution,       quartic_in_batch},
+    [EASING_QUARTIC_OUT]      = {quartic_out,            quartic_out_resolution,      quartic_out_batch},
+    [EASING_QUARTIC_IN_OUT]   = {quartic_in_out,         quartic_in_out_resolution,   quartic_in_out_batch},
+    [EASING_QUARTIC_OUT_IN]   = {quartic_out_in,         quartic_out_in_resolution,   quartic_out_in_batch},
+    [EASING_QUINTIC_IN]       = {quintic_in,             quintic_in_resolution,       quintic_in_batch},
+    [EASING_QUINTIC_OUT]      = {quintic_out,            quintic_out_resolution,      quintic_out_batch},
+    [EASING_QUINTIC_IN_OUT]   = {quintic_in_out,         quintic_in_out_resolution,   quintic_in_out_batch},
+    [EASING_QUINTIC_OUT_IN]   = {quintic_out_in,         quintic_out_in_resolution,   quintic_out_in_batch},
+    [EASING_POWER_IN]         = {power_in,               power_in_resolution,         power_in_batch},
+    [EASING_POWER_OUT]        = {power_out,              power_out_resolution,        power_out_batch},
+    [EASING_POWER_IN_OUT]     = {power_in_out,           power_in_out_resolution,     power_in_out_batch},
+    [EASING_POWER_OUT_IN]     = {power_out_in,           power_out_in_resolution,     power_out_in_batch},
+    [EASING_SINUS_IN]         = {sinus_in,               sinus_in_resolution,         sinus_in_batch},
+    [EASING_SINUS_OUT]        = {sinus_out,              sinus_out_resolution,        sinus_out_batch},
+    [EASING_SINUS_IN_OUT]     = {sinus_in_out,           sinus_in_out_resolution,     sinus_in_out_batch},
+    [EASING_SINUS_OUT_IN]     = {sinus_out_in,           sinus_out_in_resolution,     sinus_out_in_batch},
+    [EASING_EXP_IN]           = {exp_in,                 exp_in_resolution,           exp_in_batch},
+    [EASING_EXP_OUT]          = {exp_out,                exp_out_resolution,          exp_out_batch},
+    [EASING_EXP_IN_OUT]       = {exp_in_out,             exp_in_out_resolution,       exp_in_out_batch},
+    [EASING_EXP_OUT_IN]       = {exp_out_in,             exp_out_in_resolution,       exp_out_in_batch},
+    [EASING_CIRCULAR_IN]      = {circular_in,            circular_in_resolution,      circular_in_batch},
+    [EASING_CIRCULAR_OUT]     = {circular_out,           circular_out_resolution,     circular_out_batch},
+    [EASING_CIRCULAR_IN_OUT]  = {circular_in_out,        circular_in_out_resolution,  circular_in_out_batch},
+    [EASING_CIRCULAR_OUT_IN]  = {circular_out_in,        circular_out_in_resolution,  circular_out_in_batch},
+    [EASING_BOUNCE_IN]        = {bounce_in,              NULL,                        bounce_in_batch},
+    [EASING_BOUNCE_OUT]       = {bounce_out,             NULL,                        bounce_out_batch},
+    [EASING_ELASTIC_IN]       = {elastic_in,             NULL,                        elastic_in_batch},
+    [EASING_ELASTIC_OUT]      = {elastic_out,            NULL,                        elastic_out_batch},
+    [EASING_BACK_IN]          = {back_in,                NULL,                        back_in_batch},
+    [EASING_BACK_OUT]         = {back_out,               NULL,                        back_out_batch},
+    [EASING_BACK_IN_OUT]      = {back_in_out,            NULL,                        back_in_out_batch},
+    [EASING_BACK_OUT_IN]      = {back_out_in,            NULL,                        back_out_in_batch},
 };
 
 static int animkeyframe_init(struct ngl_node *node)
@@ -369,6 +435,7 @@ static int animkeyframe_init(struct ngl_node *node)
 
     s->function   = easings[easing_id].function;
     s->resolution = easings[easing_id].resolution;
+    s->batch_function = easings[easing_id].batch_function;
 
     if (s->offsets[0] || s->offsets[1] != 1.0) {
         s->scale_boundaries = 1;
@@ -376,9 +443,38 @@ static int animkeyframe_init(struct ngl_node *node)
         s->boundaries[1] = s->function(s->offsets[1], s->nb_args, s->args);
     }
 
+    ngli_easing_lut_reset(&s->lut);
+    if (s->lut_tolerance > 0.) {
+        /* The tolerance applies to the easing output once rescaled */
+        const double scale = s->scale_boundaries ? fabs(s->boundaries[1] - s->boundaries[0]) : 1.;
+        int ret = ngli_easing_lut_init(&s->lut, s->function, s->nb_args, s->args,
+                                       s->offsets[0], s->offsets[1], s->lut_tolerance * scale);
+        if (ret == NGL_ERROR_LIMIT_EXCEEDED)
+            LOG(WARNING, "%s easing can not be approximated within %g, "
+                "falling back on its direct evaluation", easing_name, s->lut_tolerance);
+        else if (ret < 0)
+            return ret;
+    }
+
     return 0;
 }
 
+static void animkeyframe_uninit(struct ngl_node *node)
+{
+    struct animkeyframe_priv *s = node->priv_data;
+    ngli_easing_lut_reset(&s->lut);
+}
+
+/*
+ * ngl_anim_evaluate() initializes the key frames outside of any rendering
+ * context, without ever uninitializing them
+ */
+static void animkeyframe_destroy(struct ngl_node *node)
+{
+    struct animkeyframe_priv *s = node->priv_data;
+    ngli_easing_lut_reset(&s->lut);
+}
+
 static char *animkeyframe_info_str(const struct ngl_node *node)
 {
     const struct animkeyframe_priv *s = node->priv_data;
@@ -445,17 +541,24 @@ int ngl_easing_solve(const char *name, double *args, int nb_args,
     int ret = ngli_params_get_select_val(easing_choices.consts, name, &easing_id);
     if (ret < 0)
         return ret;
-    if (!easings[easing_id].resolution) {
-        LOG(ERROR, "no resolution available for easing %s", name);
-        return NGL_ERROR_UNSUPPORTED;
-    }
+    const easing_function eval_func = easings[easing_id].function;
     if (offsets) {
-        const easing_function eval_func = easings[easing_id].function;
         const double start_value = eval_func(offsets[0], nb_args, args);
         const double end_value   = eval_func(offsets[1], nb_args, args);
         v = NGLI_MIX(start_value, end_value, v);
     }
-    double time = easings[easing_id].resolution(v, nb_args, args);
+    double time;
+    if (easings[easing_id].resolution) {
+        time = easings[easing_id].resolution(v, nb_args, args);
+    } else {
+        const double x0 = offsets ? offsets[0] : 0.;
+        const double x1 = offsets ? offsets[1] : 1.;
+        ret = ngli_easing_solve_numeric(eval_func, nb_args, args, x0, x1, v, &time);
+        if (ret < 0) {
+            LOG(ERROR, "easing %s never reaches %g", name, v);
+            return ret;
+        }
+    }
     if (offsets)
         time = (time - offsets[0]) / (offsets[1] - offsets[0]);
     *t = time;
@@ -467,6 +570,8 @@ const struct node_class ngli_animkeyframe##type##_class = { \
     .id        = class_id,                                  \
     .name      = class_name,                                \
     .init      = animkeyframe_init,                         \
+    .uninit    = animkeyframe_uninit,                       \
+    .destroy   = animkeyframe_destroy,                      \
     .info_str  = animkeyframe_info_str,                     \
     .priv_size = sizeof(struct animkeyframe_priv),          \
     .params    = animkeyframe##type##_params,               \
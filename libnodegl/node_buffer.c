@@ -63,13 +63,17 @@ int ngli_node_buffer_ref(struct ngl_node *node)
         if (!s->buffer)
             return NGL_ERROR_MEMORY;
 
-        int ret = ngli_buffer_init(s->buffer, s->data_size, s->usage);
+        /* The content of static buffers is never updated so they can be shared */
+        int ret = s->dynamic ? ngli_buffer_init(s->buffer, s->data_size, s->usage)
+                             : ngli_buffer_init_shared(s->buffer, s->data, s->data_size, s->usage);
         if (ret < 0)
             return ret;
 
-        ret = ngli_buffer_upload(s->buffer, s->data, s->data_size);
-        if (ret < 0)
-            return ret;
+        if (s->dynamic) {
+            ret = ngli_buffer_upload(s->buffer, s->data, s->data_size);
+            if (ret < 0)
+                return ret;
+        }
 
         s->buffer_last_upload_time = -1.;
     }
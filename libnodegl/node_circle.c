@@ -21,6 +21,7 @@
 
 #include <math.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include "log.h"
 #include "math_utils.h"
@@ -48,22 +49,24 @@ static int circle_init(struct ngl_node *node)
         LOG(ERROR, "invalid number of points (%d < 3)", s->npoints);
         return NGL_ERROR_INVALID_ARG;
     }
-    const int nb_vertices = s->npoints + 2;
+    /* Center followed by the ring points, shared by all the triangles */
+    const int nb_vertices = s->npoints + 1;
+    const int nb_indices = s->npoints * 3;
+    const int index_size = nb_vertices <= 0xffff + 1 ? sizeof(uint16_t) : sizeof(uint32_t);
 
     float *vertices  = ngli_calloc(nb_vertices, sizeof(*vertices)  * 3);
     float *uvcoords  = ngli_calloc(nb_vertices, sizeof(*uvcoords)  * 2);
     float *normals   = ngli_calloc(nb_vertices, sizeof(*normals)   * 3);
+    uint8_t *indices = ngli_calloc(nb_indices, index_size);
 
-    if (!vertices || !uvcoords || !normals)
+    if (!vertices || !uvcoords || !normals || !indices)
         goto end;
 
-
-    int i;
     const double step = 2.0 * M_PI / s->npoints;
 
     uvcoords[0] = 0.5;
     uvcoords[1] = 0.5;
-    for (i = 1; i < (nb_vertices - 1); i++) {
+    for (int i = 1; i < nb_vertices; i++) {
         const double angle = (i - 1) * step;
         const double x = sin(angle) * s->radius;
         const double y = cos(angle) * s->radius;
@@ -72,10 +75,16 @@ static int circle_init(struct ngl_node *node)
         uvcoords[i*2 + 0] = (x + 1.0) / 2.0;
         uvcoords[i*2 + 1] = (1.0 - y) / 2.0;
     }
-    vertices[i*3 + 0] = vertices[3 + 0];
-    vertices[i*3 + 1] = vertices[3 + 1];
-    uvcoords[i*2 + 0] = uvcoords[2 + 0];
-    uvcoords[i*2 + 1] = uvcoords[2 + 1];
+
+    for (int i = 0; i < s->npoints; i++) {
+        const uint32_t triangle[3] = {0, i + 1, (i + 1) % s->npoints + 1};
+        for (int j = 0; j < 3; j++) {
+            if (index_size == sizeof(uint16_t))
+                ((uint16_t *)indices)[i*3 + j] = triangle[j];
+            else
+                ((uint32_t *)indices)[i*3 + j] = triangle[j];
+        }
+    }
 
     static const float center[3] = {0};
     ngli_vec3_normalvec(normals, (float *)center, vertices, vertices + 3);
@@ -100,10 +109,22 @@ static int circle_init(struct ngl_node *node)
                                                            nb_vertices * sizeof(*normals) * 3,
                                                            normals);
 
-    if (!s->vertices_buffer || !s->uvcoords_buffer || !s->normals_buffer)
+    s->indices_buffer = ngli_node_geometry_generate_buffer(node->ctx,
+                                                           index_size == sizeof(uint16_t) ? NGL_NODE_BUFFERUSHORT
+                                                                                          : NGL_NODE_BUFFERUINT,
+                                                           nb_indices,
+                                                           nb_indices * index_size,
+                                                           indices);
+
+    if (!s->vertices_buffer || !s->uvcoords_buffer || !s->normals_buffer || !s->indices_buffer)
         goto end;
 
-    s->topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN;
+    s->max_indices = s->npoints;
+    s->topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    const float radius = fabs(s->radius);
+    const float bounds[] = {-radius, -radius, 0.0f, radius, radius, 0.0f};
+    ngli_node_geometry_set_bounds(s, bounds, 2, 3 * sizeof(*bounds));
 
     ret = 0;
 
@@ -111,23 +132,18 @@ end:
     ngli_free(vertices);
     ngli_free(uvcoords);
     ngli_free(normals);
+    ngli_free(indices);
     return ret;
 }
 
-#define NODE_UNREFP(node) do {                    \
-    if (node) {                                   \
-        ngli_node_detach_ctx(node, node->ctx);    \
-        ngl_node_unrefp(&node);                   \
-    }                                             \
-} while (0)
-
 static void circle_uninit(struct ngl_node *node)
 {
     struct geometry_priv *s = node->priv_data;
 
-    NODE_UNREFP(s->vertices_buffer);
-    NODE_UNREFP(s->uvcoords_buffer);
-    NODE_UNREFP(s->normals_buffer);
+    ngli_node_geometry_release_buffer(node->ctx, &s->vertices_buffer);
+    ngli_node_geometry_release_buffer(node->ctx, &s->uvcoords_buffer);
+    ngli_node_geometry_release_buffer(node->ctx, &s->normals_buffer);
+    ngli_node_geometry_release_buffer(node->ctx, &s->indices_buffer);
 }
 
 const struct node_class ngli_circle_class = {
@@ -24,36 +24,72 @@
 #include <string.h>
 #include <stdint.h>
 
+#include "geompool.h"
 #include "log.h"
+#include "math_utils.h"
 #include "nodegl.h"
 #include "nodes.h"
 #include "topology.h"
+#include "utils.h"
 
 struct ngl_node *ngli_node_geometry_generate_buffer(struct ngl_ctx *ctx, int type, int count, int size, void *data)
 {
-    struct ngl_node *node = ngl_node_create(type);
-    if (!node)
-        return NULL;
-
-    int ret = ngl_node_param_set(node, "count", count);
-    if (ret < 0)
-        goto fail;
-
-    if (data) {
-        int ret = ngl_node_param_set(node, "data", size, data);
-        if (ret < 0)
-            goto fail;
-    }
+    return ngli_geompool_ref(&ctx->geompool, ctx, type, count, size, data);
+}
 
-    ret = ngli_node_attach_ctx(node, ctx);
-    if (ret < 0)
-        goto fail;
+void ngli_node_geometry_release_buffer(struct ngl_ctx *ctx, struct ngl_node **nodep)
+{
+    ngli_geompool_unref(&ctx->geompool, nodep);
+}
+
+void ngli_node_geometry_set_bounds(struct geometry_priv *s, const float *vertices, int nb_vertices, int stride)
+{
+    s->has_bounds = nb_vertices > 0;
+    if (!s->has_bounds)
+        return;
+
+    memcpy(s->bounds_min, vertices, sizeof(s->bounds_min));
+    memcpy(s->bounds_max, vertices, sizeof(s->bounds_max));
+    for (int i = 1; i < nb_vertices; i++) {
+        const float *vertex = (const float *)((const uint8_t *)vertices + i * stride);
+        for (int j = 0; j < 3; j++) {
+            s->bounds_min[j] = NGLI_MIN(s->bounds_min[j], vertex[j]);
+            s->bounds_max[j] = NGLI_MAX(s->bounds_max[j], vertex[j]);
+        }
+    }
+}
 
-    return node;
-fail:
-    ngli_node_detach_ctx(node, ctx);
-    ngl_node_unrefp(&node);
-    return NULL;
+/*
+ * The geometry is considered invisible if all the corners of its bounding box
+ * lie outside the same plane of the clip volume. This test is conservative:
+ * some geometries not intersecting the view frustum may still be reported as
+ * visible.
+ */
+int ngli_node_geometry_is_visible(const struct ngl_node *node, const float *modelview_matrix, const float *projection_matrix)
+{
+    const struct geometry_priv *s = node->priv_data;
+    if (!s->has_bounds)
+        return 1;
+
+    NGLI_ALIGNED_MAT(mvp);
+    ngli_mat4_mul(mvp, projection_matrix, modelview_matrix);
+
+    int outside = 0x3f;
+    for (int i = 0; i < 8 && outside; i++) {
+        NGLI_ALIGNED_VEC(corner) = {
+            i & 1 ? s->bounds_max[0] : s->bounds_min[0],
+            i & 2 ? s->bounds_max[1] : s->bounds_min[1],
+            i & 4 ? s->bounds_max[2] : s->bounds_min[2],
+            1.0f,
+        };
+        NGLI_ALIGNED_VEC(clip);
+        ngli_mat4_mul_vec4(clip, mvp, corner);
+        const float w = clip[3];
+        outside &= (clip[0] < -w) << 0 | (clip[0] > w) << 1
+                 | (clip[1] < -w) << 2 | (clip[1] > w) << 3
+                 | (clip[2] < -w) << 4 | (clip[2] > w) << 5;
+    }
+    return !outside;
 }
 
 static const struct param_choices topology_choices = {
@@ -147,6 +183,10 @@ static int geometry_init(struct ngl_node *node)
         }
     }
 
+    /* Geometries with dynamic vertices have no bounds and are never culled */
+    if (!vertices->dynamic && !vertices->block && vertices->data)
+        ngli_node_geometry_set_bounds(s, (const float *)vertices->data, vertices->count, vertices->data_stride);
+
     return 0;
 }
 
@@ -22,12 +22,23 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
+#include "gctx.h"
+#include "log.h"
+#include "memory.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "renderbatch.h"
+
+struct group_batch {
+    int start;
+    int count;
+    struct renderbatch *batch;
+};
 
 struct group_priv {
     struct ngl_node **children;
     int nb_children;
+    struct darray batches; // group_batch, sorted by start
 };
 
 #define OFFSET(x) offsetof(struct group_priv, x)
@@ -37,6 +48,74 @@ static const struct node_param group_params[] = {
     {NULL}
 };
 
+static int add_batch(struct ngl_node *node, int start, int count)
+{
+    struct group_priv *s = node->priv_data;
+
+    struct renderbatch *batch = ngli_calloc(1, sizeof(*batch));
+    if (!batch)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_renderbatch_init(batch, node->ctx, node->label, &s->children[start], count);
+    if (ret < 0) {
+        ngli_renderbatch_uninit(batch);
+        ngli_free(batch);
+        return ret == NGL_ERROR_UNSUPPORTED ? 0 : ret;
+    }
+
+    struct group_batch group_batch = {.start = start, .count = count, .batch = batch};
+    if (!ngli_darray_push(&s->batches, &group_batch)) {
+        ngli_renderbatch_uninit(batch);
+        ngli_free(batch);
+        return NGL_ERROR_MEMORY;
+    }
+
+    LOG(DEBUG, "batching children %d to %d of %s in a single %s draw",
+        start, start + count - 1, node->label, batch->multi_draw ? "multi" : "instanced");
+    return 0;
+}
+
+/*
+ * Runs of consecutive children rendering the same geometry with the same
+ * program are merged into a single instanced draw. If multi-draw indirect is
+ * supported, the geometries only need to share the same layout.
+ */
+static int group_init(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gctx *gctx = ctx->gctx;
+    struct group_priv *s = node->priv_data;
+
+    ngli_darray_init(&s->batches, sizeof(struct group_batch), 0);
+
+    const int instancing = NGLI_FEATURE_DRAW_INSTANCED | NGLI_FEATURE_INSTANCED_ARRAY;
+    if ((gctx->features & instancing) != instancing)
+        return 0;
+
+    int start = 0;
+    while (start < s->nb_children) {
+        int end = start + 1;
+        while (end < s->nb_children && ngli_renderbatch_is_compatible(s->children[start], s->children[end]))
+            end++;
+        if (end - start > 1) {
+            int ret = add_batch(node, start, end - start);
+            if (ret < 0)
+                return ret;
+        }
+        start = end;
+    }
+
+    return 0;
+}
+
+static void drop_batch(struct group_priv *s, int batch_id)
+{
+    struct group_batch *batch = ngli_darray_get(&s->batches, batch_id);
+    ngli_renderbatch_uninit(batch->batch);
+    ngli_freep(&batch->batch);
+    ngli_darray_remove(&s->batches, batch_id);
+}
+
 static int group_prepare(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -44,12 +123,42 @@ static int group_prepare(struct ngl_node *node)
 
     int ret = 0;
     struct rnode *rnode_pos = ctx->rnode_pos;
+    const struct group_batch *batches = ngli_darray_data(&s->batches);
+    int nb_batches = ngli_darray_count(&s->batches);
+    int batch_id = 0;
     for (int i = 0; i < s->nb_children; i++) {
         struct rnode *rnode = ngli_rnode_add_child(rnode_pos);
         if (!rnode)
             return NGL_ERROR_MEMORY;
         ctx->rnode_pos = rnode;
 
+        /*
+         * The batch is prepared in place of its first member. The other
+         * members keep an empty render node so the indexes of the children
+         * render nodes stay unchanged. A batch whose program turns out to be
+         * unsuitable is dropped and its members are prepared individually.
+         */
+        if (batch_id < nb_batches && i == batches[batch_id].start) {
+            ret = ngli_renderbatch_prepare(batches[batch_id].batch);
+            if (ret == NGL_ERROR_UNSUPPORTED) {
+                LOG(DEBUG, "unbatching children %d to %d of %s",
+                    i, i + batches[batch_id].count - 1, node->label);
+                drop_batch(s, batch_id);
+                batches = ngli_darray_data(&s->batches);
+                nb_batches = ngli_darray_count(&s->batches);
+                ret = 0;
+            }
+            if (ret < 0)
+                goto done;
+        }
+
+        if (batch_id < nb_batches && i >= batches[batch_id].start) {
+            const struct group_batch *batch = &batches[batch_id];
+            if (i == batch->start + batch->count - 1)
+                batch_id++;
+            continue;
+        }
+
         struct ngl_node *child = s->children[i];
         ret = ngli_node_prepare(child);
         if (ret < 0)
@@ -82,20 +191,42 @@ static void group_draw(struct ngl_node *node)
 
     struct rnode *rnode_pos = ctx->rnode_pos;
     struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
+    const struct group_batch *batches = ngli_darray_data(&s->batches);
+    const int nb_batches = ngli_darray_count(&s->batches);
+    int batch_id = 0;
     for (int i = 0; i < s->nb_children; i++) {
         ctx->rnode_pos = &rnodes[i];
+        if (batch_id < nb_batches && i == batches[batch_id].start) {
+            const struct group_batch *batch = &batches[batch_id++];
+            ngli_renderbatch_draw(batch->batch);
+            i += batch->count - 1;
+            continue;
+        }
         struct ngl_node *child = s->children[i];
         ngli_node_draw(child);
     }
     ctx->rnode_pos = rnode_pos;
 }
 
+static void group_uninit(struct ngl_node *node)
+{
+    struct group_priv *s = node->priv_data;
+    struct group_batch *batches = ngli_darray_data(&s->batches);
+    for (int i = 0; i < ngli_darray_count(&s->batches); i++) {
+        ngli_renderbatch_uninit(batches[i].batch);
+        ngli_freep(&batches[i].batch);
+    }
+    ngli_darray_reset(&s->batches);
+}
+
 const struct node_class ngli_group_class = {
     .id        = NGL_NODE_GROUP,
     .name      = "Group",
+    .init      = group_init,
     .prepare   = group_prepare,
     .update    = group_update,
     .draw      = group_draw,
+    .uninit    = group_uninit,
     .priv_size = sizeof(struct group_priv),
     .params    = group_params,
     .file      = __FILE__,
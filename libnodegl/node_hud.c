@@ -19,9 +19,18 @@
  * under the License.
  */
 
+#ifndef TARGET_MINGW_W64
+#define _POSIX_C_SOURCE 200809L // pthread_sigmask(), sigwait()
+#endif
+
+#include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
 #include <math.h>
+#ifndef TARGET_MINGW_W64
+#include <pthread.h>
+#include <signal.h>
+#endif
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -53,9 +62,13 @@ struct hud_priv {
 
     struct darray widgets;
     uint32_t bg_color_u32;
+    int headless;
     int fd_export;
+    int export_failed;
     struct bstr *csv_line;
     struct canvas canvas;
+    struct darray dirty_rects; // rect
+    int need_full_upload;
     double refresh_rate_interval;
     double last_refresh_time;
     int need_refresh;
@@ -79,7 +92,7 @@ static const struct node_param hud_params[] = {
     {"refresh_rate",   PARAM_TYPE_RATIONAL, OFFSET(refresh_rate),
                        .desc=NGLI_DOCSTRING("refresh data buffer every `update_rate` second")},
     {"export_filename", PARAM_TYPE_STR, OFFSET(export_filename),
-                        .desc=NGLI_DOCSTRING("path to export file (CSV), disable display if enabled")},
+                        .desc=NGLI_DOCSTRING("path to export file (CSV), `-` for the standard output, or a named pipe which must have a reader, disable display if enabled")},
     {"bg_color", PARAM_TYPE_VEC4, OFFSET(bg_color), {.vec={0.0, 0.0, 0.0, 1.0}},
                  .desc=NGLI_DOCSTRING("background buffer color")},
     {"aspect_ratio", PARAM_TYPE_RATIONAL, OFFSET(aspect_ratio),
@@ -266,6 +279,11 @@ enum widget_type {
     WIDGET_DRAWCALL,
 };
 
+enum graph_type {
+    GRAPH_LINE,
+    GRAPH_BLOCK,
+};
+
 struct data_graph {
     int64_t *values;
     int nb_values;
@@ -308,8 +326,11 @@ struct widget {
     enum widget_type type;
     struct rect rect;
     int text_x, text_y;
+    struct rect text_rect;
     struct rect graph_rect;
     struct data_graph *data_graph;
+    int64_t graph_min, graph_max; // scale of the graphs currently drawn in the canvas
+    int nb_drawn_columns;
     const void *user_data;
     void *priv_data;
 };
@@ -594,57 +615,55 @@ static int clip(int x, int min, int max)
     return x;
 }
 
-static void draw_block_graph(struct hud_priv *s,
-                             const struct data_graph *d,
-                             const struct rect *rect,
-                             int64_t graph_min, int64_t graph_max,
-                             const uint32_t c)
+static int get_graph_y(int64_t v, int64_t graph_min, int64_t graph_max, int h)
 {
-    const int64_t graph_h = graph_max - graph_min;
-    const float vscale = (float)rect->h / graph_h;
-    const int start = (d->pos - d->count + d->nb_values) % d->nb_values;
-
-    for (int k = 0; k < d->count; k++) {
-        const int64_t v = d->values[(start + k) % d->nb_values];
-        const int h = (v - graph_min) * vscale;
-        const int y = clip(rect->h - h, 0, rect->h);
-        uint8_t *p = s->canvas.buf + get_pixel_pos(s, rect->x + k, rect->y + y);
-
-        for (int z = 0; z < h; z++) {
-            set_color(p, c);
-            p += s->canvas.w * 4;
-        }
-    }
+    const float vscale = (float)h / (graph_max - graph_min);
+    return (v - graph_min) * vscale;
 }
 
-static void draw_line_graph(struct hud_priv *s,
-                            const struct data_graph *d,
-                            const struct rect *rect,
-                            int64_t graph_min, int64_t graph_max,
-                            const uint32_t c)
+static int64_t get_graph_value(const struct data_graph *d, int k)
 {
-    const int64_t graph_h = graph_max - graph_min;
-    const float vscale = (float)rect->h / graph_h;
     const int start = (d->pos - d->count + d->nb_values) % d->nb_values;
-    int prev_y;
+    return d->values[(start + k) % d->nb_values];
+}
 
-    for (int k = 0; k < d->count; k++) {
-        const int64_t v = d->values[(start + k) % d->nb_values];
-        const int h = (v - graph_min) * vscale;
-        const int y = clip(rect->h - 1 - h, 0, rect->h - 1);
-        uint8_t *p = s->canvas.buf + get_pixel_pos(s, rect->x + k, rect->y + y);
+static void draw_block_graph_column(struct hud_priv *s,
+                                    const struct data_graph *d,
+                                    const struct rect *rect,
+                                    int64_t graph_min, int64_t graph_max,
+                                    const uint32_t c, int k)
+{
+    const int h = get_graph_y(get_graph_value(d, k), graph_min, graph_max, rect->h);
+    const int y = clip(rect->h - h, 0, rect->h);
+    uint8_t *p = s->canvas.buf + get_pixel_pos(s, rect->x + k, rect->y + y);
 
+    for (int z = 0; z < h; z++) {
         set_color(p, c);
-        if (k) {
-            const int sign = prev_y < y ? 1 : -1;
-            const int column_h = abs(prev_y - y);
-            uint8_t *p = s->canvas.buf + get_pixel_pos(s, rect->x + k, rect->y + prev_y);
-            for (int z = 0; z < column_h; z++) {
-                set_color(p, c);
-                p += sign * s->canvas.w * 4;
-            }
+        p += s->canvas.w * 4;
+    }
+}
+
+static void draw_line_graph_column(struct hud_priv *s,
+                                   const struct data_graph *d,
+                                   const struct rect *rect,
+                                   int64_t graph_min, int64_t graph_max,
+                                   const uint32_t c, int k)
+{
+    const int h = get_graph_y(get_graph_value(d, k), graph_min, graph_max, rect->h);
+    const int y = clip(rect->h - 1 - h, 0, rect->h - 1);
+    uint8_t *p = s->canvas.buf + get_pixel_pos(s, rect->x + k, rect->y + y);
+
+    set_color(p, c);
+    if (k) {
+        const int prev_h = get_graph_y(get_graph_value(d, k - 1), graph_min, graph_max, rect->h);
+        const int prev_y = clip(rect->h - 1 - prev_h, 0, rect->h - 1);
+        const int sign = prev_y < y ? 1 : -1;
+        const int column_h = abs(prev_y - y);
+        uint8_t *p = s->canvas.buf + get_pixel_pos(s, rect->x + k, rect->y + prev_y);
+        for (int z = 0; z < column_h; z++) {
+            set_color(p, c);
+            p += sign * s->canvas.w * 4;
         }
-        prev_y = y;
     }
 }
 
@@ -661,6 +680,92 @@ static void widgets_clear(struct hud_priv *s)
         ngli_drawutils_draw_rect(&s->canvas, &widgets[i].rect, s->bg_color_u32);
 }
 
+static void mark_dirty(struct hud_priv *s, const struct rect *rect)
+{
+    if (!ngli_darray_push(&s->dirty_rects, rect))
+        s->need_full_upload = 1;
+}
+
+static void clear_text(struct hud_priv *s, struct widget *widget)
+{
+    ngli_drawutils_draw_rect(&s->canvas, &widget->text_rect, s->bg_color_u32);
+    mark_dirty(s, &widget->text_rect);
+}
+
+static void draw_graph_column(struct hud_priv *s, const struct widget *widget,
+                              enum graph_type type, const uint32_t *colors, int nb_graphs, int k)
+{
+    for (int i = 0; i < nb_graphs; i++) {
+        if (type == GRAPH_LINE)
+            draw_line_graph_column(s, &widget->data_graph[i], &widget->graph_rect,
+                                   widget->graph_min, widget->graph_max, colors[i], k);
+        else
+            draw_block_graph_column(s, &widget->data_graph[i], &widget->graph_rect,
+                                    widget->graph_min, widget->graph_max, colors[i], k);
+    }
+}
+
+static void clear_graph_column(struct hud_priv *s, const struct widget *widget, int k)
+{
+    const struct rect *graph_rect = &widget->graph_rect;
+    const struct rect column = {graph_rect->x + k, graph_rect->y, 1, graph_rect->h};
+    ngli_drawutils_draw_rect(&s->canvas, &column, s->bg_color_u32);
+}
+
+/* Shift the graph area by one column to the left */
+static void scroll_graph(struct hud_priv *s, const struct widget *widget)
+{
+    const struct rect *rect = &widget->graph_rect;
+    for (int y = 0; y < rect->h; y++) {
+        uint8_t *p = s->canvas.buf + get_pixel_pos(s, rect->x, rect->y + y);
+        memmove(p, p + 4, (rect->w - 1) * 4);
+    }
+    clear_graph_column(s, widget, rect->w - 1);
+}
+
+/*
+ * Update the graphs of a widget after a new value has been registered in each
+ * of its data graphs. As long as the scale does not change, only the new
+ * column is drawn (the previous ones being scrolled if the graph is full),
+ * otherwise the whole graph area is redrawn.
+ */
+static void draw_graphs(struct hud_priv *s, struct widget *widget,
+                        enum graph_type type, const uint32_t *colors, int nb_graphs,
+                        int64_t graph_min, int64_t graph_max)
+{
+    const int count = widget->data_graph[0].count;
+
+    mark_dirty(s, &widget->graph_rect);
+
+    if (graph_min == graph_max) {
+        if (widget->nb_drawn_columns)
+            ngli_drawutils_draw_rect(&s->canvas, &widget->graph_rect, s->bg_color_u32);
+        widget->nb_drawn_columns = 0;
+        return;
+    }
+
+    if (!widget->nb_drawn_columns || graph_min != widget->graph_min || graph_max != widget->graph_max) {
+        widget->graph_min = graph_min;
+        widget->graph_max = graph_max;
+        ngli_drawutils_draw_rect(&s->canvas, &widget->graph_rect, s->bg_color_u32);
+        for (int k = 0; k < count; k++)
+            draw_graph_column(s, widget, type, colors, nb_graphs, k);
+        widget->nb_drawn_columns = count;
+        return;
+    }
+
+    if (widget->nb_drawn_columns == count) {
+        scroll_graph(s, widget);
+        /* The first line graph column must not connect to the dropped value */
+        if (type == GRAPH_LINE) {
+            clear_graph_column(s, widget, 0);
+            draw_graph_column(s, widget, type, colors, nb_graphs, 0);
+        }
+    }
+    draw_graph_column(s, widget, type, colors, nb_graphs, count - 1);
+    widget->nb_drawn_columns = count;
+}
+
 /* Widget draw */
 
 static void register_graph_value(struct data_graph *d, int64_t v)
@@ -703,13 +808,17 @@ static void widget_latency_draw(struct ngl_node *node, struct widget *widget)
     struct hud_priv *s = node->priv_data;
     struct widget_latency *priv = widget->priv_data;
 
+    clear_text(s, widget);
+
     char buf[LATENCY_WIDGET_TEXT_LEN + 1];
+    uint32_t colors[NB_LATENCY];
     for (int i = 0; i < NB_LATENCY; i++) {
         const int64_t t = get_latency_avg(priv, i);
 
         snprintf(buf, sizeof(buf), "%s %5" PRId64 "usec", latency_specs[i].label, t);
         print_text(s, widget->text_x, widget->text_y + i * NGLI_FONT_H, buf, latency_specs[i].color);
         register_graph_value(&widget->data_graph[i], t);
+        colors[i] = latency_specs[i].color;
     }
 
     int64_t graph_min = widget->data_graph[0].min;
@@ -719,12 +828,7 @@ static void widget_latency_draw(struct ngl_node *node, struct widget *widget)
         graph_max = NGLI_MAX(graph_max, widget->data_graph[i].max);
     }
 
-    const int64_t graph_h = graph_max - graph_min;
-    if (graph_h) {
-        for (int i = 0; i < NB_LATENCY; i++)
-            draw_line_graph(s, &widget->data_graph[i], &widget->graph_rect,
-                            graph_min, graph_max, latency_specs[i].color);
-    }
+    draw_graphs(s, widget, GRAPH_LINE, colors, NB_LATENCY, graph_min, graph_max);
 }
 
 static void widget_memory_draw(struct ngl_node *node, struct widget *widget)
@@ -732,6 +836,9 @@ static void widget_memory_draw(struct ngl_node *node, struct widget *widget)
     struct hud_priv *s = node->priv_data;
     struct widget_memory *priv = widget->priv_data;
     char buf[MEMORY_WIDGET_TEXT_LEN + 1];
+    uint32_t colors[NB_MEMORY];
+
+    clear_text(s, widget);
 
     for (int i = 0; i < NB_MEMORY; i++) {
         const uint64_t size = priv->sizes[i];
@@ -748,6 +855,7 @@ static void widget_memory_draw(struct ngl_node *node, struct widget *widget)
             snprintf(buf, sizeof(buf), "%-12s %"PRIu64"G", label, size / (1024 * 1024 * 1024));
         print_text(s, widget->text_x, widget->text_y + i * NGLI_FONT_H, buf, color);
         register_graph_value(&widget->data_graph[i], size);
+        colors[i] = color;
     }
 
     int64_t graph_min = widget->data_graph[0].min;
@@ -757,12 +865,7 @@ static void widget_memory_draw(struct ngl_node *node, struct widget *widget)
         graph_max = NGLI_MAX(graph_max, widget->data_graph[i].max);
     }
 
-    const int64_t graph_h = graph_max - graph_min;
-    if (graph_h) {
-        for (int i = 0; i < NB_MEMORY; i++)
-            draw_line_graph(s, &widget->data_graph[i], &widget->graph_rect,
-                            graph_min, graph_max, memory_specs[i].color);
-    }
+    draw_graphs(s, widget, GRAPH_LINE, colors, NB_MEMORY, graph_min, graph_max);
 }
 
 static void widget_activity_draw(struct ngl_node *node, struct widget *widget)
@@ -772,6 +875,8 @@ static void widget_activity_draw(struct ngl_node *node, struct widget *widget)
     const struct activity_spec *spec = widget->user_data;
     const uint32_t color = 0x3df4f4ff;
 
+    clear_text(s, widget);
+
     char buf[ACTIVITY_WIDGET_TEXT_LEN + 1];
     snprintf(buf, sizeof(buf), "%d/%d", priv->nb_actives, priv->nodes.count);
     print_text(s, widget->text_x, widget->text_y, spec->label, color);
@@ -779,7 +884,7 @@ static void widget_activity_draw(struct ngl_node *node, struct widget *widget)
 
     struct data_graph *d = &widget->data_graph[0];
     register_graph_value(d, priv->nb_actives);
-    draw_block_graph(s, d, &widget->graph_rect, d->amin, d->amax, color);
+    draw_graphs(s, widget, GRAPH_BLOCK, &color, 1, d->amin, d->amax);
 }
 
 static void widget_drawcall_draw(struct ngl_node *node, struct widget *widget)
@@ -789,6 +894,8 @@ static void widget_drawcall_draw(struct ngl_node *node, struct widget *widget)
     const struct drawcall_spec *spec = widget->user_data;
     const uint32_t color = 0x3df43dff;
 
+    clear_text(s, widget);
+
     char buf[DRAWCALL_WIDGET_TEXT_LEN + 1];
     snprintf(buf, sizeof(buf), "%d", priv->nb_draws);
     print_text(s, widget->text_x, widget->text_y, spec->label, color);
@@ -796,7 +903,7 @@ static void widget_drawcall_draw(struct ngl_node *node, struct widget *widget)
 
     struct data_graph *d = &widget->data_graph[0];
     register_graph_value(d, priv->nb_draws);
-    draw_block_graph(s, d, &widget->graph_rect, d->amin, d->amax, color);
+    draw_graphs(s, widget, GRAPH_BLOCK, &color, 1, d->amin, d->amax);
 }
 
 /* Widget CSV header */
@@ -981,6 +1088,12 @@ static int create_widget(struct hud_priv *s, enum widget_type type, const void *
         .rect.h    = get_widget_height(type),
         .text_x    = x + WIDGET_PADDING,
         .text_y    = y + WIDGET_PADDING,
+        .text_rect = {
+            .x = x + WIDGET_PADDING,
+            .y = y + WIDGET_PADDING,
+            .w = spec->text_cols * NGLI_FONT_W,
+            .h = spec->text_rows * NGLI_FONT_H,
+        },
         .user_data = user_data,
     };
 
@@ -1143,15 +1256,112 @@ static void widgets_draw(struct ngl_node *node)
     }
 }
 
-static int widgets_csv_header(struct ngl_node *node)
+/*
+ * Writing to a pipe whose reader is gone raises SIGPIPE, which terminates the
+ * process by default: the signal is blocked during the write and the one it
+ * raised, if any, is consumed before being unblocked.
+ */
+static ssize_t write_nosigpipe(int fd, const void *buf, size_t count)
+{
+#ifdef TARGET_MINGW_W64
+    return write(fd, buf, count);
+#else
+    sigset_t sigpipe_mask, pending, old_mask;
+    sigemptyset(&sigpipe_mask);
+    sigaddset(&sigpipe_mask, SIGPIPE);
+
+    sigpending(&pending);
+    const int was_pending = sigismember(&pending, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe_mask, &old_mask);
+
+    const ssize_t n = write(fd, buf, count);
+    const int write_errno = errno;
+
+    if (n == -1 && write_errno == EPIPE && !was_pending) {
+        sigpending(&pending);
+        if (sigismember(&pending, SIGPIPE)) {
+            int sig;
+            sigwait(&sigpipe_mask, &sig);
+        }
+    }
+
+    pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+    errno = write_errno;
+    return n;
+#endif
+}
+
+static int export_csv_line(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
+    const struct ngl_config *config = &ctx->config;
     struct hud_priv *s = node->priv_data;
+    const char *line = ngli_bstr_strptr(s->csv_line);
+
+    if (config->hud_export_callback)
+        config->hud_export_callback(config->hud_export_arg, line);
 
-    s->fd_export = open(s->export_filename, O_CREAT | O_WRONLY | O_TRUNC, 0644);
-    if (s->fd_export == -1) {
-        LOG(ERROR, "unable to open \"%s\" for writing", s->export_filename);
+    if (s->fd_export == -1 || s->export_failed)
+        return 0;
+
+    const int len = ngli_bstr_len(s->csv_line);
+    ssize_t n = write_nosigpipe(s->fd_export, line, len);
+    if (n == -1 && errno == EPIPE) {
+        /* The reader closed its end of the pipe: stop exporting but keep rendering */
+        LOG(WARNING, "\"%s\" has no reader anymore, disabling export", s->export_filename);
+        s->export_failed = 1;
+        return 0;
+    }
+    if (n != len) {
+        LOG(ERROR, "unable to write CSV line to \"%s\", disabling export", s->export_filename);
+        s->export_failed = 1;
         return NGL_ERROR_IO;
     }
+    return 0;
+}
+
+/*
+ * A named pipe is opened without blocking until a reader shows up (the open
+ * fails if there is none), then switched back to blocking writes so that no
+ * line is lost when the reader falls behind.
+ */
+static int open_export_file(const char *filename)
+{
+#ifndef TARGET_MINGW_W64
+    struct stat st;
+    if (stat(filename, &st) == 0 && S_ISFIFO(st.st_mode)) {
+        int fd = open(filename, O_WRONLY | O_NONBLOCK);
+        if (fd == -1) {
+            if (errno == ENXIO)
+                LOG(ERROR, "named pipe \"%s\" has no reader", filename);
+            return -1;
+        }
+        const int flags = fcntl(fd, F_GETFL);
+        if (flags == -1 || fcntl(fd, F_SETFL, flags & ~O_NONBLOCK) == -1) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+#endif
+    return open(filename, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+}
+
+static int widgets_csv_header(struct ngl_node *node)
+{
+    struct hud_priv *s = node->priv_data;
+
+    if (s->export_filename) {
+        if (!strcmp(s->export_filename, "-")) {
+            s->fd_export = STDOUT_FILENO;
+        } else {
+            s->fd_export = open_export_file(s->export_filename);
+            if (s->fd_export == -1) {
+                LOG(ERROR, "unable to open \"%s\" for writing", s->export_filename);
+                return NGL_ERROR_IO;
+            }
+        }
+    }
 
     s->csv_line = ngli_bstr_create();
     if (!s->csv_line)
@@ -1169,14 +1379,7 @@ static int widgets_csv_header(struct ngl_node *node)
 
     ngli_bstr_print(s->csv_line, "\n");
 
-    const int len = ngli_bstr_len(s->csv_line);
-    ssize_t n = write(s->fd_export, ngli_bstr_strptr(s->csv_line), len);
-    if (n != len) {
-        LOG(ERROR, "unable to write CSV header");
-        return NGL_ERROR_IO;
-    }
-
-    return 0;
+    return export_csv_line(node);
 }
 
 static void widgets_csv_report(struct ngl_node *node)
@@ -1196,8 +1399,7 @@ static void widgets_csv_report(struct ngl_node *node)
     }
     ngli_bstr_print(s->csv_line, "\n");
 
-    const int len = ngli_bstr_len(s->csv_line);
-    write(s->fd_export, ngli_bstr_strptr(s->csv_line), len);
+    export_csv_line(node);
 }
 
 static void free_widget(struct widget *widget)
@@ -1246,6 +1448,9 @@ static int hud_init(struct ngl_node *node)
     struct gctx *gctx = ctx->gctx;
     struct hud_priv *s = node->priv_data;
 
+    s->fd_export = -1;
+    ngli_darray_init(&s->dirty_rects, sizeof(struct rect), 0);
+
     int ret = widgets_init(node);
     if (ret < 0)
         return ret;
@@ -1254,7 +1459,12 @@ static int hud_init(struct ngl_node *node)
         s->refresh_rate_interval = s->refresh_rate[0] / (double)s->refresh_rate[1];
     s->last_refresh_time = -1;
 
-    if (s->export_filename)
+    /*
+     * In headless mode, the stats are only collected and streamed: no canvas
+     * is rasterized or uploaded so the measures are not perturbed.
+     */
+    s->headless = s->export_filename || ctx->config.hud_export_callback;
+    if (s->headless)
         return widgets_csv_header(node);
 
     s->canvas.buf = ngli_calloc(s->canvas.w * s->canvas.h, 4);
@@ -1263,6 +1473,7 @@ static int hud_init(struct ngl_node *node)
 
     s->bg_color_u32 = NGLI_COLOR_VEC4_TO_U32(s->bg_color);
     widgets_clear(s);
+    s->need_full_upload = 1;
 
     static const float coords[] = {
         -1.0f, -1.0f, 0.0f, 1.0f,
@@ -1385,6 +1596,32 @@ static int hud_update(struct ngl_node *node, double t)
     return widget_latency_update(node, &widgets[0], t);
 }
 
+/*
+ * Only the canvas areas modified since the last upload are transferred to the
+ * texture, which is left untouched when nothing was refreshed.
+ */
+static int upload_canvas(struct hud_priv *s)
+{
+    int ret = 0;
+
+    if (s->need_full_upload) {
+        ret = ngli_texture_upload(s->texture, s->canvas.buf, 0);
+        s->need_full_upload = 0;
+    } else if (ngli_darray_count(&s->dirty_rects)) {
+        const struct rect *rects = ngli_darray_data(&s->dirty_rects);
+        for (int i = 0; i < ngli_darray_count(&s->dirty_rects) && ret >= 0; i++) {
+            const struct rect *r = &rects[i];
+            const uint8_t *data = s->canvas.buf + get_pixel_pos(s, r->x, r->y);
+            ret = ngli_texture_upload_rect(s->texture, data, s->canvas.w, r->x, r->y, r->w, r->h);
+        }
+        if (ret >= 0 && ngli_texture_has_mipmap(s->texture))
+            ret = ngli_texture_generate_mipmap(s->texture);
+    }
+
+    while (ngli_darray_pop(&s->dirty_rects));
+    return ret;
+}
+
 static void hud_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -1392,19 +1629,16 @@ static void hud_draw(struct ngl_node *node)
 
     widgets_make_stats(node);
     if (s->need_refresh) {
-        if (s->export_filename) {
+        if (s->headless)
             widgets_csv_report(node);
-        } else {
-            widgets_clear(s);
+        else
             widgets_draw(node);
-        }
     }
 
-    if (s->export_filename)
+    if (s->headless)
         return;
 
-    int ret = ngli_texture_upload(s->texture, s->canvas.buf, 0);
-    if (ret < 0)
+    if (upload_canvas(s) < 0)
         return;
 
     const float *modelview_matrix  = ngli_darray_tail(&ctx->modelview_matrix_stack);
@@ -1424,11 +1658,11 @@ static void hud_uninit(struct ngl_node *node)
     ngli_buffer_freep(&s->coords);
 
     widgets_uninit(node);
+    ngli_darray_reset(&s->dirty_rects);
     ngli_free(s->canvas.buf);
-    if (s->export_filename) {
+    if (s->fd_export != -1 && s->fd_export != STDOUT_FILENO)
         close(s->fd_export);
-        ngli_bstr_freep(&s->csv_line);
-    }
+    ngli_bstr_freep(&s->csv_line);
 }
 
 const struct node_class ngli_hud_class = {
@@ -274,6 +274,19 @@ static void media_release(struct ngl_node *node)
     sxplayer_stop(s->player);
 }
 
+static int64_t media_memory_usage(const struct ngl_node *node)
+{
+    const struct media_priv *s = node->priv_data;
+    const struct sxplayer_frame *frame = s->frame;
+
+    /* Hardware frames live in the decoder pools and can not be accounted */
+    if (!frame || (frame->pix_fmt != SXPLAYER_PIXFMT_RGBA &&
+                   frame->pix_fmt != SXPLAYER_PIXFMT_BGRA &&
+                   frame->pix_fmt != SXPLAYER_SMPFMT_FLT))
+        return 0;
+    return (int64_t)frame->linesize * frame->height;
+}
+
 static void media_uninit(struct ngl_node *node)
 {
     struct media_priv *s = node->priv_data;
@@ -294,6 +307,7 @@ const struct node_class ngli_media_class = {
     .update    = media_update,
     .release   = media_release,
     .uninit    = media_uninit,
+    .memory_usage = media_memory_usage,
     .priv_size = sizeof(struct media_priv),
     .params    = media_params,
     .file      = __FILE__,
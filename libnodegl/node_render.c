@@ -32,19 +32,6 @@
 #include "topology.h"
 #include "utils.h"
 
-struct render_priv {
-    struct ngl_node *geometry;
-    struct ngl_node *program;
-    struct hmap *vert_resources;
-    struct hmap *frag_resources;
-    struct hmap *attributes;
-    struct hmap *instance_attributes;
-    int nb_instances;
-
-    struct pass pass;
-    struct darray vert_out_vars; // pgcraft_iovar
-};
-
 #define PROGRAMS_TYPES_LIST (const int[]){NGL_NODE_PROGRAM,         \
                                           -1}
 
@@ -138,6 +125,11 @@ static const struct node_param render_params[] = {
                  .desc=NGLI_DOCSTRING("per instance extra vertex attributes made accessible to the `program`")},
     {"nb_instances", PARAM_TYPE_INT, OFFSET(nb_instances), {.i64 = 1},
                  .desc=NGLI_DOCSTRING("number of instances to draw")},
+    {"culling",  PARAM_TYPE_BOOL, OFFSET(culling), {.i64=1},
+                 .desc=NGLI_DOCSTRING("skip the draw when the `geometry` lies outside the view frustum; "
+                                      "must be disabled if the `program` displaces the vertices, "
+                                      "ignored with instancing or if the `program` does not use the "
+                                      "modelview and projection matrices")},
     {NULL}
 };
 
@@ -156,6 +148,10 @@ static int render_init(struct ngl_node *node)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    /* The instances are usually positioned by the program */
+    const int instancing = s->nb_instances > 1 || (s->instance_attributes && ngli_hmap_count(s->instance_attributes));
+    s->use_culling = s->culling && !instancing;
+
     ngli_darray_init(&s->vert_out_vars, sizeof(struct pgcraft_iovar), 0);
     const struct program_priv *program = s->program->priv_data;
     if (program->vert_out_vars) {
@@ -191,7 +187,14 @@ static int render_init(struct ngl_node *node)
 static int render_prepare(struct ngl_node *node)
 {
     struct render_priv *s = node->priv_data;
-    return ngli_pass_prepare(&s->pass);
+    int ret = ngli_pass_prepare(&s->pass);
+    if (ret < 0)
+        return ret;
+
+    /* The geometry bounds say nothing about where a custom transform puts it */
+    if (!ngli_pass_uses_geometry_transform(&s->pass))
+        s->use_culling = 0;
+    return 0;
 }
 
 static void render_uninit(struct ngl_node *node)
@@ -209,7 +212,16 @@ static int render_update(struct ngl_node *node, double t)
 
 static void render_draw(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct render_priv *s = node->priv_data;
+
+    if (s->use_culling) {
+        const float *modelview_matrix = ngli_darray_tail(&ctx->modelview_matrix_stack);
+        const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
+        if (!ngli_node_geometry_is_visible(s->geometry, modelview_matrix, projection_matrix))
+            return;
+    }
+
     ngli_pass_exec(&s->pass);
 }
 
@@ -26,6 +26,7 @@
 #include "rendertarget.h"
 #include "format.h"
 #include "gctx.h"
+#include "hmap.h"
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
@@ -43,6 +44,8 @@ struct rtt_priv {
 
     int use_clear_color;
     int invalidate_depth_stencil;
+    int transient_attachments;
+    int level;
     int width;
     int height;
 
@@ -52,6 +55,13 @@ struct rtt_priv {
     struct texture *ms_colors[NGLI_MAX_COLOR_ATTACHMENTS];
     int nb_ms_colors;
     struct texture *ms_depth;
+
+    struct darray subtree_nodes;
+    int cacheable;
+    int cache_valid;
+    int64_t cache_version;
+    float cache_modelview_matrix[4 * 4];
+    float cache_projection_matrix[4 * 4];
 };
 
 #define DEFAULT_CLEAR_COLOR {-1.0f, -1.0f, -1.0f, -1.0f}
@@ -116,9 +126,144 @@ static int rtt_init(struct ngl_node *node)
     static const float clear_color[4] = DEFAULT_CLEAR_COLOR;
     s->use_clear_color = memcmp(s->clear_color, clear_color, sizeof(s->clear_color));
 
+    /*
+     * The internal attachments content does not need to outlive the draw
+     * unless the render target is not cleared between draws
+     */
+    s->transient_attachments = !(s->features & FEATURE_NO_CLEAR);
+    s->level = 0;
+
+    return 0;
+}
+
+/*
+ * Nodes whose content evolves with the time: a subtree containing any of them
+ * is considered dynamic and is rendered every frame.
+ */
+static int is_time_dependent(const struct ngl_node *node)
+{
+    switch (node->class->id) {
+    case NGL_NODE_ANIMATEDBUFFERFLOAT:
+    case NGL_NODE_ANIMATEDBUFFERVEC2:
+    case NGL_NODE_ANIMATEDBUFFERVEC3:
+    case NGL_NODE_ANIMATEDBUFFERVEC4:
+    case NGL_NODE_ANIMATEDTIME:
+    case NGL_NODE_ANIMATEDFLOAT:
+    case NGL_NODE_ANIMATEDVEC2:
+    case NGL_NODE_ANIMATEDVEC3:
+    case NGL_NODE_ANIMATEDVEC4:
+    case NGL_NODE_ANIMATEDQUAT:
+    case NGL_NODE_STREAMEDINT:
+    case NGL_NODE_STREAMEDIVEC2:
+    case NGL_NODE_STREAMEDIVEC3:
+    case NGL_NODE_STREAMEDIVEC4:
+    case NGL_NODE_STREAMEDUINT:
+    case NGL_NODE_STREAMEDUIVEC2:
+    case NGL_NODE_STREAMEDUIVEC3:
+    case NGL_NODE_STREAMEDUIVEC4:
+    case NGL_NODE_STREAMEDFLOAT:
+    case NGL_NODE_STREAMEDVEC2:
+    case NGL_NODE_STREAMEDVEC3:
+    case NGL_NODE_STREAMEDVEC4:
+    case NGL_NODE_STREAMEDMAT4:
+    case NGL_NODE_STREAMEDBUFFERINT:
+    case NGL_NODE_STREAMEDBUFFERIVEC2:
+    case NGL_NODE_STREAMEDBUFFERIVEC3:
+    case NGL_NODE_STREAMEDBUFFERIVEC4:
+    case NGL_NODE_STREAMEDBUFFERUINT:
+    case NGL_NODE_STREAMEDBUFFERUIVEC2:
+    case NGL_NODE_STREAMEDBUFFERUIVEC3:
+    case NGL_NODE_STREAMEDBUFFERUIVEC4:
+    case NGL_NODE_STREAMEDBUFFERFLOAT:
+    case NGL_NODE_STREAMEDBUFFERVEC2:
+    case NGL_NODE_STREAMEDBUFFERVEC3:
+    case NGL_NODE_STREAMEDBUFFERVEC4:
+    case NGL_NODE_STREAMEDBUFFERMAT4:
+    case NGL_NODE_MEDIA:
+    case NGL_NODE_TIME:
+    case NGL_NODE_TIMERANGEFILTER:
+    case NGL_NODE_HUD:
+    case NGL_NODE_COMPUTE:
+        return 1;
+    case NGL_NODE_RENDERTOTEXTURE: {
+        const struct rtt_priv *s = node->priv_data;
+        return !!(s->features & FEATURE_NO_CLEAR);
+    }
+    }
     return 0;
 }
 
+static int collect_subtree_nodes(struct ngl_node *node, struct hmap *visited, struct darray *nodes)
+{
+    struct darray *children_array = &node->children;
+    struct ngl_node **children = ngli_darray_data(children_array);
+    for (int i = 0; i < ngli_darray_count(children_array); i++) {
+        struct ngl_node *child = children[i];
+
+        char key[32];
+        (void)snprintf(key, sizeof(key), "%p", child);
+        if (ngli_hmap_get(visited, key))
+            continue;
+        int ret = ngli_hmap_set(visited, key, child);
+        if (ret < 0)
+            return ret;
+
+        if (is_time_dependent(child))
+            return 1;
+        if (!ngli_darray_push(nodes, &child))
+            return NGL_ERROR_MEMORY;
+
+        ret = collect_subtree_nodes(child, visited, nodes);
+        if (ret != 0)
+            return ret;
+    }
+    return 0;
+}
+
+/*
+ * The output of the RenderToTexture can be kept from one frame to another
+ * if its subtree does not contain any time dependent node. In this case, the
+ * nodes of the subtree are recorded so that their versions can be monitored
+ * at draw time.
+ */
+static int setup_cache(struct ngl_node *node)
+{
+    struct rtt_priv *s = node->priv_data;
+
+    ngli_darray_reset(&s->subtree_nodes);
+    ngli_darray_init(&s->subtree_nodes, sizeof(struct ngl_node *), 0);
+    s->cacheable = 0;
+    s->cache_valid = 0;
+
+    if (s->features & FEATURE_NO_CLEAR)
+        return 0;
+
+    struct hmap *visited = ngli_hmap_create();
+    if (!visited)
+        return NGL_ERROR_MEMORY;
+
+    int ret = collect_subtree_nodes(node, visited, &s->subtree_nodes);
+    ngli_hmap_freep(&visited);
+    if (ret < 0)
+        return ret;
+
+    s->cacheable = ret == 0;
+    if (!s->cacheable)
+        ngli_darray_reset(&s->subtree_nodes);
+
+    return 0;
+}
+
+static int64_t get_subtree_version(const struct rtt_priv *s)
+{
+    /* Versions only increase: any change in the subtree changes the sum */
+    int64_t version = 0;
+    struct ngl_node **nodes = ngli_darray_data(&s->subtree_nodes);
+    for (int i = 0; i < ngli_darray_count(&s->subtree_nodes); i++)
+        version += nodes[i]->version;
+    return version;
+}
+
 static int rtt_prepare(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -153,14 +298,64 @@ static int rtt_prepare(struct ngl_node *node)
         desc.depth_stencil.samples = s->samples;
     }
 
+    /*
+     * The nesting level is the longest chain of RenderToTexture ancestors
+     * among all the paths leading to this node: nodes of the same level can
+     * never be drawn at the same time and can share their attachments.
+     */
+    s->level = NGLI_MAX(s->level, ctx->rtt_level);
+
     struct rendertarget_desc *prev_desc = ctx->rendertarget_desc;
     ctx->rendertarget_desc = &desc;
+    ctx->rtt_level++;
 
     int ret = ngli_node_prepare(s->child);
 
+    ctx->rtt_level--;
     ctx->rendertarget_desc = prev_desc;
 
-    return ret;
+    if (ret < 0)
+        return ret;
+
+    return setup_cache(node);
+}
+
+static struct texture *create_attachment(struct ngl_node *node, int format, int samples)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gctx *gctx = ctx->gctx;
+    struct rtt_priv *s = node->priv_data;
+
+    struct texture_params attachment_params = NGLI_TEXTURE_PARAM_DEFAULTS;
+    attachment_params.format = format;
+    attachment_params.width = s->width;
+    attachment_params.height = s->height;
+    attachment_params.samples = samples;
+    attachment_params.usage = NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY;
+
+    if (s->transient_attachments)
+        return ngli_attachpool_acquire(&ctx->attachpool, gctx, &attachment_params, s->level, node);
+
+    struct texture *texture = ngli_texture_create(gctx);
+    if (!texture)
+        return NULL;
+    int ret = ngli_texture_init(texture, &attachment_params);
+    if (ret < 0) {
+        ngli_texture_freep(&texture);
+        return NULL;
+    }
+    return texture;
+}
+
+static void release_attachment(struct ngl_node *node, struct texture **texturep)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct rtt_priv *s = node->priv_data;
+
+    if (s->transient_attachments)
+        ngli_attachpool_release(&ctx->attachpool, node, texturep);
+    else
+        ngli_texture_freep(texturep);
 }
 
 static int rtt_prefetch(struct ngl_node *node)
@@ -223,19 +418,10 @@ static int rtt_prefetch(struct ngl_node *node)
         const int n = params->type == NGLI_TEXTURE_TYPE_CUBE ? 6 : 1;
         for (int j = 0; j < n; j++) {
             if (s->samples) {
-                struct texture *ms_texture = ngli_texture_create(gctx);
+                struct texture *ms_texture = create_attachment(node, params->format, s->samples);
                 if (!ms_texture)
                     return NGL_ERROR_MEMORY;
                 s->ms_colors[s->nb_ms_colors++] = ms_texture;
-                struct texture_params attachment_params = NGLI_TEXTURE_PARAM_DEFAULTS;
-                attachment_params.format = params->format;
-                attachment_params.width = s->width;
-                attachment_params.height = s->height;
-                attachment_params.samples = s->samples;
-                attachment_params.usage = NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY;
-                ret = ngli_texture_init(ms_texture, &attachment_params);
-                if (ret < 0)
-                    return ret;
                 rt_params.colors[rt_params.nb_colors].attachment = ms_texture;
                 rt_params.colors[rt_params.nb_colors].attachment_layer = 0;
                 rt_params.colors[rt_params.nb_colors].resolve_target = texture;
@@ -255,19 +441,10 @@ static int rtt_prefetch(struct ngl_node *node)
         struct texture_params *params = &texture->params;
 
         if (s->samples) {
-            struct texture *ms_texture = ngli_texture_create(gctx);
+            struct texture *ms_texture = create_attachment(node, params->format, s->samples);
             if (!ms_texture)
                 return NGL_ERROR_MEMORY;
             s->ms_depth = ms_texture;
-            struct texture_params attachment_params = NGLI_TEXTURE_PARAM_DEFAULTS;
-            attachment_params.format = params->format;
-            attachment_params.width = s->width;
-            attachment_params.height = s->height;
-            attachment_params.samples = s->samples;
-            attachment_params.usage = NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY;
-            ret = ngli_texture_init(ms_texture, &attachment_params);
-            if (ret < 0)
-                return ret;
             rt_params.depth_stencil.attachment = ms_texture;
             rt_params.depth_stencil.resolve_target = texture;
         } else {
@@ -280,19 +457,10 @@ static int rtt_prefetch(struct ngl_node *node)
             depth_format = ngli_gctx_get_preferred_depth_format(gctx);
 
         if (depth_format != NGLI_FORMAT_UNDEFINED) {
-            struct texture *depth = ngli_texture_create(gctx);
+            struct texture *depth = create_attachment(node, depth_format, s->samples);
             if (!depth)
                 return NGL_ERROR_MEMORY;
             s->depth = depth;
-            struct texture_params attachment_params = NGLI_TEXTURE_PARAM_DEFAULTS;
-            attachment_params.format = depth_format;
-            attachment_params.width = s->width;
-            attachment_params.height = s->height;
-            attachment_params.samples = s->samples;
-            attachment_params.usage = NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY;
-            ret = ngli_texture_init(depth, &attachment_params);
-            if (ret < 0)
-                return ret;
             rt_params.depth_stencil.attachment = depth;
 
             if (!(s->features & FEATURE_NO_CLEAR))
@@ -356,6 +524,20 @@ static void rtt_draw(struct ngl_node *node)
     struct gctx *gctx = ctx->gctx;
     struct rtt_priv *s = node->priv_data;
 
+    /*
+     * The previous output is kept if nothing changed in the subtree since the
+     * last render and the transformations inherited from the ancestors are
+     * the same
+     */
+    const float *modelview_matrix = ngli_darray_tail(&ctx->modelview_matrix_stack);
+    const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
+    const int64_t version = s->cacheable ? get_subtree_version(s) : 0;
+    if (s->cache_valid &&
+        s->cache_version == version &&
+        !memcmp(s->cache_modelview_matrix, modelview_matrix, sizeof(s->cache_modelview_matrix)) &&
+        !memcmp(s->cache_projection_matrix, projection_matrix, sizeof(s->cache_projection_matrix)))
+        return;
+
     struct rendertarget *rt = s->rt;
     struct rendertarget *prev_rt = ngli_gctx_get_rendertarget(gctx);
     ngli_gctx_set_rendertarget(gctx, rt);
@@ -396,6 +578,17 @@ static void rtt_draw(struct ngl_node *node)
         struct texture *texture = texture_priv->texture;
         if (ngli_texture_has_mipmap(texture))
             ngli_texture_generate_mipmap(texture);
+        s->color_textures[i]->version++;
+    }
+
+    if (s->depth_texture)
+        s->depth_texture->version++;
+
+    if (s->cacheable) {
+        s->cache_valid = 1;
+        s->cache_version = version + s->nb_color_textures + !!s->depth_texture;
+        memcpy(s->cache_modelview_matrix, modelview_matrix, sizeof(s->cache_modelview_matrix));
+        memcpy(s->cache_projection_matrix, projection_matrix, sizeof(s->cache_projection_matrix));
     }
 }
 
@@ -403,13 +596,45 @@ static void rtt_release(struct ngl_node *node)
 {
     struct rtt_priv *s = node->priv_data;
 
+    s->cache_valid = 0;
     ngli_rendertarget_freep(&s->rt);
-    ngli_texture_freep(&s->depth);
+    release_attachment(node, &s->depth);
 
     for (int i = 0; i < s->nb_ms_colors; i++)
-        ngli_texture_freep(&s->ms_colors[i]);
+        release_attachment(node, &s->ms_colors[i]);
     s->nb_ms_colors = 0;
-    ngli_texture_freep(&s->ms_depth);
+    release_attachment(node, &s->ms_depth);
+}
+
+static void rtt_uninit(struct ngl_node *node)
+{
+    struct rtt_priv *s = node->priv_data;
+    ngli_darray_reset(&s->subtree_nodes);
+}
+
+static int64_t get_attachment_size(const struct ngl_node *node, const struct texture *texture)
+{
+    const struct ngl_ctx *ctx = node->ctx;
+    const struct rtt_priv *s = node->priv_data;
+
+    /*
+     * The pooled attachments are charged to the context by memtrack but they
+     * are released along with this node, unless shared with other nodes
+     */
+    if (!texture || !s->transient_attachments ||
+        ngli_attachpool_is_shared(&ctx->attachpool, texture))
+        return 0;
+    return texture->mem.size;
+}
+
+static int64_t rtt_memory_usage(const struct ngl_node *node)
+{
+    const struct rtt_priv *s = node->priv_data;
+
+    int64_t size = get_attachment_size(node, s->depth) + get_attachment_size(node, s->ms_depth);
+    for (int i = 0; i < s->nb_ms_colors; i++)
+        size += get_attachment_size(node, s->ms_colors[i]);
+    return size;
 }
 
 const struct node_class ngli_rtt_class = {
@@ -421,6 +646,8 @@ const struct node_class ngli_rtt_class = {
     .update    = rtt_update,
     .draw      = rtt_draw,
     .release   = rtt_release,
+    .uninit    = rtt_uninit,
+    .memory_usage = rtt_memory_usage,
     .priv_size = sizeof(struct rtt_priv),
     .params    = rtt_params,
     .file      = __FILE__,
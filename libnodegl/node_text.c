@@ -22,10 +22,11 @@
 #include <stddef.h>
 #include <string.h>
 
-#include "memory.h"
 #include "nodes.h"
 #include "darray.h"
 #include "drawutils.h"
+#include "gctx.h"
+#include "glyphatlas.h"
 #include "log.h"
 #include "math_utils.h"
 #include "pgcache.h"
@@ -35,11 +36,32 @@
 #include "topology.h"
 #include "utils.h"
 
+/*
+ * The text is drawn as a set of quads sampling the glyph atlas of the
+ * context: one for the background, then one per glyph. Each quad is described
+ * by its rectangle within the text canvas, its texture coordinates in the
+ * atlas and its color. With instancing, the glyphs are the per-instance data
+ * of a single quad; otherwise, they are expanded into 2 triangles each.
+ */
+struct glyph {
+    float rect[4]; /* x0,y0,x1,y1 in the canvas, normalized, top to bottom */
+    float uvs[4];
+    float color[4];
+};
+
+struct glyph_vertex {
+    float corner[2];
+    struct glyph glyph;
+};
+
+static const char * const glyph_attribute_names[] = {"corner", "glyph_rect", "glyph_uvs", "glyph_color"};
+
 struct pipeline_desc {
     struct pgcraft *crafter;
     struct pipeline *pipeline;
     int modelview_matrix_index;
     int projection_matrix_index;
+    int glyph_attribute_indexes[NGLI_ARRAY_NB(glyph_attribute_names)];
 };
 
 struct text_priv {
@@ -57,11 +79,17 @@ struct text_priv {
     int mag_filter;
     int mipmap_filter;
 
-    struct texture *texture;
-    struct canvas canvas;
-    struct buffer *vertices;
-    struct buffer *uvcoords;
+    int live_changed;
+    int instanced;
+    struct texture *atlas;
+    struct darray glyphs;   /* struct glyph */
+    struct darray vertices; /* struct glyph_vertex, only without instancing */
+    struct buffer *corners; /* only with instancing */
+    struct buffer *glyphs_buffer;
+    int glyphs_buffer_size;
+    int nb_glyphs;
     struct darray pipeline_descs;
+    int rnode_generation;
 };
 
 #define VALIGN_CENTER 0
@@ -92,9 +120,18 @@ static const struct param_choices halign_choices = {
     }
 };
 
+static int text_live_update(struct ngl_node *node)
+{
+    struct text_priv *s = node->priv_data;
+    s->live_changed = 1;
+    return 0;
+}
+
 #define OFFSET(x) offsetof(struct text_priv, x)
 static const struct node_param text_params[] = {
-    {"text",         PARAM_TYPE_STR, OFFSET(text), .flags=PARAM_FLAG_NON_NULL,
+    {"text",         PARAM_TYPE_STR, OFFSET(text),
+                     .flags=PARAM_FLAG_NON_NULL | PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                     .update_func=text_live_update,
                      .desc=NGLI_DOCSTRING("text string to rasterize")},
     {"fg_color",     PARAM_TYPE_VEC4, OFFSET(fg_color), {.vec={1.0, 1.0, 1.0, 1.0}},
                      .desc=NGLI_DOCSTRING("foreground text color")},
@@ -130,28 +167,40 @@ static const struct node_param text_params[] = {
     {NULL}
 };
 
-static void set_canvas_dimensions(struct canvas *canvas, const char *s)
+static void get_text_dimensions(const char *s, int *w, int *h)
 {
-    canvas->w = 0;
-    canvas->h = NGLI_FONT_H;
+    *w = 0;
+    *h = NGLI_FONT_H;
     int cur_w = 0;
     for (int i = 0; s[i]; i++) {
         if (s[i] == '\n') {
             cur_w = 0;
-            canvas->h += NGLI_FONT_H;
+            *h += NGLI_FONT_H;
         } else {
             cur_w += NGLI_FONT_W;
-            canvas->w = NGLI_MAX(canvas->w, cur_w);
+            *w = NGLI_MAX(*w, cur_w);
         }
     }
 }
 
-static int prepare_canvas(struct text_priv *s)
+static int push_glyph(struct text_priv *s, const float *rect, const float *uvs, const float *color)
+{
+    struct glyph *glyph = ngli_darray_push(&s->glyphs, NULL);
+    if (!glyph)
+        return NGL_ERROR_MEMORY;
+    memcpy(glyph->rect, rect, sizeof(glyph->rect));
+    memcpy(glyph->uvs, uvs, sizeof(glyph->uvs));
+    memcpy(glyph->color, color, sizeof(glyph->color));
+    return 0;
+}
+
+static int build_glyphs(struct text_priv *s)
 {
     /* Set canvas dimensions according to text (and user padding settings) */
-    set_canvas_dimensions(&s->canvas, s->text);
-    s->canvas.w += 2 * s->padding;
-    s->canvas.h += 2 * s->padding;
+    int canvas_w, canvas_h;
+    get_text_dimensions(s->text, &canvas_w, &canvas_h);
+    canvas_w += 2 * s->padding;
+    canvas_h += 2 * s->padding;
 
     /* Pad it to match container ratio */
     const float box_width_len  = ngli_vec3_length(s->box_width);
@@ -159,17 +208,17 @@ static int prepare_canvas(struct text_priv *s)
     static const int default_ar[2] = {1, 1};
     const int *ar = s->aspect_ratio[1] ? s->aspect_ratio : default_ar;
     const float box_ratio = ar[0] * box_width_len / (float)(ar[1] * box_height_len);
-    const float tex_ratio = s->canvas.w / (float)s->canvas.h;
-    const int aspect_padw = (tex_ratio < box_ratio ? s->canvas.h * box_ratio - s->canvas.w : 0);
-    const int aspect_padh = (tex_ratio < box_ratio ? 0 : s->canvas.w / box_ratio - s->canvas.h);
+    const float tex_ratio = canvas_w / (float)canvas_h;
+    const int aspect_padw = (tex_ratio < box_ratio ? canvas_h * box_ratio - canvas_w : 0);
+    const int aspect_padh = (tex_ratio < box_ratio ? 0 : canvas_w / box_ratio - canvas_h);
 
     /* Adjust canvas size to impact text size */
-    const int texw = (s->canvas.w + aspect_padw) / s->font_scale;
-    const int texh = (s->canvas.h + aspect_padh) / s->font_scale;
-    const int padw = texw - s->canvas.w;
-    const int padh = texh - s->canvas.h;
-    s->canvas.w = NGLI_MAX(1, texw);
-    s->canvas.h = NGLI_MAX(1, texh);
+    const int texw = (canvas_w + aspect_padw) / s->font_scale;
+    const int texh = (canvas_h + aspect_padh) / s->font_scale;
+    const int padw = texw - canvas_w;
+    const int padh = texh - canvas_h;
+    canvas_w = NGLI_MAX(1, texw);
+    canvas_h = NGLI_MAX(1, texh);
 
     /* Adjust text position according to alignment settings */
     const int tx = (s->halign == HALIGN_CENTER ? padw / 2 :
@@ -179,103 +228,197 @@ static int prepare_canvas(struct text_priv *s)
                     s->valign == VALIGN_BOTTOM ? padh     :
                     0) + s->padding;
 
-    /* Allocate, draw background, print text */
-    s->canvas.buf = ngli_calloc(s->canvas.w * s->canvas.h, sizeof(*s->canvas.buf) * 4);
-    if (!s->canvas.buf)
-        return NGL_ERROR_MEMORY;
-    const uint32_t fg = NGLI_COLOR_VEC4_TO_U32(s->fg_color);
-    const uint32_t bg = NGLI_COLOR_VEC4_TO_U32(s->bg_color);
-    struct rect rect = {.w = s->canvas.w, .h = s->canvas.h};
-    ngli_drawutils_draw_rect(&s->canvas, &rect, bg);
-    ngli_drawutils_print(&s->canvas, tx, ty, s->text, fg);
+    /* Background covering the whole canvas */
+    s->glyphs.count = 0;
+    static const float bg_rect[4] = {0.f, 0.f, 1.f, 1.f};
+    float uvs[4];
+    ngli_glyphatlas_get_uvs(0, uvs);
+    int ret = push_glyph(s, bg_rect, uvs, s->bg_color);
+    if (ret < 0)
+        return ret;
+
+    /* Glyphs, clipped to the canvas */
+    int px = 0, py = 0;
+    for (int i = 0; s->text[i]; i++) {
+        const int c = s->text[i];
+        if (c == '\n') {
+            py++;
+            px = 0;
+            continue;
+        }
+        const int x = tx + px++ * NGLI_FONT_W;
+        const int y = ty + py * NGLI_FONT_H;
+        if (c == ' ')
+            continue;
+
+        const int x0 = NGLI_MAX(x, 0);
+        const int y0 = NGLI_MAX(y, 0);
+        const int x1 = NGLI_MIN(x + NGLI_FONT_W, canvas_w);
+        const int y1 = NGLI_MIN(y + NGLI_FONT_H, canvas_h);
+        if (x0 >= x1 || y0 >= y1)
+            continue;
+
+        float glyph_uvs[4];
+        ngli_glyphatlas_get_uvs(c, glyph_uvs);
+        const float du = (glyph_uvs[2] - glyph_uvs[0]) / NGLI_FONT_W;
+        const float dv = (glyph_uvs[3] - glyph_uvs[1]) / NGLI_FONT_H;
+        const float rect[4] = {
+            x0 / (float)canvas_w, y0 / (float)canvas_h,
+            x1 / (float)canvas_w, y1 / (float)canvas_h,
+        };
+        uvs[0] = glyph_uvs[0] + (x0 - x) * du;
+        uvs[1] = glyph_uvs[1] + (y0 - y) * dv;
+        uvs[2] = glyph_uvs[0] + (x1 - x) * du;
+        uvs[3] = glyph_uvs[1] + (y1 - y) * dv;
+        ret = push_glyph(s, rect, uvs, s->fg_color);
+        if (ret < 0)
+            return ret;
+    }
+
+    s->nb_glyphs = ngli_darray_count(&s->glyphs);
+    if (s->instanced)
+        return 0;
+
+    /* Expand every glyph into 2 triangles */
+    static const float corners[][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 0}, {1, 1}, {0, 1}};
+    const struct glyph *glyphs = ngli_darray_data(&s->glyphs);
+    s->vertices.count = 0;
+    for (int i = 0; i < s->nb_glyphs; i++) {
+        for (int j = 0; j < NGLI_ARRAY_NB(corners); j++) {
+            struct glyph_vertex *vertex = ngli_darray_push(&s->vertices, NULL);
+            if (!vertex)
+                return NGL_ERROR_MEMORY;
+            memcpy(vertex->corner, corners[j], sizeof(vertex->corner));
+            vertex->glyph = glyphs[i];
+        }
+    }
     return 0;
 }
 
+static int upload_glyphs(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct text_priv *s = node->priv_data;
+
+    const struct darray *data = s->instanced ? &s->glyphs : &s->vertices;
+    const int size = ngli_darray_count(data) * data->element_size;
+
+    /* Only reallocate (and rebind) the buffer if the text grows beyond it */
+    if (size > s->glyphs_buffer_size) {
+        ngli_buffer_freep(&s->glyphs_buffer);
+        s->glyphs_buffer_size = 0;
+
+        s->glyphs_buffer = ngli_buffer_create(ctx->gctx);
+        if (!s->glyphs_buffer)
+            return NGL_ERROR_MEMORY;
+
+        int ret = ngli_buffer_init(s->glyphs_buffer, size, NGLI_BUFFER_USAGE_DYNAMIC);
+        if (ret < 0)
+            return ret;
+        s->glyphs_buffer_size = size;
+
+        struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
+        for (int i = 0; i < ngli_darray_count(&s->pipeline_descs); i++) {
+            struct pipeline_desc *desc = &descs[i];
+            for (int j = s->instanced ? 1 : 0; j < NGLI_ARRAY_NB(desc->glyph_attribute_indexes); j++) {
+                const int index = desc->glyph_attribute_indexes[j];
+                if (index < 0)
+                    continue;
+                ret = ngli_pipeline_update_attribute(desc->pipeline, index, s->glyphs_buffer);
+                if (ret < 0)
+                    return ret;
+            }
+        }
+    }
+
+    return ngli_buffer_upload(s->glyphs_buffer, ngli_darray_data(data), size);
+}
+
 static const char * const vertex_data =
+    "void main()"                                                                       "\n"
+    "{"                                                                                 "\n"
+    "    vec2 pos = mix(glyph_rect.xy, glyph_rect.zw, corner);"                         "\n"
+    "    vec3 position = box_corner + box_width * pos.x + box_height * (1.0 - pos.y);"  "\n"
+    "    ngl_out_pos = projection_matrix * modelview_matrix * vec4(position, 1.0);"     "\n"
+    "    var_tex_coord = mix(glyph_uvs.xy, glyph_uvs.zw, corner);"                      "\n"
+    "    var_color = glyph_color;"                                                      "\n"
+    "}";
+
+/*
+ * Without blending, a glyph quad replaces the background drawn below it, so
+ * it composites the glyph over the background itself. With blending, the
+ * glyph coverage goes in the alpha so that the background, already blended,
+ * is not composited a second time below the glyphs.
+ */
+static const char * const fragment_data =
     "void main()"                                                           "\n"
     "{"                                                                     "\n"
-    "    ngl_out_pos = projection_matrix * modelview_matrix * position;"    "\n"
-    "    var_tex_coord = uvcoord;"                                          "\n"
+    "    float coverage = ngl_tex2d(tex, var_tex_coord).a;"                 "\n"
+    "    ngl_out_color = mix(bg_color, var_color, coverage);"               "\n"
     "}";
 
-static const char * const fragment_data =
+static const char * const fragment_data_blend =
     "void main()"                                                           "\n"
     "{"                                                                     "\n"
-    "    ngl_out_color = ngl_tex2d(tex, var_tex_coord);"                    "\n"
+    "    float coverage = ngl_tex2d(tex, var_tex_coord).a;"                 "\n"
+    "    ngl_out_color = vec4(var_color.rgb, var_color.a * coverage);"      "\n"
     "}";
 
 static const struct pgcraft_iovar vert_out_vars[] = {
     {.name = "var_tex_coord", .type = NGLI_TYPE_VEC2},
+    {.name = "var_color",     .type = NGLI_TYPE_VEC4},
 };
 
-#define C(index) s->box_corner[index]
-#define W(index) s->box_width[index]
-#define H(index) s->box_height[index]
-
 static int text_init(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct gctx *gctx = ctx->gctx;
     struct text_priv *s = node->priv_data;
 
-    int ret = prepare_canvas(s);
-    if (ret < 0)
-        return ret;
-
-    const float vertices[] = {
-        C(0),               C(1),               C(2),
-        C(0) + W(0),        C(1) + W(1),        C(2) + W(2),
-        C(0) + H(0) + W(0), C(1) + H(1) + W(1), C(2) + H(2) + W(2),
-        C(0) + H(0),        C(1) + H(1),        C(2) + H(2),
-    };
+    ngli_darray_init(&s->glyphs, sizeof(struct glyph), 0);
+    ngli_darray_init(&s->vertices, sizeof(struct glyph_vertex), 0);
+    ngli_darray_init(&s->pipeline_descs, sizeof(struct pipeline_desc), 0);
 
-    static const float uvs[] = {0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0};
+    const int instancing = NGLI_FEATURE_DRAW_INSTANCED | NGLI_FEATURE_INSTANCED_ARRAY;
+    s->instanced = (gctx->features & instancing) == instancing;
 
-    s->vertices = ngli_buffer_create(gctx);
-    if (!s->vertices)
+    s->atlas = ngli_glyphatlas_ref(&ctx->glyphatlas, gctx, s->min_filter, s->mag_filter, s->mipmap_filter);
+    if (!s->atlas)
         return NGL_ERROR_MEMORY;
 
-    ret = ngli_buffer_init(s->vertices, sizeof(vertices), NGLI_BUFFER_USAGE_STATIC);
-    if (ret < 0)
-        return ret;
+    if (s->instanced) {
+        static const float corners[] = {0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 1.0};
 
-    ret = ngli_buffer_upload(s->vertices, vertices, sizeof(vertices));
-    if (ret < 0)
-        return ret;
+        s->corners = ngli_buffer_create(gctx);
+        if (!s->corners)
+            return NGL_ERROR_MEMORY;
 
-    s->uvcoords = ngli_buffer_create(gctx);
-    if (!s->uvcoords)
-        return NGL_ERROR_MEMORY;
-
-    ret = ngli_buffer_init(s->uvcoords, sizeof(uvs), NGLI_BUFFER_USAGE_STATIC);
-    if (ret < 0)
-        return ret;
-
-    ret = ngli_buffer_upload(s->uvcoords, uvs, sizeof(uvs));
-    if (ret < 0)
-        return ret;
+        int ret = ngli_buffer_init(s->corners, sizeof(corners), NGLI_BUFFER_USAGE_STATIC);
+        if (ret < 0)
+            return ret;
 
-    struct texture_params tex_params = NGLI_TEXTURE_PARAM_DEFAULTS;
-    tex_params.width = s->canvas.w;
-    tex_params.height = s->canvas.h;
-    tex_params.format = NGLI_FORMAT_R8G8B8A8_UNORM;
-    tex_params.min_filter = s->min_filter;
-    tex_params.mag_filter = s->mag_filter;
-    tex_params.mipmap_filter = s->mipmap_filter;
-    s->texture = ngli_texture_create(gctx);
-    if (!s->texture)
-        return NGL_ERROR_MEMORY;
-    ret = ngli_texture_init(s->texture, &tex_params);
-    if (ret < 0)
-        return ret;
+        ret = ngli_buffer_upload(s->corners, corners, sizeof(corners));
+        if (ret < 0)
+            return ret;
+    }
 
-    ret = ngli_texture_upload(s->texture, s->canvas.buf, 0);
+    int ret = build_glyphs(s);
     if (ret < 0)
         return ret;
 
-    ngli_darray_init(&s->pipeline_descs, sizeof(struct pipeline_desc), 0);
+    return upload_glyphs(node);
+}
 
-    return 0;
+static void free_pipeline_descs(struct text_priv *s)
+{
+    struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
+    const int nb_descs = ngli_darray_count(&s->pipeline_descs);
+    for (int i = 0; i < nb_descs; i++) {
+        struct pipeline_desc *desc = &descs[i];
+        ngli_pipeline_freep(&desc->pipeline);
+        ngli_pgcraft_freep(&desc->crafter);
+    }
+    s->pipeline_descs.count = 0;
 }
 
 static int text_prepare(struct ngl_node *node)
@@ -284,41 +427,75 @@ static int text_prepare(struct ngl_node *node)
     struct gctx *gctx = ctx->gctx;
     struct text_priv *s = node->priv_data;
 
+    /* Drop the pipelines of a previous render node tree (see ngli_pass_prepare()) */
+    if (s->rnode_generation != ctx->rnode_generation) {
+        free_pipeline_descs(s);
+        s->rnode_generation = ctx->rnode_generation;
+    }
+
     const struct pgcraft_uniform uniforms[] = {
         {.name = "modelview_matrix",  .type = NGLI_TYPE_MAT4, .stage = NGLI_PROGRAM_SHADER_VERT, .data = NULL},
         {.name = "projection_matrix", .type = NGLI_TYPE_MAT4, .stage = NGLI_PROGRAM_SHADER_VERT, .data = NULL},
+        {.name = "box_corner",        .type = NGLI_TYPE_VEC3, .stage = NGLI_PROGRAM_SHADER_VERT, .data = s->box_corner},
+        {.name = "box_width",         .type = NGLI_TYPE_VEC3, .stage = NGLI_PROGRAM_SHADER_VERT, .data = s->box_width},
+        {.name = "box_height",        .type = NGLI_TYPE_VEC3, .stage = NGLI_PROGRAM_SHADER_VERT, .data = s->box_height},
+        {.name = "bg_color",          .type = NGLI_TYPE_VEC4, .stage = NGLI_PROGRAM_SHADER_FRAG, .data = s->bg_color},
     };
+    const int blend = ctx->graphicstate.blend;
 
     const struct pgcraft_texture textures[] = {
         {
             .name     = "tex",
             .type     = NGLI_PGCRAFT_SHADER_TEX_TYPE_TEXTURE2D,
             .stage    = NGLI_PROGRAM_SHADER_FRAG,
-            .texture  = s->texture,
+            .texture  = s->atlas,
         },
     };
 
+    const int rate   = s->instanced ? 1 : 0;
+    const int stride = s->instanced ? sizeof(struct glyph) : sizeof(struct glyph_vertex);
+    const int offset = s->instanced ? 0 : offsetof(struct glyph_vertex, glyph);
     const struct pgcraft_attribute attributes[] = {
         {
-            .name     = "position",
+            .name     = "corner",
+            .type     = NGLI_TYPE_VEC2,
+            .format   = NGLI_FORMAT_R32G32_SFLOAT,
+            .stride   = s->instanced ? 2 * 4 : stride,
+            .buffer   = s->instanced ? s->corners : s->glyphs_buffer,
+        },
+        {
+            .name     = "glyph_rect",
             .type     = NGLI_TYPE_VEC4,
-            .format   = NGLI_FORMAT_R32G32B32_SFLOAT,
-            .stride   = 3 * 4,
-            .buffer   = s->vertices,
+            .format   = NGLI_FORMAT_R32G32B32A32_SFLOAT,
+            .stride   = stride,
+            .offset   = offset + offsetof(struct glyph, rect),
+            .rate     = rate,
+            .buffer   = s->glyphs_buffer,
         },
         {
-            .name     = "uvcoord",
-            .type     = NGLI_TYPE_VEC2,
-            .format   = NGLI_FORMAT_R32G32_SFLOAT,
-            .stride   = 2 * 4,
-            .buffer   = s->uvcoords,
+            .name     = "glyph_uvs",
+            .type     = NGLI_TYPE_VEC4,
+            .format   = NGLI_FORMAT_R32G32B32A32_SFLOAT,
+            .stride   = stride,
+            .offset   = offset + offsetof(struct glyph, uvs),
+            .rate     = rate,
+            .buffer   = s->glyphs_buffer,
+        },
+        {
+            .name     = "glyph_color",
+            .type     = NGLI_TYPE_VEC4,
+            .format   = NGLI_FORMAT_R32G32B32A32_SFLOAT,
+            .stride   = stride,
+            .offset   = offset + offsetof(struct glyph, color),
+            .rate     = rate,
+            .buffer   = s->glyphs_buffer,
         },
     };
 
     struct pipeline_params pipeline_params = {
         .type          = NGLI_PIPELINE_TYPE_GRAPHICS,
         .graphics      = {
-            .topology    = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN,
+            .topology    = s->instanced ? NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN : NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
             .state       = ctx->graphicstate,
             .rt_desc     = *ctx->rendertarget_desc,
         }
@@ -326,9 +503,9 @@ static int text_prepare(struct ngl_node *node)
 
     const struct pgcraft_params crafter_params = {
         .vert_base        = vertex_data,
-        .frag_base        = fragment_data,
+        .frag_base        = blend ? fragment_data_blend : fragment_data,
         .uniforms         = uniforms,
-        .nb_uniforms      = NGLI_ARRAY_NB(uniforms),
+        .nb_uniforms      = NGLI_ARRAY_NB(uniforms) - (blend ? 1 : 0), /* bg_color is last */
         .textures         = textures,
         .nb_textures      = NGLI_ARRAY_NB(textures),
         .attributes       = attributes,
@@ -362,10 +539,26 @@ static int text_prepare(struct ngl_node *node)
 
     desc->modelview_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "modelview_matrix", NGLI_PROGRAM_SHADER_VERT);
     desc->projection_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "projection_matrix", NGLI_PROGRAM_SHADER_VERT);
+    for (int i = 0; i < NGLI_ARRAY_NB(glyph_attribute_names); i++)
+        desc->glyph_attribute_indexes[i] = ngli_pgcraft_get_vertex_attribute_index(desc->crafter, glyph_attribute_names[i]);
 
     return 0;
 }
 
+static int text_update(struct ngl_node *node, double t)
+{
+    struct text_priv *s = node->priv_data;
+    if (!s->live_changed)
+        return 0;
+    s->live_changed = 0;
+
+    int ret = build_glyphs(s);
+    if (ret < 0)
+        return ret;
+
+    return upload_glyphs(node);
+}
+
 static void text_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -380,24 +573,23 @@ static void text_draw(struct ngl_node *node)
     ngli_pipeline_update_uniform(desc->pipeline, desc->modelview_matrix_index, modelview_matrix);
     ngli_pipeline_update_uniform(desc->pipeline, desc->projection_matrix_index, projection_matrix);
 
-    ngli_pipeline_draw(desc->pipeline, 4, 1);
+    if (s->instanced)
+        ngli_pipeline_draw(desc->pipeline, 4, s->nb_glyphs);
+    else
+        ngli_pipeline_draw(desc->pipeline, 6 * s->nb_glyphs, 1);
 }
 
 static void text_uninit(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct text_priv *s = node->priv_data;
-    struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
-    const int nb_descs = ngli_darray_count(&s->pipeline_descs);
-    for (int i = 0; i < nb_descs; i++) {
-        struct pipeline_desc *desc = &descs[i];
-        ngli_pipeline_freep(&desc->pipeline);
-        ngli_pgcraft_freep(&desc->crafter);
-    }
+    free_pipeline_descs(s);
     ngli_darray_reset(&s->pipeline_descs);
-    ngli_texture_freep(&s->texture);
-    ngli_buffer_freep(&s->vertices);
-    ngli_buffer_freep(&s->uvcoords);
-    ngli_free(s->canvas.buf);
+    ngli_glyphatlas_unref(&ctx->glyphatlas, &s->atlas);
+    ngli_buffer_freep(&s->corners);
+    ngli_buffer_freep(&s->glyphs_buffer);
+    ngli_darray_reset(&s->glyphs);
+    ngli_darray_reset(&s->vertices);
 }
 
 const struct node_class ngli_text_class = {
@@ -405,6 +597,7 @@ const struct node_class ngli_text_class = {
     .name      = "Text",
     .init      = text_init,
     .prepare   = text_prepare,
+    .update    = text_update,
     .draw      = text_draw,
     .uninit    = text_uninit,
     .priv_size = sizeof(struct text_priv),
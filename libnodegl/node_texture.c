@@ -269,6 +269,7 @@ static int texture_prefetch(struct ngl_node *node)
         params->immutable = 1;
 
     const uint8_t *data = NULL;
+    int shareable = 0;
 
     if (s->data_src) {
         switch (s->data_src->class->id) {
@@ -319,6 +320,7 @@ static int texture_prefetch(struct ngl_node *node)
             }
             data = buffer->data;
             params->format = buffer->data_format;
+            shareable = !buffer->dynamic && !s->writable;
             break;
         }
         default:
@@ -330,13 +332,20 @@ static int texture_prefetch(struct ngl_node *node)
     if (!s->texture)
         return NGL_ERROR_MEMORY;
 
-    int ret = ngli_texture_init(s->texture, params);
-    if (ret < 0)
-        return ret;
-
-    ret = ngli_texture_upload(s->texture, data, 0);
-    if (ret < 0)
-        return ret;
+    /* Textures initialized from a static buffer are never updated so they can be shared */
+    if (shareable) {
+        int ret = ngli_texture_init_shared(s->texture, params, data);
+        if (ret < 0)
+            return ret;
+    } else {
+        int ret = ngli_texture_init(s->texture, params);
+        if (ret < 0)
+            return ret;
+
+        ret = ngli_texture_upload(s->texture, data, 0);
+        if (ret < 0)
+            return ret;
+    }
 
     struct image_params image_params = {
         .width = params->width,
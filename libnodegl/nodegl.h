@@ -359,8 +359,17 @@ enum {
     NGL_BACKEND_AUTO,
     NGL_BACKEND_OPENGL,
     NGL_BACKEND_OPENGLES,
+    NGL_BACKEND_NULL,       /* No rendering: the graphics commands are only recorded, for testing and benchmarking */
 };
 
+/**
+ * HUD export callback prototype.
+ *
+ * @param arg   opaque user argument as specified in the configuration
+ * @param line  a nul-terminated CSV line (including the trailing newline)
+ */
+typedef void (*ngl_hud_export_callback_type)(void *arg, const char *line);
+
 /**
  * node.gl configuration
  */
@@ -400,6 +409,52 @@ struct ngl_config {
     uint8_t *capture_buffer; /* RGBA offscreen capture buffer. If allocated,
                                 its size must be at least width * height * 4
                                 bytes. */
+
+    int64_t residency_budget; /* Amount of memory (in bytes) the resources of
+                                 inactive nodes are allowed to keep allocated
+                                 so they do not need to be re-created when the
+                                 nodes become active again. The least recently
+                                 used resources are released first when the
+                                 budget is exceeded. 0 releases the resources
+                                 as soon as the nodes become inactive. */
+
+    int profiling; /* Whether the CPU time spent in every node and the GPU time
+                      spent in every pass should be recorded. The timings can
+                      be obtained with ngl_get_stats() and
+                      ngl_export_profile(). */
+
+    int record_commands; /* Whether the graphics commands of the draw phase
+                            should be recorded into a command buffer and
+                            submitted at its end instead of as the graph is
+                            traversed. The submission still happens on the
+                            rendering thread, so the recording only adds
+                            overhead for now; it is disabled by default. */
+
+    void *hud_export_arg; /* Opaque user argument forwarded to
+                             hud_export_callback */
+
+    ngl_hud_export_callback_type hud_export_callback; /* If set, HUD nodes
+                                                         switch to headless
+                                                         mode and stream
+                                                         their CSV lines
+                                                         (header included) to
+                                                         this callback instead
+                                                         of rendering their
+                                                         widgets */
+
+    struct ngl_ctx *share_ctx; /* If set, the context shares its graphics
+                                  resources (programs, static buffers and
+                                  static textures) with this already
+                                  configured context and all the contexts
+                                  sharing with it. It must use the same
+                                  platform and backend, and must not be
+                                  reconfigured or destroyed before this
+                                  context. With the OpenGL backends, it is
+                                  mutually exclusive with handle. Only the
+                                  resources created while several contexts
+                                  share their resources are shared: the ones
+                                  created by share_ctx before this context
+                                  is configured are not. */
 };
 
 /**
@@ -473,6 +528,35 @@ int ngl_resize(struct ngl_ctx *s, int width, int height, const int *viewport);
  */
 int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene);
 
+/**
+ * Replace the scene associated with a node.gl context, preserving the nodes
+ * shared with the previous one.
+ *
+ * Every node of the new scene equivalent to a node of the current scene (same
+ * type, same parameters and equivalent children) is replaced in the new scene
+ * by the current one, which keeps its initialized state and graphics
+ * resources. Only the other nodes are initialized, and the nodes of the
+ * current scene not found in the new one are released. The nodes of the new
+ * scene are modified in place, and its root node may be replaced as well.
+ *
+ * The nodes of the new scene replaced by current ones are not attached to the
+ * context: live changes on them have no effect, and must be applied on the
+ * current nodes instead. The handles on the nodes of the previous scene which
+ * are still in use therefore remain the ones to live change.
+ *
+ * This is typically meant to apply a small edit to a large scene rebuilt from
+ * scratch. Without a current scene, or with scene=NULL, this function behaves
+ * like ngl_set_scene().
+ *
+ * @param s      pointer to the configured node.gl context
+ * @param scene  pointer to the new scene
+ *
+ * @note node.gl context must to be configured before calling this function.
+ *
+ * @return 0 on success, NGL_ERROR_* (< 0) on error
+ */
+int ngl_update_scene(struct ngl_ctx *s, struct ngl_node *scene);
+
 /**
  * Draw at the specified time.
  *
@@ -497,6 +581,129 @@ int ngl_draw(struct ngl_ctx *s, double t);
  */
 char *ngl_dot(struct ngl_ctx *s, double t);
 
+/**
+ * Statistics of a node.gl context
+ */
+struct ngl_stats {
+    /* Residency cache, see ngl_config.residency_budget */
+    int64_t residency_size;         /* Memory held by the inactive nodes (bytes) */
+    int64_t residency_max_size;     /* High-water mark of residency_size (bytes) */
+    int residency_nb_nodes;         /* Number of inactive nodes holding resources */
+    int residency_nb_hits;          /* Number of nodes re-activated without prefetch */
+    int residency_nb_evictions;     /* Number of nodes released because of the budget */
+    int64_t residency_evicted_size; /* Memory released by the evictions (bytes) */
+
+    /* Timings of the last frame, only available with ngl_config.profiling */
+    int64_t visit_time;      /* CPU time spent in the visit of the graph (µs) */
+    int64_t prefetch_time;   /* CPU time spent in the prefetch of the nodes (µs) */
+    int64_t release_time;    /* CPU time spent in the release of the nodes (µs) */
+    int64_t update_time;     /* CPU time spent in the update of the graph (µs) */
+    int64_t draw_time;       /* CPU time spent in the draw of the graph (µs) */
+    int64_t capture_time;    /* CPU time spent in the capture of the frame (µs) */
+    int64_t gpu_draw_time;   /* GPU time spent in the execution of the passes (µs);
+                                the GPU timings are collected asynchronously and
+                                account for the passes of previous frames */
+
+    /* Graphics API usage of the last frame */
+    int64_t nb_api_calls;        /* Number of graphics API (OpenGL) calls */
+    int64_t nb_state_changes;    /* Number of calls changing the graphics state
+                                    (bindings, blending, depth, stencil, ...) */
+    int64_t nb_draw_calls;       /* Number of draw calls */
+    int64_t nb_dispatch_calls;   /* Number of compute dispatch calls */
+    int64_t buffer_upload_size;  /* Data uploaded to the buffers (bytes) */
+    int64_t texture_upload_size; /* Data uploaded to the textures (bytes) */
+    int64_t nb_memory_barriers;  /* Number of memory barriers emitted after
+                                    shader writes (storage blocks, images) */
+    int64_t nb_elided_memory_barriers; /* Number of accesses to shader written
+                                          resources which did not require a new
+                                          memory barrier */
+
+    /* Scene activity of the last frame */
+    int nb_updated_nodes;        /* Number of nodes updated */
+
+    /* Graphics memory allocated by the context, see ngl_export_memory() */
+    int64_t memory_buffers_size;         /* Memory of the buffers (bytes) */
+    int64_t memory_buffers_max_size;     /* High-water mark of memory_buffers_size (bytes) */
+    int64_t memory_textures_size;        /* Memory of the textures (bytes) */
+    int64_t memory_textures_max_size;    /* High-water mark of memory_textures_size (bytes) */
+    int64_t memory_attachments_size;     /* Memory of the render target only
+                                            attachments, such as depth buffers (bytes) */
+    int64_t memory_attachments_max_size; /* High-water mark of memory_attachments_size (bytes) */
+    int64_t memory_total_size;           /* Sum of all the above sizes (bytes) */
+    int64_t memory_total_max_size;       /* High-water mark of memory_total_size (bytes) */
+    int memory_nb_buffers;               /* Number of allocated buffers */
+    int memory_nb_textures;              /* Number of allocated textures */
+    int memory_nb_attachments;           /* Number of allocated attachments */
+};
+
+/**
+ * Get the statistics of a node.gl context.
+ *
+ * @param s      pointer to the configured node.gl context
+ * @param stats  pointer to the statistics to fill
+ *
+ * @return 0 on success, NGL_ERROR_* (< 0) on error
+ */
+int ngl_get_stats(struct ngl_ctx *s, struct ngl_stats *stats);
+
+/**
+ * Export the number of calls to every graphics API function (such as the
+ * OpenGL functions) since the beginning of the last ngl_draw() call.
+ *
+ * The output is in CSV format with a "function,calls" header and one line per
+ * function called at least once.
+ *
+ * Must be destroyed using free().
+ *
+ * @param s  pointer to the configured node.gl context
+ *
+ * @return an allocated string or NULL on error
+ */
+char *ngl_export_api_calls(struct ngl_ctx *s);
+
+/**
+ * Export the graphics memory currently allocated by the context, broken down
+ * per owning node.
+ *
+ * The output is in CSV format with a "label,class,category,count,size" header
+ * and one line per node and category of resource ("buffer", "texture" or
+ * "attachment"). The sizes are expressed in bytes. The resources which do not
+ * belong to any node, such as the offscreen render targets, and the pooled
+ * resources shared between nodes, such as the glyph atlas, are reported with
+ * the "context" class. Since the memory of a scene is entirely released when
+ * it is detached, any node line left after ngl_set_scene() denotes a leak.
+ *
+ * Must be destroyed using free().
+ *
+ * @param s  pointer to the configured node.gl context
+ *
+ * @return an allocated string or NULL on error
+ */
+char *ngl_export_memory(struct ngl_ctx *s);
+
+/**
+ * Profile export formats
+ */
+enum {
+    NGL_PROFILE_FORMAT_CSV,             /* One line per event, with the times in nanoseconds */
+    NGL_PROFILE_FORMAT_CHROME_TRACE,    /* Chrome trace event JSON (chrome://tracing, Perfetto) */
+};
+
+/**
+ * Export the timings recorded since the last export (or since the context was
+ * configured) and flush them.
+ *
+ * The context must have been configured with ngl_config.profiling.
+ *
+ * Must be destroyed using free().
+ *
+ * @param s       pointer to the configured node.gl context
+ * @param format  export format (any of NGL_PROFILE_FORMAT_*)
+ *
+ * @return an allocated string or NULL on error
+ */
+char *ngl_export_profile(struct ngl_ctx *s, int format);
+
 /**
  * Destroy a node.gl context. The passed context pointer will also be set to
  * NULL.
@@ -546,7 +753,9 @@ int ngl_easing_evaluate(const char *name, double *args, int nb_args,
  * @param v         the target value
  * @param t         pointer for the resulting time
  *
- * @note Not all easings have a resolution function available
+ * @note Easings without an analytical resolution function are solved
+ *       numerically; for the non-monotonic ones (bounce, elastic, back), the
+ *       smallest time reaching the target value is returned
  *
  * @return 0 on success, NGL_ERROR_* (< 0) on error
  */
@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "gctx.h"
 #include "hmap.h"
 #include "log.h"
 #include "nodegl.h"
@@ -164,7 +165,11 @@ static void node_release(struct ngl_node *node)
     ngli_assert(node->ctx);
     if (node->class->release) {
         TRACE("RELEASE %s @ %p", node->label, node);
+        struct profiler *profiler = &node->ctx->profiler;
+        const int64_t start = profiler->enabled ? ngli_profiler_begin(profiler, NGLI_PROFILER_PHASE_RELEASE) : 0;
         node->class->release(node);
+        if (profiler->enabled)
+            ngli_profiler_end(profiler, NGLI_PROFILER_PHASE_RELEASE, start, node->label, node->class->name);
     }
     node->state = STATE_INITIALIZED;
     node->last_update_time = -1.;
@@ -197,6 +202,7 @@ static void node_uninit(struct ngl_node *node)
 
     ngli_assert(node->ctx);
     ngli_darray_reset(&node->children);
+    ngli_rescache_remove(&node->ctx->rescache, node);
     node_release(node);
 
     if (node->class->uninit) {
@@ -204,6 +210,7 @@ static void node_uninit(struct ngl_node *node)
         node->class->uninit(node);
     }
     reset_non_params(node);
+    ngli_freep(&node->params_snapshot);
     node->state = STATE_UNINITIALIZED;
     node->visit_time = -1.;
 }
@@ -272,6 +279,28 @@ static int check_params_sanity(struct ngl_node *node)
     return 0;
 }
 
+/*
+ * The parameters of a node may be altered by its initialization (such as a
+ * buffer element count deduced from its data): the hash is computed before.
+ */
+uint64_t ngli_node_hash_params(const struct ngl_node *node)
+{
+    uint64_t h = ngli_params_hash((const uint8_t *)node, ngli_base_node_params, node->class->id);
+    return ngli_params_hash(node->priv_data, node->class->params, h);
+}
+
+/*
+ * Check if the parameters of a node not initialized yet are equal to the ones
+ * of an initialized node, as they were at its initialization.
+ */
+int ngli_node_params_equal(const struct ngl_node *node, const struct ngl_node *ref)
+{
+    if (node->class != ref->class || !ref->params_snapshot)
+        return 0;
+    return ngli_params_equal((const uint8_t *)node, (const uint8_t *)ref, (const uint8_t *)ref, ngli_base_node_params) &&
+           ngli_params_equal(node->priv_data, ref->priv_data, ref->params_snapshot, node->class->params);
+}
+
 static int node_init(struct ngl_node *node)
 {
     if (node->state != STATE_UNINITIALIZED)
@@ -282,11 +311,21 @@ static int node_init(struct ngl_node *node)
         return ret;
 
     ngli_darray_init(&node->children, sizeof(struct ngl_node *), 0);
+    node->params_hash = ngli_node_hash_params(node);
+    node->params_snapshot = ngli_malloc(node->class->priv_size);
+    if (!node->params_snapshot) {
+        ngli_darray_reset(&node->children);
+        return NGL_ERROR_MEMORY;
+    }
+    memcpy(node->params_snapshot, node->priv_data, node->class->priv_size);
 
     ngli_assert(node->ctx);
     if (node->class->init) {
         LOG(VERBOSE, "INIT %s @ %p", node->label, node);
+        struct ngl_node *prev_node = node->ctx->cur_node;
+        node->ctx->cur_node = node;
         int ret = node->class->init(node);
+        node->ctx->cur_node = prev_node;
         if (ret < 0) {
             LOG(ERROR, "initializing node %s failed: %s", node->label, NGLI_RET_STR(ret));
             node->state = STATE_INIT_FAILED;
@@ -441,7 +480,7 @@ int ngli_node_prepare(struct ngl_node *node)
     return 0;
 }
 
-int ngli_node_visit(struct ngl_node *node, int is_active, double t)
+static int node_visit(struct ngl_node *node, int is_active, double t)
 {
     /*
      * If a node is inactive and meant to be, there is no need
@@ -495,6 +534,18 @@ int ngli_node_visit(struct ngl_node *node, int is_active, double t)
     return 0;
 }
 
+int ngli_node_visit(struct ngl_node *node, int is_active, double t)
+{
+    struct profiler *profiler = &node->ctx->profiler;
+    if (!profiler->enabled)
+        return node_visit(node, is_active, t);
+
+    const int64_t start = ngli_profiler_begin(profiler, NGLI_PROFILER_PHASE_VISIT);
+    int ret = node_visit(node, is_active, t);
+    ngli_profiler_end(profiler, NGLI_PROFILER_PHASE_VISIT, start, node->label, node->class->name);
+    return ret;
+}
+
 static int node_prefetch(struct ngl_node *node)
 {
     if (node->state == STATE_READY)
@@ -502,7 +553,14 @@ static int node_prefetch(struct ngl_node *node)
 
     if (node->class->prefetch) {
         TRACE("PREFETCH %s @ %p", node->label, node);
+        struct profiler *profiler = &node->ctx->profiler;
+        const int64_t start = profiler->enabled ? ngli_profiler_begin(profiler, NGLI_PROFILER_PHASE_PREFETCH) : 0;
+        struct ngl_node *prev_node = node->ctx->cur_node;
+        node->ctx->cur_node = node;
         int ret = node->class->prefetch(node);
+        node->ctx->cur_node = prev_node;
+        if (profiler->enabled)
+            ngli_profiler_end(profiler, NGLI_PROFILER_PHASE_PREFETCH, start, node->label, node->class->name);
         if (ret < 0) {
             LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
             node->visit_time = -1.;
@@ -514,24 +572,57 @@ static int node_prefetch(struct ngl_node *node)
         }
     }
     node->state = STATE_READY;
+    node->version++;
 
     return 0;
 }
 
-int ngli_node_honor_release_prefetch(struct darray *nodes_array)
+static int node_cache(struct ngl_node *node)
+{
+    struct rescache *rescache = &node->ctx->rescache;
+
+    if (rescache->budget <= 0 || node->state != STATE_READY || !node->class->release) {
+        node_release(node);
+        return 0;
+    }
+
+    /* Move the node to the most recently used position */
+    ngli_rescache_remove(rescache, node);
+
+    /*
+     * The graphics memory charged to the node is completed with the memory
+     * it releases but which memtrack can not attribute to it
+     */
+    int64_t size = ngli_memtrack_get_node_size(&node->ctx->gctx->memtrack, node);
+    if (node->class->memory_usage)
+        size += node->class->memory_usage(node);
+    return ngli_rescache_add(rescache, node, size);
+}
+
+int ngli_node_honor_release_prefetch(struct ngl_ctx *ctx)
 {
+    struct rescache *rescache = &ctx->rescache;
+    struct darray *nodes_array = &ctx->activitycheck_nodes;
     struct ngl_node **nodes = ngli_darray_data(nodes_array);
     for (int i = 0; i < ngli_darray_count(nodes_array); i++) {
         struct ngl_node *node = nodes[i];
 
         if (node->is_active) {
+            if (ngli_rescache_remove(rescache, node)) {
+                TRACE("%s @ %p is still resident, no prefetch needed", node->label, node);
+                rescache->stats.nb_hits++;
+            }
             int ret = node_prefetch(node);
             if (ret < 0)
                 return ret;
         } else {
-            node_release(node);
+            int ret = node_cache(node);
+            if (ret < 0)
+                return ret;
         }
     }
+
+    ngli_rescache_trim(rescache, node_release);
     return 0;
 }
 
@@ -541,13 +632,21 @@ int ngli_node_update(struct ngl_node *node, double t)
     if (node->class->update) {
         if (node->last_update_time != t) {
             TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
+            struct profiler *profiler = &node->ctx->profiler;
+            const int64_t start = profiler->enabled ? ngli_profiler_begin(profiler, NGLI_PROFILER_PHASE_UPDATE) : 0;
+            struct ngl_node *prev_node = node->ctx->cur_node;
+            node->ctx->cur_node = node;
             int ret = node->class->update(node, t);
+            node->ctx->cur_node = prev_node;
+            if (profiler->enabled)
+                ngli_profiler_end(profiler, NGLI_PROFILER_PHASE_UPDATE, start, node->label, node->class->name);
             if (ret < 0) {
                 LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
                 return ret;
             }
             node->last_update_time = t;
             node->draw_count = 0;
+            node->ctx->nb_updated_nodes++;
         } else {
             TRACE("%s already updated for t=%g, skip it", node->label, t);
         }
@@ -560,7 +659,14 @@ void ngli_node_draw(struct ngl_node *node)
 {
     if (node->class->draw) {
         TRACE("DRAW %s @ %p", node->label, node);
+        struct profiler *profiler = &node->ctx->profiler;
+        const int64_t start = profiler->enabled ? ngli_profiler_begin(profiler, NGLI_PROFILER_PHASE_DRAW) : 0;
+        struct ngl_node *prev_node = node->ctx->cur_node;
+        node->ctx->cur_node = node;
         node->class->draw(node);
+        node->ctx->cur_node = prev_node;
+        if (profiler->enabled)
+            ngli_profiler_end(profiler, NGLI_PROFILER_PHASE_DRAW, start, node->label, node->class->name);
         node->draw_count++;
     }
 }
@@ -601,8 +707,12 @@ int ngl_node_param_add(struct ngl_node *node, const char *key,
         return ret;
     }
 
-    if (node->ctx && par->update_func)
-        ret = par->update_func(node);
+    if (node->ctx) {
+        node->version++;
+        node->params_hash = 0;
+        if (par->update_func)
+            ret = par->update_func(node);
+    }
 
     return ret;
 }
@@ -630,8 +740,12 @@ int ngl_node_param_set(struct ngl_node *node, const char *key, ...)
         return ret;
     }
 
-    if (node->ctx && par->update_func)
-        ret = par->update_func(node);
+    if (node->ctx) {
+        node->version++;
+        node->params_hash = 0;
+        if (par->update_func)
+            ret = par->update_func(node);
+    }
 
     return ret;
 }
@@ -653,6 +767,8 @@ void ngl_node_unrefp(struct ngl_node **nodep)
     if (delete) {
         LOG(VERBOSE, "DELETE %s @ %p", node->label, node);
         ngli_assert(!node->ctx);
+        if (node->class->destroy)
+            node->class->destroy(node);
         ngli_params_free((uint8_t *)node, ngli_base_node_params);
         ngli_params_free(node->priv_data, node->class->params);
         ngli_free_aligned(node);
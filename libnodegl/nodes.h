@@ -48,8 +48,13 @@
 #endif
 
 #include "animation.h"
+#include "animbatch.h"
+#include "attachpool.h"
 #include "block.h"
 #include "drawutils.h"
+#include "easing.h"
+#include "geompool.h"
+#include "glyphatlas.h"
 #include "graphicstate.h"
 #include "hmap.h"
 #include "hwconv.h"
@@ -57,12 +62,16 @@
 #include "image.h"
 #include "nodegl.h"
 #include "params.h"
+#include "pass.h"
 #include "pgcache.h"
+#include "profiler.h"
 #include "program.h"
+#include "threadpool.h"
 #include "darray.h"
 #include "buffer.h"
 #include "format.h"
 #include "rendertarget.h"
+#include "rescache.h"
 #include "rnode.h"
 #include "texture.h"
 
@@ -79,13 +88,27 @@ struct ngl_ctx {
     struct gctx *gctx;
     struct rnode rnode;
     struct rnode *rnode_pos;
+    int rnode_generation;      /* incremented every time the rnode tree is rebuilt */
     struct graphicstate graphicstate;
     struct rendertarget_desc *rendertarget_desc;
+    int rtt_level;             /* number of RenderToTexture being prepared */
     struct ngl_node *scene;
     struct ngl_config config;
     struct darray modelview_matrix_stack;
     struct darray projection_matrix_stack;
     struct darray activitycheck_nodes;
+    struct rescache rescache;
+    struct profiler profiler;
+    struct ngl_node *cur_node; /* node being initialized, prefetched, updated
+                                  or drawn, owner of the allocated resources */
+    int nb_updated_nodes;      /* number of nodes updated in the current frame */
+    struct threadpool *threadpool; /* data-parallel jobs, created on demand by
+                                      ngli_get_threadpool(), may be NULL */
+    int threadpool_probed;
+    struct animbatch animbatch;
+    struct glyphatlas glyphatlas;
+    struct geompool geompool;
+    struct attachpool attachpool;
 #if defined(HAVE_VAAPI_X11)
     Display *x11_display;
 #endif
@@ -117,6 +140,14 @@ struct ngl_node {
     double last_update_time;
 
     int draw_count;
+    int64_t version; /* incremented every time the node content changes
+                        outside of the time flow (live changes, GPU writes,
+                        reallocations) */
+
+    uint64_t params_hash; /* hash of the parameters when the node was
+                             initialized, 0 if they were live changed since */
+    uint8_t *params_snapshot; /* copy of the private data when the node was
+                                 initialized, to compare its parameters */
 
     int refcount;
     int ctx_refcount;
@@ -163,9 +194,17 @@ struct geometry_priv {
     int topology;
 
     int64_t max_indices;
+
+    /* axis-aligned bounding box of the vertices, if they are static */
+    int has_bounds;
+    float bounds_min[3];
+    float bounds_max[3];
 };
 
 struct ngl_node *ngli_node_geometry_generate_buffer(struct ngl_ctx *ctx, int type, int count, int size, void *data);
+void ngli_node_geometry_release_buffer(struct ngl_ctx *ctx, struct ngl_node **nodep);
+void ngli_node_geometry_set_bounds(struct geometry_priv *s, const float *vertices, int nb_vertices, int stride);
+int ngli_node_geometry_is_visible(const struct ngl_node *node, const float *modelview_matrix, const float *projection_matrix);
 
 struct buffer_priv {
     int count;              // number of elements
@@ -196,6 +235,7 @@ struct buffer_priv {
     int last_index;
 
     struct buffer *buffer;
+    int buffer_offset;      // offset of the data in buffer (shared geometry pool buffers)
     int buffer_refcount;
     double buffer_last_upload_time;
 };
@@ -243,6 +283,7 @@ struct variable_priv {
     struct ngl_node *transform;
     const float *transform_matrix;
     int as_mat4; /* quaternion only */
+    int batch_index; /* index in the context animation batch, -1 if not batched */
     int dynamic;
     int live_changed;
     int last_index;
@@ -278,6 +319,21 @@ struct program_priv {
     int nb_frag_output;
 };
 
+struct render_priv {
+    struct ngl_node *geometry;
+    struct ngl_node *program;
+    struct hmap *vert_resources;
+    struct hmap *frag_resources;
+    struct hmap *attributes;
+    struct hmap *instance_attributes;
+    int nb_instances;
+    int culling;
+
+    int use_culling;
+    struct pass pass;
+    struct darray vert_out_vars; // pgcraft_iovar
+};
+
 extern const struct param_choices ngli_mipmap_filter_choices;
 extern const struct param_choices ngli_filter_choices;
 
@@ -286,6 +342,7 @@ struct texture_priv {
     struct texture_params params;
     struct ngl_node *data_src;
     int direct_rendering;
+    int writable;           // bound as a writable image by a pass
 
     uint32_t supported_image_layouts;
     struct texture *texture;
@@ -382,10 +439,9 @@ enum easing_id {
     EASING_BACK_OUT,
     EASING_BACK_IN_OUT,
     EASING_BACK_OUT_IN,
+    EASING_NB
 };
 
-typedef double easing_type;
-typedef easing_type (*easing_function)(easing_type, int, const easing_type *);
 
 struct animkeyframe_priv {
     double time;
@@ -396,11 +452,14 @@ struct animkeyframe_priv {
     int easing;
     easing_function function;
     easing_function resolution;
+    easing_batch_function batch_function;
     double *args;
     int nb_args;
     double offsets[2];
     int scale_boundaries;
     double boundaries[2];
+    double lut_tolerance;
+    struct easing_lut lut;
 };
 
 enum {
@@ -460,7 +519,11 @@ struct node_class {
     void (*draw)(struct ngl_node *node);
     void (*release)(struct ngl_node *node);
     void (*uninit)(struct ngl_node *node);
+    void (*destroy)(struct ngl_node *node);
     char *(*info_str)(const struct ngl_node *node);
+    int64_t (*memory_usage)(const struct ngl_node *node); /* memory released with the node
+                                                             on top of the graphics memory
+                                                             memtrack charges to it */
     size_t priv_size;
     const struct node_param *params;
     const char *params_id;
@@ -471,11 +534,15 @@ void ngli_node_print_specs(void);
 
 int ngli_node_prepare(struct ngl_node *node);
 int ngli_node_visit(struct ngl_node *node, int is_active, double t);
-int ngli_node_honor_release_prefetch(struct darray *nodes_array);
+int ngli_node_honor_release_prefetch(struct ngl_ctx *ctx);
 int ngli_node_update(struct ngl_node *node, double t);
 int ngli_prepare_draw(struct ngl_ctx *s, double t);
+struct threadpool *ngli_get_threadpool(struct ngl_ctx *s);
 void ngli_node_draw(struct ngl_node *node);
 
+uint64_t ngli_node_hash_params(const struct ngl_node *node);
+int ngli_node_params_equal(const struct ngl_node *node, const struct ngl_node *ref);
+
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
 void ngli_node_detach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
 
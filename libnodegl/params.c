@@ -689,6 +689,153 @@ int ngli_params_add(uint8_t *base_ptr, const struct node_param *par,
     return 0;
 }
 
+uint64_t ngli_params_hash(const uint8_t *base_ptr, const struct node_param *params, uint64_t h)
+{
+    if (!params)
+        return h;
+
+    for (int i = 0; params[i].key; i++) {
+        const struct node_param *par = &params[i];
+        const uint8_t *srcp = base_ptr + par->offset;
+
+        switch (par->type) {
+            case PARAM_TYPE_STR: {
+                const char *s = *(const char **)srcp;
+                h = s ? ngli_fnv1a(h, s, strlen(s) + 1) : ngli_fnv1a(h, "", 0);
+                break;
+            }
+            case PARAM_TYPE_DATA: {
+                const uint8_t *data = *(const uint8_t **)srcp;
+                const int size = *(const int *)(srcp + sizeof(void *));
+                h = ngli_fnv1a(h, &size, sizeof(size));
+                if (data)
+                    h = ngli_fnv1a(h, data, size);
+                break;
+            }
+            case PARAM_TYPE_NODELIST: {
+                const struct ngl_node **elems = *(const struct ngl_node ***)srcp;
+                const int nb_elems = *(const int *)(srcp + sizeof(struct ngl_node **));
+                h = ngli_fnv1a(h, &nb_elems, sizeof(nb_elems));
+                if (elems)
+                    h = ngli_fnv1a(h, elems, nb_elems * sizeof(*elems));
+                break;
+            }
+            case PARAM_TYPE_DBLLIST: {
+                const double *elems = *(const double **)srcp;
+                const int nb_elems = *(const int *)(srcp + sizeof(double *));
+                h = ngli_fnv1a(h, &nb_elems, sizeof(nb_elems));
+                if (elems)
+                    h = ngli_fnv1a(h, elems, nb_elems * sizeof(*elems));
+                break;
+            }
+            case PARAM_TYPE_NODEDICT: {
+                /* The entries order depends on the insertion history: combine
+                 * them with an order independent operation */
+                const struct hmap *hmap = *(const struct hmap **)srcp;
+                uint64_t entries_h = 0;
+                const struct hmap_entry *entry = NULL;
+                while (hmap && (entry = ngli_hmap_next(hmap, entry))) {
+                    uint64_t entry_h = ngli_fnv1a(NGLI_FNV1A_INIT, entry->key, strlen(entry->key) + 1);
+                    entries_h += ngli_fnv1a(entry_h, &entry->data, sizeof(entry->data));
+                }
+                h = ngli_fnv1a(h, &entries_h, sizeof(entries_h));
+                break;
+            }
+            default:
+                h = ngli_fnv1a(h, srcp, ngli_params_specs[par->type].size);
+                break;
+        }
+    }
+
+    return h;
+}
+
+/*
+ * Compare the parameters stored at base_ptr with the ones of another
+ * instance, stored at ref_ptr. ref_init_ptr is a copy of the storage of the
+ * other instance taken when its parameters were set: the values its
+ * initialization may have altered since (such as a deduced count) are
+ * compared with this copy, the content it allocated is only compared by
+ * size, and the pointed content which has been replaced is never considered
+ * equal.
+ */
+int ngli_params_equal(const uint8_t *base_ptr, const uint8_t *ref_ptr, const uint8_t *ref_init_ptr,
+                      const struct node_param *params)
+{
+    if (!params)
+        return 1;
+
+    for (int i = 0; params[i].key; i++) {
+        const struct node_param *par = &params[i];
+        const uint8_t *srcp = base_ptr + par->offset;
+        const uint8_t *refp = ref_ptr + par->offset;
+        const uint8_t *ref_initp = ref_init_ptr + par->offset;
+        const size_t size = ngli_params_specs[par->type].size;
+
+        switch (par->type) {
+            case PARAM_TYPE_STR:
+            case PARAM_TYPE_DATA:
+            case PARAM_TYPE_NODELIST:
+            case PARAM_TYPE_DBLLIST:
+            case PARAM_TYPE_NODEDICT:
+                /* Content only allocated by the initialization, if any */
+                if (!*(void * const *)ref_initp) {
+                    if (memcmp(srcp, ref_initp, size))
+                        return 0;
+                    continue;
+                }
+                if (memcmp(refp, ref_initp, size))
+                    return 0;
+                break;
+        }
+
+        switch (par->type) {
+            case PARAM_TYPE_STR: {
+                const char *s = *(const char **)srcp;
+                const char *ref = *(const char **)refp;
+                if (strcmp(s ? s : "", ref ? ref : ""))
+                    return 0;
+                break;
+            }
+            case PARAM_TYPE_DATA:
+            case PARAM_TYPE_NODELIST:
+            case PARAM_TYPE_DBLLIST: {
+                const uint8_t *data = *(const uint8_t **)srcp;
+                const uint8_t *ref = *(const uint8_t **)refp;
+                const int count = *(const int *)(srcp + sizeof(void *));
+                const int ref_count = *(const int *)(refp + sizeof(void *));
+                const int elem_size = par->type == PARAM_TYPE_DATA     ? 1
+                                    : par->type == PARAM_TYPE_NODELIST ? sizeof(struct ngl_node *)
+                                    :                                    sizeof(double);
+                if (count != ref_count || !data != !ref)
+                    return 0;
+                if (data && memcmp(data, ref, count * elem_size))
+                    return 0;
+                break;
+            }
+            case PARAM_TYPE_NODEDICT: {
+                const struct hmap *hmap = *(const struct hmap **)srcp;
+                const struct hmap *ref = *(const struct hmap **)refp;
+                const int count = hmap ? ngli_hmap_count(hmap) : 0;
+                const int ref_count = ref ? ngli_hmap_count(ref) : 0;
+                if (count != ref_count)
+                    return 0;
+                const struct hmap_entry *entry = NULL;
+                while (hmap && (entry = ngli_hmap_next(hmap, entry)))
+                    if (ngli_hmap_get(ref, entry->key) != entry->data)
+                        return 0;
+                break;
+            }
+            default:
+                if (memcmp(srcp, ref_initp, size))
+                    return 0;
+                break;
+        }
+    }
+
+    return 1;
+}
+
 void ngli_params_free(uint8_t *base_ptr, const struct node_param *params)
 {
     if (!params)
@@ -107,6 +107,9 @@ int ngli_params_set(uint8_t *base_ptr, const struct node_param *par, va_list *ap
 int ngli_params_vset(uint8_t *base_ptr, const struct node_param *par, ...);
 int ngli_params_set_defaults(uint8_t *base_ptr, const struct node_param *params);
 int ngli_params_add(uint8_t *base_ptr, const struct node_param *par, int nb_elems, void *elems);
+uint64_t ngli_params_hash(const uint8_t *base_ptr, const struct node_param *params, uint64_t h);
+int ngli_params_equal(const uint8_t *base_ptr, const uint8_t *ref_ptr, const uint8_t *ref_init_ptr,
+                      const struct node_param *params);
 void ngli_params_free(uint8_t *base_ptr, const struct node_param *params);
 
 #endif
@@ -89,6 +89,14 @@ static int register_uniform(struct pass *s, const char *name, struct ngl_node *u
     return 0;
 }
 
+static int is_extra_attribute(const struct pass_params *params, const char *name)
+{
+    for (int i = 0; i < params->nb_extra_attributes; i++)
+        if (!strcmp(params->extra_attributes[i].name, name))
+            return 1;
+    return 0;
+}
+
 static int register_builtin_uniforms(struct pass *s)
 {
     struct pgcraft_uniform crafter_uniforms[] = {
@@ -97,8 +105,11 @@ static int register_builtin_uniforms(struct pass *s)
         {.name = "ngl_normal_matrix",     .type = NGLI_TYPE_MAT3, .stage=NGLI_PROGRAM_SHADER_VERT, .data = NULL},
     };
 
+    const struct pass_params *params = &s->params;
     for (int i = 0; i < NGLI_ARRAY_NB(crafter_uniforms); i++) {
         struct pgcraft_uniform *crafter_uniform = &crafter_uniforms[i];
+        if (is_extra_attribute(params, crafter_uniform->name))
+            continue;
         if (!ngli_darray_push(&s->crafter_uniforms, crafter_uniform))
             return NGL_ERROR_MEMORY;
     }
@@ -144,6 +155,7 @@ static int register_texture(struct pass *s, const char *name, struct ngl_node *t
                     return NGL_ERROR_UNSUPPORTED;
                 }
                 crafter_texture.type = NGLI_PGCRAFT_SHADER_TEX_TYPE_IMAGE2D;
+                texture_priv->writable |= resprops->writable;
             }
             crafter_texture.writable  = resprops->writable;
             crafter_texture.precision = resprops->precision;
@@ -177,6 +189,14 @@ static int register_block(struct pass *s, const char *name, struct ngl_node *blo
     struct block_priv *block_priv = block_node->priv_data;
     struct block *block = &block_priv->block;
 
+    const struct resourceprops_priv *resprops = NULL;
+    const struct pass_params *params = &s->params;
+    if (params->properties) {
+        const struct ngl_node *resprops_node = ngli_hmap_get(params->properties, name);
+        if (resprops_node)
+            resprops = resprops_node->priv_data;
+    }
+
     /*
      * Select buffer type. We prefer UBO over SSBO, but in the following
      * situations, UBO is not possible.
@@ -189,16 +209,8 @@ static int register_block(struct pass *s, const char *name, struct ngl_node *blo
         LOG(DEBUG, "block %s is larger than the max UBO size (%d > %d), declaring it as SSBO",
             name, block->size, limits->max_uniform_block_size);
         type = NGLI_TYPE_STORAGE_BUFFER;
-    } else {
-        const struct pass_params *params = &s->params;
-        if (params->properties) {
-            const struct ngl_node *resprops_node = ngli_hmap_get(params->properties, name);
-            if (resprops_node) {
-                const struct resourceprops_priv *resprops = resprops_node->priv_data;
-                if (resprops->variadic || resprops->writable)
-                    type = NGLI_TYPE_STORAGE_BUFFER;
-            }
-        }
+    } else if (resprops && (resprops->variadic || resprops->writable)) {
+        type = NGLI_TYPE_STORAGE_BUFFER;
     }
 
     /*
@@ -214,6 +226,7 @@ static int register_block(struct pass *s, const char *name, struct ngl_node *blo
     block->type = type;
     crafter_block.block = block;
     crafter_block.buffer = block_priv->buffer;
+    crafter_block.writable = resprops ? resprops->writable : 0;
 
     if (!ngli_darray_push(&s->crafter_blocks, &crafter_block))
         return NGL_ERROR_MEMORY;
@@ -279,7 +292,7 @@ static int register_attribute(struct pass *s, const char *name, struct ngl_node
     struct buffer_priv *attribute_priv = attribute->priv_data;
     const int format = attribute_priv->data_format;
     int stride = attribute_priv->data_stride;
-    int offset = 0;
+    int offset = attribute_priv->buffer_offset;
     struct buffer *buffer = attribute_priv->buffer;
 
     if (attribute_priv->block) {
@@ -360,7 +373,12 @@ static int pass_graphics_init(struct pass *s)
 
     graphics->topology = geometry_priv->topology;
 
-    if (geometry_priv->indices_buffer) {
+    if (params->indirect_buffer) {
+        s->indirect_buffer = params->indirect_buffer;
+        s->nb_draws = params->nb_draws;
+        s->indices_buffer = params->indices_buffer;
+        s->indices_format = params->indices_format;
+    } else if (geometry_priv->indices_buffer) {
         struct ngl_node *indices = geometry_priv->indices_buffer;
         struct buffer_priv *indices_priv = indices->priv_data;
         if (indices_priv->block) {
@@ -393,9 +411,10 @@ static int pass_graphics_init(struct pass *s)
         (ret = check_attributes(s, params->instance_attributes, 1)) < 0)
         return ret;
 
-    if ((ret = register_attribute(s, "ngl_position", geometry_priv->vertices_buffer, 0)) < 0 ||
-        (ret = register_attribute(s, "ngl_uvcoord",  geometry_priv->uvcoords_buffer, 0)) < 0 ||
-        (ret = register_attribute(s, "ngl_normal",   geometry_priv->normals_buffer, 0)) < 0)
+    if (!params->indirect_buffer &&
+        ((ret = register_attribute(s, "ngl_position", geometry_priv->vertices_buffer, 0)) < 0 ||
+         (ret = register_attribute(s, "ngl_uvcoord",  geometry_priv->uvcoords_buffer, 0)) < 0 ||
+         (ret = register_attribute(s, "ngl_normal",   geometry_priv->normals_buffer, 0)) < 0))
         return ret;
 
     if (params->attributes) {
@@ -416,6 +435,11 @@ static int pass_graphics_init(struct pass *s)
         }
     }
 
+    for (int i = 0; i < params->nb_extra_attributes; i++) {
+        if (!ngli_darray_push(&s->crafter_attributes, &params->extra_attributes[i]))
+            return NGL_ERROR_MEMORY;
+    }
+
     return 0;
 }
 
@@ -432,11 +456,32 @@ static int pass_compute_init(struct pass *s)
     return 0;
 }
 
+static void free_pipeline_descs(struct pass *s)
+{
+    struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
+    const int nb_descs = ngli_darray_count(&s->pipeline_descs);
+    for (int i = 0; i < nb_descs; i++) {
+        struct pipeline_desc *desc = &descs[i];
+        ngli_pipeline_freep(&desc->pipeline);
+        ngli_pgcraft_freep(&desc->crafter);
+    }
+    s->pipeline_descs.count = 0;
+}
+
 int ngli_pass_prepare(struct pass *s)
 {
     struct ngl_ctx *ctx = s->ctx;
     struct gctx *gctx = ctx->gctx;
 
+    /*
+     * A pass kept across a scene update is prepared again for the new render
+     * node tree: the pipelines indexed by the previous tree are dropped.
+     */
+    if (s->rnode_generation != ctx->rnode_generation) {
+        free_pipeline_descs(s);
+        s->rnode_generation = ctx->rnode_generation;
+    }
+
     struct pipeline_graphics pipeline_graphics = s->pipeline_graphics;
     pipeline_graphics.state = ctx->graphicstate;
     pipeline_graphics.rt_desc = *ctx->rendertarget_desc;
@@ -486,12 +531,63 @@ int ngli_pass_prepare(struct pass *s)
     if (ret < 0)
         return ret;
 
+    for (int i = 0; ctx->profiler.enabled && i < NGLI_PASS_NB_GTIMERS; i++) {
+        struct pass_gtimer *timer = &s->gtimers[i];
+        if (timer->gtimer)
+            continue;
+        timer->gtimer = ngli_gtimer_create(gctx);
+        if (!timer->gtimer)
+            return NGL_ERROR_MEMORY;
+        ret = ngli_gtimer_init(timer->gtimer);
+        if (ret < 0)
+            return ret;
+    }
+
     desc->modelview_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_modelview_matrix", NGLI_PROGRAM_SHADER_VERT);
     desc->projection_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_projection_matrix", NGLI_PROGRAM_SHADER_VERT);
     desc->normal_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_normal_matrix", NGLI_PROGRAM_SHADER_VERT);
     return 0;
 }
 
+static const struct pgcraft *get_last_crafter(const struct pass *s)
+{
+    const int nb_descs = ngli_darray_count(&s->pipeline_descs);
+    if (!nb_descs)
+        return NULL;
+    const struct pipeline_desc *desc = ngli_darray_get(&s->pipeline_descs, nb_descs - 1);
+    return desc->crafter;
+}
+
+/*
+ * Check if the program of the last prepared pipeline makes use of a uniform
+ * or an attribute: the ones not referenced by the shaders are filtered out by
+ * pgcraft.
+ */
+int ngli_pass_uses_uniform(const struct pass *s, const char *name, int stage)
+{
+    const struct pgcraft *crafter = get_last_crafter(s);
+    return crafter && ngli_pgcraft_get_uniform_index(crafter, name, stage) >= 0;
+}
+
+int ngli_pass_uses_attribute(const struct pass *s, const char *name)
+{
+    const struct pgcraft *crafter = get_last_crafter(s);
+    return crafter && ngli_pgcraft_get_vertex_attribute_index(crafter, name) >= 0;
+}
+
+/*
+ * Check if the vertex stage positions the geometry with the modelview and
+ * projection matrices (the modelview matrix being either a uniform or, in a
+ * batch, a per-instance attribute), which is what the geometry culling
+ * relies on.
+ */
+int ngli_pass_uses_geometry_transform(const struct pass *s)
+{
+    return (ngli_pass_uses_uniform(s, "ngl_modelview_matrix", NGLI_PROGRAM_SHADER_VERT) ||
+            ngli_pass_uses_attribute(s, "ngl_modelview_matrix")) &&
+           ngli_pass_uses_uniform(s, "ngl_projection_matrix", NGLI_PROGRAM_SHADER_VERT);
+}
+
 int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params *params)
 {
     s->ctx = ctx;
@@ -551,15 +647,12 @@ void ngli_pass_uninit(struct pass *s)
     if (!s->ctx)
         return;
 
-    struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
-    const int nb_descs = ngli_darray_count(&s->pipeline_descs);
-    for (int i = 0; i < nb_descs; i++) {
-        struct pipeline_desc *desc = &descs[i];
-        ngli_pipeline_freep(&desc->pipeline);
-        ngli_pgcraft_freep(&desc->crafter);
-    }
+    free_pipeline_descs(s);
     ngli_darray_reset(&s->pipeline_descs);
 
+    for (int i = 0; i < NGLI_PASS_NB_GTIMERS; i++)
+        ngli_gtimer_freep(&s->gtimers[i].gtimer);
+
     if (s->indices)
         ngli_node_buffer_unref(s->indices);
 
@@ -619,6 +712,74 @@ int ngli_pass_update(struct pass *s, double t)
     return 0;
 }
 
+/*
+ * Flag the textures and blocks written by the shaders as changed so the
+ * content-aware caches (see RenderToTexture) notice the new content.
+ */
+static void track_writes(struct pass *s)
+{
+    struct ngl_node **texture_nodes = ngli_darray_data(&s->texture_nodes);
+    const struct pgcraft_texture *crafter_textures = ngli_darray_data(&s->crafter_textures);
+    for (int i = 0; i < ngli_darray_count(&s->crafter_textures); i++) {
+        const struct pgcraft_texture *crafter_texture = &crafter_textures[i];
+        if (crafter_texture->type == NGLI_PGCRAFT_SHADER_TEX_TYPE_IMAGE2D && crafter_texture->writable)
+            texture_nodes[i]->version++;
+    }
+
+    struct ngl_node **block_nodes = ngli_darray_data(&s->block_nodes);
+    const struct pgcraft_block *crafter_blocks = ngli_darray_data(&s->crafter_blocks);
+    for (int i = 0; i < ngli_darray_count(&s->crafter_blocks); i++) {
+        const struct pgcraft_block *crafter_block = &crafter_blocks[i];
+        const int is_ssbo = crafter_block->block->type == NGLI_TYPE_STORAGE_BUFFER;
+        if (crafter_block->writable || (is_ssbo && s->pipeline_type == NGLI_PIPELINE_TYPE_COMPUTE))
+            block_nodes[i]->version++;
+    }
+}
+
+static void poll_gtimers(struct pass *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    const struct pass_params *params = &s->params;
+    const char *name = s->pipeline_type == NGLI_PIPELINE_TYPE_GRAPHICS ? "graphics pass" : "compute pass";
+
+    /* Oldest measures first */
+    for (int i = 0; i < NGLI_PASS_NB_GTIMERS; i++) {
+        struct pass_gtimer *timer = &s->gtimers[(s->gtimer_index + i) % NGLI_PASS_NB_GTIMERS];
+        int64_t duration;
+        if (!timer->pending || !ngli_gtimer_poll(timer->gtimer, &duration))
+            continue;
+        ngli_profiler_add(&ctx->profiler, NGLI_PROFILER_PHASE_GPU, timer->frame_index,
+                          timer->start, duration, params->label, name);
+        timer->pending = 0;
+    }
+}
+
+static struct pass_gtimer *start_gtimer(struct pass *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    if (!s->gtimers[0].gtimer)
+        return NULL;
+
+    poll_gtimers(s);
+
+    /*
+     * Timer queries can not be nested: the pass is not measured if an outer
+     * timer (such as the one of the HUD) is running.
+     */
+    if (ctx->gctx->timer_active)
+        return NULL;
+
+    /* A measure still not available after a full cycle is dropped */
+    struct pass_gtimer *timer = &s->gtimers[s->gtimer_index];
+    s->gtimer_index = (s->gtimer_index + 1) % NGLI_PASS_NB_GTIMERS;
+    timer->pending = 0;
+    timer->frame_index = ctx->profiler.frame_index;
+    timer->start = ngli_gettime_relative_ns();
+    ngli_gtimer_start(timer->gtimer);
+    return timer;
+}
+
 int ngli_pass_exec(struct pass *s)
 {
     struct ngl_ctx *ctx = s->ctx;
@@ -635,9 +796,7 @@ int ngli_pass_exec(struct pass *s)
 
     if (desc->normal_matrix_index >= 0) {
         float normal_matrix[3*3];
-        ngli_mat3_from_mat4(normal_matrix, modelview_matrix);
-        ngli_mat3_inverse(normal_matrix, normal_matrix);
-        ngli_mat3_transpose(normal_matrix, normal_matrix);
+        ngli_mat3_normal_from_mat4(normal_matrix, modelview_matrix);
         ngli_pipeline_update_uniform(pipeline, desc->normal_matrix_index, normal_matrix);
     }
 
@@ -681,13 +840,26 @@ int ngli_pass_exec(struct pass *s)
         ngli_pipeline_update_uniform(pipeline, fields[NGLI_INFO_FIELD_SAMPLING_MODE].index, &layout);
     }
 
+    struct pass_gtimer *timer = start_gtimer(s);
+
     if (s->pipeline_type == NGLI_PIPELINE_TYPE_GRAPHICS)
-        if (s->indices_buffer)
+        if (s->indirect_buffer && s->indices_buffer)
+            ngli_pipeline_draw_indexed_indirect(pipeline, s->indices_buffer, s->indices_format, s->indirect_buffer, s->nb_draws);
+        else if (s->indirect_buffer)
+            ngli_pipeline_draw_indirect(pipeline, s->indirect_buffer, s->nb_draws);
+        else if (s->indices_buffer)
             ngli_pipeline_draw_indexed(pipeline, s->indices_buffer, s->indices_format, s->nb_indices, s->nb_instances);
         else
             ngli_pipeline_draw(pipeline, s->nb_vertices, s->nb_instances);
     else
         ngli_pipeline_dispatch(pipeline, params->nb_group_x, params->nb_group_y, params->nb_group_z);
 
+    track_writes(s);
+
+    if (timer) {
+        ngli_gtimer_stop(timer->gtimer);
+        timer->pending = 1;
+    }
+
     return 0;
 }
@@ -25,6 +25,7 @@
 #include <stdint.h>
 #include "darray.h"
 #include "pgcraft.h"
+#include "gtimer.h"
 #include "pipeline.h"
 
 struct ngl_ctx;
@@ -42,6 +43,24 @@ struct pass_params {
     int nb_instances;
     struct hmap *attributes;
     struct hmap *instance_attributes;
+    /*
+     * Attributes not backed by a buffer node, forwarded as is to the program
+     * crafter. A builtin uniform (such as ngl_modelview_matrix) sharing the
+     * name of one of these attributes is not declared.
+     */
+    const struct pgcraft_attribute *extra_attributes;
+    int nb_extra_attributes;
+    /*
+     * Multi-draw: if an indirect buffer is set, only the topology of the
+     * geometry is honored. The geometry attributes (ngl_position,
+     * ngl_uvcoord, ngl_normal) are expected among the extra attributes and
+     * the draws are described by the indirect buffer, optionally indexing
+     * the specified indices buffer.
+     */
+    struct buffer *indirect_buffer;
+    int nb_draws;
+    struct buffer *indices_buffer;
+    int indices_format;
     struct pgcraft_iovar *vert_out_vars;
     int nb_vert_out_vars;
     int nb_frag_output;
@@ -59,6 +78,20 @@ enum {
     NGLI_PASS_TYPE_COMPUTE,
 };
 
+/*
+ * GPU timers of the profiler: the measures are read asynchronously, up to
+ * NGLI_PASS_NB_GTIMERS executions late, so the profiling does not stall the
+ * pipeline waiting for the GPU
+ */
+#define NGLI_PASS_NB_GTIMERS 3
+
+struct pass_gtimer {
+    struct gtimer *gtimer;
+    int pending;
+    int64_t frame_index;
+    int64_t start;
+};
+
 struct pass {
     struct ngl_ctx *ctx;
     struct pass_params params;
@@ -74,6 +107,8 @@ struct pass {
     int nb_indices;
     int nb_vertices;
     int nb_instances;
+    struct buffer *indirect_buffer;
+    int nb_draws;
 
     int pipeline_type;
     struct pipeline_graphics pipeline_graphics;
@@ -82,10 +117,17 @@ struct pass {
     struct darray crafter_textures;
     struct darray crafter_blocks;
     struct darray pipeline_descs;
+    int rnode_generation;   /* render node tree the pipelines are prepared for */
+
+    struct pass_gtimer gtimers[NGLI_PASS_NB_GTIMERS];
+    int gtimer_index;
 };
 
 int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params *params);
 int ngli_pass_prepare(struct pass *s);
+int ngli_pass_uses_uniform(const struct pass *s, const char *name, int stage);
+int ngli_pass_uses_attribute(const struct pass *s, const char *name);
+int ngli_pass_uses_geometry_transform(const struct pass *s);
 void ngli_pass_uninit(struct pass *s);
 int ngli_pass_update(struct pass *s, double t);
 int ngli_pass_exec(struct pass *s);
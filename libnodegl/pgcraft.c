@@ -298,6 +298,7 @@ static int inject_texture_info(struct pgcraft *s, struct pgcraft_texture_info *i
                 .type     = field->type,
                 .location = -1,
                 .binding  = -1,
+                .access   = info->writable ? NGLI_ACCESS_WRITE_BIT : NGLI_ACCESS_READ_BIT,
                 .texture  = info->texture,
             };
             snprintf(pl_texture.name, sizeof(pl_texture.name), "%s", field->name);
@@ -374,6 +375,7 @@ static int inject_block(struct pgcraft *s, struct bstr *b,
     struct pipeline_buffer pl_buffer = {
         .type    = block->type,
         .binding = -1,
+        .access  = named_block->writable ? NGLI_ACCESS_READ_WRITE : NGLI_ACCESS_READ_BIT,
         .buffer  = named_block->buffer,
     };
     int len = snprintf(pl_buffer.name, sizeof(pl_buffer.name), "%s_block", named_block->name);
@@ -917,10 +919,10 @@ static int probe_pipeline_elems(struct pgcraft *s)
     return 0;
 }
 
-#define IS_GL_ES_MIN(min)   (config->backend == NGL_BACKEND_OPENGLES && gctx->version >= (min))
-#define IS_GL_MIN(min)      (config->backend == NGL_BACKEND_OPENGL   && gctx->version >= (min))
-#define IS_GLSL_ES_MIN(min) (config->backend == NGL_BACKEND_OPENGLES && s->glsl_version >= (min))
-#define IS_GLSL_MIN(min)    (config->backend == NGL_BACKEND_OPENGL   && s->glsl_version >= (min))
+#define IS_GL_ES_MIN(min)   (backend == NGL_BACKEND_OPENGLES && gctx->version >= (min))
+#define IS_GL_MIN(min)      (backend == NGL_BACKEND_OPENGL   && gctx->version >= (min))
+#define IS_GLSL_ES_MIN(min) (backend == NGL_BACKEND_OPENGLES && s->glsl_version >= (min))
+#define IS_GLSL_MIN(min)    (backend == NGL_BACKEND_OPENGL   && s->glsl_version >= (min))
 
 static void setup_glsl_info_gl(struct pgcraft *s)
 {
@@ -928,14 +930,17 @@ static void setup_glsl_info_gl(struct pgcraft *s)
     const struct ngl_config *config = &ctx->config;
     struct gctx *gctx = ctx->gctx;
 
-    if (config->backend == NGL_BACKEND_OPENGL) {
+    /* The null backend mimics a desktop OpenGL context */
+    const int backend = config->backend == NGL_BACKEND_NULL ? NGL_BACKEND_OPENGL : config->backend;
+
+    if (backend == NGL_BACKEND_OPENGL) {
         switch (gctx->version) {
         case 300: s->glsl_version = 130;           break;
         case 310: s->glsl_version = 140;           break;
         case 320: s->glsl_version = 150;           break;
         default:  s->glsl_version = gctx->version; break;
         }
-    } else if (config->backend == NGL_BACKEND_OPENGLES) {
+    } else if (backend == NGL_BACKEND_OPENGLES) {
         if (gctx->version >= 300) {
             s->glsl_version = gctx->version;
             s->glsl_version_suffix = " es";
@@ -959,9 +964,14 @@ static void setup_glsl_info_gl(struct pgcraft *s)
 
     const int has_buffer_bindings = IS_GL_ES_MIN(310) || IS_GL_MIN(420);
     if (has_buffer_bindings) {
-        /* Bindings are unique across stages and types */
-        for (int i = 0; i < NB_BINDINGS; i++)
-            s->next_bindings[i] = &s->bindings[i];
+        /*
+         * Bindings are unique across stages for a given type: the resources
+         * of all the stages live in the same binding space, as they would in
+         * a single descriptor set
+         */
+        for (int stage = 0; stage < NGLI_PROGRAM_SHADER_NB; stage++)
+            for (int type = 0; type < NGLI_BINDING_TYPE_NB; type++)
+                s->next_bindings[BIND_ID(stage, type)] = &s->bindings[type];
 
         /*
          * FIXME: currently, program probing code forces a binding for the UBO, so
@@ -987,7 +997,9 @@ static void setup_glsl_info(struct pgcraft *s)
     s->rg = "rg";
     s->glsl_version_suffix = "";
 
-    if (config->backend == NGL_BACKEND_OPENGL || config->backend == NGL_BACKEND_OPENGLES)
+    if (config->backend == NGL_BACKEND_OPENGL ||
+        config->backend == NGL_BACKEND_OPENGLES ||
+        config->backend == NGL_BACKEND_NULL)
         setup_glsl_info_gl(s);
     else
         ngli_assert(0);
@@ -1100,6 +1112,17 @@ int ngli_pgcraft_get_uniform_index(const struct pgcraft *s, const char *name, in
     return get_uniform_index(s, name);
 }
 
+int ngli_pgcraft_get_vertex_attribute_index(const struct pgcraft *s, const char *name)
+{
+    const struct pipeline_attribute *pipeline_attributes = ngli_darray_data(&s->filtered_pipeline_attributes);
+    for (int i = 0; i < ngli_darray_count(&s->filtered_pipeline_attributes); i++) {
+        const struct pipeline_attribute *pipeline_attribute = &pipeline_attributes[i];
+        if (!strcmp(pipeline_attribute->name, name))
+            return i;
+    }
+    return -1;
+}
+
 void ngli_pgcraft_freep(struct pgcraft **sp)
 {
     struct pgcraft *s = *sp;
@@ -64,6 +64,7 @@ struct pgcraft_block {
     const char *instance_name;
     int stage;
     int variadic;
+    int writable;
     const struct block *block;
     struct buffer *buffer;
 };
@@ -167,7 +168,7 @@ struct pgcraft {
 
     struct program *program;
 
-    int bindings[NB_BINDINGS];
+    int bindings[NGLI_BINDING_TYPE_NB];
     int *next_bindings[NB_BINDINGS];
     int in_locations[NGLI_PROGRAM_SHADER_NB];
     int out_locations[NGLI_PROGRAM_SHADER_NB];
@@ -190,6 +191,7 @@ int ngli_pgcraft_craft(struct pgcraft *s,
                        const struct pgcraft_params *params);
 
 int ngli_pgcraft_get_uniform_index(const struct pgcraft *s, const char *name, int stage);
+int ngli_pgcraft_get_vertex_attribute_index(const struct pgcraft *s, const char *name);
 
 void ngli_pgcraft_freep(struct pgcraft **sp);
 
@@ -21,7 +21,28 @@
 
 
 #include "gctx.h"
+#include "nodegl.h"
 #include "pipeline.h"
+#include "type.h"
+#include "utils.h"
+
+static const int uniform_sizes_map[NGLI_TYPE_NB] = {
+    [NGLI_TYPE_BOOL]   = sizeof(int)   * 1,
+    [NGLI_TYPE_INT]    = sizeof(int)   * 1,
+    [NGLI_TYPE_IVEC2]  = sizeof(int)   * 2,
+    [NGLI_TYPE_IVEC3]  = sizeof(int)   * 3,
+    [NGLI_TYPE_IVEC4]  = sizeof(int)   * 4,
+    [NGLI_TYPE_UINT]   = sizeof(int)   * 1,
+    [NGLI_TYPE_UIVEC2] = sizeof(int)   * 2,
+    [NGLI_TYPE_UIVEC3] = sizeof(int)   * 3,
+    [NGLI_TYPE_UIVEC4] = sizeof(int)   * 4,
+    [NGLI_TYPE_FLOAT]  = sizeof(float) * 1,
+    [NGLI_TYPE_VEC2]   = sizeof(float) * 2,
+    [NGLI_TYPE_VEC3]   = sizeof(float) * 3,
+    [NGLI_TYPE_VEC4]   = sizeof(float) * 4,
+    [NGLI_TYPE_MAT3]   = sizeof(float) * 3 * 3,
+    [NGLI_TYPE_MAT4]   = sizeof(float) * 4 * 4,
+};
 
 struct pipeline *ngli_pipeline_create(struct gctx *gctx)
 {
@@ -30,42 +51,107 @@ struct pipeline *ngli_pipeline_create(struct gctx *gctx)
 
 int ngli_pipeline_init(struct pipeline *s, const struct pipeline_params *params)
 {
+    ngli_darray_init(&s->uniform_sizes, sizeof(int), 0);
+    for (int i = 0; i < params->nb_uniforms; i++) {
+        const struct pipeline_uniform *uniform = &params->uniforms[i];
+        const int size = uniform_sizes_map[uniform->type] * NGLI_MAX(uniform->count, 1);
+        if (!ngli_darray_push(&s->uniform_sizes, &size))
+            return NGL_ERROR_MEMORY;
+    }
+
     return s->gctx->class->pipeline_init(s, params);
 }
 
 int ngli_pipeline_update_attribute(struct pipeline *s, int index, struct buffer *buffer)
 {
-    return s->gctx->class->pipeline_update_attribute(s, index, buffer);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        return ngli_cmdbuffer_pipeline_update_attribute(&gctx->cmdbuffer, s, index, buffer);
+    return gctx->class->pipeline_update_attribute(s, index, buffer);
 }
 
 int ngli_pipeline_update_uniform(struct pipeline *s, int index, const void *value)
 {
-    return s->gctx->class->pipeline_update_uniform(s, index, value);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        return ngli_cmdbuffer_pipeline_update_uniform(&gctx->cmdbuffer, s, index, value);
+    return gctx->class->pipeline_update_uniform(s, index, value);
 }
 
 int ngli_pipeline_update_texture(struct pipeline *s, int index, struct texture *texture)
 {
-    return s->gctx->class->pipeline_update_texture(s, index, texture);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        return ngli_cmdbuffer_pipeline_update_texture(&gctx->cmdbuffer, s, index, texture);
+    return gctx->class->pipeline_update_texture(s, index, texture);
 }
 
 void ngli_pipeline_draw(struct pipeline *s, int nb_vertices, int nb_instances)
 {
-    return s->gctx->class->pipeline_draw(s, nb_vertices, nb_instances);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording) {
+        ngli_cmdbuffer_pipeline_draw(&gctx->cmdbuffer, s, nb_vertices, nb_instances);
+    } else {
+        ngli_sharegroup_lock_submit(gctx->sharegroup);
+        gctx->class->pipeline_draw(s, nb_vertices, nb_instances);
+        ngli_sharegroup_unlock_submit(gctx->sharegroup);
+    }
 }
 
 void ngli_pipeline_draw_indexed(struct pipeline *s, struct buffer *indices, int indices_format, int nb_indices, int nb_instances)
 {
-    return s->gctx->class->pipeline_draw_indexed(s, indices, indices_format, nb_indices, nb_instances);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording) {
+        ngli_cmdbuffer_pipeline_draw_indexed(&gctx->cmdbuffer, s, indices, indices_format, nb_indices, nb_instances);
+    } else {
+        ngli_sharegroup_lock_submit(gctx->sharegroup);
+        gctx->class->pipeline_draw_indexed(s, indices, indices_format, nb_indices, nb_instances);
+        ngli_sharegroup_unlock_submit(gctx->sharegroup);
+    }
+}
+
+void ngli_pipeline_draw_indirect(struct pipeline *s, struct buffer *indirect, int nb_draws)
+{
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording) {
+        ngli_cmdbuffer_pipeline_draw_indirect(&gctx->cmdbuffer, s, indirect, nb_draws);
+    } else {
+        ngli_sharegroup_lock_submit(gctx->sharegroup);
+        gctx->class->pipeline_draw_indirect(s, indirect, nb_draws);
+        ngli_sharegroup_unlock_submit(gctx->sharegroup);
+    }
+}
+
+void ngli_pipeline_draw_indexed_indirect(struct pipeline *s, struct buffer *indices, int indices_format, struct buffer *indirect, int nb_draws)
+{
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording) {
+        ngli_cmdbuffer_pipeline_draw_indexed_indirect(&gctx->cmdbuffer, s, indices, indices_format, indirect, nb_draws);
+    } else {
+        ngli_sharegroup_lock_submit(gctx->sharegroup);
+        gctx->class->pipeline_draw_indexed_indirect(s, indices, indices_format, indirect, nb_draws);
+        ngli_sharegroup_unlock_submit(gctx->sharegroup);
+    }
 }
 
 void ngli_pipeline_dispatch(struct pipeline *s, int nb_group_x, int nb_group_y, int nb_group_z)
 {
-    return s->gctx->class->pipeline_dispatch(s, nb_group_x, nb_group_y, nb_group_z);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording) {
+        ngli_cmdbuffer_pipeline_dispatch(&gctx->cmdbuffer, s, nb_group_x, nb_group_y, nb_group_z);
+    } else {
+        ngli_sharegroup_lock_submit(gctx->sharegroup);
+        gctx->class->pipeline_dispatch(s, nb_group_x, nb_group_y, nb_group_z);
+        ngli_sharegroup_unlock_submit(gctx->sharegroup);
+    }
 }
 
 void ngli_pipeline_freep(struct pipeline **sp)
 {
     if (!*sp)
         return;
-    (*sp)->gctx->class->pipeline_freep(sp);
+    struct gctx *gctx = (*sp)->gctx;
+    ngli_cmdbuffer_sync(&gctx->cmdbuffer);
+    ngli_darray_reset(&(*sp)->uniform_sizes);
+    gctx->class->pipeline_freep(sp);
 }
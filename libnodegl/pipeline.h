@@ -22,6 +22,8 @@
 #ifndef PIPELINE_H
 #define PIPELINE_H
 
+#include <stdint.h>
+
 #include "buffer.h"
 #include "darray.h"
 #include "graphicstate.h"
@@ -43,6 +45,7 @@ struct pipeline_texture {
     int type;
     int location;
     int binding;
+    int access;
     struct texture *texture;
 };
 
@@ -50,6 +53,7 @@ struct pipeline_buffer {
     char name[MAX_ID_LEN];
     int type;
     int binding;
+    int access;
     struct buffer *buffer;
 };
 
@@ -63,6 +67,25 @@ struct pipeline_attribute {
     struct buffer *buffer;
 };
 
+/*
+ * Indirect draw commands, laid out as expected by the graphics APIs: an
+ * indirect buffer is a tightly packed array of one of these structures
+ */
+struct draw_indirect_cmd {
+    uint32_t nb_vertices;
+    uint32_t nb_instances;
+    uint32_t first_vertex;
+    uint32_t first_instance;
+};
+
+struct draw_indexed_indirect_cmd {
+    uint32_t nb_indices;
+    uint32_t nb_instances;
+    uint32_t first_index;
+    int32_t  vertex_offset;
+    uint32_t first_instance;
+};
+
 struct pipeline_graphics {
     int topology;
     struct graphicstate state;
@@ -101,6 +124,8 @@ struct pipeline {
     struct darray buffer_descs;
     struct darray attribute_descs;
     int nb_unbound_attributes;
+
+    struct darray uniform_sizes; /* int, data size of each uniform, used to record their updates */
 };
 
 struct pipeline *ngli_pipeline_create(struct gctx *gctx);
@@ -110,6 +135,8 @@ int ngli_pipeline_update_uniform(struct pipeline *s, int index, const void *valu
 int ngli_pipeline_update_texture(struct pipeline *s, int index, struct texture *texture);
 void ngli_pipeline_draw(struct pipeline *s, int nb_vertices, int nb_instances);
 void ngli_pipeline_draw_indexed(struct pipeline *s, struct buffer *indices, int indices_format, int nb_indices, int nb_instances);
+void ngli_pipeline_draw_indirect(struct pipeline *s, struct buffer *indirect, int nb_draws);
+void ngli_pipeline_draw_indexed_indirect(struct pipeline *s, struct buffer *indices, int indices_format, struct buffer *indirect, int nb_draws);
 void ngli_pipeline_dispatch(struct pipeline *s, int nb_group_x, int nb_group_y, int nb_group_z);
 
 void ngli_pipeline_freep(struct pipeline **sp);
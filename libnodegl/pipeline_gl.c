@@ -292,6 +292,110 @@ static void set_buffers(struct pipeline *s, struct glcontext *gl)
     }
 }
 
+static int is_buffer_written(const struct pipeline *s, const struct pipeline_buffer *pipeline_buffer)
+{
+    if (pipeline_buffer->type != NGLI_TYPE_STORAGE_BUFFER)
+        return 0;
+
+    /*
+     * Storage blocks are not declared readonly in the shaders, so they are
+     * assumed to be written by the compute pipelines unless proven otherwise
+     */
+    return s->type == NGLI_PIPELINE_TYPE_COMPUTE || (pipeline_buffer->access & NGLI_ACCESS_WRITE_BIT);
+}
+
+static int is_texture_written(const struct pipeline_texture *pipeline_texture)
+{
+    return pipeline_texture->type == NGLI_TYPE_IMAGE_2D && pipeline_texture->texture &&
+           (pipeline_texture->access & NGLI_ACCESS_WRITE_BIT);
+}
+
+/*
+ * Request the memory barriers needed by the resources accessed by the
+ * pipeline if they have been written by a previous shader execution
+ */
+static void require_memory_barriers(struct pipeline *s, struct glcontext *gl, const struct buffer *indices,
+                                    const struct buffer *indirect)
+{
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct memorybarrier_gl *memorybarrier = &gctx_gl->memorybarrier;
+
+    /* Nothing has ever been written by a shader */
+    if (!memorybarrier->write_id)
+        return;
+
+    const struct buffer_desc *buffer_descs = ngli_darray_data(&s->buffer_descs);
+    for (int i = 0; i < ngli_darray_count(&s->buffer_descs); i++) {
+        const struct pipeline_buffer *pipeline_buffer = &buffer_descs[i].buffer;
+        const struct buffer_gl *buffer_gl = (const struct buffer_gl *)pipeline_buffer->buffer;
+        const GLbitfield barrier = pipeline_buffer->type == NGLI_TYPE_STORAGE_BUFFER ? GL_SHADER_STORAGE_BARRIER_BIT
+                                                                                     : GL_UNIFORM_BARRIER_BIT;
+        ngli_memorybarrier_gl_require(memorybarrier, gl, buffer_gl->last_shader_write, barrier);
+    }
+
+    const struct texture_desc *texture_descs = ngli_darray_data(&s->texture_descs);
+    for (int i = 0; i < ngli_darray_count(&s->texture_descs); i++) {
+        const struct pipeline_texture *pipeline_texture = &texture_descs[i].texture;
+        const struct texture_gl *texture_gl = (const struct texture_gl *)pipeline_texture->texture;
+        if (!texture_gl)
+            continue;
+        const GLbitfield barrier = pipeline_texture->type == NGLI_TYPE_IMAGE_2D ? GL_SHADER_IMAGE_ACCESS_BARRIER_BIT
+                                                                                : GL_TEXTURE_FETCH_BARRIER_BIT;
+        ngli_memorybarrier_gl_require(memorybarrier, gl, texture_gl->last_shader_write, barrier);
+    }
+
+    const struct attribute_desc *attribute_descs = ngli_darray_data(&s->attribute_descs);
+    for (int i = 0; i < ngli_darray_count(&s->attribute_descs); i++) {
+        const struct buffer_gl *buffer_gl = (const struct buffer_gl *)attribute_descs[i].attribute.buffer;
+        if (buffer_gl)
+            ngli_memorybarrier_gl_require(memorybarrier, gl, buffer_gl->last_shader_write, GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    }
+
+    if (indices) {
+        const struct buffer_gl *indices_gl = (const struct buffer_gl *)indices;
+        ngli_memorybarrier_gl_require(memorybarrier, gl, indices_gl->last_shader_write, GL_ELEMENT_ARRAY_BARRIER_BIT);
+    }
+
+    if (indirect) {
+        const struct buffer_gl *indirect_gl = (const struct buffer_gl *)indirect;
+        ngli_memorybarrier_gl_require(memorybarrier, gl, indirect_gl->last_shader_write, GL_COMMAND_BARRIER_BIT);
+    }
+
+    ngli_memorybarrier_gl_flush(memorybarrier, gl);
+}
+
+/*
+ * Flag the resources written by the pipeline execution so that their next
+ * consumers can request the appropriate memory barriers
+ */
+static void track_memory_writes(struct pipeline *s)
+{
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    int64_t write_id = 0;
+
+    const struct buffer_desc *buffer_descs = ngli_darray_data(&s->buffer_descs);
+    for (int i = 0; i < ngli_darray_count(&s->buffer_descs); i++) {
+        const struct pipeline_buffer *pipeline_buffer = &buffer_descs[i].buffer;
+        if (is_buffer_written(s, pipeline_buffer)) {
+            if (!write_id)
+                write_id = ngli_memorybarrier_gl_add_write(&gctx_gl->memorybarrier);
+            struct buffer_gl *buffer_gl = (struct buffer_gl *)pipeline_buffer->buffer;
+            buffer_gl->last_shader_write = write_id;
+        }
+    }
+
+    const struct texture_desc *texture_descs = ngli_darray_data(&s->texture_descs);
+    for (int i = 0; i < ngli_darray_count(&s->texture_descs); i++) {
+        const struct pipeline_texture *pipeline_texture = &texture_descs[i].texture;
+        if (is_texture_written(pipeline_texture)) {
+            if (!write_id)
+                write_id = ngli_memorybarrier_gl_add_write(&gctx_gl->memorybarrier);
+            struct texture_gl *texture_gl = (struct texture_gl *)pipeline_texture->texture;
+            texture_gl->last_shader_write = write_id;
+        }
+    }
+}
+
 static int build_buffer_descs(struct pipeline *s, const struct pipeline_params *params)
 {
     for (int i = 0; i < params->nb_buffers; i++) {
@@ -579,12 +683,15 @@ void ngli_pipeline_gl_draw(struct pipeline *s, int nb_vertices, int nb_instances
         return;
     }
 
+    require_memory_barriers(s, gl, NULL, NULL);
+
     const GLenum gl_topology = ngli_topology_get_gl_topology(graphics->topology);
     if (nb_instances > 1)
         ngli_glDrawArraysInstanced(gl, gl_topology, 0, nb_vertices, nb_instances);
     else
         ngli_glDrawArrays(gl, gl_topology, 0, nb_vertices);
 
+    track_memory_writes(s);
     unbind_vertex_attribs(s, gl);
 }
 
@@ -618,12 +725,95 @@ void ngli_pipeline_gl_draw_indexed(struct pipeline *s, struct buffer *indices, i
     const GLenum gl_indices_type = get_gl_indices_type(indices_format);
     ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, indices_gl->id);
 
+    require_memory_barriers(s, gl, indices, NULL);
+
     const GLenum gl_topology = ngli_topology_get_gl_topology(graphics->topology);
     if (nb_instances > 1)
         ngli_glDrawElementsInstanced(gl, gl_topology, nb_indices, gl_indices_type, 0, nb_instances);
     else
         ngli_glDrawElements(gl, gl_topology, nb_indices, gl_indices_type, 0);
 
+    track_memory_writes(s);
+    unbind_vertex_attribs(s, gl);
+}
+
+void ngli_pipeline_gl_draw_indirect(struct pipeline *s, struct buffer *indirect, int nb_draws)
+{
+    struct gctx *gctx = s->gctx;
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    struct pipeline_graphics *graphics = &s->graphics;
+    struct program_gl *program_gl = (struct program_gl *)s->program;
+
+    ngli_glstate_update(gctx, &graphics->state);
+    ngli_glstate_use_program(gctx, program_gl->id);
+    set_uniforms(s, gl);
+    set_buffers(s, gl);
+    set_textures(s, gl);
+    bind_vertex_attribs(s, gl);
+
+    if (s->nb_unbound_attributes) {
+        LOG(ERROR, "pipeline has unbound vertex attributes");
+        return;
+    }
+
+    if (!(gl->features & NGLI_FEATURE_MULTI_DRAW_INDIRECT)) {
+        LOG(ERROR, "context does not support multi-draw indirect");
+        return;
+    }
+
+    ngli_assert(indirect);
+    const struct buffer_gl *indirect_gl = (const struct buffer_gl *)indirect;
+    ngli_glBindBuffer(gl, GL_DRAW_INDIRECT_BUFFER, indirect_gl->id);
+
+    require_memory_barriers(s, gl, NULL, indirect);
+
+    const GLenum gl_topology = ngli_topology_get_gl_topology(graphics->topology);
+    ngli_glMultiDrawArraysIndirect(gl, gl_topology, 0, nb_draws, 0);
+
+    track_memory_writes(s);
+    unbind_vertex_attribs(s, gl);
+}
+
+void ngli_pipeline_gl_draw_indexed_indirect(struct pipeline *s, struct buffer *indices, int indices_format,
+                                            struct buffer *indirect, int nb_draws)
+{
+    struct gctx *gctx = s->gctx;
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    struct pipeline_graphics *graphics = &s->graphics;
+    struct program_gl *program_gl = (struct program_gl *)s->program;
+
+    ngli_glstate_update(gctx, &graphics->state);
+    ngli_glstate_use_program(gctx, program_gl->id);
+    set_uniforms(s, gl);
+    set_buffers(s, gl);
+    set_textures(s, gl);
+    bind_vertex_attribs(s, gl);
+
+    if (s->nb_unbound_attributes) {
+        LOG(ERROR, "pipeline has unbound vertex attributes");
+        return;
+    }
+
+    if (!(gl->features & NGLI_FEATURE_MULTI_DRAW_INDIRECT)) {
+        LOG(ERROR, "context does not support multi-draw indirect");
+        return;
+    }
+
+    ngli_assert(indices && indirect);
+    const struct buffer_gl *indices_gl = (const struct buffer_gl *)indices;
+    const struct buffer_gl *indirect_gl = (const struct buffer_gl *)indirect;
+    const GLenum gl_indices_type = get_gl_indices_type(indices_format);
+    ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, indices_gl->id);
+    ngli_glBindBuffer(gl, GL_DRAW_INDIRECT_BUFFER, indirect_gl->id);
+
+    require_memory_barriers(s, gl, indices, indirect);
+
+    const GLenum gl_topology = ngli_topology_get_gl_topology(graphics->topology);
+    ngli_glMultiDrawElementsIndirect(gl, gl_topology, gl_indices_type, 0, nb_draws, 0);
+
+    track_memory_writes(s);
     unbind_vertex_attribs(s, gl);
 }
 
@@ -639,9 +829,9 @@ void ngli_pipeline_gl_dispatch(struct pipeline *s, int nb_group_x, int nb_group_
     set_buffers(s, gl);
     set_textures(s, gl);
 
-    ngli_glMemoryBarrier(gl, GL_ALL_BARRIER_BITS);
+    require_memory_barriers(s, gl, NULL, NULL);
     ngli_glDispatchCompute(gl, nb_group_x, nb_group_y, nb_group_z);
-    ngli_glMemoryBarrier(gl, GL_ALL_BARRIER_BITS);
+    track_memory_writes(s);
 }
 
 void ngli_pipeline_gl_freep(struct pipeline **sp)
@@ -42,6 +42,8 @@ int ngli_pipeline_gl_update_uniform(struct pipeline *s, int index, const void *v
 int ngli_pipeline_gl_update_texture(struct pipeline *s, int index, struct texture *texture);
 void ngli_pipeline_gl_draw(struct pipeline *s, int nb_vertices, int nb_instances);
 void ngli_pipeline_gl_draw_indexed(struct pipeline *s, struct buffer *indices, int indices_format, int nb_indices, int nb_instances);
+void ngli_pipeline_gl_draw_indirect(struct pipeline *s, struct buffer *indirect, int nb_draws);
+void ngli_pipeline_gl_draw_indexed_indirect(struct pipeline *s, struct buffer *indices, int indices_format, struct buffer *indirect, int nb_draws);
 void ngli_pipeline_gl_dispatch(struct pipeline *s, int nb_group_x, int nb_group_y, int nb_group_z);
 void ngli_pipeline_gl_freep(struct pipeline **sp);
 
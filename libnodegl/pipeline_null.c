@@ -0,0 +1,211 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gctx_null.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "pipeline_null.h"
+#include "utils.h"
+
+struct pipeline *ngli_pipeline_null_create(struct gctx *gctx)
+{
+    struct pipeline *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gctx = gctx;
+    return s;
+}
+
+static int copy_descs(struct darray *dst, const void *src, int nb, int size)
+{
+    ngli_darray_init(dst, size, 0);
+    for (int i = 0; i < nb; i++)
+        if (!ngli_darray_push(dst, (const uint8_t *)src + i * size))
+            return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+int ngli_pipeline_null_init(struct pipeline *s, const struct pipeline_params *params)
+{
+    s->type     = params->type;
+    s->graphics = params->graphics;
+    s->program  = params->program;
+
+    int ret;
+    if ((ret = copy_descs(&s->uniform_descs,   params->uniforms,   params->nb_uniforms,   sizeof(*params->uniforms))) < 0 ||
+        (ret = copy_descs(&s->texture_descs,   params->textures,   params->nb_textures,   sizeof(*params->textures))) < 0 ||
+        (ret = copy_descs(&s->buffer_descs,    params->buffers,    params->nb_buffers,    sizeof(*params->buffers))) < 0 ||
+        (ret = copy_descs(&s->attribute_descs, params->attributes, params->nb_attributes, sizeof(*params->attributes))) < 0)
+        return ret;
+
+    for (int i = 0; i < params->nb_attributes; i++)
+        if (!params->attributes[i].buffer)
+            s->nb_unbound_attributes++;
+
+    return 0;
+}
+
+int ngli_pipeline_null_update_attribute(struct pipeline *s, int index, struct buffer *buffer)
+{
+    if (index == -1)
+        return NGL_ERROR_NOT_FOUND;
+
+    ngli_assert(s->type == NGLI_PIPELINE_TYPE_GRAPHICS);
+    ngli_assert(index >= 0 && index < ngli_darray_count(&s->attribute_descs));
+
+    struct pipeline_attribute *attributes = ngli_darray_data(&s->attribute_descs);
+    struct pipeline_attribute *attribute = &attributes[index];
+
+    if (!attribute->buffer && buffer)
+        s->nb_unbound_attributes--;
+    else if (attribute->buffer && !buffer)
+        s->nb_unbound_attributes++;
+
+    attribute->buffer = buffer;
+
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_PIPELINE_UPDATE_ATTRIBUTE,
+        .object = s,
+        .args   = {index},
+    });
+    return 0;
+}
+
+int ngli_pipeline_null_update_uniform(struct pipeline *s, int index, const void *value)
+{
+    if (index == -1)
+        return NGL_ERROR_NOT_FOUND;
+
+    ngli_assert(index >= 0 && index < ngli_darray_count(&s->uniform_descs));
+    struct pipeline_uniform *uniforms = ngli_darray_data(&s->uniform_descs);
+    uniforms[index].data = NULL;
+
+    if (value)
+        ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+            .type   = NGLI_CMD_NULL_PIPELINE_UPDATE_UNIFORM,
+            .object = s,
+            .args   = {index},
+        });
+    return 0;
+}
+
+int ngli_pipeline_null_update_texture(struct pipeline *s, int index, struct texture *texture)
+{
+    if (index == -1)
+        return NGL_ERROR_NOT_FOUND;
+
+    ngli_assert(index >= 0 && index < ngli_darray_count(&s->texture_descs));
+    struct pipeline_texture *textures = ngli_darray_data(&s->texture_descs);
+    textures[index].texture = texture;
+
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_PIPELINE_UPDATE_TEXTURE,
+        .object = s,
+        .args   = {index},
+    });
+    return 0;
+}
+
+static int check_attributes(const struct pipeline *s)
+{
+    if (s->nb_unbound_attributes) {
+        LOG(ERROR, "pipeline has unbound vertex attributes");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    return 0;
+}
+
+void ngli_pipeline_null_draw(struct pipeline *s, int nb_vertices, int nb_instances)
+{
+    if (check_attributes(s) < 0)
+        return;
+
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_DRAW,
+        .object = s,
+        .args   = {nb_vertices, nb_instances},
+    });
+}
+
+void ngli_pipeline_null_draw_indexed(struct pipeline *s, struct buffer *indices, int indices_format, int nb_indices, int nb_instances)
+{
+    if (check_attributes(s) < 0)
+        return;
+
+    ngli_assert(indices);
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_DRAW_INDEXED,
+        .object = s,
+        .args   = {nb_indices, nb_instances, indices_format},
+    });
+}
+
+void ngli_pipeline_null_draw_indirect(struct pipeline *s, struct buffer *indirect, int nb_draws)
+{
+    if (check_attributes(s) < 0)
+        return;
+
+    ngli_assert(indirect);
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_DRAW_INDIRECT,
+        .object = s,
+        .args   = {nb_draws},
+    });
+}
+
+void ngli_pipeline_null_draw_indexed_indirect(struct pipeline *s, struct buffer *indices, int indices_format,
+                                              struct buffer *indirect, int nb_draws)
+{
+    if (check_attributes(s) < 0)
+        return;
+
+    ngli_assert(indices && indirect);
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_DRAW_INDEXED_INDIRECT,
+        .object = s,
+        .args   = {nb_draws, indices_format},
+    });
+}
+
+void ngli_pipeline_null_dispatch(struct pipeline *s, int nb_group_x, int nb_group_y, int nb_group_z)
+{
+    ngli_assert(s->type == NGLI_PIPELINE_TYPE_COMPUTE);
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_DISPATCH,
+        .object = s,
+        .args   = {nb_group_x, nb_group_y, nb_group_z},
+    });
+}
+
+void ngli_pipeline_null_freep(struct pipeline **sp)
+{
+    struct pipeline *s = *sp;
+    if (!s)
+        return;
+
+    ngli_darray_reset(&s->uniform_descs);
+    ngli_darray_reset(&s->texture_descs);
+    ngli_darray_reset(&s->buffer_descs);
+    ngli_darray_reset(&s->attribute_descs);
+
+    ngli_freep(sp);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "log.h"
+#include "nodegl.h"
+#include "profiler.h"
+#include "utils.h"
+
+/*
+ * Events are kept until they are exported; past this limit, the oldest
+ * frames are dropped to prevent the memory from growing unbounded.
+ */
+#define MAX_EVENTS (1 << 18)
+
+struct profiler_event {
+    int64_t frame_index;
+    int phase;
+    int64_t start;      /* CPU time (ns) */
+    int64_t duration;   /* CPU or GPU time (ns) */
+    const char *name;
+    char label[64];
+};
+
+static const char * const phase_names[NGLI_PROFILER_PHASE_NB] = {
+    [NGLI_PROFILER_PHASE_VISIT]    = "visit",
+    [NGLI_PROFILER_PHASE_PREFETCH] = "prefetch",
+    [NGLI_PROFILER_PHASE_RELEASE]  = "release",
+    [NGLI_PROFILER_PHASE_UPDATE]   = "update",
+    [NGLI_PROFILER_PHASE_DRAW]     = "draw",
+    [NGLI_PROFILER_PHASE_CAPTURE]  = "capture",
+    [NGLI_PROFILER_PHASE_GPU]      = "gpu",
+};
+
+void ngli_profiler_init(struct profiler *s, int enabled)
+{
+    memset(s, 0, sizeof(*s));
+    s->enabled = enabled;
+    ngli_darray_init(&s->events, sizeof(struct profiler_event), 0);
+}
+
+void ngli_profiler_frame_start(struct profiler *s)
+{
+    if (!s->enabled)
+        return;
+
+    const int nb_events = ngli_darray_count(&s->events);
+    if (nb_events >= MAX_EVENTS) {
+        /* Drop the oldest frames until half of the events are left */
+        const struct profiler_event *events = ngli_darray_data(&s->events);
+        int nb_dropped = nb_events / 2;
+        while (nb_dropped < nb_events && events[nb_dropped].frame_index == events[nb_dropped - 1].frame_index)
+            nb_dropped++;
+        LOG(WARNING, "profiling events have not been exported, dropping the oldest %d events", nb_dropped);
+        memmove(s->events.data, s->events.data + nb_dropped * s->events.element_size,
+                (nb_events - nb_dropped) * s->events.element_size);
+        s->events.count = nb_events - nb_dropped;
+    }
+
+    s->frame_index++;
+    memset(s->depth, 0, sizeof(s->depth));
+    memset(s->totals, 0, sizeof(s->totals));
+}
+
+int64_t ngli_profiler_begin(struct profiler *s, int phase)
+{
+    s->depth[phase]++;
+    return ngli_gettime_relative_ns();
+}
+
+void ngli_profiler_add(struct profiler *s, int phase, int64_t frame_index,
+                       int64_t start, int64_t duration,
+                       const char *label, const char *name)
+{
+    /* Nested events are already accounted in the duration of their parent */
+    if (!s->depth[phase])
+        s->totals[phase] += duration;
+
+    struct profiler_event *event = ngli_darray_push(&s->events, NULL);
+    if (!event)
+        return;
+    event->frame_index = frame_index;
+    event->phase = phase;
+    event->start = start;
+    event->duration = duration;
+    event->name = name;
+    snprintf(event->label, sizeof(event->label), "%s", label ? label : "");
+}
+
+void ngli_profiler_end(struct profiler *s, int phase, int64_t start,
+                       const char *label, const char *name)
+{
+    const int64_t duration = ngli_gettime_relative_ns() - start;
+    s->depth[phase]--;
+    ngli_profiler_add(s, phase, s->frame_index, start, duration, label, name);
+}
+
+static void print_json_str(struct bstr *b, const char *str)
+{
+    ngli_bstr_print(b, "\"");
+    for (int i = 0; str[i]; i++) {
+        const char c = str[i];
+        if (c == '"' || c == '\\')
+            ngli_bstr_printf(b, "\\%c", c);
+        else if ((unsigned char)c < 0x20)
+            ngli_bstr_printf(b, "\\u%04x", c);
+        else
+            ngli_bstr_printf(b, "%c", c);
+    }
+    ngli_bstr_print(b, "\"");
+}
+
+static void export_chrome_trace(struct bstr *b, const struct profiler_event *events, int nb_events)
+{
+    ngli_bstr_print(b, "{\"traceEvents\":[\n");
+    ngli_bstr_print(b, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n");
+    ngli_bstr_print(b, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"GPU\"}}");
+    for (int i = 0; i < nb_events; i++) {
+        const struct profiler_event *event = &events[i];
+        const int gpu = event->phase == NGLI_PROFILER_PHASE_GPU;
+
+        /* GPU events are placed on their own track at the CPU time of their submission */
+        ngli_bstr_print(b, ",\n{\"name\":");
+        print_json_str(b, event->label);
+        ngli_bstr_printf(b, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+                         "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"class\":",
+                         phase_names[event->phase], gpu, event->start / 1000., event->duration / 1000.);
+        print_json_str(b, event->name);
+        ngli_bstr_printf(b, ",\"frame\":%" PRId64 "}}", event->frame_index);
+    }
+    ngli_bstr_print(b, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+static void export_csv(struct bstr *b, const struct profiler_event *events, int nb_events)
+{
+    ngli_bstr_print(b, "frame,label,class,phase,start_ns,duration_ns\n");
+    for (int i = 0; i < nb_events; i++) {
+        const struct profiler_event *event = &events[i];
+        ngli_bstr_printf(b, "%" PRId64 ",", event->frame_index);
+        ngli_bstr_print_csv(b, event->label);
+        ngli_bstr_printf(b, ",%s,%s,%" PRId64 ",%" PRId64 "\n",
+                         event->name, phase_names[event->phase], event->start, event->duration);
+    }
+}
+
+char *ngli_profiler_export(struct profiler *s, int format)
+{
+    if (!s->enabled) {
+        LOG(ERROR, "profiling is not enabled");
+        return NULL;
+    }
+
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    const struct profiler_event *events = ngli_darray_data(&s->events);
+    const int nb_events = ngli_darray_count(&s->events);
+
+    switch (format) {
+    case NGL_PROFILE_FORMAT_CSV:          export_csv(b, events, nb_events);          break;
+    case NGL_PROFILE_FORMAT_CHROME_TRACE: export_chrome_trace(b, events, nb_events); break;
+    default:
+        LOG(ERROR, "unsupported profile format %d", format);
+        ngli_bstr_freep(&b);
+        return NULL;
+    }
+
+    char *str = ngli_bstr_check(b) < 0 ? NULL : ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    if (str)
+        s->events.count = 0;
+    return str;
+}
+
+void ngli_profiler_reset(struct profiler *s)
+{
+    ngli_darray_reset(&s->events);
+    memset(s, 0, sizeof(*s));
+}
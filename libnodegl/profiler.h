@@ -0,0 +1,59 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+#include "darray.h"
+
+enum {
+    NGLI_PROFILER_PHASE_VISIT,
+    NGLI_PROFILER_PHASE_PREFETCH,
+    NGLI_PROFILER_PHASE_RELEASE,
+    NGLI_PROFILER_PHASE_UPDATE,
+    NGLI_PROFILER_PHASE_DRAW,
+    NGLI_PROFILER_PHASE_CAPTURE,
+    NGLI_PROFILER_PHASE_GPU,
+    NGLI_PROFILER_PHASE_NB
+};
+
+struct profiler {
+    int enabled;
+    int64_t frame_index;
+    struct darray events; // profiler_event
+    int depth[NGLI_PROFILER_PHASE_NB];
+    int64_t totals[NGLI_PROFILER_PHASE_NB]; // ns
+};
+
+void ngli_profiler_init(struct profiler *s, int enabled);
+void ngli_profiler_frame_start(struct profiler *s);
+int64_t ngli_profiler_begin(struct profiler *s, int phase);
+void ngli_profiler_end(struct profiler *s, int phase, int64_t start,
+                       const char *label, const char *name);
+void ngli_profiler_add(struct profiler *s, int phase, int64_t frame_index,
+                       int64_t start, int64_t duration,
+                       const char *label, const char *name);
+char *ngli_profiler_export(struct profiler *s, int format);
+void ngli_profiler_reset(struct profiler *s);
+
+#endif
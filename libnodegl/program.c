@@ -36,5 +36,6 @@ void ngli_program_freep(struct program **sp)
 {
     if (!*sp)
         return;
+    ngli_cmdbuffer_sync(&(*sp)->gctx->cmdbuffer);
     (*sp)->gctx->class->program_freep(sp);
 }
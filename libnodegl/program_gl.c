@@ -19,6 +19,8 @@
  * under the License.
  */
 
+#include <inttypes.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -252,7 +254,7 @@ struct program *ngli_program_gl_create(struct gctx *gctx)
     return (struct program *)s;
 }
 
-int ngli_program_gl_init(struct program *s, const char *vertex, const char *fragment, const char *compute)
+static int program_build(struct program *s, const char *vertex, const char *fragment, const char *compute)
 {
     struct program_gl *s_priv = (struct program_gl *)s;
 
@@ -270,11 +272,6 @@ int ngli_program_gl_init(struct program *s, const char *vertex, const char *frag
     struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
     struct glcontext *gl = gctx_gl->glcontext;
 
-    if (compute && (gl->features & NGLI_FEATURE_COMPUTE_SHADER_ALL) != NGLI_FEATURE_COMPUTE_SHADER_ALL) {
-        LOG(ERROR, "context does not support compute shaders");
-        return NGL_ERROR_UNSUPPORTED;
-    }
-
     s_priv->id = ngli_glCreateProgram(gl);
 
     for (int i = 0; i < NGLI_ARRAY_NB(shaders); i++) {
@@ -286,33 +283,90 @@ int ngli_program_gl_init(struct program *s, const char *vertex, const char *frag
         ngli_glCompileShader(gl, shader);
         ret = program_check_status(gl, shader, GL_COMPILE_STATUS);
         if (ret < 0)
-            goto fail;
+            goto end;
         ngli_glAttachShader(gl, s_priv->id, shader);
     }
 
     ngli_glLinkProgram(gl, s_priv->id);
     ret = program_check_status(gl, s_priv->id, GL_LINK_STATUS);
-    if (ret < 0)
-        goto fail;
 
+end:
     for (int i = 0; i < NGLI_ARRAY_NB(shaders); i++)
         ngli_glDeleteShader(gl, shaders[i].id);
 
-    s->uniforms = program_probe_uniforms(gl, s_priv->id);
-    s->attributes = program_probe_attributes(gl, s_priv->id);
-    s->buffer_blocks = program_probe_buffer_blocks(gl, s_priv->id);
-    if (!s->uniforms || !s->attributes || !s->buffer_blocks) {
-        ret = NGL_ERROR_MEMORY;
-        goto fail;
+    return ret;
+}
+
+static int program_build_shared(struct program *s, const char *vertex, const char *fragment, const char *compute)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    struct sharegroup *sharegroup = s->gctx->sharegroup;
+
+    /* The terminating nul bytes tell the stages apart */
+    const struct sharegroup_chunk chunks[] = {
+        {vertex,   vertex   ? strlen(vertex)   + 1 : 0},
+        {fragment, fragment ? strlen(fragment) + 1 : 0},
+        {compute,  compute  ? strlen(compute)  + 1 : 0},
+    };
+    char key[NGLI_SHAREGROUP_KEY_LEN];
+
+    ngli_sharegroup_lock(sharegroup);
+    const int shared = ngli_sharegroup_is_shared(sharegroup);
+    if (shared) {
+        snprintf(key, sizeof(key), "program:%016" PRIx64,
+                 ngli_sharegroup_hash(chunks, NGLI_ARRAY_NB(chunks)));
+
+        uintptr_t handle;
+        if (ngli_sharegroup_acquire(sharegroup, key, chunks, NGLI_ARRAY_NB(chunks), &handle)) {
+            ngli_sharegroup_unlock(sharegroup);
+            s_priv->id = (GLuint)handle;
+            snprintf(s_priv->share_key, sizeof(s_priv->share_key), "%s", key);
+            return 0;
+        }
     }
+    ngli_sharegroup_unlock(sharegroup);
+
+    int ret = program_build(s, vertex, fragment, compute);
+    if (ret < 0 || !shared)
+        return ret;
 
+    /* The link must be complete before the program is used by another context */
+    ngli_glFinish(gl);
+
+    ngli_sharegroup_lock(sharegroup);
+    ret = ngli_sharegroup_publish(sharegroup, key, chunks, NGLI_ARRAY_NB(chunks), s_priv->id);
+    ngli_sharegroup_unlock(sharegroup);
+    if (ret < 0)
+        return ret;
+    if (ret)
+        snprintf(s_priv->share_key, sizeof(s_priv->share_key), "%s", key);
     return 0;
+}
 
-fail:
-    for (int i = 0; i < NGLI_ARRAY_NB(shaders); i++)
-        ngli_glDeleteShader(gl, shaders[i].id);
+int ngli_program_gl_init(struct program *s, const char *vertex, const char *fragment, const char *compute)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
 
-    return ret;
+    if (compute && (gl->features & NGLI_FEATURE_COMPUTE_SHADER_ALL) != NGLI_FEATURE_COMPUTE_SHADER_ALL) {
+        LOG(ERROR, "context does not support compute shaders");
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    int ret = program_build_shared(s, vertex, fragment, compute);
+    if (ret < 0)
+        return ret;
+
+    s->uniforms = program_probe_uniforms(gl, s_priv->id);
+    s->attributes = program_probe_attributes(gl, s_priv->id);
+    s->buffer_blocks = program_probe_buffer_blocks(gl, s_priv->id);
+    if (!s->uniforms || !s->attributes || !s->buffer_blocks)
+        return NGL_ERROR_MEMORY;
+
+    return 0;
 }
 
 void ngli_program_gl_freep(struct program **sp)
@@ -326,6 +380,14 @@ void ngli_program_gl_freep(struct program **sp)
     ngli_hmap_freep(&s->buffer_blocks);
     struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
     struct glcontext *gl = gctx_gl->glcontext;
-    ngli_glDeleteProgram(gl, s_priv->id);
+    int last_user = 1;
+    if (s_priv->share_key[0]) {
+        struct sharegroup *sharegroup = s->gctx->sharegroup;
+        ngli_sharegroup_lock(sharegroup);
+        last_user = ngli_sharegroup_release(sharegroup, s_priv->share_key);
+        ngli_sharegroup_unlock(sharegroup);
+    }
+    if (last_user)
+        ngli_glDeleteProgram(gl, s_priv->id);
     ngli_freep(sp);
 }
@@ -24,12 +24,14 @@
 
 #include "glincludes.h"
 #include "program.h"
+#include "sharegroup.h"
 
 struct gctx;
 
 struct program_gl {
     struct program parent;
     GLuint id;
+    char share_key[NGLI_SHAREGROUP_KEY_LEN]; /* set if the program is shared */
 };
 
 struct program *ngli_program_gl_create(struct gctx *gctx);
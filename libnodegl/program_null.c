@@ -0,0 +1,206 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <ctype.h>
+#include <string.h>
+
+#include "hmap.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "program_null.h"
+#include "utils.h"
+
+struct program *ngli_program_null_create(struct gctx *gctx)
+{
+    struct program *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gctx = gctx;
+    return s;
+}
+
+static int is_identifier_char(char c)
+{
+    return isalnum(c) || c == '_';
+}
+
+static const char *next_identifier(const char *p, const char **end)
+{
+    while (*p && !(is_identifier_char(*p) && !isdigit(*p)))
+        p++;
+    if (!*p)
+        return NULL;
+    *end = p;
+    while (is_identifier_char(**end))
+        (*end)++;
+    return p;
+}
+
+static int is_identifier(const char *p, const char *end, const char *name)
+{
+    const size_t len = end - p;
+    return len == strlen(name) && !memcmp(p, name, len);
+}
+
+static int count_identifier(const char *src, const char *name)
+{
+    int count = 0;
+    const char *p = src, *end;
+    while (src && (p = next_identifier(p, &end))) {
+        count += is_identifier(p, end, name);
+        p = end;
+    }
+    return count;
+}
+
+static void free_data(void *user_arg, void *data)
+{
+    ngli_free(data);
+}
+
+static int is_precision_qualifier(const char *p, const char *end)
+{
+    return is_identifier(p, end, "lowp") ||
+           is_identifier(p, end, "mediump") ||
+           is_identifier(p, end, "highp");
+}
+
+static const char *skip_spaces(const char *p)
+{
+    return p + strspn(p, " \t\r\n");
+}
+
+/*
+ * Count the declarations of each standalone uniform of a shader stage (the
+ * uniform blocks are skipped)
+ */
+static int register_uniforms(struct hmap *decls, const char *src)
+{
+    const char *p = src, *end;
+    while (src && (p = next_identifier(p, &end))) {
+        if (!is_identifier(p, end, "uniform")) {
+            p = end;
+            continue;
+        }
+
+        const char *type, *type_end = end;
+        do {
+            type = next_identifier(type_end, &type_end);
+        } while (type && is_precision_qualifier(type, type_end));
+        if (!type)
+            return 0;
+        p = type_end;
+        if (*skip_spaces(type_end) == '{')
+            continue;
+
+        const char *name_end;
+        const char *name = next_identifier(type_end, &name_end);
+        if (!name)
+            return 0;
+        p = name_end;
+        if (name_end - name >= MAX_ID_LEN)
+            continue;
+
+        char id[MAX_ID_LEN];
+        memcpy(id, name, name_end - name);
+        id[name_end - name] = 0;
+
+        int *nb_decls = ngli_hmap_get(decls, id);
+        if (nb_decls) {
+            (*nb_decls)++;
+            continue;
+        }
+
+        nb_decls = ngli_calloc(1, sizeof(*nb_decls));
+        if (!nb_decls)
+            return NGL_ERROR_MEMORY;
+        *nb_decls = 1;
+        int ret = ngli_hmap_set(decls, id, nb_decls);
+        if (ret < 0) {
+            ngli_free(nb_decls);
+            return ret;
+        }
+    }
+    return 0;
+}
+
+static int probe_uniforms(struct program *s, const struct hmap *decls, const char **sources, int nb_sources)
+{
+    s->uniforms = ngli_hmap_create();
+    if (!s->uniforms)
+        return NGL_ERROR_MEMORY;
+    ngli_hmap_set_free(s->uniforms, free_data, NULL);
+
+    const struct hmap_entry *entry = NULL;
+    while ((entry = ngli_hmap_next(decls, entry))) {
+        const int *nb_decls = entry->data;
+        int nb_refs = 0;
+        for (int i = 0; i < nb_sources; i++)
+            nb_refs += count_identifier(sources[i], entry->key);
+        if (nb_refs <= *nb_decls)
+            continue;
+
+        struct program_variable_info *info = ngli_calloc(1, sizeof(*info));
+        if (!info)
+            return NGL_ERROR_MEMORY;
+        info->binding = -1;
+        info->location = ngli_hmap_count(s->uniforms);
+        int ret = ngli_hmap_set(s->uniforms, entry->key, info);
+        if (ret < 0) {
+            ngli_free(info);
+            return ret;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Nothing is compiled, but the shaders are scanned to mimic the reflection of
+ * the actual backends: a uniform is only reported as active if it is
+ * referenced beyond its declarations, so the crafter filters out the unused
+ * ones the same way. The attributes and buffer blocks are all kept.
+ */
+int ngli_program_null_init(struct program *s, const char *vertex, const char *fragment, const char *compute)
+{
+    struct hmap *decls = ngli_hmap_create();
+    if (!decls)
+        return NGL_ERROR_MEMORY;
+    ngli_hmap_set_free(decls, free_data, NULL);
+
+    const char *sources[] = {vertex, fragment, compute};
+    int ret = 0;
+    for (int i = 0; i < NGLI_ARRAY_NB(sources) && ret >= 0; i++)
+        ret = register_uniforms(decls, sources[i]);
+    if (ret >= 0)
+        ret = probe_uniforms(s, decls, sources, NGLI_ARRAY_NB(sources));
+
+    ngli_hmap_freep(&decls);
+    return ret;
+}
+
+void ngli_program_null_freep(struct program **sp)
+{
+    struct program *s = *sp;
+    if (!s)
+        return;
+    ngli_hmap_freep(&s->uniforms);
+    ngli_freep(sp);
+}
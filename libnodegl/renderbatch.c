@@ -0,0 +1,813 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "format.h"
+#include "gctx.h"
+#include "log.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "renderbatch.h"
+#include "type.h"
+#include "utils.h"
+
+/*
+ * Minimum number of vertex attribute locations guaranteed by OpenGL 3.x and
+ * OpenGLES 3.0
+ */
+#define MAX_VERTEX_ATTRIBUTES 16
+
+#define MODELVIEW_MATRIX_NAME "ngl_modelview_matrix"
+#define FORWARD_PREFIX        "ngl_batch_"
+
+enum {
+    GEOMETRY_BUFFER_VERTICES,
+    GEOMETRY_BUFFER_UVCOORDS,
+    GEOMETRY_BUFFER_NORMALS,
+    GEOMETRY_BUFFER_INDICES,
+    NB_GEOMETRY_BUFFERS
+};
+
+static const char * const geometry_attribute_names[] = {
+    [GEOMETRY_BUFFER_VERTICES] = "ngl_position",
+    [GEOMETRY_BUFFER_UVCOORDS] = "ngl_uvcoord",
+    [GEOMETRY_BUFFER_NORMALS]  = "ngl_normal",
+};
+
+struct renderbatch_member {
+    struct ngl_node *render;
+    int transform_start;
+    int nb_transforms;
+};
+
+struct renderbatch_field {
+    char name[MAX_ID_LEN];
+    int type;
+    int stage;
+    int offset;
+    int size;
+};
+
+static int is_transform(const struct ngl_node *node)
+{
+    switch (node->class->id) {
+    case NGL_NODE_ROTATE:
+    case NGL_NODE_ROTATEQUAT:
+    case NGL_NODE_SCALE:
+    case NGL_NODE_TRANSFORM:
+    case NGL_NODE_TRANSLATE:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static const struct ngl_node *get_render(const struct ngl_node *node)
+{
+    while (is_transform(node)) {
+        const struct transform_priv *trf = node->priv_data;
+        node = trf->child;
+    }
+    return node->class->id == NGL_NODE_RENDER ? node : NULL;
+}
+
+static int get_instance_format(int type)
+{
+    switch (type) {
+    case NGLI_TYPE_FLOAT: return NGLI_FORMAT_R32_SFLOAT;
+    case NGLI_TYPE_VEC2:  return NGLI_FORMAT_R32G32_SFLOAT;
+    case NGLI_TYPE_VEC3:  return NGLI_FORMAT_R32G32B32_SFLOAT;
+    case NGLI_TYPE_VEC4:
+    case NGLI_TYPE_MAT4:  return NGLI_FORMAT_R32G32B32A32_SFLOAT;
+    default:              return NGLI_FORMAT_UNDEFINED;
+    }
+}
+
+static int is_instanceable(const struct ngl_node *node)
+{
+    if (node->class->category != NGLI_NODE_CATEGORY_UNIFORM)
+        return 0;
+    const struct variable_priv *variable = node->priv_data;
+    return get_instance_format(variable->data_type) != NGLI_FORMAT_UNDEFINED;
+}
+
+static int get_data_type(const struct ngl_node *node)
+{
+    const struct variable_priv *variable = node->priv_data;
+    return variable->data_type;
+}
+
+static int count_entries(const struct hmap *hm)
+{
+    return hm ? ngli_hmap_count(hm) : 0;
+}
+
+/*
+ * A Render can be a batch member if it draws a single instance. Its vertex
+ * stage must also not depend on anything that would differ between a regular
+ * and an instanced draw, which is only known once the batch program is
+ * crafted (see ngli_renderbatch_prepare()).
+ */
+static int is_batchable(const struct ngl_node *render)
+{
+    const struct render_priv *s = render->priv_data;
+    return s->nb_instances == 1 && !count_entries(s->instance_attributes);
+}
+
+static int has_same_nodes(const struct hmap *a, const struct hmap *b)
+{
+    if (count_entries(a) != count_entries(b))
+        return 0;
+    if (!a)
+        return 1;
+    const struct hmap_entry *e = NULL;
+    while ((e = ngli_hmap_next(a, e)))
+        if (ngli_hmap_get(b, e->key) != e->data)
+            return 0;
+    return 1;
+}
+
+static int has_compatible_resources(const struct render_priv *a, const struct render_priv *b, int stage)
+{
+    const struct hmap *res_a = stage == NGLI_PROGRAM_SHADER_VERT ? a->vert_resources : a->frag_resources;
+    const struct hmap *res_b = stage == NGLI_PROGRAM_SHADER_VERT ? b->vert_resources : b->frag_resources;
+    if (count_entries(res_a) != count_entries(res_b))
+        return 0;
+    if (!res_a)
+        return 1;
+
+    const struct program_priv *program = a->program->priv_data;
+    const struct hmap_entry *e = NULL;
+    while ((e = ngli_hmap_next(res_a, e))) {
+        const struct ngl_node *node_a = e->data;
+        const struct ngl_node *node_b = ngli_hmap_get(res_b, e->key);
+        if (node_a == node_b)
+            continue;
+        if (!node_b || !is_instanceable(node_a) || !is_instanceable(node_b) ||
+            get_data_type(node_a) != get_data_type(node_b))
+            return 0;
+
+        /*
+         * Per-instance fragment uniforms are forwarded from the vertex stage
+         * through a communication variable of the same name
+         */
+        if (stage == NGLI_PROGRAM_SHADER_FRAG &&
+            ((a->vert_resources && ngli_hmap_get(a->vert_resources, e->key)) ||
+             (program->vert_out_vars && ngli_hmap_get(program->vert_out_vars, e->key))))
+            return 0;
+    }
+    return 1;
+}
+
+static struct ngl_node *get_geometry_buffer(const struct ngl_node *render, int index)
+{
+    const struct render_priv *s = render->priv_data;
+    const struct geometry_priv *geometry = s->geometry->priv_data;
+    switch (index) {
+    case GEOMETRY_BUFFER_VERTICES: return geometry->vertices_buffer;
+    case GEOMETRY_BUFFER_UVCOORDS: return geometry->uvcoords_buffer;
+    case GEOMETRY_BUFFER_NORMALS:  return geometry->normals_buffer;
+    case GEOMETRY_BUFFER_INDICES:  return geometry->indices_buffer;
+    default:
+        ngli_assert(0);
+    }
+}
+
+static int is_static_buffer(const struct ngl_node *node)
+{
+    if (!node)
+        return 1;
+    const struct buffer_priv *buffer = node->priv_data;
+    return !buffer->dynamic && !buffer->block && buffer->data;
+}
+
+static int has_same_layout(const struct ngl_node *a, const struct ngl_node *b)
+{
+    if (!a || !b)
+        return a == b;
+    const struct buffer_priv *buffer_a = a->priv_data;
+    const struct buffer_priv *buffer_b = b->priv_data;
+    return buffer_a->data_format == buffer_b->data_format &&
+           buffer_a->data_stride == buffer_b->data_stride;
+}
+
+/*
+ * Renders using different geometries can be merged in a multi-draw if these
+ * geometries are static and share the same topology and buffer layouts. The
+ * user vertex attributes are not supported since they would have to be merged
+ * as well.
+ */
+static int can_multi_draw(const struct ngl_node *render_a, const struct ngl_node *render_b)
+{
+    const struct gctx *gctx = render_a->ctx->gctx;
+    if (!(gctx->features & NGLI_FEATURE_MULTI_DRAW_INDIRECT))
+        return 0;
+
+    const struct render_priv *s_a = render_a->priv_data;
+    const struct render_priv *s_b = render_b->priv_data;
+    const struct geometry_priv *geometry_a = s_a->geometry->priv_data;
+    const struct geometry_priv *geometry_b = s_b->geometry->priv_data;
+    if (count_entries(s_a->attributes) || count_entries(s_b->attributes) ||
+        geometry_a->topology != geometry_b->topology)
+        return 0;
+
+    for (int i = 0; i < NB_GEOMETRY_BUFFERS; i++) {
+        const struct ngl_node *buffer_a = get_geometry_buffer(render_a, i);
+        const struct ngl_node *buffer_b = get_geometry_buffer(render_b, i);
+        if (!is_static_buffer(buffer_a) || !is_static_buffer(buffer_b) ||
+            !has_same_layout(buffer_a, buffer_b))
+            return 0;
+    }
+    return 1;
+}
+
+int ngli_renderbatch_is_compatible(const struct ngl_node *a, const struct ngl_node *b)
+{
+    const struct ngl_node *render_a = get_render(a);
+    const struct ngl_node *render_b = get_render(b);
+    if (!render_a || !render_b || !is_batchable(render_a) || !is_batchable(render_b))
+        return 0;
+
+    const struct render_priv *s_a = render_a->priv_data;
+    const struct render_priv *s_b = render_b->priv_data;
+    return s_a->program == s_b->program &&
+           (s_a->geometry == s_b->geometry || can_multi_draw(render_a, render_b)) &&
+           has_same_nodes(s_a->attributes, s_b->attributes) &&
+           has_compatible_resources(s_a, s_b, NGLI_PROGRAM_SHADER_VERT) &&
+           has_compatible_resources(s_a, s_b, NGLI_PROGRAM_SHADER_FRAG);
+}
+
+static int add_member(struct renderbatch *s, struct ngl_node *node)
+{
+    struct renderbatch_member member = {.transform_start = ngli_darray_count(&s->transforms)};
+    while (is_transform(node)) {
+        const struct transform_priv *trf = node->priv_data;
+        const float *matrix = trf->matrix;
+        if (!ngli_darray_push(&s->transforms, &matrix))
+            return NGL_ERROR_MEMORY;
+        node = trf->child;
+    }
+    member.render = node;
+    member.nb_transforms = ngli_darray_count(&s->transforms) - member.transform_start;
+    if (!ngli_darray_push(&s->members, &member))
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+static int add_field(struct renderbatch *s, const char *name, int type, int stage, int size)
+{
+    struct renderbatch_field field = {
+        .type   = type,
+        .stage  = stage,
+        .offset = s->stride,
+        .size   = size,
+    };
+    snprintf(field.name, sizeof(field.name), "%s", name);
+    if (!ngli_darray_push(&s->fields, &field))
+        return NGL_ERROR_MEMORY;
+    s->stride += size;
+    return 0;
+}
+
+/*
+ * Split the resources of the first member between the ones shared by all the
+ * members and the uniforms which need to be specified per instance.
+ */
+static int register_resources(struct renderbatch *s, int stage)
+{
+    const struct renderbatch_member *members = ngli_darray_data(&s->members);
+    const struct render_priv *render = members[0].render->priv_data;
+    const struct hmap *resources = stage == NGLI_PROGRAM_SHADER_VERT ? render->vert_resources : render->frag_resources;
+    struct hmap *shared = stage == NGLI_PROGRAM_SHADER_VERT ? s->vert_resources : s->frag_resources;
+    if (!resources)
+        return 0;
+
+    const struct hmap_entry *e = NULL;
+    while ((e = ngli_hmap_next(resources, e))) {
+        int per_instance = 0;
+        for (int i = 1; i < ngli_darray_count(&s->members) && !per_instance; i++) {
+            const struct render_priv *member = members[i].render->priv_data;
+            const struct hmap *member_resources = stage == NGLI_PROGRAM_SHADER_VERT ? member->vert_resources
+                                                                                     : member->frag_resources;
+            per_instance = ngli_hmap_get(member_resources, e->key) != e->data;
+        }
+
+        if (!per_instance) {
+            int ret = ngli_hmap_set(shared, e->key, e->data);
+            if (ret < 0)
+                return ret;
+            continue;
+        }
+
+        const struct variable_priv *variable = ((const struct ngl_node *)e->data)->priv_data;
+        int ret = add_field(s, e->key, variable->data_type, stage, variable->data_size);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+static int register_sources(struct renderbatch *s)
+{
+    const struct renderbatch_member *members = ngli_darray_data(&s->members);
+    const struct renderbatch_field *fields = ngli_darray_data(&s->fields);
+    for (int i = 0; i < ngli_darray_count(&s->members); i++) {
+        const struct render_priv *render = members[i].render->priv_data;
+        for (int j = 0; j < ngli_darray_count(&s->fields); j++) {
+            const struct renderbatch_field *field = &fields[j];
+            const void *data = NULL;
+            if (field->stage != -1) {
+                const struct hmap *resources = field->stage == NGLI_PROGRAM_SHADER_VERT ? render->vert_resources
+                                                                                         : render->frag_resources;
+                const struct ngl_node *node = ngli_hmap_get(resources, field->name);
+                const struct variable_priv *variable = node->priv_data;
+                data = variable->data;
+            }
+            if (!ngli_darray_push(&s->sources, &data))
+                return NGL_ERROR_MEMORY;
+        }
+    }
+    return 0;
+}
+
+static int craft_vert_base(struct renderbatch *s, const char *vertex)
+{
+    s->vert_base = ngli_bstr_create();
+    if (!s->vert_base)
+        return NGL_ERROR_MEMORY;
+
+    const struct renderbatch_field *fields = ngli_darray_data(&s->fields);
+    int nb_forwarded = 0;
+    for (int i = 0; i < ngli_darray_count(&s->fields); i++)
+        nb_forwarded += fields[i].stage == NGLI_PROGRAM_SHADER_FRAG;
+
+    /* Every member draws a single instance */
+    ngli_bstr_print(s->vert_base, "#define gl_InstanceID 0\n"
+                                  "#define gl_InstanceIndex 0\n");
+
+    if (!nb_forwarded) {
+        ngli_bstr_print(s->vert_base, vertex);
+        return ngli_bstr_check(s->vert_base);
+    }
+
+    /*
+     * The user main function is wrapped so the per-instance fragment
+     * uniforms can be forwarded to the fragment stage before it runs.
+     */
+    ngli_bstr_printf(s->vert_base, "#define main ngl_batch_main\n%s\n#undef main\n\n"
+                                   "void main()\n{\n", vertex);
+    for (int i = 0; i < ngli_darray_count(&s->fields); i++) {
+        const struct renderbatch_field *field = &fields[i];
+        if (field->stage == NGLI_PROGRAM_SHADER_FRAG)
+            ngli_bstr_printf(s->vert_base, "    %s = " FORWARD_PREFIX "%s;\n", field->name, field->name);
+    }
+    ngli_bstr_print(s->vert_base, "    ngl_batch_main();\n}\n");
+    return ngli_bstr_check(s->vert_base);
+}
+
+static int get_nb_locations(int type)
+{
+    return type == NGLI_TYPE_MAT4 ? 4 : 1;
+}
+
+static int register_attributes(struct renderbatch *s, const struct render_priv *render)
+{
+    int nb_locations = 3; /* ngl_position, ngl_uvcoord, ngl_normal */
+    if (render->attributes) {
+        const struct hmap_entry *e = NULL;
+        while ((e = ngli_hmap_next(render->attributes, e))) {
+            const struct buffer_priv *buffer = ((const struct ngl_node *)e->data)->priv_data;
+            nb_locations += get_nb_locations(buffer->data_type);
+        }
+    }
+
+    const struct renderbatch_field *fields = ngli_darray_data(&s->fields);
+    for (int i = 0; i < ngli_darray_count(&s->fields); i++) {
+        const struct renderbatch_field *field = &fields[i];
+        nb_locations += get_nb_locations(field->type);
+
+        struct pgcraft_attribute attribute = {
+            .type   = field->type,
+            .format = get_instance_format(field->type),
+            .stride = s->stride,
+            .offset = field->offset,
+            .rate   = 1,
+            .buffer = s->buffer,
+        };
+        const char *prefix = field->stage == NGLI_PROGRAM_SHADER_FRAG ? FORWARD_PREFIX : "";
+        snprintf(attribute.name, sizeof(attribute.name), "%s%s", prefix, field->name);
+        if (!ngli_darray_push(&s->attributes, &attribute))
+            return NGL_ERROR_MEMORY;
+
+        if (field->stage == NGLI_PROGRAM_SHADER_FRAG) {
+            struct pgcraft_iovar iovar = {.type = field->type};
+            snprintf(iovar.name, sizeof(iovar.name), "%s", field->name);
+            if (!ngli_darray_push(&s->vert_out_vars, &iovar))
+                return NGL_ERROR_MEMORY;
+        }
+    }
+
+    if (nb_locations > MAX_VERTEX_ATTRIBUTES) {
+        LOG(DEBUG, "batch requires too many vertex attributes (%d > %d)",
+            nb_locations, MAX_VERTEX_ATTRIBUTES);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    return 0;
+}
+
+static int merge_geometry_buffer(struct renderbatch *s, int index)
+{
+    const struct renderbatch_member *members = ngli_darray_data(&s->members);
+    const int nb_members = ngli_darray_count(&s->members);
+    if (!get_geometry_buffer(members[0].render, index))
+        return 0;
+
+    int size = 0;
+    for (int i = 0; i < nb_members; i++) {
+        const struct buffer_priv *buffer = get_geometry_buffer(members[i].render, index)->priv_data;
+        size += buffer->data_size;
+    }
+
+    uint8_t *data = ngli_malloc(size);
+    if (!data)
+        return NGL_ERROR_MEMORY;
+
+    uint8_t *dst = data;
+    for (int i = 0; i < nb_members; i++) {
+        const struct buffer_priv *buffer = get_geometry_buffer(members[i].render, index)->priv_data;
+        memcpy(dst, buffer->data, buffer->data_size);
+        dst += buffer->data_size;
+    }
+
+    struct buffer *buffer = ngli_buffer_create(s->ctx->gctx);
+    if (!buffer) {
+        ngli_free(data);
+        return NGL_ERROR_MEMORY;
+    }
+    s->geometry_buffers[index] = buffer;
+
+    int ret = ngli_buffer_init(buffer, size, NGLI_BUFFER_USAGE_STATIC);
+    if (ret >= 0)
+        ret = ngli_buffer_upload(buffer, data, size);
+    ngli_free(data);
+    return ret;
+}
+
+static int register_geometry_attributes(struct renderbatch *s, const struct program_priv *program)
+{
+    const struct renderbatch_member *members = ngli_darray_data(&s->members);
+    for (int i = 0; i < NGLI_ARRAY_NB(geometry_attribute_names); i++) {
+        const struct ngl_node *node = get_geometry_buffer(members[0].render, i);
+        if (!node)
+            continue;
+
+        /* See the ngl_position exception in the pass attributes registration */
+        const struct buffer_priv *buffer = node->priv_data;
+        const char *name = geometry_attribute_names[i];
+        struct pgcraft_attribute attribute = {
+            .type   = i == GEOMETRY_BUFFER_VERTICES ? NGLI_TYPE_VEC4 : buffer->data_type,
+            .format = buffer->data_format,
+            .stride = buffer->data_stride,
+            .buffer = s->geometry_buffers[i],
+        };
+        snprintf(attribute.name, sizeof(attribute.name), "%s", name);
+
+        if (program->properties) {
+            const struct ngl_node *resprops_node = ngli_hmap_get(program->properties, name);
+            if (resprops_node) {
+                const struct resourceprops_priv *resprops = resprops_node->priv_data;
+                attribute.precision = resprops->precision;
+            }
+        }
+
+        if (!ngli_darray_push(&s->attributes, &attribute))
+            return NGL_ERROR_MEMORY;
+    }
+    return 0;
+}
+
+/*
+ * Concatenate the geometries of the members and describe the draw of each
+ * member in the indirect buffer: the member index is used as base instance so
+ * its per-instance data is fetched from the instance attributes.
+ */
+static int init_multi_draw(struct renderbatch *s, const struct program_priv *program)
+{
+    for (int i = 0; i < NB_GEOMETRY_BUFFERS; i++) {
+        int ret = merge_geometry_buffer(s, i);
+        if (ret < 0)
+            return ret;
+    }
+
+    const struct renderbatch_member *members = ngli_darray_data(&s->members);
+    const int nb_members = ngli_darray_count(&s->members);
+    const int indexed = s->geometry_buffers[GEOMETRY_BUFFER_INDICES] != NULL;
+    s->indirect_stride = indexed ? sizeof(struct draw_indexed_indirect_cmd) : sizeof(struct draw_indirect_cmd);
+    const int size = s->indirect_stride * nb_members;
+
+    s->indirect_data = ngli_calloc(nb_members, s->indirect_stride);
+    if (!s->indirect_data)
+        return NGL_ERROR_MEMORY;
+
+    uint32_t first_vertex = 0;
+    uint32_t first_index = 0;
+    for (int i = 0; i < nb_members; i++) {
+        const struct ngl_node *render = members[i].render;
+        const struct buffer_priv *vertices = get_geometry_buffer(render, GEOMETRY_BUFFER_VERTICES)->priv_data;
+        if (indexed) {
+            const struct buffer_priv *indices = get_geometry_buffer(render, GEOMETRY_BUFFER_INDICES)->priv_data;
+            struct draw_indexed_indirect_cmd *cmd = (struct draw_indexed_indirect_cmd *)s->indirect_data + i;
+            cmd->nb_indices     = indices->count;
+            cmd->nb_instances   = 1;
+            cmd->first_index    = first_index;
+            cmd->vertex_offset  = first_vertex;
+            cmd->first_instance = i;
+            first_index += indices->count;
+        } else {
+            struct draw_indirect_cmd *cmd = (struct draw_indirect_cmd *)s->indirect_data + i;
+            cmd->nb_vertices    = vertices->count;
+            cmd->nb_instances   = 1;
+            cmd->first_vertex   = first_vertex;
+            cmd->first_instance = i;
+        }
+        first_vertex += vertices->count;
+    }
+
+    s->indirect_buffer = ngli_buffer_create(s->ctx->gctx);
+    if (!s->indirect_buffer)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_buffer_init(s->indirect_buffer, size, NGLI_BUFFER_USAGE_DYNAMIC);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_buffer_upload(s->indirect_buffer, s->indirect_data, size);
+    if (ret < 0)
+        return ret;
+
+    LOG(DEBUG, "merging %d different geometries in a multi-draw", nb_members);
+
+    return register_geometry_attributes(s, program);
+}
+
+static int get_indices_format(const struct renderbatch *s)
+{
+    if (!s->geometry_buffers[GEOMETRY_BUFFER_INDICES])
+        return NGLI_FORMAT_UNDEFINED;
+    const struct renderbatch_member *members = ngli_darray_data(&s->members);
+    const struct buffer_priv *indices = get_geometry_buffer(members[0].render, GEOMETRY_BUFFER_INDICES)->priv_data;
+    return indices->data_format;
+}
+
+int ngli_renderbatch_init(struct renderbatch *s, struct ngl_ctx *ctx, const char *label,
+                          struct ngl_node **nodes, int nb_nodes)
+{
+    s->ctx = ctx;
+
+    ngli_darray_init(&s->members, sizeof(struct renderbatch_member), 0);
+    ngli_darray_init(&s->transforms, sizeof(const float *), 0);
+    ngli_darray_init(&s->fields, sizeof(struct renderbatch_field), 0);
+    ngli_darray_init(&s->sources, sizeof(const void *), 0);
+    ngli_darray_init(&s->attributes, sizeof(struct pgcraft_attribute), 0);
+    ngli_darray_init(&s->vert_out_vars, sizeof(struct pgcraft_iovar), 0);
+
+    for (int i = 0; i < nb_nodes; i++) {
+        int ret = add_member(s, nodes[i]);
+        if (ret < 0)
+            return ret;
+    }
+
+    const struct renderbatch_member *members = ngli_darray_data(&s->members);
+    const struct render_priv *render = members[0].render->priv_data;
+    const struct program_priv *program = render->program->priv_data;
+
+    s->vert_resources = ngli_hmap_create();
+    s->frag_resources = ngli_hmap_create();
+    if (!s->vert_resources || !s->frag_resources)
+        return NGL_ERROR_MEMORY;
+
+    int ret;
+    if ((ret = add_field(s, MODELVIEW_MATRIX_NAME, NGLI_TYPE_MAT4, -1, 4 * 4 * sizeof(float))) < 0 ||
+        (ret = register_resources(s, NGLI_PROGRAM_SHADER_VERT)) < 0 ||
+        (ret = register_resources(s, NGLI_PROGRAM_SHADER_FRAG)) < 0 ||
+        (ret = register_sources(s)) < 0)
+        return ret;
+
+    s->data_size = s->stride * nb_nodes;
+    s->data = ngli_calloc(1, s->data_size);
+    s->uploaded_data = ngli_calloc(1, s->data_size);
+    if (!s->data || !s->uploaded_data)
+        return NGL_ERROR_MEMORY;
+
+    s->buffer = ngli_buffer_create(ctx->gctx);
+    if (!s->buffer)
+        return NGL_ERROR_MEMORY;
+
+    ret = ngli_buffer_init(s->buffer, s->data_size, NGLI_BUFFER_USAGE_DYNAMIC);
+    if (ret < 0)
+        return ret;
+
+    for (int i = 1; i < nb_nodes && !s->multi_draw; i++) {
+        const struct render_priv *member = members[i].render->priv_data;
+        s->multi_draw = member->geometry != render->geometry;
+    }
+
+    if (s->multi_draw) {
+        ret = init_multi_draw(s, program);
+        if (ret < 0)
+            return ret;
+    }
+
+    const struct pgcraft_iovar *iovars = ngli_darray_data(&render->vert_out_vars);
+    for (int i = 0; i < ngli_darray_count(&render->vert_out_vars); i++)
+        if (!ngli_darray_push(&s->vert_out_vars, &iovars[i]))
+            return NGL_ERROR_MEMORY;
+
+    if ((ret = register_attributes(s, render)) < 0 ||
+        (ret = craft_vert_base(s, program->vertex)) < 0)
+        return ret;
+
+    const struct pass_params params = {
+        .label               = label,
+        .geometry            = render->geometry,
+        .vert_base           = ngli_bstr_strptr(s->vert_base),
+        .frag_base           = program->fragment,
+        .vert_resources      = s->vert_resources,
+        .frag_resources      = s->frag_resources,
+        .properties          = program->properties,
+        .attributes          = render->attributes,
+        .extra_attributes    = ngli_darray_data(&s->attributes),
+        .nb_extra_attributes = ngli_darray_count(&s->attributes),
+        .nb_instances        = nb_nodes,
+        .indirect_buffer     = s->indirect_buffer,
+        .nb_draws            = nb_nodes,
+        .indices_buffer      = s->geometry_buffers[GEOMETRY_BUFFER_INDICES],
+        .indices_format      = get_indices_format(s),
+        .vert_out_vars       = ngli_darray_data(&s->vert_out_vars),
+        .nb_vert_out_vars    = ngli_darray_count(&s->vert_out_vars),
+        .nb_frag_output      = program->nb_frag_output,
+    };
+    return ngli_pass_init(&s->pass, ctx, &params);
+}
+
+int ngli_renderbatch_prepare(struct renderbatch *s)
+{
+    int ret = ngli_pass_prepare(&s->pass);
+    if (ret < 0)
+        return ret;
+
+    /*
+     * The normal matrix is derived from the modelview matrix of the batch
+     * instead of the ones of the members: a program actually making use of it
+     * can not be batched.
+     */
+    if (ngli_pass_uses_uniform(&s->pass, "ngl_normal_matrix", NGLI_PROGRAM_SHADER_VERT))
+        return NGL_ERROR_UNSUPPORTED;
+
+    s->use_culling = ngli_pass_uses_geometry_transform(&s->pass);
+    return 0;
+}
+
+static void compute_modelview_matrix(const struct renderbatch *s, const struct renderbatch_member *member,
+                                     const float *parent_matrix, float *dst)
+{
+    NGLI_ALIGNED_MAT(matrices[2]);
+    const float * const *transforms = ngli_darray_data(&s->transforms);
+
+    memcpy(matrices[0], parent_matrix, sizeof(matrices[0]));
+    for (int i = 0; i < member->nb_transforms; i++) {
+        const float *transform = transforms[member->transform_start + i];
+        ngli_mat4_mul(matrices[(i + 1) & 1], matrices[i & 1], transform);
+    }
+    memcpy(dst, matrices[member->nb_transforms & 1], sizeof(matrices[0]));
+}
+
+static int is_member_visible(const struct renderbatch *s, const struct renderbatch_member *member,
+                             const float *modelview_matrix, const float *projection_matrix)
+{
+    const struct render_priv *render = member->render->priv_data;
+    return !s->use_culling || !render->use_culling ||
+           ngli_node_geometry_is_visible(render->geometry, modelview_matrix, projection_matrix);
+}
+
+/*
+ * The culled members of a multi-draw keep their slot in the instance data
+ * since it is addressed by the base instance of each command: only their
+ * instance count is updated.
+ */
+static int update_indirect_data(struct renderbatch *s, int index, uint32_t nb_instances)
+{
+    uint8_t *cmd = s->indirect_data + index * s->indirect_stride;
+    const size_t offset = s->geometry_buffers[GEOMETRY_BUFFER_INDICES] ? offsetof(struct draw_indexed_indirect_cmd, nb_instances)
+                                                                       : offsetof(struct draw_indirect_cmd, nb_instances);
+    if (!memcmp(cmd + offset, &nb_instances, sizeof(nb_instances)))
+        return 0;
+    memcpy(cmd + offset, &nb_instances, sizeof(nb_instances));
+    return 1;
+}
+
+void ngli_renderbatch_draw(struct renderbatch *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    const float *parent_matrix = ngli_darray_tail(&ctx->modelview_matrix_stack);
+    const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
+
+    const struct renderbatch_member *members = ngli_darray_data(&s->members);
+    const struct renderbatch_field *fields = ngli_darray_data(&s->fields);
+    const void * const *sources = ngli_darray_data(&s->sources);
+    const int nb_fields = ngli_darray_count(&s->fields);
+    const int nb_members = ngli_darray_count(&s->members);
+
+    int nb_visible = 0;
+    int indirect_changed = 0;
+    for (int i = 0; i < nb_members; i++) {
+        NGLI_ALIGNED_MAT(modelview_matrix);
+        compute_modelview_matrix(s, &members[i], parent_matrix, modelview_matrix);
+
+        const int visible = is_member_visible(s, &members[i], modelview_matrix, projection_matrix);
+        if (s->multi_draw)
+            indirect_changed |= update_indirect_data(s, i, visible);
+        else if (!visible)
+            continue;
+
+        uint8_t *dst = s->data + (s->multi_draw ? i : nb_visible) * s->stride;
+        memcpy(dst, modelview_matrix, sizeof(modelview_matrix));
+        for (int j = 1; j < nb_fields; j++)
+            memcpy(dst + fields[j].offset, sources[i * nb_fields + j], fields[j].size);
+        nb_visible += visible;
+    }
+
+    if (indirect_changed) {
+        int ret = ngli_buffer_upload(s->indirect_buffer, s->indirect_data, nb_members * s->indirect_stride);
+        if (ret < 0) {
+            LOG(ERROR, "unable to upload batch indirect commands: %s", NGLI_RET_STR(ret));
+            return;
+        }
+    }
+
+    if (!nb_visible)
+        return;
+
+    /* Static layouts are only uploaded once */
+    if (!s->uploaded || memcmp(s->data, s->uploaded_data, s->data_size)) {
+        int ret = ngli_buffer_upload(s->buffer, s->data, s->data_size);
+        if (ret < 0) {
+            LOG(ERROR, "unable to upload batch instance data: %s", NGLI_RET_STR(ret));
+            return;
+        }
+        memcpy(s->uploaded_data, s->data, s->data_size);
+        s->uploaded = 1;
+    }
+
+    s->pass.nb_instances = nb_visible;
+    ngli_pass_exec(&s->pass);
+}
+
+void ngli_renderbatch_uninit(struct renderbatch *s)
+{
+    if (!s->ctx)
+        return;
+
+    ngli_pass_uninit(&s->pass);
+    ngli_buffer_freep(&s->buffer);
+    for (int i = 0; i < NB_GEOMETRY_BUFFERS; i++)
+        ngli_buffer_freep(&s->geometry_buffers[i]);
+    ngli_buffer_freep(&s->indirect_buffer);
+    ngli_freep(&s->indirect_data);
+    ngli_freep(&s->data);
+    ngli_freep(&s->uploaded_data);
+    ngli_bstr_freep(&s->vert_base);
+    ngli_hmap_freep(&s->vert_resources);
+    ngli_hmap_freep(&s->frag_resources);
+    ngli_darray_reset(&s->members);
+    ngli_darray_reset(&s->transforms);
+    ngli_darray_reset(&s->fields);
+    ngli_darray_reset(&s->sources);
+    ngli_darray_reset(&s->attributes);
+    ngli_darray_reset(&s->vert_out_vars);
+    memset(s, 0, sizeof(*s));
+}
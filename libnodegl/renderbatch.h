@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef RENDERBATCH_H
+#define RENDERBATCH_H
+
+#include <stdint.h>
+
+#include "bstr.h"
+#include "buffer.h"
+#include "darray.h"
+#include "hmap.h"
+#include "pass.h"
+
+struct ngl_ctx;
+struct ngl_node;
+
+/*
+ * Instanced rendering of a run of consecutive sibling Render nodes.
+ *
+ * The members of a batch are Render nodes (optionally placed under a chain of
+ * transforms) sharing the same program, geometry and resources, except for
+ * some of their float and vector uniforms. The transformation matrices and
+ * these differing uniforms are packed into a per-instance attribute buffer,
+ * and the whole run is rasterized with a single instanced draw call. The
+ * instances being rasterized in order, the members drawing order is preserved.
+ *
+ * If the context supports multi-draw indirect, members drawing different
+ * static geometries sharing the same layout can also be batched: their
+ * vertices (and indices) are concatenated into buffers owned by the batch,
+ * and each member is submitted as one command of a single multi-draw, using
+ * its index as base instance to fetch its per-instance data.
+ *
+ * The members whose geometry lies outside the view frustum are culled: they
+ * are removed from the instance data, or get a zero instance count in their
+ * multi-draw command.
+ */
+struct renderbatch {
+    struct ngl_ctx *ctx;
+
+    struct darray members;          /* struct renderbatch_member */
+    struct darray transforms;       /* const float *, members transform matrices, outermost first */
+    struct darray fields;           /* struct renderbatch_field, per-instance data layout */
+    struct darray sources;          /* const void *, field data of each member */
+
+    struct hmap *vert_resources;    /* resources shared by all the members */
+    struct hmap *frag_resources;
+    struct darray attributes;       /* struct pgcraft_attribute */
+    struct darray vert_out_vars;    /* struct pgcraft_iovar */
+    struct bstr *vert_base;
+
+    struct buffer *buffer;
+    uint8_t *data;
+    uint8_t *uploaded_data;
+    int stride;
+    int data_size;
+    int uploaded;
+
+    int multi_draw;
+    int use_culling;                /* the program positions the members geometry */
+    struct buffer *geometry_buffers[4]; /* vertices, uvcoords, normals, indices */
+    struct buffer *indirect_buffer;
+    uint8_t *indirect_data;
+    int indirect_stride;
+
+    struct pass pass;
+};
+
+int ngli_renderbatch_is_compatible(const struct ngl_node *a, const struct ngl_node *b);
+int ngli_renderbatch_init(struct renderbatch *s, struct ngl_ctx *ctx, const char *label,
+                          struct ngl_node **nodes, int nb_nodes);
+int ngli_renderbatch_prepare(struct renderbatch *s);
+void ngli_renderbatch_draw(struct renderbatch *s);
+void ngli_renderbatch_uninit(struct renderbatch *s);
+
+#endif
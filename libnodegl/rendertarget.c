@@ -34,16 +34,25 @@ int ngli_rendertarget_init(struct rendertarget *s, const struct rendertarget_par
 
 void ngli_rendertarget_blit(struct rendertarget *s, struct rendertarget *dst, int vflip)
 {
-    return s->gctx->class->rendertarget_blit(s, dst, vflip);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        ngli_cmdbuffer_rendertarget_blit(&gctx->cmdbuffer, s, dst, vflip);
+    else
+        gctx->class->rendertarget_blit(s, dst, vflip);
 }
 
 void ngli_rendertarget_resolve(struct rendertarget *s)
 {
-    s->gctx->class->rendertarget_resolve(s);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        ngli_cmdbuffer_rendertarget_resolve(&gctx->cmdbuffer, s);
+    else
+        gctx->class->rendertarget_resolve(s);
 }
 
 void ngli_rendertarget_read_pixels(struct rendertarget *s, uint8_t *data)
 {
+    ngli_cmdbuffer_sync(&s->gctx->cmdbuffer);
     s->gctx->class->rendertarget_read_pixels(s, data);
 }
 
@@ -51,5 +60,6 @@ void ngli_rendertarget_freep(struct rendertarget **sp)
 {
     if (!*sp)
         return;
+    ngli_cmdbuffer_sync(&(*sp)->gctx->cmdbuffer);
     (*sp)->gctx->class->rendertarget_freep(sp);
 }
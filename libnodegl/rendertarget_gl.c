@@ -32,6 +32,14 @@
 #include "texture_gl.h"
 #include "utils.h"
 
+static void require_framebuffer_barrier(struct rendertarget *s)
+{
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    ngli_memorybarrier_gl_require_rendertarget(&gctx_gl->memorybarrier, gl, s);
+    ngli_memorybarrier_gl_flush(&gctx_gl->memorybarrier, gl);
+}
+
 static GLenum get_gl_attachment_index(GLenum format)
 {
     switch (format) {
@@ -306,6 +314,7 @@ void ngli_rendertarget_gl_blit(struct rendertarget *s, struct rendertarget *dst,
 
     struct rendertarget_gl *s_priv = (struct rendertarget_gl *)s;
     struct rendertarget_gl *dst_gl = (struct rendertarget_gl *)dst;
+    require_framebuffer_barrier(s);
     ngli_glBindFramebuffer(gl, GL_READ_FRAMEBUFFER, s_priv->id);
     ngli_glBindFramebuffer(gl, GL_DRAW_FRAMEBUFFER, dst_gl->id);
     s_priv->blit(s, dst->nb_color_attachments, dst->width, dst->height, vflip);
@@ -328,6 +337,7 @@ void ngli_rendertarget_gl_resolve(struct rendertarget *s)
     if (!s_priv->resolve_id)
         return;
 
+    require_framebuffer_barrier(s);
     ngli_glBindFramebuffer(gl, GL_READ_FRAMEBUFFER, s_priv->id);
     ngli_glBindFramebuffer(gl, GL_DRAW_FRAMEBUFFER, s_priv->resolve_id);
     s_priv->resolve(s);
@@ -348,6 +358,7 @@ void ngli_rendertarget_gl_read_pixels(struct rendertarget *s, uint8_t *data)
 
     const GLuint fbo_id = rt_gl ? rt_gl->id : ngli_glcontext_get_default_framebuffer(gl);
     const GLuint id = s_priv->resolve_id ? s_priv->resolve_id : s_priv->id;
+    require_framebuffer_barrier(s);
     if (id != fbo_id)
         ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, id);
 
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gctx_null.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "rendertarget_null.h"
+
+struct rendertarget *ngli_rendertarget_null_create(struct gctx *gctx)
+{
+    struct rendertarget *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gctx = gctx;
+    return s;
+}
+
+int ngli_rendertarget_null_init(struct rendertarget *s, const struct rendertarget_params *params)
+{
+    const struct limits *limits = &s->gctx->limits;
+
+    s->params = *params;
+    s->width = params->width;
+    s->height = params->height;
+
+    for (int i = 0; i < params->nb_colors; i++) {
+        const struct attachment *color = &params->colors[i];
+        if (!color->attachment)
+            continue;
+        s->nb_color_attachments++;
+        if (color->resolve_target)
+            s->nb_resolve_color_attachments++;
+    }
+
+    if (s->nb_color_attachments > limits->max_draw_buffers) {
+        LOG(ERROR, "draw buffer count (%d) exceeds driver limit (%d)",
+            s->nb_color_attachments, limits->max_draw_buffers);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    return 0;
+}
+
+void ngli_rendertarget_null_blit(struct rendertarget *s, struct rendertarget *dst, int vflip)
+{
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_RENDERTARGET_BLIT,
+        .object = s,
+        .args   = {dst->width, dst->height, vflip},
+    });
+}
+
+void ngli_rendertarget_null_resolve(struct rendertarget *s)
+{
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){.type = NGLI_CMD_NULL_RENDERTARGET_RESOLVE, .object = s});
+}
+
+/* There is no rendered content: the destination is left untouched */
+void ngli_rendertarget_null_read_pixels(struct rendertarget *s, uint8_t *data)
+{
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_RENDERTARGET_READ_PIXELS,
+        .object = s,
+        .args   = {s->width, s->height},
+    });
+}
+
+void ngli_rendertarget_null_freep(struct rendertarget **sp)
+{
+    ngli_freep(sp);
+}
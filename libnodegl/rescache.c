@@ -0,0 +1,133 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "rescache.h"
+#include "utils.h"
+
+struct rescache_entry {
+    struct ngl_node *node;
+    int64_t size;
+};
+
+void ngli_rescache_init(struct rescache *s, int64_t budget)
+{
+    memset(s, 0, sizeof(*s));
+    s->budget = budget;
+    ngli_darray_init(&s->entries, sizeof(struct rescache_entry), 0);
+}
+
+int ngli_rescache_add(struct rescache *s, struct ngl_node *node, int64_t size)
+{
+    const struct rescache_entry entry = {.node = node, .size = size};
+    if (!ngli_darray_push(&s->entries, &entry))
+        return NGL_ERROR_MEMORY;
+
+    struct rescache_stats *stats = &s->stats;
+    stats->size += size;
+    stats->max_size = NGLI_MAX(stats->max_size, stats->size);
+    stats->nb_nodes++;
+    TRACE("CACHE %s @ %p (%" PRId64 " bytes, total: %" PRId64 "/%" PRId64 ")",
+          node->label, node, size, stats->size, s->budget);
+    return 0;
+}
+
+static int find_entry(const struct rescache *s, const struct ngl_node *node)
+{
+    const struct rescache_entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++)
+        if (entries[i].node == node)
+            return i;
+    return -1;
+}
+
+static void remove_entry(struct rescache *s, int index)
+{
+    const struct rescache_entry *entry = ngli_darray_get(&s->entries, index);
+    s->stats.size -= entry->size;
+    s->stats.nb_nodes--;
+    ngli_darray_remove(&s->entries, index);
+}
+
+int ngli_rescache_remove(struct rescache *s, const struct ngl_node *node)
+{
+    const int index = find_entry(s, node);
+    if (index < 0)
+        return 0;
+    remove_entry(s, index);
+    return 1;
+}
+
+static int depends_on(const struct ngl_node *node, const struct ngl_node *dep)
+{
+    const struct darray *children_array = &node->children;
+    struct ngl_node * const *children = ngli_darray_data(children_array);
+    for (int i = 0; i < ngli_darray_count(children_array); i++)
+        if (children[i] == dep || depends_on(children[i], dep))
+            return 1;
+    return 0;
+}
+
+static void evict_entry(struct rescache *s, int index, rescache_release_func_type release_func)
+{
+    const struct rescache_entry entry = *(struct rescache_entry *)ngli_darray_get(&s->entries, index);
+
+    LOG(VERBOSE, "evict %s @ %p (%" PRId64 " bytes) from the residency cache",
+        entry.node->label, entry.node, entry.size);
+    remove_entry(s, index);
+    s->stats.nb_evictions++;
+    s->stats.evicted_size += entry.size;
+
+    /*
+     * Other cached nodes may still reference the resources of the evicted
+     * node (typically a RenderToTexture and its color textures), so they need
+     * to be evicted along with it.
+     */
+    int i = 0;
+    while (i < ngli_darray_count(&s->entries)) {
+        const struct rescache_entry *cached = ngli_darray_get(&s->entries, i);
+        if (depends_on(cached->node, entry.node)) {
+            evict_entry(s, i, release_func);
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+
+    release_func(entry.node);
+}
+
+void ngli_rescache_trim(struct rescache *s, rescache_release_func_type release_func)
+{
+    while (s->stats.size > s->budget && ngli_darray_count(&s->entries))
+        evict_entry(s, 0, release_func);
+}
+
+void ngli_rescache_reset(struct rescache *s)
+{
+    ngli_darray_reset(&s->entries);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef RESCACHE_H
+#define RESCACHE_H
+
+#include <stdint.h>
+
+#include "darray.h"
+
+struct ngl_node;
+
+struct rescache_stats {
+    int64_t size;           /* memory currently held by the cached nodes */
+    int64_t max_size;       /* high-water mark of size */
+    int nb_nodes;           /* number of nodes currently cached */
+    int nb_hits;            /* cached nodes re-activated without a new prefetch */
+    int nb_evictions;       /* cached nodes released because of the budget */
+    int64_t evicted_size;   /* cumulated memory released by the evictions */
+};
+
+/*
+ * Residency cache of the nodes which became inactive but still hold their
+ * resources. The nodes are kept in least recently used order: the first
+ * entry is the first candidate for eviction.
+ */
+struct rescache {
+    int64_t budget;
+    struct darray entries; // rescache_entry
+    struct rescache_stats stats;
+};
+
+typedef void (*rescache_release_func_type)(struct ngl_node *node);
+
+void ngli_rescache_init(struct rescache *s, int64_t budget);
+int ngli_rescache_add(struct rescache *s, struct ngl_node *node, int64_t size);
+int ngli_rescache_remove(struct rescache *s, const struct ngl_node *node);
+void ngli_rescache_trim(struct rescache *s, rescache_release_func_type release_func);
+void ngli_rescache_reset(struct rescache *s);
+
+#endif
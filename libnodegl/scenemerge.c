@@ -0,0 +1,376 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "darray.h"
+#include "hmap.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "scenemerge.h"
+
+struct scenemerge {
+    struct hmap *new_nodes;     /* nodes reachable from the new scene */
+    struct hmap *cur_nodes;     /* nodes reachable from the current scene */
+    struct hmap *candidates;    /* struct darray of current nodes, by signature */
+    struct hmap *merged;        /* node replacing every visited new node */
+    int positional;             /* only match the nodes with their hint */
+    int nb_replaced;
+};
+
+typedef int (*child_func_type)(struct scenemerge *s, struct ngl_node *node);
+
+static int foreach_child(struct scenemerge *s, struct ngl_node *node, child_func_type func)
+{
+    const uint8_t *base_ptr = node->priv_data;
+    const struct node_param *par = node->class->params;
+
+    if (!par)
+        return 0;
+
+    for (; par->key; par++) {
+        const uint8_t *parp = base_ptr + par->offset;
+
+        if (par->type == PARAM_TYPE_NODE) {
+            struct ngl_node *child = *(struct ngl_node **)parp;
+            if (child) {
+                int ret = func(s, child);
+                if (ret < 0)
+                    return ret;
+            }
+        } else if (par->type == PARAM_TYPE_NODELIST) {
+            struct ngl_node **elems = *(struct ngl_node ***)parp;
+            const int nb_elems = *(const int *)(parp + sizeof(struct ngl_node **));
+            for (int i = 0; i < nb_elems; i++) {
+                int ret = func(s, elems[i]);
+                if (ret < 0)
+                    return ret;
+            }
+        } else if (par->type == PARAM_TYPE_NODEDICT) {
+            const struct hmap *hmap = *(const struct hmap **)parp;
+            if (!hmap)
+                continue;
+            const struct hmap_entry *entry = NULL;
+            while ((entry = ngli_hmap_next(hmap, entry))) {
+                int ret = func(s, entry->data);
+                if (ret < 0)
+                    return ret;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int visit_once(struct hmap *visited, struct ngl_node *node)
+{
+    char key[32];
+    (void)snprintf(key, sizeof(key), "%p", node);
+    if (ngli_hmap_get(visited, key))
+        return 0;
+    int ret = ngli_hmap_set(visited, key, node);
+    return ret < 0 ? ret : 1;
+}
+
+static int is_visited(const struct hmap *visited, const struct ngl_node *node)
+{
+    char key[32];
+    (void)snprintf(key, sizeof(key), "%p", node);
+    return !!ngli_hmap_get(visited, key);
+}
+
+static void get_signature(char *buf, size_t size, uint64_t params_hash)
+{
+    (void)snprintf(buf, size, "%016" PRIx64, params_hash);
+}
+
+static int collect_new_nodes(struct scenemerge *s, struct ngl_node *node)
+{
+    int ret = visit_once(s->new_nodes, node);
+    if (ret <= 0)
+        return ret;
+    return foreach_child(s, node, collect_new_nodes);
+}
+
+static void free_candidates(void *user_arg, void *data)
+{
+    struct darray *nodes = data;
+    ngli_darray_reset(nodes);
+    ngli_free(nodes);
+}
+
+static int add_candidate(struct scenemerge *s, struct ngl_node *node)
+{
+    char signature[32];
+    get_signature(signature, sizeof(signature), node->params_hash);
+    struct darray *nodes = ngli_hmap_get(s->candidates, signature);
+    if (!nodes) {
+        nodes = ngli_calloc(1, sizeof(*nodes));
+        if (!nodes)
+            return NGL_ERROR_MEMORY;
+        ngli_darray_init(nodes, sizeof(struct ngl_node *), 0);
+        int ret = ngli_hmap_set(s->candidates, signature, nodes);
+        if (ret < 0) {
+            free_candidates(NULL, nodes);
+            return ret;
+        }
+    }
+    if (!ngli_darray_push(nodes, &node))
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+static int collect_candidates(struct scenemerge *s, struct ngl_node *node)
+{
+    /* The current nodes still referenced by the new scene are kept as is */
+    if (is_visited(s->new_nodes, node))
+        return 0;
+
+    int ret = visit_once(s->cur_nodes, node);
+    if (ret <= 0)
+        return ret;
+
+    /* The nodes live changed since their initialization are never reused */
+    if (node->params_hash) {
+        ret = add_candidate(s, node);
+        if (ret < 0)
+            return ret;
+    }
+
+    return foreach_child(s, node, collect_candidates);
+}
+
+static int take_candidate(struct scenemerge *s, const struct ngl_node *cur_node)
+{
+    char signature[32];
+    get_signature(signature, sizeof(signature), cur_node->params_hash);
+    struct darray *nodes_array = ngli_hmap_get(s->candidates, signature);
+    if (!nodes_array)
+        return 0;
+
+    struct ngl_node **nodes = ngli_darray_data(nodes_array);
+    for (int i = 0; i < ngli_darray_count(nodes_array); i++) {
+        if (nodes[i] == cur_node) {
+            /* A current node replaces at most one new node */
+            ngli_darray_remove(nodes_array, i);
+            s->nb_replaced++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * The current nodes parameters may have been altered by their initialization,
+ * so the equivalence is established with their parameters recorded at that
+ * time: the hash selects the candidates, which are then compared field by
+ * field so that a hash collision never merges two different nodes.
+ */
+static struct ngl_node *find_equivalent(struct scenemerge *s, const struct ngl_node *node,
+                                        struct ngl_node *hint)
+{
+    const uint64_t params_hash = ngli_node_hash_params(node);
+
+    if (hint && hint->params_hash == params_hash && ngli_node_params_equal(node, hint))
+        return take_candidate(s, hint) ? hint : NULL;
+    if (s->positional)
+        return NULL;
+
+    char signature[32];
+    get_signature(signature, sizeof(signature), params_hash);
+    struct darray *nodes_array = ngli_hmap_get(s->candidates, signature);
+    if (!nodes_array)
+        return NULL;
+
+    struct ngl_node **nodes = ngli_darray_data(nodes_array);
+    for (int i = 0; i < ngli_darray_count(nodes_array); i++) {
+        struct ngl_node *cur_node = nodes[i];
+        if (ngli_node_params_equal(node, cur_node) && take_candidate(s, cur_node))
+            return cur_node;
+    }
+    return NULL;
+}
+
+static int merge_node(struct scenemerge *s, struct ngl_node *node, struct ngl_node *hint,
+                      struct ngl_node **dstp);
+
+static int merge_child(struct scenemerge *s, struct ngl_node **childp, struct ngl_node *hint)
+{
+    struct ngl_node *child = *childp;
+    struct ngl_node *merged;
+    int ret = merge_node(s, child, hint, &merged);
+    if (ret < 0)
+        return ret;
+    if (merged != child) {
+        *childp = ngl_node_ref(merged);
+        ngl_node_unrefp(&child);
+    }
+    return 0;
+}
+
+/*
+ * The children of the current node found at the same place (same parameter,
+ * same index or key) are used as hints for the children of the new node.
+ */
+static int merge_children(struct scenemerge *s, struct ngl_node *node, struct ngl_node *hint)
+{
+    uint8_t *base_ptr = node->priv_data;
+    const uint8_t *hint_base_ptr = hint && hint->class == node->class ? hint->priv_data : NULL;
+    const struct node_param *par = node->class->params;
+
+    if (!par)
+        return 0;
+
+    for (; par->key; par++) {
+        uint8_t *parp = base_ptr + par->offset;
+        const uint8_t *hint_parp = hint_base_ptr ? hint_base_ptr + par->offset : NULL;
+
+        if (par->type == PARAM_TYPE_NODE) {
+            if (!*(struct ngl_node **)parp)
+                continue;
+            struct ngl_node *hint_child = hint_parp ? *(struct ngl_node **)hint_parp : NULL;
+            int ret = merge_child(s, (struct ngl_node **)parp, hint_child);
+            if (ret < 0)
+                return ret;
+        } else if (par->type == PARAM_TYPE_NODELIST) {
+            struct ngl_node **elems = *(struct ngl_node ***)parp;
+            const int nb_elems = *(const int *)(parp + sizeof(struct ngl_node **));
+            struct ngl_node **hint_elems = hint_parp ? *(struct ngl_node ***)hint_parp : NULL;
+            const int nb_hint_elems = hint_parp ? *(const int *)(hint_parp + sizeof(struct ngl_node **)) : 0;
+            for (int i = 0; i < nb_elems; i++) {
+                struct ngl_node *hint_child = i < nb_hint_elems ? hint_elems[i] : NULL;
+                int ret = merge_child(s, &elems[i], hint_child);
+                if (ret < 0)
+                    return ret;
+            }
+        } else if (par->type == PARAM_TYPE_NODEDICT) {
+            struct hmap *hmap = *(struct hmap **)parp;
+            if (!hmap)
+                continue;
+            const struct hmap *hint_hmap = hint_parp ? *(const struct hmap **)hint_parp : NULL;
+            const struct hmap_entry *entry = NULL;
+            while ((entry = ngli_hmap_next(hmap, entry))) {
+                struct ngl_node *hint_child = hint_hmap ? ngli_hmap_get(hint_hmap, entry->key) : NULL;
+                struct ngl_node *merged;
+                int ret = merge_node(s, entry->data, hint_child, &merged);
+                if (ret < 0)
+                    return ret;
+                if (merged != entry->data) {
+                    /* The replaced node is released by the dictionary */
+                    ret = ngli_hmap_set(hmap, entry->key, ngl_node_ref(merged));
+                    if (ret < 0) {
+                        ngl_node_unrefp(&merged);
+                        return ret;
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int merge_node(struct scenemerge *s, struct ngl_node *node, struct ngl_node *hint,
+                      struct ngl_node **dstp)
+{
+    /* Nodes already attached to a context are not candidates for merging */
+    if (node->ctx) {
+        *dstp = node;
+        return 0;
+    }
+
+    char key[32];
+    (void)snprintf(key, sizeof(key), "%p", node);
+    struct ngl_node *merged = ngli_hmap_get(s->merged, key);
+    if (merged) {
+        *dstp = merged;
+        return 0;
+    }
+
+    /*
+     * The children are merged first so that the equivalence of a node with a
+     * current one can be established by comparing their children addresses.
+     */
+    int ret = merge_children(s, node, hint);
+    if (ret < 0)
+        return ret;
+
+    merged = find_equivalent(s, node, hint);
+    if (!merged)
+        merged = node;
+
+    ret = ngli_hmap_set(s->merged, key, merged);
+    if (ret < 0)
+        return ret;
+
+    *dstp = merged;
+    return 0;
+}
+
+int ngli_scene_merge(struct ngl_node *cur_scene, struct ngl_node *scene, struct ngl_node **dstp)
+{
+    struct scenemerge s = {
+        .new_nodes  = ngli_hmap_create(),
+        .cur_nodes  = ngli_hmap_create(),
+        .candidates = ngli_hmap_create(),
+    };
+
+    int ret = NGL_ERROR_MEMORY;
+    if (!s.new_nodes || !s.cur_nodes || !s.candidates)
+        goto end;
+    ngli_hmap_set_free(s.candidates, free_candidates, NULL);
+
+    if ((ret = collect_new_nodes(&s, scene)) < 0 ||
+        (ret = collect_candidates(&s, cur_scene)) < 0)
+        goto end;
+
+    /*
+     * The nodes are first only matched with the current nodes at the same
+     * place in the graph, which is the common case of an edited scene. This
+     * prevents a new node from taking over an equivalent current node located
+     * elsewhere, which would then be missing for the new node at its place.
+     * The nodes moved around are matched in a second pass.
+     */
+    for (s.positional = 1; s.positional >= 0; s.positional--) {
+        ngli_hmap_freep(&s.merged);
+        s.merged = ngli_hmap_create();
+        if (!s.merged) {
+            ret = NGL_ERROR_MEMORY;
+            goto end;
+        }
+        ret = merge_node(&s, scene, cur_scene, dstp);
+        if (ret < 0)
+            goto end;
+        scene = *dstp;
+    }
+
+    LOG(DEBUG, "%d nodes of the new scene replaced by current ones", s.nb_replaced);
+
+end:
+    ngli_hmap_freep(&s.new_nodes);
+    ngli_hmap_freep(&s.cur_nodes);
+    ngli_hmap_freep(&s.candidates);
+    ngli_hmap_freep(&s.merged);
+    return ret;
+}
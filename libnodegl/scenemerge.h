@@ -0,0 +1,39 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef SCENEMERGE_H
+#define SCENEMERGE_H
+
+#include "nodegl.h"
+
+/*
+ * Merge a new scene with the scene currently attached to a context.
+ *
+ * Every node of the new scene equivalent to a node of the current scene (same
+ * class, same parameters and equivalent children) is replaced in its parents
+ * by the current one, which keeps its initialized state and GPU resources
+ * once the merged scene is attached. The nodes of the new scene are modified
+ * in place, and the merged scene root is returned in dstp (which may be a node
+ * of the current scene).
+ */
+int ngli_scene_merge(struct ngl_node *cur_scene, struct ngl_node *scene, struct ngl_node **dstp);
+
+#endif
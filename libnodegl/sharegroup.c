@@ -0,0 +1,228 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <pthread.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "hmap.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "sharegroup.h"
+#include "utils.h"
+
+struct sharegroup {
+    int refcount;
+    pthread_mutex_t lock;
+    pthread_mutex_t submit_lock;
+
+    /* Protected by the lock */
+    int nb_members;
+    struct hmap *objects;
+};
+
+struct shared_object {
+    uintptr_t handle;
+    int refcount;
+    uint8_t *content;
+    int content_size;
+};
+
+static void free_object(void *user_arg, void *data)
+{
+    struct shared_object *object = data;
+    ngli_free(object->content);
+    ngli_free(object);
+}
+
+struct sharegroup *ngli_sharegroup_create(void)
+{
+    struct sharegroup *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->objects = ngli_hmap_create();
+    if (!s->objects) {
+        ngli_free(s);
+        return NULL;
+    }
+    ngli_hmap_set_free(s->objects, free_object, NULL);
+
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_mutex_init(&s->submit_lock, NULL);
+    s->refcount = 1;
+    s->nb_members = 1;
+    return s;
+}
+
+struct sharegroup *ngli_sharegroup_ref(struct sharegroup *s)
+{
+    pthread_mutex_lock(&s->lock);
+    s->refcount++;
+    s->nb_members++;
+    pthread_mutex_unlock(&s->lock);
+    return s;
+}
+
+void ngli_sharegroup_unrefp(struct sharegroup **sp)
+{
+    struct sharegroup *s = *sp;
+    if (!s)
+        return;
+    *sp = NULL;
+
+    pthread_mutex_lock(&s->lock);
+    const int refcount = --s->refcount;
+    s->nb_members--;
+    pthread_mutex_unlock(&s->lock);
+    if (refcount)
+        return;
+
+    /* All the objects must have been released by their last user */
+    ngli_assert(!ngli_hmap_count(s->objects));
+    ngli_hmap_freep(&s->objects);
+    pthread_mutex_destroy(&s->lock);
+    pthread_mutex_destroy(&s->submit_lock);
+    ngli_free(s);
+}
+
+void ngli_sharegroup_lock(struct sharegroup *s)
+{
+    pthread_mutex_lock(&s->lock);
+}
+
+void ngli_sharegroup_unlock(struct sharegroup *s)
+{
+    pthread_mutex_unlock(&s->lock);
+}
+
+void ngli_sharegroup_lock_submit(struct sharegroup *s)
+{
+    pthread_mutex_lock(&s->submit_lock);
+}
+
+void ngli_sharegroup_unlock_submit(struct sharegroup *s)
+{
+    pthread_mutex_unlock(&s->submit_lock);
+}
+
+int ngli_sharegroup_is_shared(const struct sharegroup *s)
+{
+    return s->nb_members > 1;
+}
+
+uint64_t ngli_sharegroup_hash(const struct sharegroup_chunk *chunks, int nb_chunks)
+{
+    uint64_t h = NGLI_FNV1A_INIT;
+    for (int i = 0; i < nb_chunks; i++) {
+        h = ngli_fnv1a(h, &chunks[i].size, sizeof(chunks[i].size));
+        h = ngli_fnv1a(h, chunks[i].data, chunks[i].size);
+    }
+    return h;
+}
+
+/* The content is stored as the size of each chunk followed by its data */
+static int has_content(const struct shared_object *object,
+                       const struct sharegroup_chunk *chunks, int nb_chunks)
+{
+    const uint8_t *p = object->content;
+    const uint8_t *end = p + object->content_size;
+    for (int i = 0; i < nb_chunks; i++) {
+        const struct sharegroup_chunk *chunk = &chunks[i];
+        if (end - p < (ptrdiff_t)sizeof(chunk->size) + chunk->size ||
+            memcmp(p, &chunk->size, sizeof(chunk->size)) ||
+            (chunk->size && memcmp(p + sizeof(chunk->size), chunk->data, chunk->size)))
+            return 0;
+        p += sizeof(chunk->size) + chunk->size;
+    }
+    return p == end;
+}
+
+/*
+ * Return 1 and take a reference on the object published under key if its
+ * content matches, 0 otherwise
+ */
+int ngli_sharegroup_acquire(struct sharegroup *s, const char *key,
+                            const struct sharegroup_chunk *chunks, int nb_chunks,
+                            uintptr_t *handlep)
+{
+    struct shared_object *object = ngli_hmap_get(s->objects, key);
+    if (!object || !has_content(object, chunks, nb_chunks))
+        return 0;
+    object->refcount++;
+    *handlep = object->handle;
+    return 1;
+}
+
+/*
+ * Return 1 if the object has been published, 0 if another object has
+ * already been published under key, in which case the caller keeps its
+ * object private
+ */
+int ngli_sharegroup_publish(struct sharegroup *s, const char *key,
+                            const struct sharegroup_chunk *chunks, int nb_chunks,
+                            uintptr_t handle)
+{
+    if (ngli_hmap_get(s->objects, key))
+        return 0;
+
+    struct shared_object *object = ngli_calloc(1, sizeof(*object));
+    if (!object)
+        return NGL_ERROR_MEMORY;
+    object->handle = handle;
+    object->refcount = 1;
+
+    for (int i = 0; i < nb_chunks; i++)
+        object->content_size += sizeof(chunks[i].size) + chunks[i].size;
+    object->content = ngli_malloc(object->content_size);
+    if (!object->content) {
+        ngli_free(object);
+        return NGL_ERROR_MEMORY;
+    }
+    uint8_t *p = object->content;
+    for (int i = 0; i < nb_chunks; i++) {
+        memcpy(p, &chunks[i].size, sizeof(chunks[i].size));
+        if (chunks[i].size)
+            memcpy(p + sizeof(chunks[i].size), chunks[i].data, chunks[i].size);
+        p += sizeof(chunks[i].size) + chunks[i].size;
+    }
+
+    int ret = ngli_hmap_set(s->objects, key, object);
+    if (ret < 0) {
+        free_object(NULL, object);
+        return ret;
+    }
+    return 1;
+}
+
+/*
+ * Drop a reference on the object published under key, return 1 if it was the
+ * last one, meaning the caller must destroy the object
+ */
+int ngli_sharegroup_release(struct sharegroup *s, const char *key)
+{
+    struct shared_object *object = ngli_hmap_get(s->objects, key);
+    ngli_assert(object);
+    if (--object->refcount)
+        return 0;
+    ngli_hmap_set(s->objects, key, NULL);
+    return 1;
+}
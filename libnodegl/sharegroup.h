@@ -0,0 +1,82 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef SHAREGROUP_H
+#define SHAREGROUP_H
+
+#include <stdint.h>
+
+/*
+ * Group of graphics contexts sharing their immutable resources.
+ *
+ * Every graphics context holds a reference on a share group: its own, or the
+ * one of the context it has been configured to share its resources with (see
+ * ngl_config.share_ctx). As long as the group has several members, the
+ * backends publish their immutable objects (programs, static buffers and
+ * textures) under a key derived from their content, and the other members
+ * acquire them instead of creating their own copy. The objects are
+ * refcounted and destroyed by the last member releasing them. The objects
+ * created while the context was alone in its group are never shared.
+ *
+ * The group keeps a copy of the content of every published object: an
+ * object is only acquired if its content is identical to the one requested,
+ * so a collision of keys can not make a member use the wrong object.
+ *
+ * The object functions must be called with the group locked. The objects
+ * must be complete and usable by the other contexts when published, which
+ * usually means the backend has to wait for their creation: this must be
+ * done without the group lock held.
+ *
+ * Some state of the shared objects (such as the loose uniforms of a program)
+ * is set right before the draw calls: the members must thus submit their
+ * commands with the group submit lock held.
+ */
+
+#define NGLI_SHAREGROUP_KEY_LEN 48
+
+struct sharegroup;
+
+/* Part of the content of an object */
+struct sharegroup_chunk {
+    const void *data;
+    int size;
+};
+
+struct sharegroup *ngli_sharegroup_create(void);
+struct sharegroup *ngli_sharegroup_ref(struct sharegroup *s);
+void ngli_sharegroup_unrefp(struct sharegroup **sp);
+
+void ngli_sharegroup_lock(struct sharegroup *s);
+void ngli_sharegroup_unlock(struct sharegroup *s);
+void ngli_sharegroup_lock_submit(struct sharegroup *s);
+void ngli_sharegroup_unlock_submit(struct sharegroup *s);
+
+int ngli_sharegroup_is_shared(const struct sharegroup *s);
+uint64_t ngli_sharegroup_hash(const struct sharegroup_chunk *chunks, int nb_chunks);
+int ngli_sharegroup_acquire(struct sharegroup *s, const char *key,
+                            const struct sharegroup_chunk *chunks, int nb_chunks,
+                            uintptr_t *handlep);
+int ngli_sharegroup_publish(struct sharegroup *s, const char *key,
+                            const struct sharegroup_chunk *chunks, int nb_chunks,
+                            uintptr_t handle);
+int ngli_sharegroup_release(struct sharegroup *s, const char *key);
+
+#endif
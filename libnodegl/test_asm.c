@@ -20,8 +20,10 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
+#include "easing.h"
 #include "utils.h"
 #include "math_utils.h"
 
@@ -31,6 +33,13 @@ static void flt_diff(float *dst, const float *a, const float *b, int size)
         dst[i] = a[i] - b[i];
 }
 
+/* Relative difference, for results with large magnitudes */
+static void flt_diff_rel(float *dst, const float *a, const float *b, int size)
+{
+    for (int i = 0; i < size; i++)
+        dst[i] = (a[i] - b[i]) / NGLI_MAX(fabsf(a[i]), 1.f);
+}
+
 static void flt_check(const float *f, int size)
 {
     for (int i = 0; i < size; i++) {
@@ -42,6 +51,89 @@ static void flt_check(const float *f, int size)
     printf("=> OK\n");
 }
 
+typedef void (*mat4_mul_func_type)(float *dst, const float *m1, const float *m2);
+typedef void (*mat4_mul_vec4_func_type)(float *dst, const float *m, const float *v);
+typedef void (*mat3_normal_func_type)(float *dst, const float *m);
+typedef void (*quat_slerp_func_type)(float *dst, const float *q1, const float *q2, float t);
+typedef void (*mix_floats_func_type)(float *dst, const float *a, const float *b, float c, int n);
+typedef void (*ease_poly_func_type)(double *dst, const double *x, int n, int degree, int transform);
+
+struct variant {
+    const char *name;
+    int cpu_flags;
+    void *func;
+};
+
+static const struct variant mat4_mul_variants[] = {
+#if defined(ARCH_AARCH64)
+    {"aarch64", 0,                  ngli_mat4_mul_aarch64},
+#elif defined(ARCH_X86_64)
+    {"sse2",    NGLI_CPU_FLAG_SSE2, ngli_mat4_mul_sse2},
+    {"avx",     NGLI_CPU_FLAG_AVX,  ngli_mat4_mul_avx},
+    {"fma",     NGLI_CPU_FLAG_FMA,  ngli_mat4_mul_fma},
+#endif
+    {NULL}
+};
+
+static const struct variant mat4_mul_vec4_variants[] = {
+#if defined(ARCH_AARCH64)
+    {"aarch64", 0,                  ngli_mat4_mul_vec4_aarch64},
+#elif defined(ARCH_X86_64)
+    {"sse2",    NGLI_CPU_FLAG_SSE2, ngli_mat4_mul_vec4_sse2},
+    {"fma",     NGLI_CPU_FLAG_FMA,  ngli_mat4_mul_vec4_fma},
+#endif
+    {NULL}
+};
+
+static const struct variant mat3_normal_variants[] = {
+#if defined(ARCH_X86_64)
+    {"sse2",    NGLI_CPU_FLAG_SSE2, ngli_mat3_normal_from_mat4_sse2},
+#endif
+    {NULL}
+};
+
+static const struct variant quat_slerp_variants[] = {
+#if defined(ARCH_X86_64)
+    {"sse2",    NGLI_CPU_FLAG_SSE2, ngli_quat_slerp_sse2},
+#endif
+    {NULL}
+};
+
+static const struct variant mix_floats_variants[] = {
+#if defined(ARCH_X86_64)
+    {"sse2",    NGLI_CPU_FLAG_SSE2, ngli_mix_floats_sse2},
+    {"avx",     NGLI_CPU_FLAG_AVX,  ngli_mix_floats_avx},
+    {"fma",     NGLI_CPU_FLAG_FMA,  ngli_mix_floats_fma},
+#endif
+    {NULL}
+};
+
+static const struct variant ease_poly_variants[] = {
+#if defined(ARCH_X86_64)
+    {"sse2",    NGLI_CPU_FLAG_SSE2, ngli_ease_poly_sse2},
+    {"avx",     NGLI_CPU_FLAG_AVX,  ngli_ease_poly_avx},
+#endif
+    {NULL}
+};
+
+static int get_cpu_flags(void)
+{
+#if defined(ARCH_X86_64)
+    return ngli_cpu_get_flags_x86_64();
+#else
+    return 0;
+#endif
+}
+
+static int is_supported(const struct variant *variant, int cpu_flags)
+{
+    if ((variant->cpu_flags & cpu_flags) != variant->cpu_flags) {
+        printf(":: Skipping %s (unsupported by the CPU)\n", variant->name);
+        return 0;
+    }
+    return 1;
+}
+
 int main(void)
 {
     static const NGLI_ALIGNED_MAT(m1) = {
@@ -58,29 +150,60 @@ int main(void)
         6.19681, 5.45165, 0.77647,  0.59262,
     };
 
+    static const float quats[][4] = {
+        { 0.18257,  0.36515, 0.54772, 0.73030},
+        {-0.51450,  0.68599, 0.34300, 0.38590},
+        {-0.18250, -0.36510, -0.54770, -0.73030},
+        { 0.18260,  0.36520, 0.54770, 0.73020},
+    };
+
+    static const NGLI_ALIGNED_MAT(m_singular) = {
+        1.0, 2.0, 3.0, 0.0,
+        2.0, 4.0, 6.0, 0.0,
+        0.5, 1.5, 2.5, 0.0,
+        0.0, 0.0, 0.0, 1.0,
+    };
+
+    const int cpu_flags = get_cpu_flags();
+
     printf("m1:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m1));
     printf("m2:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m2));
 
-    if (ngli_mat4_mul_c != ngli_mat4_mul) {
-        printf(":: Testing mat4 mul\n");
+    for (const struct variant *variant = mat4_mul_variants; variant->name; variant++) {
+        if (!is_supported(variant, cpu_flags))
+            continue;
 
+        printf(":: Testing mat4 mul (%s)\n", variant->name);
+
+        const mat4_mul_func_type mat4_mul = variant->func;
         NGLI_ALIGNED_MAT(m_ref);
         NGLI_ALIGNED_MAT(m_out) = {0};
         NGLI_ALIGNED_MAT(m_diff);
 
         ngli_mat4_mul_c(m_ref, m1, m2);
-        ngli_mat4_mul(m_out, m1, m2);
+        mat4_mul(m_out, m1, m2);
         flt_diff(m_diff, m_ref, m_out, 4*4);
 
         printf("ref:\n"  NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_ref));
         printf("out:\n"  NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_out));
         printf("diff:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_diff));
         flt_check(m_diff, 4*4);
+
+        printf(":: Testing mat4 mul in-place (%s)\n", variant->name);
+
+        memcpy(m_out, m2, sizeof(m_out));
+        mat4_mul(m_out, m1, m_out);
+        flt_diff(m_diff, m_ref, m_out, 4*4);
+        flt_check(m_diff, 4*4);
     }
 
-    if (ngli_mat4_mul_vec4_c != ngli_mat4_mul_vec4) {
+    for (const struct variant *variant = mat4_mul_vec4_variants; variant->name; variant++) {
+        if (!is_supported(variant, cpu_flags))
+            continue;
+
+        const mat4_mul_vec4_func_type mat4_mul_vec4 = variant->func;
         for (int i = 0; i < 4; i++) {
-            printf(":: Testing mat4 mul vec4 %d/4\n", i + 1);
+            printf(":: Testing mat4 mul vec4 %d/4 (%s)\n", i + 1, variant->name);
 
             const float *v = &m2[i * 4];
 
@@ -89,7 +212,7 @@ int main(void)
             NGLI_ALIGNED_VEC(v_diff);
 
             ngli_mat4_mul_vec4_c(v_ref, m1, v);
-            ngli_mat4_mul_vec4(v_out, m1, v);
+            mat4_mul_vec4(v_out, m1, v);
             flt_diff(v_diff, v_ref, v_out, 4);
 
             printf("ref:  " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(v_ref));
@@ -99,5 +222,128 @@ int main(void)
         }
     }
 
+    for (const struct variant *variant = mat3_normal_variants; variant->name; variant++) {
+        if (!is_supported(variant, cpu_flags))
+            continue;
+
+        const mat3_normal_func_type mat3_normal = variant->func;
+        const float *matrices[] = {m1, m2, m_singular};
+        for (int i = 0; i < NGLI_ARRAY_NB(matrices); i++) {
+            printf(":: Testing mat3 normal from mat4 %d/%d (%s)\n", i + 1, NGLI_ARRAY_NB(matrices), variant->name);
+
+            float n_ref[3*3];
+            float n_out[3*3 + 1] = {0};
+            float n_diff[3*3];
+
+            ngli_mat3_normal_from_mat4_c(n_ref, matrices[i]);
+            mat3_normal(n_out, matrices[i]);
+            flt_diff_rel(n_diff, n_ref, n_out, 3*3);
+
+            printf("ref:  " NGLI_FMT_MAT3 "\n", NGLI_ARG_MAT3(n_ref));
+            printf("out:  " NGLI_FMT_MAT3 "\n", NGLI_ARG_MAT3(n_out));
+            flt_check(n_diff, 3*3);
+
+            if (n_out[3*3] != 0.f) {
+                fprintf(stderr, "out of bounds write\n");
+                return 1;
+            }
+        }
+    }
+
+    for (const struct variant *variant = quat_slerp_variants; variant->name; variant++) {
+        if (!is_supported(variant, cpu_flags))
+            continue;
+
+        const quat_slerp_func_type quat_slerp = variant->func;
+        for (int i = 0; i < NGLI_ARRAY_NB(quats); i++) {
+            const float *q1 = quats[i];
+            const float *q2 = quats[(i + 1) % NGLI_ARRAY_NB(quats)];
+            for (int j = 0; j <= 4; j++) {
+                const float t = j / 4.f;
+                printf(":: Testing quat slerp %d/%d t=%g (%s)\n", i + 1, NGLI_ARRAY_NB(quats), t, variant->name);
+
+                NGLI_ALIGNED_VEC(q_ref);
+                NGLI_ALIGNED_VEC(q_out) = {0};
+                NGLI_ALIGNED_VEC(q_diff);
+
+                ngli_quat_slerp_c(q_ref, q1, q2, t);
+                quat_slerp(q_out, q1, q2, t);
+                flt_diff(q_diff, q_ref, q_out, 4);
+
+                printf("ref:  " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(q_ref));
+                printf("out:  " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(q_out));
+                flt_check(q_diff, 4);
+            }
+        }
+    }
+
+    for (const struct variant *variant = mix_floats_variants; variant->name; variant++) {
+        if (!is_supported(variant, cpu_flags))
+            continue;
+
+        const mix_floats_func_type mix_floats = variant->func;
+
+        /* Sizes not multiple of the vector sizes exercise the tails */
+        static const int sizes[] = {1, 3, 4, 7, 8, 16, 29, 64, 131};
+        for (int i = 0; i < NGLI_ARRAY_NB(sizes); i++) {
+            const int n = sizes[i];
+            printf(":: Testing mix floats n=%d (%s)\n", n, variant->name);
+
+            float a[131], b[131], f_ref[131], f_out[131 + 1], f_diff[131];
+            for (int j = 0; j < n; j++) {
+                a[j] = m1[j % 16] * (j + 1);
+                b[j] = m2[j % 16] - j;
+            }
+
+            static const float ratios[] = {0.f, 0.37f, 1.f};
+            for (int r = 0; r < NGLI_ARRAY_NB(ratios); r++) {
+                f_out[n] = 0.f;
+                ngli_mix_floats_c(f_ref, a, b, ratios[r], n);
+                mix_floats(f_out, a, b, ratios[r], n);
+                if (f_out[n] != 0.f) {
+                    fprintf(stderr, "out of bounds write\n");
+                    return 1;
+                }
+                flt_diff_rel(f_diff, f_ref, f_out, n);
+                flt_check(f_diff, n);
+            }
+        }
+    }
+
+    for (const struct variant *variant = ease_poly_variants; variant->name; variant++) {
+        if (!is_supported(variant, cpu_flags))
+            continue;
+
+        const ease_poly_func_type ease_poly = variant->func;
+
+        /* The scalar and vector versions are expected to be bit exact */
+        static const int sizes[] = {1, 3, 4, 7, 8, 16, 29, 64, 131};
+        for (int i = 0; i < NGLI_ARRAY_NB(sizes); i++) {
+            const int n = sizes[i];
+            printf(":: Testing ease poly n=%d (%s)\n", n, variant->name);
+
+            double x[131], d_ref[131], d_out[131 + 1];
+            for (int j = 0; j < n; j++)
+                x[j] = n > 1 ? (double)j / (n - 1) : 0.5;
+
+            for (int degree = 2; degree <= 5; degree++) {
+                for (int transform = NGLI_EASE_IN; transform <= NGLI_EASE_OUT_IN; transform++) {
+                    d_out[n] = 0.0;
+                    ngli_ease_poly_c(d_ref, x, n, degree, transform);
+                    ease_poly(d_out, x, n, degree, transform);
+                    if (d_out[n] != 0.0) {
+                        fprintf(stderr, "out of bounds write\n");
+                        return 1;
+                    }
+                    if (memcmp(d_ref, d_out, n * sizeof(*d_out))) {
+                        fprintf(stderr, "degree %d transform %d mismatch\n", degree, transform);
+                        return 1;
+                    }
+                }
+            }
+            printf("=> OK\n");
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "buffer.h"
+#include "cmdbuffer.h"
+#include "gctx.h"
+#include "gctx_null.h"
+#include "gtimer.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+static int count_cmds(const struct gctx *gctx)
+{
+    const struct gctx_null *gctx_null = (const struct gctx_null *)gctx;
+    return ngli_darray_count(&gctx_null->cmds);
+}
+
+static const struct cmd_null *get_cmd(const struct gctx *gctx, int index)
+{
+    const struct gctx_null *gctx_null = (const struct gctx_null *)gctx;
+    return ngli_darray_get(&gctx_null->cmds, index);
+}
+
+int main(void)
+{
+    struct ngl_ctx *ctx = ngl_create();
+    ngli_assert(ctx);
+
+    struct ngl_config config = {
+        .backend   = NGL_BACKEND_NULL,
+        .offscreen = 1,
+        .width     = 16,
+        .height    = 16,
+    };
+    int ret = ngl_configure(ctx, &config);
+    ngli_assert(ret == 0);
+
+    struct gctx *gctx = ctx->gctx;
+    struct cmdbuffer *cmdbuffer = &gctx->cmdbuffer;
+
+    struct buffer *buffer = ngli_buffer_create(gctx);
+    ngli_assert(buffer);
+    ret = ngli_buffer_init(buffer, 16, NGLI_BUFFER_USAGE_DYNAMIC);
+    ngli_assert(ret == 0);
+
+    struct gtimer *gtimer = ngli_gtimer_create(gctx);
+    ngli_assert(gtimer);
+    ret = ngli_gtimer_init(gtimer);
+    ngli_assert(ret == 0);
+
+    ngli_gctx_reset_counters(gctx);
+    const int64_t serial = cmdbuffer->serial;
+
+    /* Record a frame: nothing reaches the backend until the end */
+    ngli_cmdbuffer_begin(cmdbuffer);
+
+    static const int viewport[4] = {1, 2, 3, 4};
+    ngli_gctx_set_viewport(gctx, viewport);
+    int cur_viewport[4];
+    ngli_gctx_get_viewport(gctx, cur_viewport);
+    ngli_assert(!memcmp(cur_viewport, viewport, sizeof(viewport)));
+
+    ngli_gtimer_start(gtimer);
+    ngli_assert(gctx->timer_active);
+    uint8_t data[16] = {0};
+    ret = ngli_buffer_upload(buffer, data, sizeof(data));
+    ngli_assert(ret == 0);
+    memset(data, 0xff, sizeof(data));
+    ngli_gctx_clear_color(gctx);
+    ngli_gtimer_stop(gtimer);
+    ngli_assert(!gctx->timer_active);
+
+    /* The measure can not be available before the stop is submitted */
+    int64_t duration;
+    ngli_assert(!ngli_gtimer_poll(gtimer, &duration));
+    ngli_assert(count_cmds(gctx) == 0);
+
+    ret = ngli_cmdbuffer_end(cmdbuffer);
+    ngli_assert(ret == 0);
+    ngli_assert(cmdbuffer->serial == serial + 1);
+
+    /* The commands are replayed in the order they were recorded */
+    static const int expected[] = {
+        NGLI_CMD_NULL_SET_VIEWPORT,
+        NGLI_CMD_NULL_BUFFER_UPLOAD,
+        NGLI_CMD_NULL_CLEAR_COLOR,
+    };
+    ngli_assert(count_cmds(gctx) == NGLI_ARRAY_NB(expected));
+    for (int i = 0; i < NGLI_ARRAY_NB(expected); i++)
+        ngli_assert(get_cmd(gctx, i)->type == expected[i]);
+    ngli_assert(!memcmp(get_cmd(gctx, 0)->args, viewport, sizeof(viewport)));
+    ngli_assert(get_cmd(gctx, 1)->object == buffer);
+    ngli_assert(get_cmd(gctx, 1)->args[0] == sizeof(data));
+
+    /* A synchronization submits the pending commands and keeps recording */
+    ngli_gctx_reset_counters(gctx);
+    ngli_cmdbuffer_begin(cmdbuffer);
+    ngli_gctx_clear_color(gctx);
+    ngli_assert(count_cmds(gctx) == 0);
+    ngli_cmdbuffer_sync(cmdbuffer);
+    ngli_assert(count_cmds(gctx) == 1);
+    ngli_assert(cmdbuffer->recording);
+    ngli_gctx_clear_depth_stencil(gctx);
+    ngli_assert(count_cmds(gctx) == 1);
+    ret = ngli_cmdbuffer_end(cmdbuffer);
+    ngli_assert(ret == 0);
+    ngli_assert(count_cmds(gctx) == 2);
+    ngli_assert(get_cmd(gctx, 1)->type == NGLI_CMD_NULL_CLEAR_DEPTH_STENCIL);
+
+    /* A failed replay carries on and reports its first error at the end */
+    ngli_gctx_reset_counters(gctx);
+    ngli_cmdbuffer_begin(cmdbuffer);
+    ret = ngli_buffer_upload_range(buffer, data, 8, sizeof(data));
+    ngli_assert(ret == 0);
+    ngli_gctx_clear_color(gctx);
+    ngli_cmdbuffer_sync(cmdbuffer);
+    ngli_assert(count_cmds(gctx) == 1);
+    ngli_assert(get_cmd(gctx, 0)->type == NGLI_CMD_NULL_CLEAR_COLOR);
+    ngli_gctx_clear_depth_stencil(gctx);
+    ret = ngli_cmdbuffer_end(cmdbuffer);
+    ngli_assert(ret == NGL_ERROR_INVALID_ARG);
+    ngli_assert(count_cmds(gctx) == 2);
+
+    /* The error does not outlive the frame */
+    ngli_cmdbuffer_begin(cmdbuffer);
+    ngli_gctx_clear_color(gctx);
+    ret = ngli_cmdbuffer_end(cmdbuffer);
+    ngli_assert(ret == 0);
+
+    /* Nothing is submitted for an empty frame */
+    const int64_t last_serial = cmdbuffer->serial;
+    ngli_cmdbuffer_begin(cmdbuffer);
+    ret = ngli_cmdbuffer_end(cmdbuffer);
+    ngli_assert(ret == 0);
+    ngli_assert(cmdbuffer->serial == last_serial);
+
+    ngli_gtimer_freep(&gtimer);
+    ngli_buffer_freep(&buffer);
+    ngl_freep(&ctx);
+    return 0;
+}
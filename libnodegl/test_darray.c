@@ -55,6 +55,23 @@ int main(void)
     count = ngli_darray_count(&darray);
     ngli_assert(count == 0);
 
+    for (int i = 0; i < 4; i++)
+        ngli_darray_push(&darray, &i);
+
+    ngli_darray_remove(&darray, 1);
+    ngli_darray_remove(&darray, 4);
+    count = ngli_darray_count(&darray);
+    ngli_assert(count == 3);
+
+    const int *data = ngli_darray_data(&darray);
+    ngli_assert(data[0] == 0 && data[1] == 2 && data[2] == 3);
+
+    ngli_darray_remove(&darray, 2);
+    ngli_darray_remove(&darray, 0);
+    count = ngli_darray_count(&darray);
+    ngli_assert(count == 1);
+    ngli_assert(data[0] == 2);
+
     ngli_darray_reset(&darray);
 
     return 0;
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+
+#include "easing.h"
+#include "math_utils.h"
+#include "nodegl.h"
+#include "utils.h"
+
+static easing_type cubic(easing_type x, int nb_args, const easing_type *args)
+{
+    return x * x * x;
+}
+
+static easing_type back(easing_type x, int nb_args, const easing_type *args)
+{
+    const easing_type s = nb_args > 0 ? args[0] : 1.70158;
+    return x * x * ((s + 1.0) * x - s);
+}
+
+static easing_type wave(easing_type x, int nb_args, const easing_type *args)
+{
+    return x + 0.3 * sin(x * 2.0 * M_PI);
+}
+
+static int nb_evaluations;
+
+static easing_type counted_cubic(easing_type x, int nb_args, const easing_type *args)
+{
+    nb_evaluations++;
+    return cubic(x, nb_args, args);
+}
+
+static void test_solve(void)
+{
+    /*
+     * A monotonic easing is only coarsely subdivided, requiring fewer
+     * evaluations than a uniform sampling at the solver resolution (1/128)
+     */
+    double x;
+    ngli_assert(ngli_easing_solve_numeric(counted_cubic, 0, NULL, 0., 1., 0.3, &x) == 0);
+    ngli_assert(fabs(x - cbrt(0.3)) < 1e-9);
+    ngli_assert(nb_evaluations < 64);
+
+    for (int i = 0; i <= 100; i++) {
+        const double v = i / 100.;
+        ngli_assert(ngli_easing_solve_numeric(cubic, 0, NULL, 0., 1., v, &x) == 0);
+        ngli_assert(fabs(x - cbrt(v)) < 1e-9);
+    }
+
+    /* back reaches -0.05 twice around its minimum at 2s/3(s+1), the first root is returned */
+    const easing_type arg = 1.70158;
+    ngli_assert(ngli_easing_solve_numeric(back, 1, &arg, 0., 1., -0.05, &x) == 0);
+    ngli_assert(fabs(back(x, 1, &arg) + 0.05) < 1e-9);
+    ngli_assert(x < 2. * arg / (3. * (arg + 1.)));
+
+    /* wave crosses 0.5 several times */
+    ngli_assert(ngli_easing_solve_numeric(wave, 0, NULL, 0., 1., 0.5, &x) == 0);
+    ngli_assert(fabs(wave(x, 0, NULL) - 0.5) < 1e-9);
+    ngli_assert(x < 0.25);
+
+    /* restricted domain and unreachable value */
+    ngli_assert(ngli_easing_solve_numeric(cubic, 0, NULL, 0.5, 1., 0.5, &x) == 0);
+    ngli_assert(x >= 0.5 && fabs(x - cbrt(0.5)) < 1e-9);
+    ngli_assert(ngli_easing_solve_numeric(cubic, 0, NULL, 0., 1., 2., &x) < 0);
+}
+
+static void test_lut(easing_function f, double x0, double x1, double tolerance)
+{
+    struct easing_lut lut = {0};
+    ngli_assert(ngli_easing_lut_init(&lut, f, 0, NULL, x0, x1, tolerance) == 0);
+
+    const int nb_probes = 10007;
+    for (int i = 0; i <= nb_probes; i++) {
+        const double x = x0 + (x1 - x0) * i / nb_probes;
+        ngli_assert(fabs(ngli_easing_lut_evaluate(&lut, x) - f(x, 0, NULL)) <= tolerance * 1.01);
+    }
+
+    ngli_easing_lut_reset(&lut);
+    ngli_assert(!lut.samples);
+}
+
+int main(void)
+{
+    test_solve();
+
+    test_lut(cubic, 0., 1., 1e-3);
+    test_lut(cubic, 0., 1., 1e-6);
+    test_lut(back,  0.2, 0.9, 1e-4);
+    test_lut(wave,  0., 1., 1e-5);
+
+    struct easing_lut lut = {0};
+    ngli_assert(ngli_easing_lut_init(&lut, wave, 0, NULL, 0., 1., 1e-15) == NGL_ERROR_LIMIT_EXCEEDED);
+    ngli_assert(!lut.samples);
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gctx_null.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+static const char * const vertex =
+    "void main()\n"
+    "{\n"
+    "    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * ngl_position;\n"
+    "}\n";
+
+static const char * const fragment =
+    "void main()\n"
+    "{\n"
+    "    ngl_out_color = color;\n"
+    "}\n";
+
+static const struct cmd_null *get_cmds(const struct ngl_ctx *ctx, int *nb_cmds)
+{
+    const struct gctx_null *gctx_null = (const struct gctx_null *)ctx->gctx;
+    *nb_cmds = ngli_darray_count(&gctx_null->cmds);
+    return ngli_darray_data(&gctx_null->cmds);
+}
+
+static int count_cmds(const struct ngl_ctx *ctx, int type)
+{
+    int nb_cmds, count = 0;
+    const struct cmd_null *cmds = get_cmds(ctx, &nb_cmds);
+    for (int i = 0; i < nb_cmds; i++)
+        count += cmds[i].type == type;
+    return count;
+}
+
+static const struct cmd_null *find_cmd(const struct ngl_ctx *ctx, int type)
+{
+    int nb_cmds;
+    const struct cmd_null *cmds = get_cmds(ctx, &nb_cmds);
+    for (int i = 0; i < nb_cmds; i++)
+        if (cmds[i].type == type)
+            return &cmds[i];
+    return NULL;
+}
+
+static struct ngl_node *create_scene(int nb_renders)
+{
+    struct ngl_node *program = ngl_node_create(NGL_NODE_PROGRAM);
+    struct ngl_node *color   = ngl_node_create(NGL_NODE_UNIFORMVEC4);
+    struct ngl_node *quad    = ngl_node_create(NGL_NODE_QUAD);
+    struct ngl_node *group   = ngl_node_create(NGL_NODE_GROUP);
+    ngli_assert(program && color && quad && group);
+    ngli_assert(ngl_node_param_set(program, "vertex", vertex) == 0);
+    ngli_assert(ngl_node_param_set(program, "fragment", fragment) == 0);
+
+    for (int i = 0; i < nb_renders; i++) {
+        struct ngl_node *render = ngl_node_create(NGL_NODE_RENDER);
+        struct ngl_node *translate = ngl_node_create(NGL_NODE_TRANSLATE);
+        ngli_assert(render && translate);
+        const float vector[3] = {i * 0.1f, 0.f, 0.f};
+        ngli_assert(ngl_node_param_set(render, "geometry", quad) == 0);
+        ngli_assert(ngl_node_param_set(render, "program", program) == 0);
+        ngli_assert(ngl_node_param_set(render, "frag_resources", "color", color) == 0);
+        ngli_assert(ngl_node_param_set(translate, "child", render) == 0);
+        ngli_assert(ngl_node_param_set(translate, "vector", vector) == 0);
+        ngli_assert(ngl_node_param_add(group, "children", 1, &translate) == 0);
+        ngl_node_unrefp(&translate);
+        ngl_node_unrefp(&render);
+    }
+
+    ngl_node_unrefp(&quad);
+    ngl_node_unrefp(&color);
+    ngl_node_unrefp(&program);
+    return group;
+}
+
+int main(void)
+{
+    struct ngl_ctx *ctx = ngl_create();
+    ngli_assert(ctx);
+
+    struct ngl_config config = {
+        .backend   = NGL_BACKEND_NULL,
+        .offscreen = 1,
+        .width     = 16,
+        .height    = 16,
+    };
+    int ret = ngl_configure(ctx, &config);
+    ngli_assert(ret == 0);
+
+    static const int nb_renders = 3;
+    struct ngl_node *scene = create_scene(nb_renders);
+    ret = ngl_set_scene(ctx, scene);
+    ngli_assert(ret == 0);
+    ngl_node_unrefp(&scene);
+
+    /* The frame starts with the clear of the default render target */
+    ret = ngl_draw(ctx, 0.0);
+    ngli_assert(ret == 0);
+    int nb_cmds;
+    const struct cmd_null *cmds = get_cmds(ctx, &nb_cmds);
+    ngli_assert(nb_cmds >= 3);
+    ngli_assert(cmds[0].type == NGLI_CMD_NULL_CLEAR_COLOR);
+    ngli_assert(cmds[1].type == NGLI_CMD_NULL_CLEAR_DEPTH_STENCIL);
+
+    /*
+     * The sibling renders are batched into a single instanced draw of the
+     * quad, the modelview matrices of the members being uploaded once
+     */
+    ngli_assert(count_cmds(ctx, NGLI_CMD_NULL_DRAW) == 1);
+    const struct cmd_null *draw = find_cmd(ctx, NGLI_CMD_NULL_DRAW);
+    ngli_assert(draw == &cmds[nb_cmds - 1]);
+    ngli_assert(draw->args[0] == 4 && draw->args[1] == nb_renders);
+    ngli_assert(count_cmds(ctx, NGLI_CMD_NULL_BUFFER_UPLOAD) == 1);
+    const struct cmd_null *upload = find_cmd(ctx, NGLI_CMD_NULL_BUFFER_UPLOAD);
+    ngli_assert(upload->args[0] == nb_renders * 16 * sizeof(float));
+
+    /* Nothing changed: the same draw is submitted without any upload */
+    ret = ngl_draw(ctx, 1.0);
+    ngli_assert(ret == 0);
+    ngli_assert(count_cmds(ctx, NGLI_CMD_NULL_DRAW) == 1);
+    ngli_assert(find_cmd(ctx, NGLI_CMD_NULL_DRAW)->args[1] == nb_renders);
+    ngli_assert(count_cmds(ctx, NGLI_CMD_NULL_BUFFER_UPLOAD) == 0);
+
+    struct ngl_stats stats;
+    ret = ngl_get_stats(ctx, &stats);
+    ngli_assert(ret == 0);
+    get_cmds(ctx, &nb_cmds);
+    ngli_assert(stats.nb_api_calls == nb_cmds);
+
+    /* No job was large enough to be split, so no thread was spawned */
+    ngli_assert(!ctx->threadpool);
+
+    ngl_freep(&ctx);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "geompool.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+#define NB_VERTICES 64 /* 768 bytes per geometry, already aligned */
+
+static struct ngl_node *ref_geometry(struct ngl_ctx *ctx, float value)
+{
+    float data[NB_VERTICES * 3];
+    for (int i = 0; i < NGLI_ARRAY_NB(data); i++)
+        data[i] = value;
+    struct ngl_node *node = ngli_geompool_ref(&ctx->geompool, ctx, NGL_NODE_BUFFERVEC3,
+                                              NB_VERTICES, sizeof(data), data);
+    ngli_assert(node);
+    return node;
+}
+
+static struct ngl_node *ref_large_geometry(struct ngl_ctx *ctx, float value)
+{
+    float data[NB_VERTICES * 2 * 3];
+    for (int i = 0; i < NGLI_ARRAY_NB(data); i++)
+        data[i] = value;
+    struct ngl_node *node = ngli_geompool_ref(&ctx->geompool, ctx, NGL_NODE_BUFFERVEC3,
+                                              NB_VERTICES * 2, sizeof(data), data);
+    ngli_assert(node);
+    return node;
+}
+
+static const struct buffer *get_buffer(const struct ngl_node *node)
+{
+    const struct buffer_priv *s = node->priv_data;
+    return s->buffer;
+}
+
+static int get_offset(const struct ngl_node *node)
+{
+    const struct buffer_priv *s = node->priv_data;
+    return s->buffer_offset;
+}
+
+int main(void)
+{
+    struct ngl_ctx *ctx = ngl_create();
+    ngli_assert(ctx);
+
+    struct ngl_config config = {
+        .backend   = NGL_BACKEND_NULL,
+        .offscreen = 1,
+        .width     = 16,
+        .height    = 16,
+    };
+    int ret = ngl_configure(ctx, &config);
+    ngli_assert(ret == 0);
+
+    /* Identical geometries are shared */
+    struct ngl_node *a = ref_geometry(ctx, 1.f);
+    struct ngl_node *a2 = ref_geometry(ctx, 1.f);
+    ngli_assert(a == a2);
+    ngli_geompool_unref(&ctx->geompool, &a2);
+
+    /* Different geometries are packed in the same arena */
+    struct ngl_node *b = ref_geometry(ctx, 2.f);
+    struct ngl_node *c = ref_geometry(ctx, 3.f);
+    struct ngl_node *d = ref_geometry(ctx, 4.f);
+    const struct buffer *arena = get_buffer(a);
+    ngli_assert(arena && get_buffer(b) == arena && get_buffer(c) == arena && get_buffer(d) == arena);
+    const int size = get_offset(b) - get_offset(a);
+    ngli_assert(get_offset(a) == 0 && size > 0);
+    ngli_assert(get_offset(c) == 2 * size && get_offset(d) == 3 * size);
+
+    /* A released range in the middle of the arena is recycled */
+    const int offset_b = get_offset(b);
+    ngli_geompool_unref(&ctx->geompool, &b);
+    struct ngl_node *e = ref_geometry(ctx, 5.f);
+    ngli_assert(get_buffer(e) == arena && get_offset(e) == offset_b);
+
+    /* Adjacent released ranges are merged to fit a larger geometry */
+    ngli_geompool_unref(&ctx->geompool, &a);
+    ngli_geompool_unref(&ctx->geompool, &e);
+    struct ngl_node *f = ref_large_geometry(ctx, 6.f);
+    ngli_assert(get_buffer(f) == arena && get_offset(f) == 0);
+
+    /* A released range at the end of the arena is given back to its tail */
+    ngli_geompool_unref(&ctx->geompool, &d);
+    struct ngl_node *g = ref_large_geometry(ctx, 7.f);
+    ngli_assert(get_buffer(g) == arena && get_offset(g) == 3 * size);
+
+    ngli_geompool_unref(&ctx->geompool, &c);
+    ngli_geompool_unref(&ctx->geompool, &f);
+    ngli_geompool_unref(&ctx->geompool, &g);
+
+    /* The arena is released with its last geometry and its ranges start over */
+    struct ngl_node *h = ref_geometry(ctx, 8.f);
+    ngli_assert(get_offset(h) == 0);
+    ngli_geompool_unref(&ctx->geompool, &h);
+
+    ngl_freep(&ctx);
+    return 0;
+}
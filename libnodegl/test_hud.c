@@ -0,0 +1,178 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define _POSIX_C_SOURCE 200809L // mkfifo()
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "nodegl.h"
+#include "utils.h"
+
+static struct ngl_ctx *create_ctx(struct ngl_config *config)
+{
+    struct ngl_ctx *ctx = ngl_create();
+    ngli_assert(ctx);
+    config->backend   = NGL_BACKEND_NULL;
+    config->offscreen = 1;
+    config->width     = 64;
+    config->height    = 64;
+    int ret = ngl_configure(ctx, config);
+    ngli_assert(ret == 0);
+    return ctx;
+}
+
+static struct ngl_node *create_hud(const char *export_filename)
+{
+    struct ngl_node *group = ngl_node_create(NGL_NODE_GROUP);
+    struct ngl_node *hud = ngl_node_create(NGL_NODE_HUD);
+    ngli_assert(group && hud);
+    int ret = ngl_node_param_set(hud, "child", group);
+    ngli_assert(ret == 0);
+    ngl_node_unrefp(&group);
+    if (export_filename) {
+        ret = ngl_node_param_set(hud, "export_filename", export_filename);
+        ngli_assert(ret == 0);
+    }
+    return hud;
+}
+
+static int set_hud_scene(struct ngl_ctx *ctx, const char *export_filename)
+{
+    struct ngl_node *hud = create_hud(export_filename);
+    int ret = ngl_set_scene(ctx, hud);
+    ngl_node_unrefp(&hud);
+    return ret;
+}
+
+static void collect_line(void *arg, const char *line)
+{
+    int *nb_lines = arg;
+    ngli_assert(line[strlen(line) - 1] == '\n');
+    if (!*nb_lines)
+        ngli_assert(!strncmp(line, "time,", 5));
+    (*nb_lines)++;
+}
+
+/* The export callback receives the header then one line per refresh */
+static void test_export_callback(void)
+{
+    int nb_lines = 0;
+    struct ngl_config config = {
+        .hud_export_callback = collect_line,
+        .hud_export_arg      = &nb_lines,
+    };
+    struct ngl_ctx *ctx = create_ctx(&config);
+    int ret = set_hud_scene(ctx, NULL);
+    ngli_assert(ret == 0);
+    ngli_assert(nb_lines == 1);
+    for (int i = 0; i < 10; i++) {
+        ret = ngl_draw(ctx, i / 60.);
+        ngli_assert(ret == 0);
+    }
+    ngli_assert(nb_lines == 11);
+
+    /* No canvas is uploaded in headless mode */
+    struct ngl_stats stats;
+    ret = ngl_get_stats(ctx, &stats);
+    ngli_assert(ret == 0);
+    ngli_assert(stats.texture_upload_size == 0);
+    ngl_freep(&ctx);
+}
+
+/* Only the modified canvas areas are uploaded after the first refresh */
+static void test_dirty_rects(void)
+{
+    struct ngl_config config = {0};
+    struct ngl_ctx *ctx = create_ctx(&config);
+    int ret = set_hud_scene(ctx, NULL);
+    ngli_assert(ret == 0);
+
+    struct ngl_stats stats;
+    ret = ngl_draw(ctx, 0.);
+    ngli_assert(ret == 0);
+    ret = ngl_get_stats(ctx, &stats);
+    ngli_assert(ret == 0);
+    const int64_t full_upload_size = stats.texture_upload_size;
+    ngli_assert(full_upload_size > 0);
+
+    for (int i = 1; i < 10; i++) {
+        ret = ngl_draw(ctx, i / 60.);
+        ngli_assert(ret == 0);
+        ret = ngl_get_stats(ctx, &stats);
+        ngli_assert(ret == 0);
+        ngli_assert(stats.texture_upload_size > 0);
+        ngli_assert(stats.texture_upload_size < full_upload_size);
+    }
+    ngl_freep(&ctx);
+}
+
+/* A named pipe reader going away disables the export without interrupting the rendering */
+static void test_export_pipe(const char *fifo)
+{
+    struct ngl_config config = {0};
+    struct ngl_ctx *ctx = create_ctx(&config);
+
+    (void)unlink(fifo);
+    int ret = mkfifo(fifo, 0600);
+    ngli_assert(ret == 0);
+
+    /* Without a reader, the open fails instead of blocking */
+    ret = set_hud_scene(ctx, fifo);
+    ngli_assert(ret < 0);
+
+    int fd = open(fifo, O_RDONLY | O_NONBLOCK);
+    ngli_assert(fd != -1);
+    ret = set_hud_scene(ctx, fifo);
+    ngli_assert(ret == 0);
+    ret = ngl_draw(ctx, 0.);
+    ngli_assert(ret == 0);
+
+    char buf[4096];
+    ngli_assert(read(fd, buf, sizeof(buf)) > 0);
+    close(fd);
+
+    for (int i = 1; i < 10; i++) {
+        ret = ngl_draw(ctx, i / 60.);
+        ngli_assert(ret == 0);
+    }
+
+    ngl_freep(&ctx);
+    ret = unlink(fifo);
+    ngli_assert(ret == 0);
+}
+
+int main(int ac, char **av)
+{
+    if (ac != 2) {
+        fprintf(stderr, "Usage: %s <fifo.csv>\n", av[0]);
+        return EXIT_FAILURE;
+    }
+
+    test_export_callback();
+    test_dirty_rects();
+    test_export_pipe(av[1]);
+    return 0;
+}
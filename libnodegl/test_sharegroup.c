@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "sharegroup.h"
+#include "utils.h"
+
+int main(void)
+{
+    struct sharegroup *s = ngli_sharegroup_create();
+    ngli_assert(s);
+    ngli_assert(!ngli_sharegroup_is_shared(s));
+
+    struct sharegroup *ref = ngli_sharegroup_ref(s);
+    ngli_assert(ngli_sharegroup_is_shared(s));
+
+    static const char key[] = "object:0";
+    const struct sharegroup_chunk content[] = {{"ab", 2}, {"c", 1}};
+    const struct sharegroup_chunk moved[]   = {{"a", 1}, {"bc", 2}};
+    const struct sharegroup_chunk other[]   = {{"ab", 2}, {"d", 1}};
+    const struct sharegroup_chunk longer[]  = {{"ab", 2}, {"c", 1}, {"", 0}};
+    ngli_assert(ngli_sharegroup_hash(content, 2) != ngli_sharegroup_hash(moved, 2));
+
+    uintptr_t handle = 0;
+    ngli_sharegroup_lock(s);
+    ngli_assert(ngli_sharegroup_acquire(s, key, content, 2, &handle) == 0);
+    ngli_assert(ngli_sharegroup_publish(s, key, content, 2, 42) == 1);
+
+    /* Only an identical content acquires the object */
+    ngli_assert(ngli_sharegroup_acquire(s, key, moved, 2, &handle) == 0);
+    ngli_assert(ngli_sharegroup_acquire(s, key, other, 2, &handle) == 0);
+    ngli_assert(ngli_sharegroup_acquire(s, key, longer, 3, &handle) == 0);
+    ngli_assert(ngli_sharegroup_acquire(s, key, content, 1, &handle) == 0);
+    ngli_assert(handle == 0);
+    ngli_assert(ngli_sharegroup_acquire(s, key, content, 2, &handle) == 1);
+    ngli_assert(handle == 42);
+
+    /* A colliding object stays private */
+    ngli_assert(ngli_sharegroup_publish(s, key, other, 2, 43) == 0);
+
+    ngli_assert(ngli_sharegroup_release(s, key) == 0);
+    ngli_assert(ngli_sharegroup_release(s, key) == 1);
+    ngli_assert(ngli_sharegroup_acquire(s, key, content, 2, &handle) == 0);
+    ngli_sharegroup_unlock(s);
+
+    ngli_sharegroup_unrefp(&ref);
+    ngli_assert(!ngli_sharegroup_is_shared(s));
+    ngli_sharegroup_unrefp(&s);
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "threadpool.h"
+#include "utils.h"
+
+#define NB_VALUES 10007
+
+struct job_data {
+    int values[NB_VALUES];
+    int nb_calls[64];
+};
+
+static void job_func(void *arg, int job_id, int nb_jobs)
+{
+    struct job_data *s = arg;
+    const int chunk_size = NB_VALUES / nb_jobs;
+    const int start = job_id * chunk_size;
+    const int end = job_id == nb_jobs - 1 ? NB_VALUES : start + chunk_size;
+    for (int i = start; i < end; i++)
+        s->values[i] += i;
+    s->nb_calls[job_id]++;
+}
+
+int main(void)
+{
+    static struct job_data data;
+
+    for (int nb_threads = 1; nb_threads <= 4; nb_threads++) {
+        struct threadpool *threadpool = ngli_threadpool_create(nb_threads);
+        ngli_assert(threadpool);
+        ngli_assert(ngli_threadpool_get_nb_threads(threadpool) == nb_threads);
+
+        for (int nb_jobs = 1; nb_jobs <= 64; nb_jobs++) {
+            memset(&data, 0, sizeof(data));
+
+            /* Executing twice checks the pool is reusable */
+            ngli_threadpool_execute(threadpool, job_func, &data, nb_jobs);
+            ngli_threadpool_execute(threadpool, job_func, &data, nb_jobs);
+
+            for (int i = 0; i < NB_VALUES; i++)
+                ngli_assert(data.values[i] == 2 * i);
+            for (int i = 0; i < NGLI_ARRAY_NB(data.nb_calls); i++)
+                ngli_assert(data.nb_calls[i] == (i < nb_jobs ? 2 : 0));
+        }
+
+        ngli_threadpool_freep(&threadpool);
+        ngli_assert(!threadpool);
+    }
+
+    ngli_assert(ngli_threadpool_get_nb_cpus() >= 1);
+
+    return 0;
+}
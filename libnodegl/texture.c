@@ -19,7 +19,9 @@
  * under the License.
  */
 
+#include "format.h"
 #include "gctx.h"
+#include "nodes.h"
 #include "texture.h"
 
 struct texture *ngli_texture_create(struct gctx *gctx)
@@ -27,9 +29,51 @@ struct texture *ngli_texture_create(struct gctx *gctx)
     return gctx->class->texture_create(gctx);
 }
 
+static int64_t get_memory_size(const struct texture *s)
+{
+    const struct texture_params *params = &s->params;
+    int64_t size = (int64_t)params->width * params->height * NGLI_MAX(params->depth, 1)
+                 * ngli_format_get_bytes_per_pixel(params->format) * NGLI_MAX(params->samples, 1);
+    if (params->type == NGLI_TEXTURE_TYPE_CUBE)
+        size *= 6;
+    /* The whole mipmap chain adds up to a third of the base level */
+    if (params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
+        size += size / 3;
+    return size;
+}
+
 int ngli_texture_init(struct texture *s, const struct texture_params *params)
 {
-    return s->gctx->class->texture_init(s, params);
+    struct gctx *gctx = s->gctx;
+    int ret = gctx->class->texture_init(s, params);
+    if (ret < 0)
+        return ret;
+
+    /* The storage of external textures is not allocated by node.gl */
+    if (s->external_storage)
+        return 0;
+
+    const int category = (params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY) ? NGLI_MEMTRACK_ATTACHMENT
+                                                                              : NGLI_MEMTRACK_TEXTURE;
+    return ngli_memtrack_add(&gctx->memtrack, &s->mem, gctx->ctx->cur_node, category, get_memory_size(s));
+}
+
+int ngli_texture_init_shared(struct texture *s,
+                             const struct texture_params *params,
+                             const uint8_t *data)
+{
+    struct gctx *gctx = s->gctx;
+    if (!gctx->class->texture_init_shared) {
+        int ret = ngli_texture_init(s, params);
+        if (ret < 0)
+            return ret;
+        return ngli_texture_upload(s, data, 0);
+    }
+
+    int ret = gctx->class->texture_init_shared(s, params, data);
+    if (ret < 0)
+        return ret;
+    return ngli_memtrack_add(&gctx->memtrack, &s->mem, gctx->ctx->cur_node, NGLI_MEMTRACK_TEXTURE, get_memory_size(s));
 }
 
 int ngli_texture_has_mipmap(const struct texture *s)
@@ -44,17 +88,35 @@ int ngli_texture_match_dimensions(const struct texture *s, int width, int height
 
 int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize)
 {
-    return s->gctx->class->texture_upload(s, data, linesize);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        return ngli_cmdbuffer_texture_upload(&gctx->cmdbuffer, s, data, linesize);
+    return gctx->class->texture_upload(s, data, linesize);
+}
+
+int ngli_texture_upload_rect(struct texture *s, const uint8_t *data, int linesize,
+                             int x, int y, int width, int height)
+{
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        return ngli_cmdbuffer_texture_upload_rect(&gctx->cmdbuffer, s, data, linesize, x, y, width, height);
+    return gctx->class->texture_upload_rect(s, data, linesize, x, y, width, height);
 }
 
 int ngli_texture_generate_mipmap(struct texture *s)
 {
-    return s->gctx->class->texture_generate_mipmap(s);
+    struct gctx *gctx = s->gctx;
+    if (gctx->cmdbuffer.recording)
+        return ngli_cmdbuffer_texture_generate_mipmap(&gctx->cmdbuffer, s);
+    return gctx->class->texture_generate_mipmap(s);
 }
 
 void ngli_texture_freep(struct texture **sp)
 {
     if (!*sp)
         return;
-    (*sp)->gctx->class->texture_freep(sp);
+    struct gctx *gctx = (*sp)->gctx;
+    ngli_cmdbuffer_sync(&gctx->cmdbuffer);
+    ngli_memtrack_remove(&gctx->memtrack, &(*sp)->mem);
+    gctx->class->texture_freep(sp);
 }
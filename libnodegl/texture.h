@@ -22,6 +22,7 @@
 #ifndef TEXTURE_H
 #define TEXTURE_H
 
+#include "memtrack.h"
 #include "utils.h"
 
 struct gctx;
@@ -103,6 +104,7 @@ struct texture {
     int wrapped;
     int external_storage;
     int bytes_per_pixel;
+    struct memtrack_entry mem;
 };
 
 struct texture *ngli_texture_create(struct gctx *gctx);
@@ -110,10 +112,26 @@ struct texture *ngli_texture_create(struct gctx *gctx);
 int ngli_texture_init(struct texture *s,
                       const struct texture_params *params);
 
+/*
+ * Initialize the texture and upload its final content, which must not be
+ * changed afterwards; this allows the texture to be shared with the other
+ * contexts of the share group holding the same content.
+ */
+int ngli_texture_init_shared(struct texture *s,
+                             const struct texture_params *params,
+                             const uint8_t *data);
+
 int ngli_texture_has_mipmap(const struct texture *s);
 int ngli_texture_match_dimensions(const struct texture *s, int width, int height, int depth);
 
 int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize);
+/*
+ * Upload a sub-rectangle of a 2D texture; linesize is expressed in pixels.
+ * Unlike ngli_texture_upload(), mipmaps are not regenerated so that callers
+ * can batch several rectangles before calling ngli_texture_generate_mipmap().
+ */
+int ngli_texture_upload_rect(struct texture *s, const uint8_t *data, int linesize,
+                             int x, int y, int width, int height);
 int ngli_texture_generate_mipmap(struct texture *s);
 
 void ngli_texture_freep(struct texture **sp);
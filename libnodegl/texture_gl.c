@@ -19,10 +19,13 @@
  * under the License.
  */
 
+#include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "log.h"
 #include "utils.h"
+#include "format.h"
 #include "format_gl.h"
 #include "gctx_gl.h"
 #include "glincludes.h"
@@ -318,6 +321,15 @@ static int is_pow2(int x)
     return x && !(x & (x - 1));
 }
 
+static int is_mipmap_supported(const struct texture *s)
+{
+    const struct gctx_gl *gctx_gl = (const struct gctx_gl *)s->gctx;
+    const struct glcontext *gl = gctx_gl->glcontext;
+    const struct texture_params *params = &s->params;
+    return (gl->features & NGLI_FEATURE_TEXTURE_NPOT) ||
+           (is_pow2(params->width) && is_pow2(params->height));
+}
+
 struct texture *ngli_texture_gl_create(struct gctx *gctx)
 {
     struct texture_gl *s = ngli_calloc(1, sizeof(*s));
@@ -346,9 +358,7 @@ int ngli_texture_gl_init(struct texture *s, const struct texture_params *params)
     } else {
         ngli_glGenTextures(gl, 1, &s_priv->id);
         ngli_glBindTexture(gl, s_priv->target, s_priv->id);
-        if (s->params.mipmap_filter &&
-            !(gl->features & NGLI_FEATURE_TEXTURE_NPOT) &&
-            (!is_pow2(params->width) || !is_pow2(params->height))) {
+        if (s->params.mipmap_filter && !is_mipmap_supported(s)) {
             LOG(WARNING, "context does not support non-power of two textures, "
                 "mipmapping will be disabled");
             s->params.mipmap_filter = NGLI_MIPMAP_FILTER_NONE;
@@ -383,6 +393,71 @@ int ngli_texture_gl_init(struct texture *s, const struct texture_params *params)
     return 0;
 }
 
+int ngli_texture_gl_init_shared(struct texture *s,
+                                const struct texture_params *params,
+                                const uint8_t *data)
+{
+    struct texture_gl *s_priv = (struct texture_gl *)s;
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    struct sharegroup *sharegroup = s->gctx->sharegroup;
+
+    int data_size = params->width * params->height * NGLI_MAX(params->depth, 1)
+                  * ngli_format_get_bytes_per_pixel(params->format);
+    if (params->type == NGLI_TEXTURE_TYPE_CUBE)
+        data_size *= 6;
+    const struct sharegroup_chunk chunks[] = {
+        {params, sizeof(*params)},
+        {data, data_size},
+    };
+    char key[NGLI_SHAREGROUP_KEY_LEN];
+
+    ngli_sharegroup_lock(sharegroup);
+    const int shared = ngli_sharegroup_is_shared(sharegroup);
+    if (shared) {
+        snprintf(key, sizeof(key), "texture:%016" PRIx64,
+                 ngli_sharegroup_hash(chunks, NGLI_ARRAY_NB(chunks)));
+
+        uintptr_t handle;
+        if (ngli_sharegroup_acquire(sharegroup, key, chunks, NGLI_ARRAY_NB(chunks), &handle)) {
+            s->params = *params;
+            int ret = texture_init_fields(s);
+            if (ret < 0) {
+                ngli_sharegroup_release(sharegroup, key);
+                ngli_sharegroup_unlock(sharegroup);
+                return ret;
+            }
+            ngli_sharegroup_unlock(sharegroup);
+            if (s->params.mipmap_filter && !is_mipmap_supported(s))
+                s->params.mipmap_filter = NGLI_MIPMAP_FILTER_NONE;
+            s_priv->id = (GLuint)handle;
+            snprintf(s_priv->share_key, sizeof(s_priv->share_key), "%s", key);
+            return 0;
+        }
+    }
+    ngli_sharegroup_unlock(sharegroup);
+
+    int ret = ngli_texture_gl_init(s, params);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_texture_gl_upload(s, data, 0);
+    if (ret < 0 || !shared)
+        return ret;
+
+    /* The upload must be complete before the texture is used by another context */
+    ngli_glFinish(gl);
+
+    ngli_sharegroup_lock(sharegroup);
+    ret = ngli_sharegroup_publish(sharegroup, key, chunks, NGLI_ARRAY_NB(chunks), s_priv->id);
+    ngli_sharegroup_unlock(sharegroup);
+    if (ret < 0)
+        return ret;
+    if (ret)
+        snprintf(s_priv->share_key, sizeof(s_priv->share_key), "%s", key);
+    return 0;
+}
+
 int ngli_texture_gl_wrap(struct texture *s,
                          const struct texture_params *params,
                          GLuint texture)
@@ -432,6 +507,15 @@ int ngli_texture_gl_match_dimensions(const struct texture *s, int width, int hei
     return params->width == width && params->height == height && params->depth == depth;
 }
 
+static void require_update_barrier(struct texture *s)
+{
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    const struct texture_gl *s_priv = (struct texture_gl *)s;
+    ngli_memorybarrier_gl_require(&gctx_gl->memorybarrier, gl, s_priv->last_shader_write, GL_TEXTURE_UPDATE_BARRIER_BIT);
+    ngli_memorybarrier_gl_flush(&gctx_gl->memorybarrier, gl);
+}
+
 int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize)
 {
     struct texture_gl *s_priv = (struct texture_gl *)s;
@@ -443,6 +527,7 @@ int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize)
      * buffers) cannot update their content with this function */
     ngli_assert(!s->external_storage && !(params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY));
 
+    require_update_barrier(s);
     ngli_glBindTexture(gl, s_priv->target, s_priv->id);
     if (data) {
         texture_set_sub_image(s, data, linesize);
@@ -454,6 +539,45 @@ int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize)
     return 0;
 }
 
+int ngli_texture_gl_upload_rect(struct texture *s, const uint8_t *data, int linesize,
+                                int x, int y, int width, int height)
+{
+    struct texture_gl *s_priv = (struct texture_gl *)s;
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    const struct texture_params *params = &s->params;
+
+    ngli_assert(!s->external_storage && !(params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY));
+    ngli_assert(s_priv->target == GL_TEXTURE_2D);
+    ngli_assert(x >= 0 && y >= 0 && x + width <= params->width && y + height <= params->height);
+
+    if (!linesize)
+        linesize = params->width;
+
+    require_update_barrier(s);
+    ngli_glBindTexture(gl, s_priv->target, s_priv->id);
+
+    const int bytes_per_row = linesize * s->bytes_per_pixel;
+    const int alignment = NGLI_MIN(bytes_per_row & ~(bytes_per_row - 1), 8);
+    ngli_glPixelStorei(gl, GL_UNPACK_ALIGNMENT, alignment);
+
+    if (gl->features & NGLI_FEATURE_ROW_LENGTH) {
+        ngli_glPixelStorei(gl, GL_UNPACK_ROW_LENGTH, linesize);
+        ngli_glTexSubImage2D(gl, GL_TEXTURE_2D, 0, x, y, width, height, s_priv->format, s_priv->format_type, data);
+        ngli_glPixelStorei(gl, GL_UNPACK_ROW_LENGTH, 0);
+    } else {
+        for (int i = 0; i < height; i++) {
+            ngli_glTexSubImage2D(gl, GL_TEXTURE_2D, 0, x, y + i, width, 1, s_priv->format, s_priv->format_type, data);
+            data += bytes_per_row;
+        }
+    }
+
+    ngli_glPixelStorei(gl, GL_UNPACK_ALIGNMENT, 4);
+    ngli_glBindTexture(gl, s_priv->target, 0);
+
+    return 0;
+}
+
 int ngli_texture_gl_generate_mipmap(struct texture *s)
 {
     struct texture_gl *s_priv = (struct texture_gl *)s;
@@ -463,6 +587,7 @@ int ngli_texture_gl_generate_mipmap(struct texture *s)
 
     ngli_assert(!(params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY));
 
+    require_update_barrier(s);
     ngli_glBindTexture(gl, s_priv->target, s_priv->id);
     ngli_glGenerateMipmap(gl, s_priv->target);
     return 0;
@@ -478,7 +603,15 @@ void ngli_texture_gl_freep(struct texture **sp)
     struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
     struct glcontext *gl = gctx_gl->glcontext;
 
-    if (!s->wrapped) {
+    int last_user = 1;
+    if (s_priv->share_key[0]) {
+        struct sharegroup *sharegroup = s->gctx->sharegroup;
+        ngli_sharegroup_lock(sharegroup);
+        last_user = ngli_sharegroup_release(sharegroup, s_priv->share_key);
+        ngli_sharegroup_unlock(sharegroup);
+    }
+
+    if (!s->wrapped && last_user) {
         if (s_priv->target == GL_RENDERBUFFER)
             ngli_glDeleteRenderbuffers(gl, 1, &s_priv->id);
         else
@@ -23,6 +23,7 @@
 #define TEXTURE_GL_H
 
 #include "glincludes.h"
+#include "sharegroup.h"
 #include "texture.h"
 
 GLint ngli_texture_get_gl_min_filter(int min_filter, int mipmap_filter);
@@ -37,6 +38,8 @@ struct texture_gl {
     GLint format;
     GLint internal_format;
     GLenum format_type;
+    int64_t last_shader_write; /* see memorybarrier_gl.h */
+    char share_key[NGLI_SHAREGROUP_KEY_LEN]; /* set if the texture is shared */
 };
 
 struct texture *ngli_texture_gl_create(struct gctx *gctx);
@@ -44,6 +47,10 @@ struct texture *ngli_texture_gl_create(struct gctx *gctx);
 int ngli_texture_gl_init(struct texture *s,
                       const struct texture_params *params);
 
+int ngli_texture_gl_init_shared(struct texture *s,
+                                const struct texture_params *params,
+                                const uint8_t *data);
+
 int ngli_texture_gl_wrap(struct texture *s,
                          const struct texture_params *params,
                          GLuint id);
@@ -55,6 +62,8 @@ int ngli_texture_gl_has_mipmap(const struct texture *s);
 int ngli_texture_gl_match_dimensions(const struct texture *s, int width, int height, int depth);
 
 int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize);
+int ngli_texture_gl_upload_rect(struct texture *s, const uint8_t *data, int linesize,
+                                int x, int y, int width, int height);
 int ngli_texture_gl_generate_mipmap(struct texture *s);
 
 void ngli_texture_gl_freep(struct texture **sp);
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "format.h"
+#include "gctx_null.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "texture_null.h"
+
+struct texture *ngli_texture_null_create(struct gctx *gctx)
+{
+    struct texture *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gctx = gctx;
+    return s;
+}
+
+int ngli_texture_null_init(struct texture *s, const struct texture_params *params)
+{
+    s->params = *params;
+    s->bytes_per_pixel = ngli_format_get_bytes_per_pixel(params->format);
+
+    if (params->external_storage || params->external_oes)
+        s->external_storage = 1;
+
+    if (!s->external_storage) {
+        if (!params->width || !params->height ||
+            (params->type == NGLI_TEXTURE_TYPE_3D && !params->depth)) {
+            LOG(ERROR, "invalid texture type %dx%dx%d",
+                params->width, params->height, params->depth);
+            return NGL_ERROR_INVALID_ARG;
+        }
+    }
+
+    return 0;
+}
+
+int ngli_texture_null_has_mipmap(const struct texture *s)
+{
+    return s->params.mipmap_filter != NGLI_MIPMAP_FILTER_NONE;
+}
+
+int ngli_texture_null_match_dimensions(const struct texture *s, int width, int height, int depth)
+{
+    const struct texture_params *params = &s->params;
+    return params->width == width && params->height == height && params->depth == depth;
+}
+
+static void record_upload(struct texture *s, int x, int y, int width, int height)
+{
+    const struct texture_params *params = &s->params;
+    int size = s->bytes_per_pixel * width * height * NGLI_MAX(params->depth, 1);
+    if (params->type == NGLI_TEXTURE_TYPE_CUBE)
+        size *= 6;
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){
+        .type   = NGLI_CMD_NULL_TEXTURE_UPLOAD,
+        .object = s,
+        .args   = {size, x, y},
+    });
+}
+
+int ngli_texture_null_upload(struct texture *s, const uint8_t *data, int linesize)
+{
+    const struct texture_params *params = &s->params;
+
+    ngli_assert(!s->external_storage && !(params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY));
+
+    if (data) {
+        record_upload(s, 0, 0, params->width, params->height);
+        if (ngli_texture_null_has_mipmap(s))
+            ngli_texture_null_generate_mipmap(s);
+    }
+
+    return 0;
+}
+
+int ngli_texture_null_upload_rect(struct texture *s, const uint8_t *data, int linesize,
+                                  int x, int y, int width, int height)
+{
+    const struct texture_params *params = &s->params;
+
+    ngli_assert(!s->external_storage && !(params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY));
+    ngli_assert(params->type == NGLI_TEXTURE_TYPE_2D);
+
+    record_upload(s, x, y, width, height);
+    if (ngli_texture_null_has_mipmap(s))
+        ngli_texture_null_generate_mipmap(s);
+
+    return 0;
+}
+
+int ngli_texture_null_generate_mipmap(struct texture *s)
+{
+    ngli_gctx_null_record(s->gctx, &(struct cmd_null){.type = NGLI_CMD_NULL_TEXTURE_GENERATE_MIPMAP, .object = s});
+    return 0;
+}
+
+void ngli_texture_null_freep(struct texture **sp)
+{
+    ngli_freep(sp);
+}
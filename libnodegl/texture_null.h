@@ -0,0 +1,39 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TEXTURE_NULL_H
+#define TEXTURE_NULL_H
+
+#include "texture.h"
+
+struct gctx;
+
+struct texture *ngli_texture_null_create(struct gctx *gctx);
+int ngli_texture_null_init(struct texture *s, const struct texture_params *params);
+int ngli_texture_null_has_mipmap(const struct texture *s);
+int ngli_texture_null_match_dimensions(const struct texture *s, int width, int height, int depth);
+int ngli_texture_null_upload(struct texture *s, const uint8_t *data, int linesize);
+int ngli_texture_null_upload_rect(struct texture *s, const uint8_t *data, int linesize,
+                                  int x, int y, int width, int height);
+int ngli_texture_null_generate_mipmap(struct texture *s);
+void ngli_texture_null_freep(struct texture **sp);
+
+#endif
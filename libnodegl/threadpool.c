@@ -0,0 +1,182 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "memory.h"
+#include "threadpool.h"
+
+struct threadpool {
+    pthread_t *threads;
+    int nb_threads;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond_job;  /* signaled to the workers when jobs are queued */
+    pthread_cond_t cond_done; /* signaled to the caller when all jobs are done */
+
+    /* Protected by the lock */
+    ngli_threadpool_func_type func;
+    void *arg;
+    int nb_jobs;
+    int next_job;
+    int nb_done;
+    int stop;
+};
+
+/* Pick and run the pending jobs, called with the lock held */
+static void run_jobs(struct threadpool *s)
+{
+    while (s->next_job < s->nb_jobs) {
+        const int job_id = s->next_job++;
+        const ngli_threadpool_func_type func = s->func;
+        void *arg = s->arg;
+        const int nb_jobs = s->nb_jobs;
+
+        pthread_mutex_unlock(&s->lock);
+        func(arg, job_id, nb_jobs);
+        pthread_mutex_lock(&s->lock);
+
+        if (++s->nb_done == s->nb_jobs)
+            pthread_cond_signal(&s->cond_done);
+    }
+}
+
+static void *worker_thread(void *arg)
+{
+    struct threadpool *s = arg;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->stop && s->next_job >= s->nb_jobs)
+            pthread_cond_wait(&s->cond_job, &s->lock);
+        if (s->stop)
+            break;
+        run_jobs(s);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+struct threadpool *ngli_threadpool_create(int nb_threads)
+{
+    struct threadpool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->threads = ngli_calloc(nb_threads, sizeof(*s->threads));
+    if (!s->threads) {
+        ngli_free(s);
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&s->lock, NULL)) {
+        ngli_free(s->threads);
+        ngli_free(s);
+        return NULL;
+    }
+
+    if (pthread_cond_init(&s->cond_job, NULL)) {
+        pthread_mutex_destroy(&s->lock);
+        ngli_free(s->threads);
+        ngli_free(s);
+        return NULL;
+    }
+
+    if (pthread_cond_init(&s->cond_done, NULL)) {
+        pthread_cond_destroy(&s->cond_job);
+        pthread_mutex_destroy(&s->lock);
+        ngli_free(s->threads);
+        ngli_free(s);
+        return NULL;
+    }
+
+    for (int i = 0; i < nb_threads; i++) {
+        if (pthread_create(&s->threads[i], NULL, worker_thread, s)) {
+            LOG(ERROR, "could not create thread %d/%d of the pool", i + 1, nb_threads);
+            ngli_threadpool_freep(&s);
+            return NULL;
+        }
+        s->nb_threads++;
+    }
+
+    return s;
+}
+
+int ngli_threadpool_get_nb_threads(const struct threadpool *s)
+{
+    return s->nb_threads;
+}
+
+void ngli_threadpool_execute(struct threadpool *s, ngli_threadpool_func_type func, void *arg, int nb_jobs)
+{
+    pthread_mutex_lock(&s->lock);
+    s->func = func;
+    s->arg = arg;
+    s->nb_jobs = nb_jobs;
+    s->next_job = 0;
+    s->nb_done = 0;
+    pthread_cond_broadcast(&s->cond_job);
+
+    run_jobs(s);
+    while (s->nb_done < s->nb_jobs)
+        pthread_cond_wait(&s->cond_done, &s->lock);
+
+    s->func = NULL;
+    s->arg = NULL;
+    s->nb_jobs = 0;
+    s->next_job = 0;
+    pthread_mutex_unlock(&s->lock);
+}
+
+void ngli_threadpool_freep(struct threadpool **sp)
+{
+    struct threadpool *s = *sp;
+    if (!s)
+        return;
+
+    pthread_mutex_lock(&s->lock);
+    s->stop = 1;
+    pthread_cond_broadcast(&s->cond_job);
+    pthread_mutex_unlock(&s->lock);
+
+    for (int i = 0; i < s->nb_threads; i++)
+        pthread_join(s->threads[i], NULL);
+
+    pthread_cond_destroy(&s->cond_done);
+    pthread_cond_destroy(&s->cond_job);
+    pthread_mutex_destroy(&s->lock);
+    ngli_free(s->threads);
+    ngli_freep(sp);
+}
+
+int ngli_threadpool_get_nb_cpus(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    const long nb_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_cpus > 0)
+        return nb_cpus;
+#endif
+    return 1;
+}
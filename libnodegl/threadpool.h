@@ -0,0 +1,45 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/*
+ * Pool of worker threads executing data-parallel jobs.
+ *
+ * ngli_threadpool_execute() runs func(arg, job_id, nb_jobs) for every job_id
+ * in [0, nb_jobs) and blocks until all of them are done; the calling thread
+ * participates in the execution. A pool is meant to be driven by a single
+ * thread at a time.
+ */
+
+typedef void (*ngli_threadpool_func_type)(void *arg, int job_id, int nb_jobs);
+
+struct threadpool;
+
+struct threadpool *ngli_threadpool_create(int nb_threads);
+int ngli_threadpool_get_nb_threads(const struct threadpool *s);
+void ngli_threadpool_execute(struct threadpool *s, ngli_threadpool_func_type func, void *arg, int nb_jobs);
+void ngli_threadpool_freep(struct threadpool **sp);
+
+int ngli_threadpool_get_nb_cpus(void);
+
+#endif
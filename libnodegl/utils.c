@@ -63,6 +63,14 @@ int64_t ngli_gettime_relative(void)
     return 1000000 * (int64_t)ts.tv_sec + ts.tv_nsec / 1000;
 }
 
+int64_t ngli_gettime_relative_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return 1000000000 * (int64_t)ts.tv_sec + ts.tv_nsec;
+}
+
 char *ngli_asprintf(const char *fmt, ...)
 {
     char *p = NULL;
@@ -145,6 +153,15 @@ uint32_t ngli_crc32(const char *s)
     return ~crc;
 }
 
+/* 64-bit FNV-1a, h is the hash to continue from or NGLI_FNV1A_INIT */
+uint64_t ngli_fnv1a(uint64_t h, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < size; i++)
+        h = (h ^ p[i]) * 0x100000001b3ULL;
+    return h;
+}
+
 void ngli_thread_set_name(const char *name)
 {
 #if defined(__APPLE__)
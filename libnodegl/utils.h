@@ -96,8 +96,12 @@
 char *ngli_strdup(const char *s);
 int64_t ngli_gettime(void);
 int64_t ngli_gettime_relative(void);
+int64_t ngli_gettime_relative_ns(void);
 char *ngli_asprintf(const char *fmt, ...) ngli_printf_format(1, 2);
 uint32_t ngli_crc32(const char *s);
+
+#define NGLI_FNV1A_INIT 0xcbf29ce484222325ULL
+uint64_t ngli_fnv1a(uint64_t h, const void *data, size_t size);
 void ngli_thread_set_name(const char *name);
 
 #endif /* UTILS_H */
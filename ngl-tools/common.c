@@ -19,11 +19,20 @@
  * under the License.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <sys/time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nodegl.h>
 
 #include "common.h"
 
+#define BUF_SIZE 1024
+
 int64_t gettime(void)
 {
     struct timeval tv;
@@ -57,3 +66,40 @@ void get_viewport(int width, int height, const int *aspect_ratio, int *vp)
     vp[0] = (width  - vp[2]) / 2.0;
     vp[1] = (height - vp[3]) / 2.0;
 }
+
+struct ngl_node *load_scene(const char *filename)
+{
+    struct ngl_node *scene = NULL;
+    char *buf = NULL;
+
+    int fd = filename ? open(filename, O_RDONLY) : STDIN_FILENO;
+    if (fd == -1) {
+        fprintf(stderr, "unable to open %s\n", filename);
+        goto end;
+    }
+
+    ssize_t pos = 0;
+    for (;;) {
+        const ssize_t needed = pos + BUF_SIZE + 1;
+        void *new_buf = realloc(buf, needed);
+        if (!new_buf)
+            goto end;
+        buf = new_buf;
+        const ssize_t n = read(fd, buf + pos, BUF_SIZE);
+        if (n < 0)
+            goto end;
+        if (n == 0) {
+            buf[pos] = 0;
+            break;
+        }
+        pos += n;
+    }
+
+    scene = ngl_node_deserialize(buf);
+
+end:
+    if (fd != -1 && fd != STDIN_FILENO)
+        close(fd);
+    free(buf);
+    return scene;
+}
@@ -25,6 +25,8 @@
 
 #include <stdint.h>
 
+struct ngl_node;
+
 #define ARRAY_NB(x) ((int)(sizeof(x) / sizeof(*(x))))
 
 #define DEFAULT_WIDTH  640
@@ -34,5 +36,6 @@ int64_t gettime(void);
 double clipd(double v, double min, double max);
 int clipi(int v, int min, int max);
 void get_viewport(int width, int height, const int *aspect_ratio, int *vp);
+struct ngl_node *load_scene(const char *filename);
 
 #endif
@@ -0,0 +1,294 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include <nodegl.h>
+
+#include "common.h"
+#include "opts.h"
+
+enum {
+    PHASE_VISIT,
+    PHASE_PREFETCH,
+    PHASE_RELEASE,
+    PHASE_UPDATE,
+    PHASE_DRAW,
+    PHASE_CAPTURE,
+    PHASE_GPU,
+    PHASE_TOTAL,
+    NB_PHASES
+};
+
+static const char * const phase_names[NB_PHASES] = {
+    [PHASE_VISIT]    = "visit",
+    [PHASE_PREFETCH] = "prefetch",
+    [PHASE_RELEASE]  = "release",
+    [PHASE_UPDATE]   = "update",
+    [PHASE_DRAW]     = "draw",
+    [PHASE_CAPTURE]  = "capture",
+    [PHASE_GPU]      = "gpu",
+    [PHASE_TOTAL]    = "total",
+};
+
+struct ctx {
+    /* options */
+    int log_level;
+    struct ngl_config cfg;
+    const char *input;
+    const char *output;
+    int nb_warmup_frames;
+    int nb_frames;
+    int rate[2];
+    double start_time;
+    int capture;
+
+    /* per-frame samples, in microseconds */
+    double *samples[NB_PHASES];
+};
+
+#define OFFSET(x) offsetof(struct ctx, x)
+static const struct opt options[] = {
+    {"-i", "--input",         OPT_TYPE_STR,      .offset=OFFSET(input)},
+    {"-o", "--output",        OPT_TYPE_STR,      .offset=OFFSET(output)},
+    {"-w", "--warmup",        OPT_TYPE_INT,      .offset=OFFSET(nb_warmup_frames)},
+    {"-n", "--frames",        OPT_TYPE_INT,      .offset=OFFSET(nb_frames)},
+    {"-r", "--rate",          OPT_TYPE_RATIONAL, .offset=OFFSET(rate)},
+    {"-t", "--start_time",    OPT_TYPE_TIME,     .offset=OFFSET(start_time)},
+    {"-c", "--capture",       OPT_TYPE_TOGGLE,   .offset=OFFSET(capture)},
+    {"-p", "--profiling",     OPT_TYPE_TOGGLE,   .offset=OFFSET(cfg.profiling)},
+    {"-l", "--loglevel",      OPT_TYPE_LOGLEVEL, .offset=OFFSET(log_level)},
+    {"-b", "--backend",       OPT_TYPE_BACKEND,  .offset=OFFSET(cfg.backend)},
+    {"-s", "--size",          OPT_TYPE_RATIONAL, .offset=OFFSET(cfg.width)},
+    {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
+};
+
+static int cmp_double(const void *a, const void *b)
+{
+    const double va = *(const double *)a;
+    const double vb = *(const double *)b;
+    return (va > vb) - (va < vb);
+}
+
+/* Nearest-rank percentile on sorted samples */
+static double get_percentile(const double *sorted, int n, int p)
+{
+    const int rank = (p * n + 99) / 100;
+    return sorted[clipi(rank - 1, 0, n - 1)];
+}
+
+static int64_t get_max_rss(void)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) < 0)
+        return -1;
+#if defined(TARGET_DARWIN)
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024;
+#endif
+}
+
+static void print_report(FILE *f, const struct ctx *s, const struct ngl_stats *stats)
+{
+    fprintf(f, "{\n");
+    fprintf(f, "    \"input\": \"%s\",\n", s->input ? s->input : "<stdin>");
+    fprintf(f, "    \"width\": %d,\n", s->cfg.width);
+    fprintf(f, "    \"height\": %d,\n", s->cfg.height);
+    fprintf(f, "    \"samples\": %d,\n", s->cfg.samples);
+    fprintf(f, "    \"capture\": %s,\n", s->capture ? "true" : "false");
+    fprintf(f, "    \"profiling\": %s,\n", s->cfg.profiling ? "true" : "false");
+    fprintf(f, "    \"warmup_frames\": %d,\n", s->nb_warmup_frames);
+    fprintf(f, "    \"frames\": %d,\n", s->nb_frames);
+    fprintf(f, "    \"unit\": \"us\",\n");
+    fprintf(f, "    \"phases\": {\n");
+    for (int i = 0; i < NB_PHASES; i++) {
+        /* The phases timings are only measured with profiling enabled */
+        if (i != PHASE_TOTAL && !s->cfg.profiling)
+            continue;
+        double *samples = s->samples[i];
+        const int n = s->nb_frames;
+        qsort(samples, n, sizeof(*samples), cmp_double);
+        double sum = 0.;
+        for (int k = 0; k < n; k++)
+            sum += samples[k];
+        fprintf(f, "        \"%s\": {\"min\": %.3f, \"median\": %.3f, \"p95\": %.3f, "
+                "\"p99\": %.3f, \"max\": %.3f, \"mean\": %.3f}%s\n",
+                phase_names[i], samples[0], get_percentile(samples, n, 50),
+                get_percentile(samples, n, 95), get_percentile(samples, n, 99),
+                samples[n - 1], sum / n, i == NB_PHASES - 1 ? "" : ",");
+    }
+    fprintf(f, "    },\n");
+    fprintf(f, "    \"memory\": {\n");
+    fprintf(f, "        \"max_rss\": %" PRId64 ",\n", get_max_rss());
+    fprintf(f, "        \"residency_max_size\": %" PRId64 ",\n", stats->residency_max_size);
+    fprintf(f, "        \"buffers_max_size\": %" PRId64 ",\n", stats->memory_buffers_max_size);
+    fprintf(f, "        \"textures_max_size\": %" PRId64 ",\n", stats->memory_textures_max_size);
+    fprintf(f, "        \"attachments_max_size\": %" PRId64 ",\n", stats->memory_attachments_max_size);
+    fprintf(f, "        \"total_max_size\": %" PRId64 ",\n", stats->memory_total_max_size);
+    fprintf(f, "        \"nb_buffers\": %d,\n", stats->memory_nb_buffers);
+    fprintf(f, "        \"nb_textures\": %d,\n", stats->memory_nb_textures);
+    fprintf(f, "        \"nb_attachments\": %d\n", stats->memory_nb_attachments);
+    fprintf(f, "    }\n");
+    fprintf(f, "}\n");
+}
+
+static int record_frame(struct ctx *s, struct ngl_ctx *ctx, int frame, int64_t total)
+{
+    struct ngl_stats stats;
+    int ret = ngl_get_stats(ctx, &stats);
+    if (ret < 0)
+        return ret;
+
+    s->samples[PHASE_VISIT][frame]    = stats.visit_time;
+    s->samples[PHASE_PREFETCH][frame] = stats.prefetch_time;
+    s->samples[PHASE_RELEASE][frame]  = stats.release_time;
+    s->samples[PHASE_UPDATE][frame]   = stats.update_time;
+    s->samples[PHASE_DRAW][frame]     = stats.draw_time;
+    s->samples[PHASE_CAPTURE][frame]  = stats.capture_time;
+    s->samples[PHASE_GPU][frame]      = stats.gpu_draw_time;
+    s->samples[PHASE_TOTAL][frame]    = total;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    struct ctx s = {
+        .log_level          = NGL_LOG_WARNING,
+        .cfg.width          = DEFAULT_WIDTH,
+        .cfg.height         = DEFAULT_HEIGHT,
+        .cfg.offscreen      = 1,
+        .cfg.swap_interval  = -1,
+        .cfg.clear_color[3] = 1.f,
+        .nb_warmup_frames   = 10,
+        .nb_frames          = 100,
+        .rate[0]            = 60,
+        .rate[1]            = 1,
+    };
+
+    int ret = opts_parse(argc, argc, argv, options, ARRAY_NB(options), &s);
+    if (ret < 0 || ret == OPT_HELP) {
+        opts_print_usage(argv[0], options, ARRAY_NB(options), NULL);
+        return ret == OPT_HELP ? 0 : EXIT_FAILURE;
+    }
+
+    ngl_log_set_min_level(s.log_level);
+
+    if (s.nb_frames <= 0 || s.nb_warmup_frames < 0 || s.rate[0] <= 0 || s.rate[1] <= 0) {
+        fprintf(stderr, "Invalid number of frames or rate\n");
+        return EXIT_FAILURE;
+    }
+
+    ret = EXIT_FAILURE;
+
+    FILE *output = stdout;
+    struct ngl_ctx *ctx = NULL;
+    uint8_t *capture_buffer = NULL;
+
+    for (int i = 0; i < NB_PHASES; i++) {
+        s.samples[i] = calloc(s.nb_frames, sizeof(*s.samples[i]));
+        if (!s.samples[i])
+            goto end;
+    }
+
+    struct ngl_node *scene = load_scene(s.input);
+    if (!scene)
+        goto end;
+
+    if (s.capture) {
+        capture_buffer = calloc(s.cfg.width * s.cfg.height, 4);
+        if (!capture_buffer) {
+            ngl_node_unrefp(&scene);
+            goto end;
+        }
+        s.cfg.capture_buffer = capture_buffer;
+    }
+
+    ctx = ngl_create();
+    if (!ctx) {
+        ngl_node_unrefp(&scene);
+        goto end;
+    }
+
+    if (ngl_configure(ctx, &s.cfg) < 0) {
+        ngl_node_unrefp(&scene);
+        goto end;
+    }
+
+    int set_scene_ret = ngl_set_scene(ctx, scene);
+    ngl_node_unrefp(&scene);
+    if (set_scene_ret < 0)
+        goto end;
+
+    const int nb_frames = s.nb_warmup_frames + s.nb_frames;
+    for (int i = 0; i < nb_frames; i++) {
+        const double t = s.start_time + i * s.rate[1] / (double)s.rate[0];
+
+        const int64_t start = gettime();
+        if (ngl_draw(ctx, t) < 0) {
+            fprintf(stderr, "Unable to draw @ t=%g\n", t);
+            goto end;
+        }
+        const int64_t total = gettime() - start;
+
+        /* Flush the recorded events; only the per-frame totals are used */
+        if (s.cfg.profiling)
+            free(ngl_export_profile(ctx, NGL_PROFILE_FORMAT_CSV));
+
+        if (i < s.nb_warmup_frames)
+            continue;
+
+        if (record_frame(&s, ctx, i - s.nb_warmup_frames, total) < 0)
+            goto end;
+    }
+
+    struct ngl_stats stats;
+    if (ngl_get_stats(ctx, &stats) < 0)
+        goto end;
+
+    if (s.output) {
+        output = fopen(s.output, "w");
+        if (!output) {
+            fprintf(stderr, "Unable to open %s\n", s.output);
+            output = stdout;
+            goto end;
+        }
+    }
+
+    print_report(output, &s, &stats);
+    ret = 0;
+
+end:
+    ngl_freep(&ctx);
+
+    if (output != stdout)
+        fclose(output);
+
+    free(capture_buffer);
+    for (int i = 0; i < NB_PHASES; i++)
+        free(s.samples[i]);
+
+    return ret;
+}
@@ -33,49 +33,10 @@
 #include "opts.h"
 #include "wsi.h"
 
-#define BUF_SIZE 1024
-
 #ifndef O_BINARY
 #define O_BINARY 0
 #endif
 
-static struct ngl_node *get_scene(const char *filename)
-{
-    struct ngl_node *scene = NULL;
-    char *buf = NULL;
-
-    int fd = filename ? open(filename, O_RDONLY) : STDIN_FILENO;
-    if (fd == -1) {
-        fprintf(stderr, "unable to open %s\n", filename);
-        goto end;
-    }
-
-    ssize_t pos = 0;
-    for (;;) {
-        const ssize_t needed = pos + BUF_SIZE + 1;
-        void *new_buf = realloc(buf, needed);
-        if (!new_buf)
-            goto end;
-        buf = new_buf;
-        const ssize_t n = read(fd, buf + pos, BUF_SIZE);
-        if (n < 0)
-            goto end;
-        if (n == 0) {
-            buf[pos] = 0;
-            break;
-        }
-        pos += n;
-    }
-
-    scene = ngl_node_deserialize(buf);
-
-end:
-    if (fd != -1 && fd != STDIN_FILENO)
-        close(fd);
-    free(buf);
-    return scene;
-}
-
 struct range {
     float start;
     float duration;
@@ -180,7 +141,7 @@ int main(int argc, char *argv[])
     struct ngl_ctx *ctx = NULL;
     uint8_t *capture_buffer = NULL;
 
-    struct ngl_node *scene = get_scene(s.input);
+    struct ngl_node *scene = load_scene(s.input);
     if (!scene) {
         ret = EXIT_FAILURE;
         goto end;
@@ -200,5 +200,6 @@ def get_backend(backend):
     backend_map = {
         'gl': ngl.BACKEND_OPENGL,
         'gles': ngl.BACKEND_OPENGLES,
+        'null': ngl.BACKEND_NULL,
     }
     return backend_map[backend]
@@ -245,7 +245,8 @@ class Player(QtCore.QThread):
         self._push_event(lambda: self._set_scene())
 
     def _set_scene(self):
-        self._viewer.set_scene_from_string(self._scene)
+        # Nodes unchanged since the previous scene keep their resources
+        self._viewer.update_scene_from_string(self._scene)
         self._clock.configure(self._framerate, self._duration)
         self.onSceneMetadata.emit({'framerate': self._framerate, 'duration': self._duration})
         return False
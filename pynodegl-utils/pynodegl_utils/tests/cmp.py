@@ -65,6 +65,7 @@ class CompareSceneBase(CompareBase):
                  exercise_dot=True,
                  scene_wrap=None,
                  samples=0,
+                 backend=None,
                  **scene_kwargs):
         self._width = width
         self._height = height
@@ -77,6 +78,7 @@ class CompareSceneBase(CompareBase):
         self._exercise_dot = exercise_dot
         self._scene_wrap = scene_wrap
         self._samples = samples
+        self._backend = backend
 
     def render_frames(self):
         # We make sure the lists of medias is explicitely empty. If we don't a
@@ -84,7 +86,7 @@ class CompareSceneBase(CompareBase):
         # default ngl-media.mp4.
         idict = dict(medias=[])
 
-        backend = os.environ.get('BACKEND')
+        backend = self._backend or os.environ.get('BACKEND')
         if backend:
             idict['backend'] = backend
 
@@ -114,6 +116,9 @@ class CompareSceneBase(CompareBase):
         else:
             viewer.set_scene(scene)
 
+        # Exposed to the testers needing to query the context between frames
+        self._viewer = viewer
+
         for t_id in range(self._nb_keyframes):
             if self._keyframes_callback:
                 self._keyframes_callback(t_id)
@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+#
+# Copyright 2020 GoPro Inc.
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import csv
+
+from .cmp import CompareSceneBase, get_test_decorator
+
+
+_METRICS = (
+    'commands',
+    'draws',
+    'uniform_updates',
+    'uploaded_bytes',
+    'updated_nodes',
+)
+
+
+def _get_calls(api_calls, *functions):
+    return sum(int(row['calls']) for row in api_calls if row['function'] in functions)
+
+
+# The scenes are drawn with the null backend which records the commands
+# without any GPU: unlike timings, these metrics are deterministic and
+# independent of the graphics driver, so they can be compared against the
+# references with an optional relative tolerance
+class _ComparePerf(CompareSceneBase):
+    def __init__(self, scene_func, tolerances=None, **kwargs):
+        super().__init__(scene_func, width=320, height=240, backend='null', **kwargs)
+        self._tolerances = tolerances if tolerances is not None else {}
+        assert all(metric in _METRICS for metric in self._tolerances)
+
+    @staticmethod
+    def serialize(data):
+        ret = ','.join(_METRICS) + '\n'
+        for row in data:
+            ret += ','.join(str(row[metric]) for metric in _METRICS) + '\n'
+        return ret
+
+    @staticmethod
+    def deserialize(data):
+        return [dict((k, int(v)) for k, v in row.items()) for row in csv.DictReader(data.splitlines())]
+
+    def get_out_data(self):
+        data = []
+        for frame in self.render_frames():
+            stats = self._viewer.get_stats()
+            api_calls = list(csv.DictReader(self._viewer.export_api_calls().decode().splitlines()))
+            data.append(dict(
+                commands=stats['nb_api_calls'],
+                draws=_get_calls(api_calls, 'draw', 'draw_indexed', 'draw_indirect', 'draw_indexed_indirect'),
+                uniform_updates=_get_calls(api_calls, 'pipeline_update_uniform'),
+                uploaded_bytes=stats['buffer_upload_size'] + stats['texture_upload_size'],
+                updated_nodes=stats['nb_updated_nodes'],
+            ))
+        return data
+
+    def compare_data(self, test_name, ref_data, out_data):
+        err = []
+        if len(ref_data) != len(out_data):
+            return ['{}: number of frames mismatch ({} != {})'.format(test_name, len(ref_data), len(out_data))]
+        for frame, (ref_row, out_row) in enumerate(zip(ref_data, out_data)):
+            for metric in _METRICS:
+                ref_value, out_value = ref_row[metric], out_row[metric]
+                tolerance = self._tolerances.get(metric, 0)
+                if abs(out_value - ref_value) > ref_value * tolerance:
+                    err.append('{} frame {}: {} {} from {} to {} (tolerance: {:g}%)'.format(
+                        test_name, frame, metric,
+                        'regressed' if out_value > ref_value else 'improved (update the reference)',
+                        ref_value, out_value, tolerance * 100))
+        return err
+
+
+test_perf = get_test_decorator(_ComparePerf)
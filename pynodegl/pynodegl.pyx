@@ -22,7 +22,7 @@
 
 from libc.stdlib cimport calloc
 from libc.string cimport memset
-from libc.stdint cimport uint8_t
+from libc.stdint cimport int64_t, uint8_t
 from libc.stdint cimport uintptr_t
 
 cdef extern from "nodegl.h":
@@ -59,6 +59,7 @@ cdef extern from "nodegl.h":
     cdef int NGL_BACKEND_AUTO
     cdef int NGL_BACKEND_OPENGL
     cdef int NGL_BACKEND_OPENGLES
+    cdef int NGL_BACKEND_NULL
 
     cdef struct ngl_ctx
 
@@ -77,13 +78,60 @@ cdef extern from "nodegl.h":
         int  set_surface_pts
         float clear_color[4]
         uint8_t *capture_buffer
+        int64_t residency_budget
+        int  profiling
+        int  record_commands
+        ngl_ctx *share_ctx
+
+    cdef struct ngl_stats:
+        int64_t residency_size
+        int64_t residency_max_size
+        int residency_nb_nodes
+        int residency_nb_hits
+        int residency_nb_evictions
+        int64_t residency_evicted_size
+        int64_t visit_time
+        int64_t prefetch_time
+        int64_t release_time
+        int64_t update_time
+        int64_t draw_time
+        int64_t capture_time
+        int64_t gpu_draw_time
+        int64_t nb_api_calls
+        int64_t nb_state_changes
+        int64_t nb_draw_calls
+        int64_t nb_dispatch_calls
+        int64_t buffer_upload_size
+        int64_t texture_upload_size
+        int64_t nb_memory_barriers
+        int64_t nb_elided_memory_barriers
+        int nb_updated_nodes
+        int64_t memory_buffers_size
+        int64_t memory_buffers_max_size
+        int64_t memory_textures_size
+        int64_t memory_textures_max_size
+        int64_t memory_attachments_size
+        int64_t memory_attachments_max_size
+        int64_t memory_total_size
+        int64_t memory_total_max_size
+        int memory_nb_buffers
+        int memory_nb_textures
+        int memory_nb_attachments
+
+    cdef int NGL_PROFILE_FORMAT_CSV
+    cdef int NGL_PROFILE_FORMAT_CHROME_TRACE
 
     ngl_ctx *ngl_create()
     int ngl_configure(ngl_ctx *s, ngl_config *config)
     int ngl_resize(ngl_ctx *s, int width, int height, const int *viewport);
     int ngl_set_scene(ngl_ctx *s, ngl_node *scene)
+    int ngl_update_scene(ngl_ctx *s, ngl_node *scene)
     int ngl_draw(ngl_ctx *s, double t) nogil
     char *ngl_dot(ngl_ctx *s, double t) nogil
+    int ngl_get_stats(ngl_ctx *s, ngl_stats *stats)
+    char *ngl_export_api_calls(ngl_ctx *s)
+    char *ngl_export_memory(ngl_ctx *s)
+    char *ngl_export_profile(ngl_ctx *s, int format)
     void ngl_freep(ngl_ctx **ss)
 
     int ngl_easing_evaluate(const char *name, double *args, int nb_args,
@@ -101,6 +149,10 @@ PLATFORM_WINDOWS = NGL_PLATFORM_WINDOWS
 BACKEND_AUTO      = NGL_BACKEND_AUTO
 BACKEND_OPENGL    = NGL_BACKEND_OPENGL
 BACKEND_OPENGLES  = NGL_BACKEND_OPENGLES
+BACKEND_NULL      = NGL_BACKEND_NULL
+
+PROFILE_FORMAT_CSV          = NGL_PROFILE_FORMAT_CSV
+PROFILE_FORMAT_CHROME_TRACE = NGL_PROFILE_FORMAT_CHROME_TRACE
 
 LOG_VERBOSE = NGL_LOG_VERBOSE
 LOG_DEBUG   = NGL_LOG_DEBUG
@@ -172,6 +224,7 @@ cdef _set_node_ctx(_Node node, int type):
 cdef class Context:
     cdef ngl_ctx *ctx
     cdef object capture_buffer
+    cdef object share_ctx
 
     def __cinit__(self):
         self.ctx = ngl_create()
@@ -201,6 +254,13 @@ cdef class Context:
         self.capture_buffer = kwargs.get('capture_buffer')
         if self.capture_buffer is not None:
             config.capture_buffer = self.capture_buffer
+        config.residency_budget = kwargs.get('residency_budget', 0)
+        config.profiling = kwargs.get('profiling', 0)
+        config.record_commands = kwargs.get('record_commands', 0)
+        # Keep a reference so the share context is destroyed after this one
+        self.share_ctx = kwargs.get('share_ctx')
+        if self.share_ctx is not None:
+            config.share_ctx = (<Context>self.share_ctx).ctx
         return ngl_configure(self.ctx, &config)
 
     def resize(self, width, height, viewport=None):
@@ -220,6 +280,15 @@ cdef class Context:
         ngl_node_unrefp(&scene)
         return ret
 
+    def update_scene(self, _Node scene):
+        return ngl_update_scene(self.ctx, NULL if scene is None else scene.ctx)
+
+    def update_scene_from_string(self, s):
+        cdef ngl_node *scene = ngl_node_deserialize(s);
+        ret = ngl_update_scene(self.ctx, scene)
+        ngl_node_unrefp(&scene)
+        return ret
+
     def draw(self, double t):
         with nogil:
             ret = ngl_draw(self.ctx, t)
@@ -231,5 +300,23 @@ cdef class Context:
             s = ngl_dot(self.ctx, t)
         return _ret_pystr(s) if s else None
 
+    def get_stats(self):
+        cdef ngl_stats stats
+        if ngl_get_stats(self.ctx, &stats) < 0:
+            return None
+        return stats
+
+    def export_api_calls(self):
+        cdef char *s = ngl_export_api_calls(self.ctx)
+        return _ret_pystr(s) if s else None
+
+    def export_memory(self):
+        cdef char *s = ngl_export_memory(self.ctx)
+        return _ret_pystr(s) if s else None
+
+    def export_profile(self, int format=PROFILE_FORMAT_CHROME_TRACE):
+        cdef char *s = ngl_export_profile(self.ctx, format)
+        return _ret_pystr(s) if s else None
+
     def __dealloc__(self):
         ngl_freep(&self.ctx)
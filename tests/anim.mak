@@ -22,6 +22,7 @@
 ANIM_TEST_NAMES =        \
     forward_api          \
     forward_float        \
+    forward_float_lut    \
     forward_vec2         \
     forward_vec3         \
     forward_vec4         \
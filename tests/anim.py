@@ -150,9 +150,13 @@ _vec2_kf_func  = lambda t, v, **kw: ngl.AnimKeyFrameVec2(t, v, **kw)
 _vec3_kf_func  = lambda t, v, **kw: ngl.AnimKeyFrameVec3(t, v, **kw)
 _vec4_kf_func  = lambda t, v, **kw: ngl.AnimKeyFrameVec4(t, v, **kw)
 _quat_kf_func  = lambda t, v, **kw: ngl.AnimKeyFrameQuat(t, v, **kw)
+_lut_kf_func   = lambda t, v, **kw: ngl.AnimKeyFrameFloat(t, v[0], easing_lut_tolerance=1e-4, **kw)
 
 anim_forward_float = _get_anim_func(1, ngl.AnimatedFloat, _float_kf_func)
 anim_forward_vec2  = _get_anim_func(2, ngl.AnimatedVec2,  _vec2_kf_func)
 anim_forward_vec3  = _get_anim_func(3, ngl.AnimatedVec3,  _vec3_kf_func)
 anim_forward_vec4  = _get_anim_func(4, ngl.AnimatedVec4,  _vec4_kf_func)
 anim_forward_quat  = _get_anim_func(4, ngl.AnimatedQuat,  _quat_kf_func)
+
+# The look-up tables are built outside of any rendering context
+anim_forward_float_lut = _get_anim_func(1, ngl.AnimatedFloat, _lut_kf_func)
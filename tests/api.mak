@@ -27,6 +27,16 @@ API_TEST_NAMES =             \
     ctx_ownership            \
     ctx_ownership_subgraph   \
     capture_buffer_lifetime  \
+    residency_budget         \
+    profiling                \
+    record_commands          \
+    calls                    \
+    memory_barriers          \
+    memory                   \
+    memory_pools             \
+    attachpool               \
+    update_scene             \
+    share_ctx                \
     hud                      \
 
 $(eval $(call DECLARE_SIMPLE_TESTS,api,$(API_TEST_NAMES)))
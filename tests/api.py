@@ -20,6 +20,7 @@
 # under the License.
 #
 
+import array
 import os
 import pynodegl as ngl
 from pynodegl_utils.misc import get_backend
@@ -30,6 +31,8 @@ _backend = get_backend(_backend_str) if _backend_str else ngl.BACKEND_AUTO
 
 _vert = 'void main() { ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * ngl_position; }'
 _frag = 'void main() { ngl_out_color = color; }'
+_vert_texture = 'void main() { ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * ngl_position; var_uvcoord = ngl_uvcoord; }'
+_frag_texture = 'void main() { ngl_out_color = ngl_texvideo(tex, var_uvcoord); }'
 
 def _get_scene(geometry=None):
     program = ngl.Program(vertex=_vert, fragment=_frag)
@@ -130,6 +133,345 @@ def api_capture_buffer_lifetime(width=1024, height=1024):
     del viewer
 
 
+def api_residency_budget(width=16, height=16):
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend, residency_budget=-1) != 0
+    # The budget can hold the texture of one inactive branch but not two
+    texture_size = width * height * 4
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend,
+                            residency_budget=texture_size * 3 // 2) == 0
+    filters = []
+    for i in range(3):
+        texture = ngl.Texture2D(width=width, height=height)
+        ranges = [ngl.TimeRangeModeNoop(0), ngl.TimeRangeModeCont(i), ngl.TimeRangeModeNoop(i + 1)]
+        rtt = ngl.RenderToTexture(_get_scene(), [texture])
+        filters.append(ngl.TimeRangeFilter(rtt, ranges=ranges[1:] if i == 0 else ranges,
+                                           prefetch_time=0, max_idle_time=0.5))
+    assert viewer.set_scene(ngl.Group(filters)) == 0
+
+    # Branch 0 becomes inactive and is kept resident
+    assert viewer.draw(0) == 0
+    assert viewer.draw(1) == 0
+    stats = viewer.get_stats()
+    assert stats['residency_size'] == texture_size
+    assert stats['residency_nb_evictions'] == 0
+
+    # Branch 1 becomes inactive as well: branch 0 (least recently used) is evicted
+    assert viewer.draw(2) == 0
+    stats = viewer.get_stats()
+    assert stats['residency_size'] == texture_size
+    assert stats['residency_nb_evictions'] > 0
+    assert stats['residency_evicted_size'] == texture_size
+    assert stats['residency_nb_hits'] == 0
+
+    # Branch 1 is still resident and re-activated without a new prefetch while
+    # branch 2 takes its place in the cache
+    assert viewer.draw(1) == 0
+    stats = viewer.get_stats()
+    assert stats['residency_nb_hits'] > 0
+    assert stats['residency_size'] == texture_size
+    assert stats['residency_evicted_size'] == texture_size
+
+    assert viewer.set_scene(None) == 0
+    del viewer
+
+
+def api_profiling(width=16, height=16):
+    import csv
+    import json
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend) == 0
+    assert viewer.export_profile() is None
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend, profiling=1) == 0
+    scene = _get_scene()
+    assert viewer.set_scene(scene) == 0
+    for i in range(3):
+        assert viewer.draw(i) == 0
+    stats = viewer.get_stats()
+    assert stats['update_time'] >= 0 and stats['draw_time'] >= 0
+    trace = json.loads(viewer.export_profile(ngl.PROFILE_FORMAT_CHROME_TRACE))
+    labels = set(event['name'] for event in trace['traceEvents'] if event.get('cat') == 'draw')
+    assert 'render' in labels
+    assert viewer.draw(3) == 0
+    rows = list(csv.DictReader(viewer.export_profile(ngl.PROFILE_FORMAT_CSV).decode().splitlines()))
+    assert set(row['frame'] for row in rows if row['phase'] != 'gpu') == {'4'}
+    assert all(int(row['start_ns']) >= 0 and int(row['duration_ns']) >= 0 for row in rows)
+    # The GPU timings are collected asynchronously and may belong to the previous frames
+    assert all(int(row['frame']) <= 4 for row in rows if row['phase'] == 'gpu')
+    del viewer
+
+
+def api_record_commands(width=16, height=16):
+    import zlib
+
+    def get_scene():
+        scene = _get_scene()
+        color = ngl.AnimatedVec4(keyframes=(
+            ngl.AnimKeyFrameVec4(0, (1.0, 0.0, 0.0, 1.0)),
+            ngl.AnimKeyFrameVec4(1, (0.0, 0.0, 1.0, 1.0)),
+        ))
+        scene.update_frag_resources(color=color)
+        texture = ngl.Texture2D(width=width, height=height)
+        rtt = ngl.RenderToTexture(scene, [texture])
+        program = ngl.Program(vertex=_vert_texture, fragment=_frag_texture)
+        program.update_vert_out_vars(var_uvcoord=ngl.IOVec2())
+        render = ngl.Render(ngl.Quad((-1, -1, 0), (1, 0, 0), (0, 2, 0)), program)
+        render.update_frag_resources(tex=texture)
+        return ngl.Group(children=(rtt, render))
+
+    # The recorded frames must be identical to the ones submitted directly
+    crcs = []
+    for record_commands in (0, 1):
+        capture_buffer = bytearray(width * height * 4)
+        viewer = ngl.Context()
+        assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend,
+                                capture_buffer=capture_buffer, record_commands=record_commands) == 0
+        assert viewer.set_scene(get_scene()) == 0
+        frames = []
+        for t in (0.0, 0.5, 1.0):
+            assert viewer.draw(t) == 0
+            frames.append(zlib.crc32(capture_buffer))
+        crcs.append(frames)
+        del viewer
+    assert len(set(crcs[0])) == 3
+    assert crcs[0] == crcs[1]
+
+
+def api_calls(width=16, height=16):
+    import csv
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend) == 0
+    scene = _get_scene()
+    assert viewer.set_scene(scene) == 0
+    # The counters are reset for every frame so consecutive frames of a static
+    # scene must report the exact same calls
+    calls = []
+    for i in range(3):
+        assert viewer.draw(i) == 0
+        stats = viewer.get_stats()
+        assert stats['nb_draw_calls'] == 1
+        assert stats['nb_dispatch_calls'] == 0
+        assert 0 < stats['nb_state_changes'] < stats['nb_api_calls']
+        rows = list(csv.DictReader(viewer.export_api_calls().decode().splitlines()))
+        assert sum(int(row['calls']) for row in rows) == stats['nb_api_calls']
+        calls.append(rows)
+    assert calls[1] == calls[2]
+    del viewer
+
+
+_compute_scale = '''
+layout(local_size_x = 4, local_size_y = 1, local_size_z = 1) in;
+
+void main()
+{
+    uint i = gl_LocalInvocationIndex;
+    dst.vertices[i] = src.vertices[i] * 0.5;
+}
+'''
+
+
+def api_memory_barriers(width=16, height=16):
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend) == 0
+    vertices_data = array.array('f', [-1.0, -1.0, 0.0, 1.0, -1.0, 0.0, 1.0, 1.0, 0.0, -1.0, 1.0, 0.0])
+    src = ngl.Block(fields=[ngl.BufferVec3(data=vertices_data, label='vertices')], layout='std140')
+    dst = ngl.Block(fields=[ngl.BufferVec3(data=vertices_data, label='vertices')], layout='std430')
+    compute = ngl.Compute(1, 1, 1, ngl.ComputeProgram(_compute_scale))
+    compute.update_resources(src=src, dst=dst)
+    geometry = ngl.Geometry(ngl.BufferVec3(block=dst, block_field=0), topology='triangle_fan')
+    assert viewer.set_scene(ngl.Group(children=(compute, _get_scene(geometry), _get_scene(geometry)))) == 0
+    # The vertices written by the compute need a barrier before the first
+    # render, which also covers the second one. From the second frame, the
+    # storage blocks written by the previous dispatch also need a barrier
+    # before the next one.
+    for i, nb_barriers in enumerate((1, 2, 2)):
+        assert viewer.draw(i) == 0
+        stats = viewer.get_stats()
+        assert stats['nb_dispatch_calls'] == 1
+        assert stats['nb_memory_barriers'] == nb_barriers
+        assert stats['nb_elided_memory_barriers'] == 1
+    del viewer
+
+
+def api_memory(width=16, height=16):
+    import csv
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend) == 0
+    ctx_size = viewer.get_stats()['memory_total_size']
+    texture = ngl.Texture2D(width=width, height=height)
+    scene = ngl.RenderToTexture(_get_scene(), [texture])
+    assert viewer.set_scene(scene) == 0
+    assert viewer.draw(0) == 0
+    stats = viewer.get_stats()
+    assert stats['memory_nb_textures'] == 1
+    assert stats['memory_textures_size'] == width * height * 4
+    assert stats['memory_buffers_size'] > 0
+    rows = list(csv.DictReader(viewer.export_memory().decode().splitlines()))
+    assert sum(int(row['size']) for row in rows) == stats['memory_total_size']
+    assert any(row['class'] == 'Texture2D' and row['category'] == 'texture' for row in rows)
+    # The geometry arenas are shared between nodes and charged to the context
+    assert any(row['class'] == 'context' and row['category'] == 'buffer' for row in rows)
+    # Detaching the scene must release all the memory owned by its nodes
+    assert viewer.set_scene(None) == 0
+    stats = viewer.get_stats()
+    assert stats['memory_total_size'] == ctx_size
+    assert stats['memory_total_max_size'] > ctx_size
+    rows = list(csv.DictReader(viewer.export_memory().decode().splitlines()))
+    assert all(row['class'] == 'context' for row in rows)
+    del viewer
+
+
+def api_memory_pools(width=16, height=16):
+    import csv
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend) == 0
+    ctx_size = viewer.get_stats()['memory_total_size']
+    scene = ngl.Group(children=[ngl.Text('a'), ngl.Text('b')])
+    assert viewer.set_scene(scene) == 0
+    assert viewer.draw(0) == 0
+    # The glyph atlas is shared by both texts and charged to the context
+    rows = list(csv.DictReader(viewer.export_memory().decode().splitlines()))
+    textures = [row for row in rows if row['category'] == 'texture']
+    assert len(textures) == 1
+    assert textures[0]['class'] == 'context' and textures[0]['count'] == '1'
+    assert viewer.set_scene(None) == 0
+    assert viewer.get_stats()['memory_total_size'] == ctx_size
+    del viewer
+
+
+def api_attachpool(width=16, height=16):
+    import csv
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend) == 0
+    ctx_stats = viewer.get_stats()
+
+    def get_rtts(features):
+        rtts = [ngl.RenderToTexture(_get_scene(), [ngl.Texture2D(width=width, height=height)], features=features)
+                for i in range(2)]
+        return ngl.Group(children=rtts)
+
+    # The depth buffers of two RTTs drawn one after the other are aliased
+    assert viewer.set_scene(get_rtts('depth')) == 0
+    assert viewer.draw(0) == 0
+    stats = viewer.get_stats()
+    depth_size = stats['memory_attachments_size'] - ctx_stats['memory_attachments_size']
+    assert depth_size > 0
+    assert stats['memory_nb_attachments'] == ctx_stats['memory_nb_attachments'] + 1
+    rows = list(csv.DictReader(viewer.export_memory().decode().splitlines()))
+    assert all(row['class'] == 'context' for row in rows if row['category'] == 'attachment')
+
+    # Depth buffers preserved between draws can not be aliased
+    assert viewer.set_scene(get_rtts('depth+no_clear')) == 0
+    assert viewer.draw(0) == 0
+    stats = viewer.get_stats()
+    assert stats['memory_nb_attachments'] == ctx_stats['memory_nb_attachments'] + 2
+    assert stats['memory_attachments_size'] == ctx_stats['memory_attachments_size'] + 2 * depth_size
+    rows = list(csv.DictReader(viewer.export_memory().decode().splitlines()))
+    assert sum(1 for row in rows if row['class'] == 'RenderToTexture' and row['category'] == 'attachment') == 2
+
+    assert viewer.set_scene(None) == 0
+    assert viewer.get_stats()['memory_attachments_size'] == ctx_stats['memory_attachments_size']
+    del viewer
+
+
+def api_update_scene(width=16, height=16):
+    import zlib
+    capture_buffer = bytearray(width * height * 4)
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffer) == 0
+
+    def get_scene(color):
+        scene = _get_scene()
+        if not isinstance(color, ngl.UniformVec4):
+            color = ngl.UniformVec4(value=color)
+        scene.update_frag_resources(color=color)
+        texture = ngl.Texture2D(width=width, height=height)
+        rtt = ngl.RenderToTexture(scene, [texture])
+        program = ngl.Program(vertex=_vert_texture, fragment=_frag_texture)
+        program.update_vert_out_vars(var_uvcoord=ngl.IOVec2())
+        render = ngl.Render(ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0)), program)
+        render.update_frag_resources(tex=texture)
+        return ngl.Group(children=(rtt, render))
+
+    assert viewer.set_scene(get_scene((1.0, 0.0, 0.0, 1.0))) == 0
+    assert viewer.draw(0) == 0
+    max_size = viewer.get_stats()['memory_total_max_size']
+    # The nodes of an equivalent scene are not initialized again
+    assert viewer.update_scene(get_scene((1.0, 0.0, 0.0, 1.0))) == 0
+    assert viewer.draw(0) == 0
+    assert viewer.get_stats()['memory_total_max_size'] == max_size
+    # Changing a uniform only re-initializes its ancestors
+    assert viewer.update_scene(get_scene((0.0, 1.0, 0.0, 1.0))) == 0
+    assert viewer.draw(0) == 0
+    crc = zlib.crc32(capture_buffer)
+    assert viewer.set_scene(get_scene((0.0, 1.0, 0.0, 1.0))) == 0
+    assert viewer.draw(0) == 0
+    assert zlib.crc32(capture_buffer) == crc
+    # A node replaced by a current one is not attached: only a live change of
+    # the current node affects the rendering
+    cur_color = ngl.UniformVec4(value=(1.0, 0.0, 0.0, 1.0))
+    assert viewer.set_scene(get_scene(cur_color)) == 0
+    assert viewer.draw(0) == 0
+    crc = zlib.crc32(capture_buffer)
+    new_color = ngl.UniformVec4(value=(1.0, 0.0, 0.0, 1.0))
+    assert viewer.update_scene(get_scene(new_color)) == 0
+    assert new_color.set_value(0.0, 0.0, 1.0, 1.0) == 0
+    assert viewer.draw(0) == 0
+    assert zlib.crc32(capture_buffer) == crc
+    assert cur_color.set_value(0.0, 0.0, 1.0, 1.0) == 0
+    assert viewer.draw(0) == 0
+    assert zlib.crc32(capture_buffer) != crc
+    # A live changed node is never reused, even with the same parameters
+    assert viewer.update_scene(get_scene((0.0, 0.0, 1.0, 1.0))) == 0
+    assert viewer.draw(0) == 0
+    assert zlib.crc32(capture_buffer) != crc
+    assert viewer.update_scene(None) == 0
+    del viewer
+
+
+def api_share_ctx(width=16, height=16):
+    import zlib
+
+    def get_scene():
+        data = array.array('B', [(i * 37) & 0xff for i in range(4 * 4 * 4)])
+        texture = ngl.Texture2D(width=4, height=4, data_src=ngl.BufferUBVec4(data=data))
+        program = ngl.Program(vertex=_vert_texture, fragment=_frag_texture)
+        program.update_vert_out_vars(var_uvcoord=ngl.IOVec2())
+        render = ngl.Render(ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0)), program)
+        render.update_frag_resources(tex=texture)
+        return render
+
+    # Reference rendering without any sharing
+    capture_buffer = bytearray(width * height * 4)
+    viewer = ngl.Context()
+    assert viewer.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffer) == 0
+    assert viewer.set_scene(get_scene()) == 0
+    assert viewer.draw(0) == 0
+    crc = zlib.crc32(capture_buffer)
+    del viewer
+
+    # The share context must be configured
+    viewer0 = ngl.Context()
+    viewer1 = ngl.Context()
+    assert viewer1.configure(offscreen=1, width=width, height=height, backend=_backend, share_ctx=viewer0) < 0
+
+    capture_buffers = [bytearray(width * height * 4) for i in range(2)]
+    assert viewer0.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffers[0]) == 0
+    assert viewer1.configure(offscreen=1, width=width, height=height, backend=_backend, capture_buffer=capture_buffers[1],
+                             share_ctx=viewer0) == 0
+    assert viewer0.set_scene(get_scene()) == 0
+    assert viewer1.set_scene(get_scene()) == 0
+    for viewer, capture_buffer in zip((viewer0, viewer1), capture_buffers):
+        assert viewer.draw(0) == 0
+        assert zlib.crc32(capture_buffer) == crc
+    # The shared resources outlive the scene of the context which created them
+    assert viewer0.set_scene(None) == 0
+    assert viewer1.draw(0) == 0
+    assert zlib.crc32(capture_buffers[1]) == crc
+    del viewer1
+    del viewer0
+
+
 # Exercise the HUD rasterization. We can't really check the output, so this is
 # just for blind coverage and similar code instrumentalization.
 def api_hud(width=234, height=123):
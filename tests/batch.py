@@ -0,0 +1,211 @@
+#!/usr/bin/env python
+#
+# Copyright 2020 GoPro Inc.
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import array
+import pynodegl as ngl
+from pynodegl_utils.misc import scene
+from pynodegl_utils.toolbox.colors import COLORS
+from pynodegl_utils.tests.cmp_fingerprint import test_fingerprint
+
+
+_GRID_SIZE = 4
+
+_COLORS = ('red', 'green', 'blue', 'yellow', 'cyan', 'magenta', 'orange', 'white')
+
+
+def _grid_positions():
+    step = 2.0 / _GRID_SIZE
+    for y in range(_GRID_SIZE):
+        for x in range(_GRID_SIZE):
+            yield (-1.0 + step * (x + 0.5), -1.0 + step * (y + 0.5), 0.0)
+
+
+def _color_program(cfg):
+    return ngl.Program(vertex=cfg.get_vert('color'), fragment=cfg.get_frag('color'))
+
+
+def _get_geometries():
+    size = 1.5 / _GRID_SIZE
+    return (
+        ngl.Quad((-size / 2, -size / 2, 0), (size, 0, 0), (0, size, 0)),
+        ngl.Quad((-size / 2, -size / 4, 0), (size, size / 4, 0), (0, size / 2, 0)),
+    )
+
+
+def _get_batch_scene(cfg, get_geometry, get_color):
+    '''Consecutive sibling renders sharing the same program'''
+    cfg.aspect_ratio = (1, 1)
+    program = _color_program(cfg)
+    group = ngl.Group()
+    for i, position in enumerate(_grid_positions()):
+        render = ngl.Render(get_geometry(i), program)
+        render.update_frag_resources(color=get_color(i))
+        group.add_children(ngl.Translate(render, vector=position))
+    return group
+
+
+@test_fingerprint()
+@scene()
+def batch_shared_geometry(cfg):
+    geometry = _get_geometries()[0]
+    color = ngl.UniformVec4(value=COLORS['azure'])
+    return _get_batch_scene(cfg, lambda i: geometry, lambda i: color)
+
+
+@test_fingerprint()
+@scene()
+def batch_mixed_geometry(cfg):
+    geometries = _get_geometries()
+    color = ngl.UniformVec4(value=COLORS['azure'])
+    return _get_batch_scene(cfg, lambda i: geometries[i % len(geometries)], lambda i: color)
+
+
+def _get_indexed_geometries():
+    size = 1.5 / _GRID_SIZE
+    square = ngl.Geometry(
+        vertices=ngl.BufferVec3(data=array.array('f', [
+            -size / 2, -size / 2, 0,
+             size / 2, -size / 2, 0,
+             size / 2,  size / 2, 0,
+            -size / 2,  size / 2, 0,
+        ])),
+        indices=ngl.BufferUShort(data=array.array('H', [0, 1, 2, 0, 2, 3])),
+    )
+    arrow = ngl.Geometry(
+        vertices=ngl.BufferVec3(data=array.array('f', [
+            -size / 2, -size / 4, 0,
+                    0, -size / 4, 0,
+                    0, -size / 2, 0,
+             size / 2,         0, 0,
+                    0,  size / 2, 0,
+                    0,  size / 4, 0,
+            -size / 2,  size / 4, 0,
+        ])),
+        indices=ngl.BufferUShort(data=array.array('H', [0, 1, 5, 0, 5, 6, 2, 3, 4])),
+    )
+    return square, arrow
+
+
+@test_fingerprint()
+@scene()
+def batch_mixed_indexed_geometry(cfg):
+    geometries = _get_indexed_geometries()
+    color = ngl.UniformVec4(value=COLORS['orange'])
+    return _get_batch_scene(cfg, lambda i: geometries[i % len(geometries)], lambda i: color)
+
+
+@test_fingerprint()
+@scene()
+def batch_differing_uniforms(cfg):
+    geometry = _get_geometries()[0]
+    colors = [ngl.UniformVec4(value=COLORS[name]) for name in _COLORS]
+    return _get_batch_scene(cfg, lambda i: geometry, lambda i: colors[i % len(colors)])
+
+
+_INSTANCE_ID_VERT = '''
+void main()
+{
+    vec4 offset = vec4(float(gl_InstanceID) * 0.5, 0.0, 0.0, 0.0);
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * (ngl_position + offset);
+}
+'''
+
+
+@test_fingerprint()
+@scene()
+def batch_instance_id(cfg):
+    '''Every batch member sees the index of its single instance'''
+    cfg.aspect_ratio = (1, 1)
+    program = ngl.Program(vertex=_INSTANCE_ID_VERT, fragment=cfg.get_frag('color'))
+    geometry = _get_geometries()[0]
+    color = ngl.UniformVec4(value=COLORS['rose'])
+    group = ngl.Group()
+    for position in _grid_positions():
+        render = ngl.Render(geometry, program)
+        render.update_frag_resources(color=color)
+        group.add_children(ngl.Translate(render, vector=position))
+    return group
+
+
+_NORMAL_VERT = '''
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * ngl_position;
+    var_normal = ngl_normal_matrix * ngl_normal;
+}
+'''
+
+
+_NORMAL_FRAG = '''
+void main()
+{
+    ngl_out_color = vec4((var_normal + 1.0) / 2.0, 1.0);
+}
+'''
+
+
+@test_fingerprint()
+@scene()
+def batch_normal_matrix(cfg):
+    '''The members making use of the normal matrix are drawn individually'''
+    cfg.aspect_ratio = (1, 1)
+    program = ngl.Program(vertex=_NORMAL_VERT, fragment=_NORMAL_FRAG)
+    program.update_vert_out_vars(var_normal=ngl.IOVec3())
+    geometry = _get_geometries()[0]
+    group = ngl.Group()
+    for i, position in enumerate(_grid_positions()):
+        render = ngl.Render(geometry, program)
+        render = ngl.Rotate(render, angle=i * 360. / (_GRID_SIZE * _GRID_SIZE), axis=(1, 1, 0))
+        group.add_children(ngl.Translate(render, vector=position))
+    return group
+
+
+def _get_culling_scene(cfg, get_geometry):
+    '''Batch members panning in and out of the viewport'''
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 2.
+    program = _color_program(cfg)
+    color = ngl.UniformVec4(value=COLORS['cyan'])
+    group = ngl.Group()
+    for i, (x, y, z) in enumerate(_grid_positions()):
+        render = ngl.Render(get_geometry(i), program)
+        render.update_frag_resources(color=color)
+        group.add_children(ngl.Translate(render, vector=(x * 2, y * 2, z)))
+    animkf = [
+        ngl.AnimKeyFrameVec3(0, (1, 1, 0)),
+        ngl.AnimKeyFrameVec3(cfg.duration, (-1, -1, 0)),
+    ]
+    return ngl.Translate(group, anim=ngl.AnimatedVec3(animkf))
+
+
+@test_fingerprint(nb_keyframes=5)
+@scene()
+def batch_culling(cfg):
+    geometry = _get_geometries()[0]
+    return _get_culling_scene(cfg, lambda i: geometry)
+
+
+@test_fingerprint(nb_keyframes=5)
+@scene()
+def batch_culling_multi_draw(cfg):
+    geometries = _get_geometries()
+    return _get_culling_scene(cfg, lambda i: geometries[i % len(geometries)])
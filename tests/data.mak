@@ -59,6 +59,7 @@ DATA_TEST_NAMES      += $(addsuffix _std140,$(DATA_TEST_BLOCK_NAMES))
 
 ifneq ($(DISABLE_TESTS_STD430),yes)
 DATA_TEST_NAMES      += $(addsuffix _std430,$(DATA_TEST_BLOCK_NAMES))
+DATA_TEST_NAMES      += vert_frag_std430
 endif
 
 DATA_TEST_NAMES      +=            \
@@ -314,3 +314,34 @@ def data_streamed_buffer_vec4(cfg, show_dbg_points=False):
 @scene(show_dbg_points=scene.Bool())
 def data_streamed_buffer_vec4_time_anim(cfg, show_dbg_points=False):
     return _get_data_streamed_buffer_vec4_scene(cfg, 2, show_dbg_points)
+
+
+_RENDER_VERT_FRAG_BLOCKS_VERT = '''
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * (ngl_position + vec4(vert_block.offset, 0.0));
+}
+'''
+
+_RENDER_VERT_FRAG_BLOCKS_FRAG = '''
+void main()
+{
+    ngl_out_color = frag_block.color;
+}
+'''
+
+
+@test_cuepoints(points={'left': (-0.5, 0), 'right': (0.5, 0)}, tolerance=1)
+@scene()
+def data_vert_frag_std430(cfg):
+    cfg.aspect_ratio = (1, 1)
+    # The storage blocks of the vertex and fragment stages must not share
+    # their binding: the left half quad is moved to the right
+    vert_block = ngl.Block(fields=[ngl.UniformVec3(value=(1, 0, 0), label='offset')], layout='std430')
+    frag_block = ngl.Block(fields=[ngl.UniformVec4(value=(0, 1, 0, 1), label='color')], layout='std430')
+    quad = ngl.Quad((-1, -1, 0), (1, 0, 0), (0, 2, 0))
+    program = ngl.Program(vertex=_RENDER_VERT_FRAG_BLOCKS_VERT, fragment=_RENDER_VERT_FRAG_BLOCKS_FRAG)
+    render = ngl.Render(quad, program)
+    render.update_vert_resources(vert_block=vert_block)
+    render.update_frag_resources(frag_block=frag_block)
+    return render
@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+#
+# Copyright 2020 GoPro Inc.
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import array
+import pynodegl as ngl
+from pynodegl_utils.misc import scene
+from pynodegl_utils.toolbox.colors import COLORS
+from pynodegl_utils.tests.cmp_perf import test_perf
+
+
+def _get_color_render(cfg, color):
+    quad = ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0))
+    prog = ngl.Program(vertex=cfg.get_vert('color'), fragment=cfg.get_frag('color'))
+    render = ngl.Render(quad, prog)
+    render.update_frag_resources(color=color)
+    return render
+
+
+def _get_texture_render(cfg, texture):
+    quad = ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0))
+    prog = ngl.Program(vertex=cfg.get_vert('texture'), fragment=cfg.get_frag('texture'))
+    prog.update_vert_out_vars(var_tex0_coord=ngl.IOVec2(), var_uvcoord=ngl.IOVec2())
+    render = ngl.Render(quad, prog)
+    render.update_frag_resources(tex0=texture)
+    return render
+
+
+@test_perf(nb_keyframes=5)
+@scene()
+def perf_static_render(cfg):
+    return _get_color_render(cfg, ngl.UniformVec4(value=COLORS['orange']))
+
+
+@test_perf(nb_keyframes=5)
+@scene()
+def perf_animated_uniform(cfg):
+    animkf = [
+        ngl.AnimKeyFrameVec4(0, COLORS['orange']),
+        ngl.AnimKeyFrameVec4(cfg.duration, COLORS['cyan']),
+    ]
+    return _get_color_render(cfg, ngl.AnimatedVec4(animkf))
+
+
+@test_perf(nb_keyframes=5)
+@scene()
+def perf_animated_texture(cfg):
+    dim = 16
+    animkf = [
+        ngl.AnimKeyFrameBuffer(0, array.array('f', [0.0] * dim * dim * 4)),
+        ngl.AnimKeyFrameBuffer(cfg.duration, array.array('f', [1.0] * dim * dim * 4)),
+    ]
+    texture = ngl.Texture2D(data_src=ngl.AnimatedBufferVec4(keyframes=animkf), width=dim, height=dim)
+    return _get_texture_render(cfg, texture)
+
+
+@test_perf(nb_keyframes=5)
+@scene()
+def perf_rtt(cfg):
+    texture = ngl.Texture2D(width=64, height=64)
+    rtt = ngl.RenderToTexture(_get_color_render(cfg, ngl.UniformVec4(value=COLORS['orange'])), [texture])
+    return ngl.Group(children=(rtt, _get_texture_render(cfg, texture)))
+
+
+@test_perf(nb_keyframes=5)
+@scene()
+def perf_rtt_animated(cfg):
+    animkf = [
+        ngl.AnimKeyFrameVec4(0, COLORS['orange']),
+        ngl.AnimKeyFrameVec4(cfg.duration, COLORS['cyan']),
+    ]
+    texture = ngl.Texture2D(width=64, height=64)
+    rtt = ngl.RenderToTexture(_get_color_render(cfg, ngl.AnimatedVec4(animkf)), [texture])
+    return ngl.Group(children=(rtt, _get_texture_render(cfg, texture)))
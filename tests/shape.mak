@@ -22,6 +22,8 @@
 SHAPE_TEST_NAMES =              \
     triangle                    \
     triangles_mat4_attribute    \
+    culling_displace            \
+    culling_custom_vertex       \
     quad                        \
     circle                      \
     diamond_colormask           \
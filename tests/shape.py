@@ -367,3 +367,48 @@ def shape_triangles_mat4_attribute(cfg):
     render.update_instance_attributes(matrix=matrices)
     render.update_frag_resources(color=ngl.UniformVec4(value=COLORS['orange']))
     return render
+
+
+_CULLING_DISPLACE_VERT = '''
+void main()
+{
+    vec4 position = ngl_position - vec4(offset, 0.0);
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * position;
+}
+'''
+
+
+@test_fingerprint()
+@scene()
+def shape_culling_displace(cfg):
+    '''Off-screen geometries displaced into the viewport are only drawn with culling disabled'''
+    cfg.aspect_ratio = (1, 1)
+    program = ngl.Program(vertex=_CULLING_DISPLACE_VERT, fragment=cfg.get_frag('color'))
+    group = ngl.Group()
+    for culling, color, y in ((False, 'orange', 0.5), (True, 'azure', -0.5)):
+        geometry = ngl.Quad((2.6, y - 0.4, 0), (0.8, 0, 0), (0, 0.8, 0))
+        render = ngl.Render(geometry, program, culling=culling)
+        render.update_vert_resources(offset=ngl.UniformVec3(value=(3, 0, 0)))
+        render.update_frag_resources(color=ngl.UniformVec4(value=COLORS[color]))
+        group.add_children(render)
+    return group
+
+
+_CULLING_CUSTOM_VERTEX_VERT = '''
+void main()
+{
+    ngl_out_pos = ngl_position;
+}
+'''
+
+
+@test_fingerprint()
+@scene()
+def shape_culling_custom_vertex(cfg):
+    '''A program positioning its geometry without the transformation matrices is never culled'''
+    cfg.aspect_ratio = (1, 1)
+    program = ngl.Program(vertex=_CULLING_CUSTOM_VERTEX_VERT, fragment=cfg.get_frag('color'))
+    geometry = ngl.Quad((-0.5, -0.5, 0), (1, 0, 0), (0, 1, 0))
+    render = ngl.Render(geometry, program)
+    render.update_frag_resources(color=ngl.UniformVec4(value=COLORS['rose']))
+    return ngl.Translate(render, vector=(5, 0, 0))
@@ -31,5 +31,6 @@ TEXT_TEST_NAMES =           \
     align_tc                \
     align_tr                \
     align_tl                \
+    translucent_bg          \
 
 $(eval $(call DECLARE_REF_TESTS,text,$(TEXT_TEST_NAMES)))
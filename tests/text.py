@@ -101,3 +101,18 @@ def text_align_tr(cfg):
 @scene()
 def text_align_tl(cfg):
     return _text(valign="top", halign="left")
+
+
+@test_fingerprint(tolerance=1)
+@scene()
+def text_translucent_bg(cfg):
+    prog = ngl.Program(vertex=cfg.get_vert('color'), fragment=cfg.get_frag('color'))
+    bg = ngl.Render(ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0)), prog)
+    bg.update_frag_resources(color=ngl.UniformVec4(value=COLORS['azure']))
+    text = _text(fg_color=COLORS['white'], bg_color=(0.0, 0.0, 0.0, 0.5))
+    text = ngl.GraphicConfig(text, blend=True,
+                             blend_src_factor='src_alpha',
+                             blend_dst_factor='one_minus_src_alpha',
+                             blend_src_factor_a='zero',
+                             blend_dst_factor_a='one')
+    return ngl.Group(children=(bg, text))